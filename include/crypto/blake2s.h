@@ -30,6 +30,9 @@ struct blake2s_state {
 void blake2s_init(struct blake2s_state *state, const size_t outlen);
 void blake2s_init_key(struct blake2s_state *state, const size_t outlen,
 		      const void *key, const size_t keylen);
+void blake2s_init_key_compressed(struct blake2s_state *state,
+				 const size_t outlen, const void *key,
+				 const size_t keylen);
 void blake2s_update(struct blake2s_state *state, const uint8_t *in, size_t inlen);
 void blake2s_final(struct blake2s_state *state, uint8_t *out, const size_t outlen);
 
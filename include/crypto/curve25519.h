@@ -4,12 +4,18 @@
 #include <sys/systm.h>
 
 #define CURVE25519_KEY_SIZE 32
+#define CURVE25519_BATCH_MAX 8
 
 typedef uint8_t u8;
 
 void curve25519_generic(u8 [CURVE25519_KEY_SIZE],
 			const u8 [CURVE25519_KEY_SIZE],
 			const u8 [CURVE25519_KEY_SIZE]);
+/* The scalar is clamped, so it must be a secret rather than any scalar. */
+void curve25519_generic_base(u8 [CURVE25519_KEY_SIZE],
+			     const u8 [CURVE25519_KEY_SIZE]);
+/* out[i] = scalar[i] * point[i], for up to CURVE25519_BATCH_MAX at once. */
+void curve25519_generic_batch(u8 *[], const u8 *[], const u8 *[], int);
 
 static inline void curve25519_clamp_secret(u8 secret[CURVE25519_KEY_SIZE])
 {
@@ -30,12 +36,11 @@ static inline int curve25519(u8 mypublic[CURVE25519_KEY_SIZE],
 static inline int curve25519_generate_public(u8 pub[CURVE25519_KEY_SIZE],
 				const u8 secret[CURVE25519_KEY_SIZE])
 {
-	static const u8 basepoint[CURVE25519_KEY_SIZE] __aligned(32) = { 9 };
-
 	if (timingsafe_bcmp(secret, null_point, CURVE25519_KEY_SIZE) == 0)
 		return 0;
 
-	return curve25519(pub, secret, basepoint);
+	curve25519_generic_base(pub, secret);
+	return timingsafe_bcmp(pub, null_point, CURVE25519_KEY_SIZE);
 }
 
 static inline void curve25519_generate_secret(u8 secret[CURVE25519_KEY_SIZE])
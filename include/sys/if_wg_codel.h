@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _IF_WG_CODEL_H_
+#define _IF_WG_CODEL_H_
+
+#include <sys/types.h>
+#include <sys/time.h>
+
+/*
+ * CoDel (RFC 8289) for a queue whose owner drains it. Each packet taken off
+ * the queue is passed to wg_codel_drop with the time it waited there. Once
+ * every packet for WG_CODEL_INTERVAL has waited WG_CODEL_TARGET or longer,
+ * one is dropped, and then more at intervals that shrink with the square
+ * root of the number dropped, until a packet gets through in under the
+ * target or the queue runs empty. The caller serializes the calls.
+ */
+#define WG_CODEL_TARGET		(5 * SBT_1MS)
+#define WG_CODEL_INTERVAL	(100 * SBT_1MS)
+
+struct wg_codel {
+	sbintime_t		 c_first_above;	/* 0 while under target. */
+	sbintime_t		 c_drop_next;
+	u_int			 c_count;
+	u_int			 c_lastcount;
+	bool			 c_dropping;
+};
+
+void	wg_codel_init(struct wg_codel *);
+bool	wg_codel_drop(struct wg_codel *, sbintime_t, sbintime_t, bool);
+
+#endif /* _IF_WG_CODEL_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _IF_WG_COOKIE_H_
+#define _IF_WG_COOKIE_H_
+
+#include <sys/types.h>
+
+/*
+ * MAC1, MAC2 and cookie replies. The interface checks MAC1 of every
+ * handshake packet against a BLAKE2s state keyed from its own public key,
+ * so that state is derived whenever the private key changes, through
+ * wg_cookie_checker_set_private, and at attach from the key wg_cloneattach
+ * was given.
+ */
+struct mbuf;
+struct wg_cookie;
+struct wg_cookie_checker;
+struct wg_endpoint;
+struct wg_peer;
+struct wg_pkt_cookie;
+struct wg_softc;
+
+void	wg_precompute_key(uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE],
+			  const char *);
+void	wg_cookie_checker_init(struct wg_cookie_checker *);
+void	wg_cookie_checker_attach(struct wg_softc *);
+void	wg_cookie_checker_set_private(struct wg_softc *,
+				      const uint8_t [WG_KEY_SIZE]);
+void	wg_cookie_checker_precompute_device_keys(struct wg_softc *);
+void	wg_cookie_init(struct wg_cookie *);
+void	wg_cookie_precompute_peer_keys(struct wg_peer *);
+void	wg_compute_mac1(uint8_t [WG_COOKIE_SIZE], const void *, size_t,
+			const uint8_t [WG_KEY_SIZE]);
+void	wg_compute_mac2(uint8_t [WG_COOKIE_SIZE], const void *, size_t,
+			const uint8_t [WG_COOKIE_SIZE]);
+void	wg_make_cookie(uint8_t [WG_COOKIE_SIZE], struct wg_endpoint *,
+		       struct wg_cookie_checker *);
+bool	wg_cookie_check_mac1(struct wg_cookie_checker *, struct mbuf *);
+enum wg_cookie_mac_state
+	wg_cookie_validate_packet(struct wg_cookie_checker *, struct mbuf *,
+				  int);
+void	wg_cookie_add_mac_to_packet(struct wg_cookie *, void *, size_t);
+void	wg_cookie_message_create(struct wg_pkt_cookie *, struct mbuf *,
+				 uint32_t, struct wg_cookie_checker *);
+void	wg_cookie_message_consume(struct wg_pkt_cookie *, struct wg_softc *);
+
+#endif /* _IF_WG_COOKIE_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _IF_WG_DQL_H_
+#define _IF_WG_DQL_H_
+
+#include <sys/types.h>
+#include <machine/atomic.h>
+
+/*
+ * Dynamic queue limits. The limit of a queue follows the rate at which it
+ * is served, so that it holds d_delay milliseconds of work: enough to keep
+ * the consumer busy through a burst when it is fast, and no more latency
+ * than that when it is slow. The rate is measured over intervals of
+ * WG_DQL_INTERVAL_MS. Only an interval in which the queue never ran empty
+ * shows how fast it can be served, and is averaged in; one in which it did
+ * shows how fast it was asked to be, and can raise the rate but not lower
+ * it. The limit stays within d_min and d_max.
+ *
+ * Producers and the consumer report without a lock. Whoever reports first
+ * after an interval is over folds it in; the others carry on.
+ */
+#define WG_DQL_INTERVAL_MS	100
+#define WG_DQL_RATE_WEIGHT	2	/* Each busy interval counts 1/4. */
+
+struct wg_dql {
+	volatile u_int		 d_limit;
+	/* The current interval. */
+	volatile u_int		 d_start;	/* In ticks. */
+	volatile u_int		 d_served;
+	volatile u_int		 d_high;	/* Longest the queue got. */
+	volatile u_int		 d_drained;	/* Whether it ran empty. */
+	/* Written only by whoever folds an interval in. */
+	u_int			 d_rate;	/* Served a second, smoothed. */
+	u_int			 d_watermark;	/* d_high of the last interval. */
+	u_int			 d_min;
+	u_int			 d_max;
+	u_int			 d_delay;	/* Work to hold, in ms. */
+};
+
+void	wg_dql_init(struct wg_dql *, u_int, u_int, u_int, u_int);
+void	wg_dql_served(struct wg_dql *, u_int, u_int);
+
+static inline u_int
+wg_dql_limit(struct wg_dql *d)
+{
+	return (atomic_load_int(&d->d_limit));
+}
+
+/* The queue is len long after an enqueue. A lost race loses a sample. */
+static inline void
+wg_dql_queued(struct wg_dql *d, u_int len)
+{
+	if (len > atomic_load_int(&d->d_high))
+		atomic_store_int(&d->d_high, len);
+}
+
+#endif /* _IF_WG_DQL_H_ */
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _IF_WG_MBUF_H_
+#define _IF_WG_MBUF_H_
+
+#include <sys/types.h>
+
+/*
+ * Data messages are sealed in place, inline or by crypto(9), so the
+ * plaintext is first made into one writable mbuf of its own: what the stack
+ * hands over may be a chain, and its clusters may still be shared with a
+ * socket buffer that TCP will retransmit from. wg_mbuf_data_frame copies
+ * the packet only when it is not so already, or lacks the room for the
+ * header in front and the padding and tag behind. wg_mbuf_tso builds the
+ * packets it cuts from a TSO segment that way to begin with.
+ */
+struct mbuf;
+struct mbufq;
+struct wg_queue_pkt;
+
+struct mbuf *
+	wg_mbuf_data_frame(struct mbuf *, uint32_t, uint64_t);
+void	wg_mbuf_data_seal(struct mbuf *, const uint8_t *);
+int	wg_mbuf_tso(struct mbuf *, struct mbufq *);
+void	wg_mbuf_csum(struct mbuf *);
+
+/* The queue entry of a packet, carried in an mbuf tag from wg_pkt_zone. */
+struct wg_queue_pkt *
+	wg_mbuf_pkt_get(struct mbuf *);
+void	wg_mbuf_pkt_detach(struct wg_queue_pkt *);
+
+#endif /* _IF_WG_MBUF_H_ */
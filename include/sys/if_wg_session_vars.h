@@ -23,9 +23,17 @@
 
 #include <sys/lock.h>
 #include <sys/mutex.h>
+#include <sys/mbuf.h>
 #include <crypto/siphash/siphash.h>
+#include <crypto/blake2s.h>
+#include <opencrypto/cryptodev.h>
+#include <net/route.h>
+#include <vm/uma.h>
 
 #include <sys/wg_module.h>
+#include <sys/if_wg_wheel.h>
+#include <sys/if_wg_dql.h>
+#include <sys/if_wg_codel.h>
 /* This is only needed for wg_keypair. */
 #include <sys/if_wg_session.h>
 
@@ -41,6 +49,15 @@
 
 #define WG_PADDING_SIZE(n) ((-(n)) & (WG_MSG_PADDING_SIZE - 1))
 
+/*
+ * pahole-style layout check: the members from first to last start on a
+ * cache line and span no more than n lines.
+ */
+#define WG_CACHELINE_GROUP(type, first, last, n)			\
+	CTASSERT(offsetof(type, first) % CACHE_LINE_SIZE == 0);		\
+	CTASSERT(offsetof(type, last) + sizeof(((type *)0)->last) -	\
+	    offsetof(type, first) <= (n) * CACHE_LINE_SIZE)
+
 /* Constant for session */
 #define COUNTER_TYPE		int
 //#define COUNTER_BITS_TOTAL	256
@@ -59,16 +76,55 @@
 #define KEEPALIVE_TIMEOUT		10
 #define MAX_TIMER_HANDSHAKES		(90 / REKEY_TIMEOUT)
 #define NEW_HANDSHAKE_TIMEOUT		(REKEY_TIMEOUT + KEEPALIVE_TIMEOUT)
+/*
+ * Peers brought up together would otherwise rekey together forever. Under
+ * load an initiator pushes its next rekey back by a random delay, over a
+ * window of a second for every REKEY_SPREAD_RATE handshake messages
+ * processed in the last second, up to REKEY_SPREAD_TIME. That still leaves
+ * a retry before the responder's own deadline.
+ */
+#define REKEY_SPREAD_RATE		250
+#define REKEY_SPREAD_TIME		(REJECT_AFTER_TIME - KEEPALIVE_TIMEOUT - \
+					 2 * REKEY_TIMEOUT - REKEY_AFTER_TIME)
 //#define COOKIE_SECRET_MAX_AGE		120
 //#define COOKIE_SECRET_LATENCY		5
 
-#define MAX_QUEUED_INCOMING_HANDSHAKES	4096 /* TODO: replace this with DQL */
-#define MAX_STAGED_PACKETS		256
-#define MAX_QUEUED_PACKETS		1024 /* TODO: replace this with DQL */
+#define NOISE_EPHEMERAL_POOL		8 /* Ephemeral keys kept per CPU. */
+#define WG_HANDSHAKE_BATCH		8 /* Initiations consumed together. */
+
+/*
+ * The encrypt queue, each decrypt worker's queue and each handshake class
+ * are limited by a struct wg_dql, which starts at the MAX_QUEUED_ value and
+ * follows the rate the queue is served at, within the bounds below. The
+ * encrypt side counts packets until they are encrypted, crypto(9) included,
+ * and is served as encryptions complete. A peer may stage as many packets
+ * as it may hold.
+ */
+#define MAX_QUEUED_INCOMING_HANDSHAKES	4096
+#define WG_HANDSHAKEQ_MIN		256
+#define WG_HANDSHAKEQ_MAX		8192
+#define WG_HANDSHAKEQ_DELAY		250 /* ms */
+#define MAX_QUEUED_PACKETS		1024
+#define WG_PKTQ_MIN			128
+#define WG_PKTQ_MAX			16384
+#define WG_PKTQ_DELAY			5 /* ms */
+
+/*
+ * Peers with staged packets take turns at the room left in the encrypt
+ * queue, deficit round-robin, each turn worth WG_DRR_QUANTUM bytes.
+ */
+#define WG_DRR_QUANTUM			1500
 
 #define HASHTABLE_PEER_SIZE		(1 << 6)			//1 << 11
 #define HASHTABLE_INDEX_SIZE		(HASHTABLE_PEER_SIZE * 3)	//1 << 13
 
+/* The top bits of a local index name the decrypt worker of its keypair. */
+#define WG_INDEX_WORKER_BITS		4
+#define WG_INDEX_WORKER_SHIFT		(32 - WG_INDEX_WORKER_BITS)
+#define WG_INDEX_WORKER_MASK		(~0u << WG_INDEX_WORKER_SHIFT)
+#define WG_INDEX_WORKER(index)		((index) >> WG_INDEX_WORKER_SHIFT)
+#define MAX_DECRYPT_WORKERS		(1 << WG_INDEX_WORKER_BITS)
+
 
 #if __FreeBSD_version > 1300000
 typedef void timeout_t (void *);
@@ -88,6 +144,44 @@ struct wg_endpoint {
 	} e_local;
 };
 
+/* Outer IPv6 and UDP header, the larger of the two families. */
+#define WG_IPUDP_HDR_MAX	(40 + 8)
+
+/*
+ * Prebuilt outer IP and UDP header for an endpoint. Only the lengths and
+ * the UDP checksum, seeded from h_psum, are patched per packet.
+ */
+struct wg_ipudp_hdr {
+	uint8_t			 h_buf[WG_IPUDP_HDR_MAX] __aligned(4);
+	uint16_t		 h_len;
+	uint16_t		 h_psum;
+	in_port_t		 h_sport;
+	sa_family_t		 h_family;
+	bool			 h_routed;
+};
+
+/*
+ * Header last built for a peer's endpoint, and the route its packets take,
+ * in the spirit of the Linux dst_cache. The header stays valid until the
+ * routing table generation of the family moves on (dc_gen is sampled when
+ * the source is selected), the socket is rebound or the endpoint is
+ * changed. The route is handed to ip_output and ip6_output, which keep the
+ * nexthop they look up in it and reuse it while it is valid and for the
+ * same destination; it is dropped once the generation moves on from
+ * dc_route_gen. Only the peer's send task, which runs one at a time, uses
+ * the route, so it is not under dc_mtx.
+ */
+struct wg_dst_cache {
+	struct mtx		 dc_mtx;
+	rt_gen_t		 dc_gen;
+	struct wg_ipudp_hdr	 dc_hdr;
+	union {
+		struct route	 dc_route;
+		struct route_in6 dc_route6;
+	};
+	rt_gen_t		 dc_route_gen;
+};
+
 struct wg_socket {
 	struct mtx	 so_mtx;
 	uint8_t		 so_rdomain;
@@ -153,6 +247,10 @@ struct wg_queue_pkt {
 	STAILQ_ENTRY(wg_queue_pkt)	 p_serial;
 	STAILQ_ENTRY(wg_queue_pkt)	 p_parallel;
 	uint64_t			 p_nonce;
+	sbintime_t			 p_staged;	/* For CoDel. */
+	/* The first of a TSO segment's packets counts them. */
+	u_int				 p_train;
+	u_int				 p_train_len;
 	int				 p_done;
 	enum wg_pkt_state {
 		WG_PKT_STATE_NEW = 0,
@@ -162,6 +260,19 @@ struct wg_queue_pkt {
 	}				 p_state;
 };
 
+/*
+ * The queue entry and, for received packets, the sender's endpoint ride on
+ * the packet as an mbuf tag. Its storage is a wg_pkt_zone item rather than
+ * malloc(9), and m_tag_free hands it back there.
+ */
+#define MTAG_WG		1600790421
+
+struct wg_pkt_tag {
+	struct m_tag			 t_tag;
+	struct wg_queue_pkt		 t_pkt;
+	struct wg_endpoint		 t_endpoint;
+};
+
 struct wg_pktq {
 	struct mtx			q_mtx;
 	size_t				q_len;
@@ -175,23 +286,52 @@ struct wg_queue_pkt	*wg_pktq_parallel_dequeue(struct wg_pktq *);
 struct wg_queue_pkt	*wg_pktq_serial_dequeue(struct wg_pktq *);
 size_t			 wg_pktq_parallel_len(struct wg_pktq *);
 
+/*
+ * Each worker is bound to one CPU. Data packets are steered to the worker
+ * encoded in their receiver index, so a session is always decrypted on the
+ * same CPU and arrives at the serial stage in order.
+ */
+struct wg_decrypt_worker {
+	struct wg_pktq			 w_queue;
+	struct wg_dql			 w_dql;
+	/* Admitted by wg_input and not yet decrypted, in crypto(9) or not. */
+	volatile u_int			 w_pending;
+	struct grouptask		 w_task;
+	struct wg_softc			*w_sc;
+};
+
 
 /* Counter */
 struct wg_counter {
-	struct mtx	c_mtx;
-	uint64_t	c_send;
-	uint64_t	c_recv;
-	COUNTER_TYPE	c_backtrack[COUNTER_BITS_TOTAL / __LONG_BIT];
+	/* TX: nonces are handed out with an atomic add. */
+	volatile uint64_t c_send __aligned(CACHE_LINE_SIZE);
+
+	/*
+	 * RX: the replay window, changed under c_mtx. wg_input also reads it
+	 * without the lock, to drop stale packets before they are decrypted.
+	 */
+	struct mtx	c_mtx __aligned(CACHE_LINE_SIZE);
+	volatile uint64_t c_recv;
+	volatile COUNTER_TYPE c_backtrack[COUNTER_TYPE_NUM];
 };
 
+WG_CACHELINE_GROUP(struct wg_counter, c_send, c_send, 1);
+WG_CACHELINE_GROUP(struct wg_counter, c_mtx, c_backtrack, 5);
+
 /* Timers */
 struct wg_timers {
 	struct rwlock	t_lock;
-	struct callout	t_retransmit_handshake;
-	struct callout	t_send_keepalive;
-	struct callout	t_new_handshake;
-	struct callout	t_zero_key_material;
-	struct callout	t_persistent_keepalive;
+	struct wg_wheel_entry t_entry;
+	/* Deadlines in ticks, 0 when the timer is not running. */
+	volatile int	t_retransmit_handshake;
+	volatile int	t_send_keepalive;
+	volatile int	t_new_handshake;
+	volatile int	t_zero_key_material;
+	/* The persistent keepalive is due an interval after this. */
+	volatile int	t_last_traversal;
+	/* When t_entry is due, or 0. */
+	volatile int	t_armed;
+	bool		t_disabled;
 	uint16_t	t_persistent_keepalive_interval;
 	uint8_t		t_handshake_attempts;
 	uint8_t		t_need_another_keepalive;
@@ -235,35 +375,51 @@ enum noise_keypair_state {
 };
 
 
+/*
+ * Laid out so that TX and RX never write to a line the other reads:
+ * - the keys, indices and k_state are read by every packet and only
+ *   written while the handshake runs;
+ * - k_counter keeps c_send (TX) and the replay window (RX) apart;
+ * - the reference count, hash linkage and handshake state are cold.
+ * WG_CACHELINE_GROUP below checks this.
+ */
 struct noise_keypair {
-	LIST_ENTRY(noise_keypair)	 k_entry;
-	volatile uint32_t			 k_refcnt;
-	uint64_t			 k_id;
-	struct wg_peer			*k_peer;
-
-	uint8_t				 k_send[WG_KEY_SIZE];
+	uint8_t				 k_send[WG_KEY_SIZE] __aligned(CACHE_LINE_SIZE);
 	uint8_t				 k_recv[WG_KEY_SIZE];
+	struct wg_peer			*k_peer;
 	uint32_t			 k_local_index;
 	uint32_t			 k_remote_index;
+	struct timespec			 k_birthdate;
+	uint32_t			 k_rekey_delay;	/* ms */
+	/* Written under k_mtx while the handshake runs. */
+	enum noise_keypair_state	 k_state;
 
 	struct wg_counter		 k_counter;
-	struct timespec			 k_birthdate;
 
-	/* Mutex protects the following elements */
+	volatile uint32_t		 k_refcnt __aligned(CACHE_LINE_SIZE);
+	CK_LIST_ENTRY(noise_keypair)	 k_entry;
+	uint64_t			 k_id;
+
+	/* Mutex protects the following elements, and k_state */
 	struct mtx			 k_mtx;
-	enum noise_keypair_state	 k_state;
 	uint8_t		 		 k_ephemeral_private[WG_KEY_SIZE];
 	uint8_t		 		 k_remote_ephemeral[WG_KEY_SIZE];
 	uint8_t		 		 k_hash[WG_HASH_SIZE];
 	uint8_t		 		 k_chaining_key[WG_HASH_SIZE];
+
+	struct epoch_context		 k_ctx;
 };
 
+WG_CACHELINE_GROUP(struct noise_keypair, k_send, k_state, 2);
+WG_CACHELINE_GROUP(struct noise_keypair, k_refcnt, k_id, 1);
+
 enum noise_keypair_type {
 	NOISE_KEYPAIR_CURRENT,
 	NOISE_KEYPAIR_PREVIOUS,
 	NOISE_KEYPAIR_NEXT,
 };
 
+/* Written under kp_mtx, read locklessly within the net epoch. */
 struct noise_keypairs {
 	struct mtx			 kp_mtx;
 	struct noise_keypair		*kp_current_keypair;
@@ -284,6 +440,11 @@ struct noise_local {
 	int		l_has_identity;
 	uint8_t		l_public[WG_KEY_SIZE];
 	uint8_t		l_private[WG_KEY_SIZE];
+
+	/* Handshake load, counted without caring much about races. */
+	volatile u_int	l_load_count;	/* Messages during l_load_second. */
+	u_int		l_load_last;	/* Messages the second before. */
+	time_t		l_load_second;
 };
 
 /* Ratelimiter */
@@ -299,6 +460,8 @@ struct wg_cookie_checker {
 	uint8_t		cc_secret[WG_HASH_SIZE];
 	uint8_t		cc_cookie_key[WG_KEY_SIZE];
 	uint8_t		cc_message_mac1_key[WG_KEY_SIZE];
+	/* BLAKE2s keyed with cc_message_mac1_key, past the key block. */
+	struct blake2s_state cc_mac1_state;
 	struct timespec cc_secret_birthdate;
 };
 
@@ -328,47 +491,106 @@ enum wg_cookie_mac_state {
 
 struct wg_softc;
 
+/*
+ * Grouped by who writes what, each group starting on its own cache line:
+ * read-mostly state every packet looks at, the TX path, the RX path, the
+ * timers (shared, but only behind t_lock) and configuration. The layout
+ * is checked with WG_CACHELINE_GROUP below.
+ */
 struct wg_peer {
-	LIST_ENTRY(wg_peer)	 p_entry;
-	uint64_t		 p_id;
+	/* Read-mostly */
 	struct wg_softc		*p_sc;
+	uint64_t		 p_id;
 	volatile uint32_t		 p_refcnt;
-
-	struct noise_remote	 p_remote;
-	struct wg_cookie	 p_cookie;
-	struct wg_timers	 p_timers;
 	struct noise_keypairs	 p_keypairs;
-
-	struct rwlock		 p_endpoint_lock;
 	struct wg_endpoint	 p_endpoint;
 
+	/* TX */
+	struct mtx p_lock __aligned(CACHE_LINE_SIZE);
 	struct mbufq	 p_staged_packets;
-	struct grouptask		 p_send_staged;
-
+	struct rwlock		 p_endpoint_lock;
 	struct wg_pktq	 p_send_queue;
-	struct wg_pktq	 p_recv_queue;
+	volatile u_int		 p_send_pending;
+	counter_u64_t		 p_tx_bytes;
+	struct wg_dst_cache	 p_dst_cache;
+	struct wg_codel		 p_codel;	/* Behind p_lock. */
+	/* Behind sc_drr.d_mtx. */
+	TAILQ_ENTRY(wg_peer)	 p_drr_entry;
+	int			 p_drr_deficit;
+	bool			 p_drr_active;
+
+	/* RX */
+	struct wg_pktq	 p_recv_queue __aligned(CACHE_LINE_SIZE);
+	volatile u_int		 p_recv_pending;
+	counter_u64_t		 p_rx_bytes;
+
+	struct wg_timers	 p_timers __aligned(CACHE_LINE_SIZE);
+
+	/* Cold */
+	LIST_ENTRY(wg_peer)	 p_entry __aligned(CACHE_LINE_SIZE);
+	struct noise_remote	 p_remote;
+	struct wg_cookie	 p_cookie;
+
+	struct grouptask		 p_send_staged;
 	struct grouptask		 p_send;
 	struct grouptask		 p_recv;
-
 	struct grouptask		 p_tx_initiation;
 
-	counter_u64_t		 p_tx_bytes;
-	counter_u64_t		 p_rx_bytes;
-
 	CK_LIST_HEAD(, wg_route)	 p_routes;
-	struct mtx p_lock;
 	struct epoch_context p_ctx;
 };
 
+WG_CACHELINE_GROUP(struct wg_peer, p_sc, p_endpoint, 2);
+WG_CACHELINE_GROUP(struct wg_peer, p_lock, p_tx_bytes, 3);
+WG_CACHELINE_GROUP(struct wg_peer, p_recv_queue, p_rx_bytes, 2);
+WG_CACHELINE_GROUP(struct wg_peer, p_timers, p_timers, 8);
+WG_CACHELINE_GROUP(struct wg_peer, p_entry, p_entry, 1);
+
 struct wg_hashtable {
 	struct mtx			 h_mtx;
 	SIPHASH_KEY			 h_secret;
 	LIST_HEAD(, wg_peer)		*h_peers;
 	u_long				 h_peers_mask;
 	size_t				 h_num_peers;
-	LIST_HEAD(, noise_keypair)	*h_keys;
+	CK_LIST_HEAD(, noise_keypair)	*h_keys;
 	u_long				 h_keys_mask;
 	size_t				 h_num_keys;
+	u_int				 h_workers;
+	u_int				 h_next_worker;
+};
+
+/*
+ * Handshake packets waiting for the handshake task, in two classes. Those
+ * that carry a valid MAC2 cookie, or answer a message of ours, are served
+ * ahead of the rest, so that a flood of initiations cannot keep real peers
+ * from completing handshakes. hq_load is the queue length, smoothed over
+ * the packets the task has taken, and decides whether the interface is
+ * under load.
+ */
+enum wg_handshake_class {
+	WG_HANDSHAKE_PRIORITY,
+	WG_HANDSHAKE_NORMAL,
+	WG_HANDSHAKE_CLASSES
+};
+
+#define WG_HANDSHAKE_LOAD_SHIFT		8 /* Fixed point hq_load. */
+#define WG_HANDSHAKE_LOAD_WEIGHT	3 /* Each sample counts 1/8. */
+
+struct wg_handshake_queue {
+	struct mtx	hq_mtx;
+	struct mbufq	hq_class[WG_HANDSHAKE_CLASSES];
+	struct wg_dql	hq_dql;		/* Limits each class. */
+	u_int		hq_load;
+	struct timespec	hq_last_under_load;
+};
+
+/*
+ * The peers waiting for room in the encrypt queue. Each holds a reference
+ * while it is on d_active.
+ */
+struct wg_drr {
+	struct mtx		 d_mtx;
+	TAILQ_HEAD(, wg_peer)	 d_active;
 };
 
 /* Softc */
@@ -383,16 +605,30 @@ struct wg_softc {
 	struct wg_route_table	 sc_routes;
 
 	struct taskq		*sc_taskq;
-	struct mbufq	 sc_handshake_queue;
+	struct wg_handshake_queue sc_handshake_queue;
 	struct grouptask		 sc_handshake;
 
 	struct noise_local	 sc_local;
 	struct wg_cookie_checker sc_cookie_checker;
 
 	struct wg_pktq sc_encrypt_queue;
-	struct wg_pktq sc_decrypt_queue;
+	struct wg_dql			 sc_encrypt_dql;
+	/* Admitted by sc_drr and not yet encrypted, in crypto(9) or not. */
+	volatile u_int			 sc_encrypt_pending;
+	volatile u_int			 sc_encrypt_stopped;
+	struct wg_drr			 sc_drr;
 	struct grouptask		 sc_encrypt;
-	struct grouptask		 sc_decrypt;
+
+	u_int				 sc_decrypt_workers;
+	struct wg_decrypt_worker	 sc_decrypt[MAX_DECRYPT_WORKERS];
+
+	/* Drives the timers of every peer. */
+	struct wg_wheel		 sc_wheel;
+
+	crypto_session_t	 sc_crypto;
+	/* Requests handed to crypto(9) whose callback has yet to run. */
+	volatile u_int		 sc_crypto_pending;
+	volatile u_int		 sc_crypto_draining;
 };
 
 struct wg_peer *
@@ -404,7 +640,16 @@ struct wg_peer	*
 void	wg_peer_put(struct wg_peer *);
 void	wg_peer_remove_all(struct wg_softc *);
 
+/* Staging, and the encrypt queue the peers share */
+int	wg_peer_stage(struct wg_peer *, struct mbuf *);
+bool	wg_peer_stage_keepalive(struct wg_peer *);
+void	wg_peer_send_keepalive(struct wg_peer *);
 void	wg_peer_send_staged_packets(struct wg_peer *);
+void	wg_peer_send_staged_packets_ref(struct wg_peer *);
+void	wg_peer_flush_staged_packets(struct wg_peer *);
+bool	wg_softc_drr_run(struct wg_softc *, bool);
+void	wg_softc_drr_remove(struct wg_softc *, struct wg_peer *);
+void	wg_softc_encrypt_done(struct wg_softc *);
 
 void	wg_hashtable_init(struct wg_hashtable *);
 void	wg_hashtable_destroy(struct wg_hashtable *);
@@ -412,12 +657,154 @@ void	wg_hashtable_destroy(struct wg_hashtable *);
 
 int	wg_route_init(struct wg_route_table *);
 
+int	wg_crypto_init(struct wg_softc *);
+void	wg_crypto_drain(struct wg_softc *);
+void	wg_crypto_uninit(struct wg_softc *);
+
+void	wg_softc_handshake_init(struct wg_softc *);
+void	wg_softc_handshake_uninit(struct wg_softc *);
+
+void	wg_softc_encrypt_init(struct wg_softc *);
+void	wg_softc_encrypt_uninit(struct wg_softc *);
+
+void	wg_decrypt_workers_init(struct wg_softc *);
+void	wg_decrypt_workers_uninit(struct wg_softc *);
+
+/* Timers */
+void	wg_softc_timers_init(struct wg_softc *);
+void	wg_softc_timers_uninit(struct wg_softc *);
+void	wg_peer_timers_init(struct wg_peer *);
+void	wg_peer_timers_stop(struct wg_peer *);
+void	wg_peer_timers_last_handshake(struct wg_peer *, struct timespec *);
+void	wg_peer_timers_data_sent(struct wg_peer *);
+void	wg_peer_timers_data_received(struct wg_peer *);
+void	wg_peer_timers_any_authenticated_packet_sent(struct wg_peer *);
+void	wg_peer_timers_any_authenticated_packet_received(struct wg_peer *);
+void	wg_peer_timers_handshake_initiated(struct wg_peer *);
+void	wg_peer_timers_handshake_complete(struct wg_peer *);
+void	wg_peer_timers_session_derived(struct wg_peer *);
+void	wg_peer_timers_any_authenticated_packet_traversal(struct wg_peer *);
+
+void	wg_stats_init(void);
+void	wg_stats_uninit(void);
+
+extern counter_u64_t wg_send_codel_drops;
+extern counter_u64_t wg_send_stops;
+extern counter_u64_t wg_send_refused;
+void	wg_softc_sysctl_init(struct wg_softc *, struct sysctl_ctx_list *,
+	    struct sysctl_oid_list *);
+
+extern uma_zone_t wg_keypair_zone;
+extern uma_zone_t wg_pkt_zone;
+
+void	wg_zones_init(void);
+void	wg_zones_uninit(void);
+
 int wg_socket_init(struct wg_softc *sc);
 void wg_socket_reinit(struct wg_softc *, struct socket *so4,
     struct socket *so6);
 
+#if 0
+#define DPRINTF(sc, str, ...) do { if (ISSET((sc)->sc_if.if_flags, IFF_DEBUG)) \
+    printf("%s: " str, (sc)->sc_if.if_xname, ##__VA_ARGS__); } while (0)
+#endif
+
+#define DPRINTF(sc, s, ...)
+
+/* Counter */
+void	wg_counter_init(struct wg_counter *);
+uint64_t
+	wg_counter_next(struct wg_counter *, u_int);
+int	wg_counter_validate(struct wg_counter *, uint64_t);
+bool	wg_counter_stale(struct wg_counter *, uint64_t);
+
+/* Shared between if_wg_session.c, if_wg_noise.c and if_wg_cookie.c */
+int	wg_timers_expired(struct timespec *, time_t, long);
+void	wg_peer_queue_handshake_initiation(struct wg_peer *, int);
+void	wg_peer_clear_src(struct wg_peer *);
+struct wg_endpoint *
+	wg_mbuf_endpoint_get(struct mbuf *);
+int	wg_ratelimiter_allow(struct wg_ratelimiter *, struct mbuf *);
+
+struct wg_peer *
+	wg_hashtable_peer_lookup(struct wg_hashtable *,
+				 const uint8_t [WG_KEY_SIZE]);
+uint32_t
+	wg_hashtable_keypair_insert(struct wg_hashtable *,
+						     struct noise_keypair *);
+struct noise_keypair *
+	wg_hashtable_keypair_lookup(struct wg_hashtable *, const uint32_t);
+void	wg_hashtable_keypair_remove(struct wg_hashtable *,
+				    struct noise_keypair *);
+
+/* Noise */
+void	noise_remote_init(struct noise_remote *, uint8_t [WG_KEY_SIZE]);
+void	noise_remote_set_psk(struct noise_remote *, uint8_t [WG_KEY_SIZE]);
+void	noise_local_init(struct noise_local *);
+void	noise_local_set_private(struct noise_local *,
+				const uint8_t [WG_KEY_SIZE]);
+
+struct noise_keypair *
+	noise_keypair_create(void);
+void	noise_keypair_attach_to_peer(struct noise_keypair *, struct wg_peer *);
+struct noise_keypair *
+	noise_keypair_ref(struct noise_keypair *);
+struct noise_keypair *
+	noise_keypair_ref_epoch(struct noise_keypair *);
+void	noise_keypair_put(struct noise_keypair *);
+void	noise_keypair_destroy(struct noise_keypair **);
+void	noise_keypair_free(struct noise_keypair *);
+void	noise_keypairs_init(struct noise_keypairs *);
+void	noise_keypairs_clear(struct noise_keypairs *);
+void	noise_keypairs_insert_new(struct noise_keypairs *,
+				  struct noise_keypair *);
+struct noise_keypair *
+	noise_keypairs_lookup(struct noise_keypairs *,
+			      enum noise_keypair_type);
+struct noise_keypair *
+	noise_keypairs_current(struct noise_keypairs *);
+int	noise_keypairs_begin_session(struct noise_keypairs *);
+int	noise_keypairs_received_with_keypair(struct noise_keypairs *,
+					     struct noise_keypair *);
+void	noise_keypairs_keep_key_fresh_send(struct noise_keypairs *);
+void	noise_keypairs_keep_key_fresh_recv(struct noise_keypairs *);
+
+void	noise_kdf(uint8_t *, uint8_t *, uint8_t *, const uint8_t *, size_t,
+		  size_t, size_t, size_t, const uint8_t [WG_HASH_SIZE]);
+int	noise_mix_dh(uint8_t [WG_HASH_SIZE], uint8_t [WG_KEY_SIZE],
+		     const uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE]);
+void	noise_mix_hash(uint8_t [WG_HASH_SIZE], const uint8_t *, size_t);
+void	noise_mix_psk(uint8_t [WG_HASH_SIZE], uint8_t [WG_HASH_SIZE],
+		      uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE]);
+void	noise_param_init(uint8_t [WG_HASH_SIZE], uint8_t [WG_HASH_SIZE],
+			 const uint8_t [WG_KEY_SIZE]);
+void	noise_message_encrypt(uint8_t *, const uint8_t *, size_t,
+			      uint8_t [WG_KEY_SIZE], uint8_t [WG_HASH_SIZE]);
+int	noise_message_decrypt(uint8_t *, const uint8_t *, size_t,
+			      uint8_t [WG_KEY_SIZE], uint8_t [WG_HASH_SIZE]);
+void	noise_message_ephemeral(uint8_t [WG_KEY_SIZE],
+				const uint8_t [WG_KEY_SIZE],
+				uint8_t [WG_HASH_SIZE],
+				uint8_t [WG_HASH_SIZE]);
+void	noise_tai64n_now(uint8_t [WG_TIMESTAMP_SIZE]);
+
+int	noise_handshake_create_initiation(struct wg_pkt_initiation *,
+					  struct wg_peer *peer);
+struct noise_keypair *
+	noise_handshake_consume_initiation(struct wg_pkt_initiation *,
+					   struct wg_softc *);
+void	noise_handshake_consume_initiations(struct wg_pkt_initiation *[],
+					    struct noise_keypair *[], int,
+					    struct wg_softc *);
+int	noise_handshake_create_response(struct wg_pkt_response *,
+					struct wg_peer *peer);
+struct noise_keypair *
+	noise_handshake_consume_response(struct wg_pkt_response *,
+					 struct wg_softc *);
 
 void wg_noise_param_init(void);
+void noise_ephemeral_init(void);
+void noise_ephemeral_uninit(void);
 
 
 
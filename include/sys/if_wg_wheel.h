@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _IF_WG_WHEEL_H_
+#define _IF_WG_WHEEL_H_
+
+#include <sys/types.h>
+#include <sys/queue.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/callout.h>
+#include <machine/atomic.h>
+
+/*
+ * A hierarchical timer wheel driven by one callout. Level 0 has a slot per
+ * wheel tick (WG_WHEEL_HZ a second) and the slots of every level above are
+ * eight times as coarse, so five levels of 64 slots cover 43 minutes. An
+ * entry goes on the finest level that reaches its deadline and fires from
+ * there when its slot comes round, without being cascaded down, which makes
+ * it late by at most a slot of that level: an eighth of its timeout. All
+ * that expires in a tick is handed to the callback in batches of up to
+ * WG_WHEEL_BATCH.
+ */
+#define WG_WHEEL_HZ		100
+#define WG_WHEEL_BITS		6
+#define WG_WHEEL_SLOTS		(1 << WG_WHEEL_BITS)
+#define WG_WHEEL_MASK		(WG_WHEEL_SLOTS - 1)
+#define WG_WHEEL_GRAN_BITS	3
+#define WG_WHEEL_LEVELS		5
+#define WG_WHEEL_BATCH		256
+#define WG_WHEEL_IDLE		(-1)
+
+struct wg_wheel_entry {
+	TAILQ_ENTRY(wg_wheel_entry) we_entry;
+	uint64_t		 we_expire;	/* Wheel tick it fires on. */
+	/* Slot the entry is on, WG_WHEEL_IDLE when it is not pending. */
+	volatile int		 we_level;
+	int			 we_slot;
+};
+
+TAILQ_HEAD(wg_wheel_slot, wg_wheel_entry);
+
+typedef void wg_wheel_fn_t(void *, struct wg_wheel_entry **, int);
+
+struct wg_wheel {
+	struct mtx		 w_mtx;
+	struct callout		 w_callout;
+	wg_wheel_fn_t		*w_fn;
+	void			*w_arg;
+	int			 w_tick;	/* Kernel ticks a wheel tick. */
+	uint64_t		 w_now;		/* Next wheel tick to run. */
+	int			 w_ticks;	/* Kernel tick w_now is due. */
+	uint64_t		 w_armed;	/* Wheel tick w_callout is due. */
+	u_int			 w_count;
+	bool			 w_running;
+	bool			 w_dying;
+	uint64_t		 w_used[WG_WHEEL_LEVELS];
+	struct wg_wheel_slot	 w_slots[WG_WHEEL_LEVELS][WG_WHEEL_SLOTS];
+	/* Only w_callout runs the wheel, so one batch buffer will do. */
+	struct wg_wheel_entry	*w_batch[WG_WHEEL_BATCH];
+};
+
+void	wg_wheel_init(struct wg_wheel *, wg_wheel_fn_t *, void *);
+void	wg_wheel_uninit(struct wg_wheel *);
+void	wg_wheel_entry_init(struct wg_wheel_entry *);
+bool	wg_wheel_schedule(struct wg_wheel *, struct wg_wheel_entry *, int);
+bool	wg_wheel_remove(struct wg_wheel *, struct wg_wheel_entry *);
+
+static inline bool
+wg_wheel_pending(struct wg_wheel_entry *e)
+{
+	return (atomic_load_int(&e->we_level) != WG_WHEEL_IDLE);
+}
+
+#endif /* _IF_WG_WHEEL_H_ */
@@ -3,6 +3,7 @@
 
 #include <sys/mbuf.h>
 #include <sys/socket.h>
+#include <sys/sysctl.h>
 #include <net/if.h>
 #include <net/if_var.h>
 #include <net/ethernet.h>
@@ -15,6 +16,7 @@
 #include <crypto/blake2s.h>
 
 MALLOC_DECLARE(M_WG);
+SYSCTL_DECL(_net_wg);
 
 
 typedef struct {
@@ -178,6 +178,20 @@ static inline void blake2s_compress(struct blake2s_state *state,
 	}
 }
 
+/* As blake2s_init_key, but with the key block compressed straight away
+ * rather than left in the buffer. A copy of the state then takes a keyed
+ * hash of any non-empty message without paying for the key again.
+ */
+void blake2s_init_key_compressed(struct blake2s_state *state,
+				 const size_t outlen, const void *key,
+				 const size_t keylen)
+{
+	blake2s_init_key(state, outlen, key, keylen);
+	blake2s_compress(state, state->buf, 1, BLAKE2S_BLOCK_SIZE);
+	explicit_bzero(state->buf, BLAKE2S_BLOCK_SIZE);
+	state->buflen = 0;
+}
+
 void blake2s_update(struct blake2s_state *state, const uint8_t *in, size_t inlen)
 {
 	const size_t fill = BLAKE2S_BLOCK_SIZE - state->buflen;
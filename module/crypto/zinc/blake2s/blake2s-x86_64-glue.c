@@ -20,6 +20,26 @@ static bool blake2s_use_avx512 __ro_after_init;
 static bool *const blake2s_nobs[] __initconst = { &blake2s_use_ssse3,
 						  &blake2s_use_avx512 };
 
+/* Bits follow the order of blake2s_nobs. */
+enum blake2s_impl_bits {
+	BLAKE2S_IMPL_SSSE3 = BIT(0),
+	BLAKE2S_IMPL_AVX512 = BIT(1)
+};
+
+static bool blake2s_calibrate __ro_after_init;
+static unsigned long blake2s_impl[CALIBRATE_CLASSES] = {
+	[0 ... CALIBRATE_CLASSES - 1] = ~0UL };
+static unsigned long blake2s_impl_nsecs[CALIBRATE_CLASSES];
+static int blake2s_impl_override = CALIBRATE_AUTO;
+module_param(blake2s_calibrate, bool, 0444);
+MODULE_PARM_DESC(blake2s_calibrate, "Time each BLAKE2s implementation at load");
+module_param_array(blake2s_impl, ulong, NULL, 0444);
+MODULE_PARM_DESC(blake2s_impl, "Implementation mask chosen per size class");
+module_param_array(blake2s_impl_nsecs, ulong, NULL, 0444);
+MODULE_PARM_DESC(blake2s_impl_nsecs, "Calibrated cost per size class in ns");
+module_param(blake2s_impl_override, int, 0644);
+MODULE_PARM_DESC(blake2s_impl_override, "Force an implementation mask, -1 for auto");
+
 static void __init blake2s_fpu_init(void)
 {
 	blake2s_use_ssse3 = boot_cpu_has(X86_FEATURE_SSSE3);
@@ -38,6 +58,9 @@ static inline bool blake2s_compress_arch(struct blake2s_state *state,
 					 const u8 *block, size_t nblocks,
 					 const u32 inc)
 {
+	const unsigned long impl = calibrate_mask(blake2s_impl,
+			READ_ONCE(blake2s_impl_override),
+			nblocks * BLAKE2S_BLOCK_SIZE);
 	simd_context_t simd_context;
 	bool used_arch = false;
 
@@ -47,7 +70,7 @@ static inline bool blake2s_compress_arch(struct blake2s_state *state,
 	simd_get(&simd_context);
 
 	if (!IS_ENABLED(CONFIG_AS_SSSE3) || !blake2s_use_ssse3 ||
-	    !simd_use(&simd_context))
+	    !(impl & BLAKE2S_IMPL_SSSE3) || !simd_use(&simd_context))
 		goto out;
 	used_arch = true;
 
@@ -55,7 +78,8 @@ static inline bool blake2s_compress_arch(struct blake2s_state *state,
 		const size_t blocks = min_t(size_t, nblocks,
 					    PAGE_SIZE / BLAKE2S_BLOCK_SIZE);
 
-		if (IS_ENABLED(CONFIG_AS_AVX512) && blake2s_use_avx512)
+		if (IS_ENABLED(CONFIG_AS_AVX512) && blake2s_use_avx512 &&
+		    (impl & BLAKE2S_IMPL_AVX512))
 			blake2s_compress_avx512(state, block, blocks, inc);
 		else
 			blake2s_compress_ssse3(state, block, blocks, inc);
@@ -70,3 +94,21 @@ out:
 	simd_put(&simd_context);
 	return used_arch;
 }
+
+static u8 blake2s_calibrate_buf[CALIBRATE_MAX_LEN] __initdata;
+
+static void __init blake2s_calibrate_one(size_t len)
+{
+	u8 hash[BLAKE2S_HASH_SIZE];
+
+	blake2s(hash, blake2s_calibrate_buf, NULL, sizeof(hash), len, 0);
+}
+
+static void __init blake2s_calibrate_init(void)
+{
+	if (!blake2s_calibrate)
+		return;
+	calibrate_run("blake2s", blake2s_calibrate_one, blake2s_nobs,
+		      ARRAY_SIZE(blake2s_nobs), blake2s_impl,
+		      blake2s_impl_nsecs);
+}
@@ -10,6 +10,7 @@
 
 #include <zinc/blake2s.h>
 #include "../selftest/run.h"
+#include "../calibrate.h"
 
 #include <linux/types.h>
 #include <linux/string.h>
@@ -90,6 +91,9 @@ static bool *const blake2s_nobs[] __initconst = { };
 static void __init blake2s_fpu_init(void)
 {
 }
+static void __init blake2s_calibrate_init(void)
+{
+}
 static inline bool blake2s_compress_arch(struct blake2s_state *state,
 					 const u8 *block, size_t nblocks,
 					 const u32 inc)
@@ -259,6 +263,8 @@ static int __init mod_init(void)
 	if (!selftest_run("blake2s", blake2s_selftest, blake2s_nobs,
 			  ARRAY_SIZE(blake2s_nobs)))
 		return -ENOTRECOVERABLE;
+	if (!nosimd)
+		blake2s_calibrate_init();
 	return 0;
 }
 
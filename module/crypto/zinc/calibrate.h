@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Load-time micro-calibration of the SIMD implementations. Instead of
+ * trusting CPUID alone, each combination of implementations that passed the
+ * self-tests is timed on a representative packet size for every size class,
+ * and the fastest combination is remembered per class.
+ */
+
+#ifndef _ZINC_CALIBRATE_H
+#define _ZINC_CALIBRATE_H
+
+#include <linux/kernel.h>
+#include <linux/printk.h>
+#include <linux/ktime.h>
+#include <linux/bug.h>
+
+enum calibrate_class {
+	CALIBRATE_CLASS_SMALL,	/* Handshakes, keepalives, bare ACKs. */
+	CALIBRATE_CLASS_MEDIUM,
+	CALIBRATE_CLASS_LARGE,	/* Full sized tunnel packets. */
+	CALIBRATE_CLASSES
+};
+
+enum calibrate_values {
+	CALIBRATE_SMALL_MAX = 256,
+	CALIBRATE_MEDIUM_MAX = 1024,
+	CALIBRATE_MAX_LEN = 1440,
+	CALIBRATE_WARMUP = 16,
+	CALIBRATE_ROUNDS = 256,
+	CALIBRATE_TRIALS = 3,
+	/* Leaves every implementation that passed the self-tests enabled. */
+	CALIBRATE_AUTO = -1
+};
+
+/* One representative length per class; must not exceed CALIBRATE_MAX_LEN. */
+static const size_t calibrate_class_len[CALIBRATE_CLASSES] = {
+	[CALIBRATE_CLASS_SMALL] = 128,
+	[CALIBRATE_CLASS_MEDIUM] = 576,
+	[CALIBRATE_CLASS_LARGE] = 1420
+};
+
+static inline enum calibrate_class calibrate_class(size_t len)
+{
+	if (len <= CALIBRATE_SMALL_MAX)
+		return CALIBRATE_CLASS_SMALL;
+	if (len <= CALIBRATE_MEDIUM_MAX)
+		return CALIBRATE_CLASS_MEDIUM;
+	return CALIBRATE_CLASS_LARGE;
+}
+
+/* Returns the bitmask of nobs that may be used for a message of len bytes. */
+static inline unsigned long calibrate_mask(const unsigned long impl[],
+					   const int override, size_t len)
+{
+	if (override != CALIBRATE_AUTO)
+		return (unsigned long)override;
+	return impl[calibrate_class(len)];
+}
+
+/* Like selftest_run, every subset of the enabled nobs is tried in turn. The
+ * winning subset for each class is stored in impl[] and its cost per call in
+ * nsecs[]. The nobs are left as they were found, so that the arch functions
+ * can later be restricted purely through impl[].
+ */
+static inline void calibrate_run(const char *name, void (*bench)(size_t len),
+				 bool *const nobs[], unsigned int nobs_len,
+				 unsigned long impl[CALIBRATE_CLASSES],
+				 unsigned long nsecs[CALIBRATE_CLASSES])
+{
+	unsigned long set = 0, subset = 0, elapsed;
+	unsigned int i, class, trial, round;
+	u64 start;
+
+	BUILD_BUG_ON(!__builtin_constant_p(nobs_len) ||
+		     nobs_len >= BITS_PER_LONG);
+
+	for (i = 0; i < nobs_len; ++i)
+		set |= ((unsigned long)*nobs[i]) << i;
+
+	for (class = 0; class < CALIBRATE_CLASSES; ++class) {
+		impl[class] = set;
+		nsecs[class] = ULONG_MAX;
+	}
+
+	do {
+		for (i = 0; i < nobs_len; ++i)
+			*nobs[i] = BIT(i) & subset;
+		for (class = 0; class < CALIBRATE_CLASSES; ++class) {
+			for (round = 0; round < CALIBRATE_WARMUP; ++round)
+				bench(calibrate_class_len[class]);
+			for (trial = 0; trial < CALIBRATE_TRIALS; ++trial) {
+				start = ktime_get_ns();
+				for (round = 0; round < CALIBRATE_ROUNDS; ++round)
+					bench(calibrate_class_len[class]);
+				elapsed = (ktime_get_ns() - start) /
+					  CALIBRATE_ROUNDS;
+				if (elapsed < nsecs[class]) {
+					nsecs[class] = elapsed;
+					impl[class] = subset;
+				}
+			}
+		}
+		subset = (subset - set) & set;
+	} while (subset);
+
+	for (i = 0; i < nobs_len; ++i)
+		*nobs[i] = BIT(i) & set;
+
+	for (class = 0; class < CALIBRATE_CLASSES; ++class)
+		pr_info("%s calibration: %zu bytes uses 0x%lx of 0x%lx (%lu ns)\n",
+			name, calibrate_class_len[class], impl[class], set,
+			nsecs[class]);
+}
+
+#endif
@@ -10,6 +10,10 @@ static void __init chacha20_fpu_init(void)
 {
 }
 
+static void __init chacha20_calibrate_init(void)
+{
+}
+
 static inline bool chacha20_arch(struct chacha20_ctx *ctx, u8 *dst,
 				 const u8 *src, size_t len,
 				 simd_context_t *simd_context)
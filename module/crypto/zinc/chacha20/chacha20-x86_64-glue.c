@@ -27,6 +27,28 @@ static bool *const chacha20_nobs[] __initconst = {
 	&chacha20_use_ssse3, &chacha20_use_avx2, &chacha20_use_avx512,
 	&chacha20_use_avx512vl };
 
+/* Bits follow the order of chacha20_nobs. */
+enum chacha20_impl_bits {
+	CHACHA20_IMPL_SSSE3 = BIT(0),
+	CHACHA20_IMPL_AVX2 = BIT(1),
+	CHACHA20_IMPL_AVX512 = BIT(2),
+	CHACHA20_IMPL_AVX512VL = BIT(3)
+};
+
+static bool chacha20_calibrate __ro_after_init;
+static unsigned long chacha20_impl[CALIBRATE_CLASSES] = {
+	[0 ... CALIBRATE_CLASSES - 1] = ~0UL };
+static unsigned long chacha20_impl_nsecs[CALIBRATE_CLASSES];
+static int chacha20_impl_override = CALIBRATE_AUTO;
+module_param(chacha20_calibrate, bool, 0444);
+MODULE_PARM_DESC(chacha20_calibrate, "Time each ChaCha20 implementation at load");
+module_param_array(chacha20_impl, ulong, NULL, 0444);
+MODULE_PARM_DESC(chacha20_impl, "Implementation mask chosen per size class");
+module_param_array(chacha20_impl_nsecs, ulong, NULL, 0444);
+MODULE_PARM_DESC(chacha20_impl_nsecs, "Calibrated cost per size class in ns");
+module_param(chacha20_impl_override, int, 0644);
+MODULE_PARM_DESC(chacha20_impl_override, "Force an implementation mask, -1 for auto");
+
 static void __init chacha20_fpu_init(void)
 {
 	chacha20_use_ssse3 = boot_cpu_has(X86_FEATURE_SSSE3);
@@ -61,20 +83,27 @@ static inline bool chacha20_arch(struct chacha20_ctx *ctx, u8 *dst,
 	BUILD_BUG_ON(PAGE_SIZE < CHACHA20_BLOCK_SIZE ||
 		     PAGE_SIZE % CHACHA20_BLOCK_SIZE);
 
+	const unsigned long impl = calibrate_mask(chacha20_impl,
+			READ_ONCE(chacha20_impl_override), len);
+
 	if (!IS_ENABLED(CONFIG_AS_SSSE3) || !chacha20_use_ssse3 ||
-	    len <= CHACHA20_BLOCK_SIZE || !simd_use(simd_context))
+	    !(impl & CHACHA20_IMPL_SSSE3) || len <= CHACHA20_BLOCK_SIZE ||
+	    !simd_use(simd_context))
 		return false;
 
 	for (;;) {
 		const size_t bytes = min_t(size_t, len, PAGE_SIZE);
 
 		if (IS_ENABLED(CONFIG_AS_AVX512) && chacha20_use_avx512 &&
+		    (impl & CHACHA20_IMPL_AVX512) &&
 		    len >= CHACHA20_BLOCK_SIZE * 8)
 			chacha20_avx512(dst, src, bytes, ctx->key, ctx->counter);
 		else if (IS_ENABLED(CONFIG_AS_AVX512) && chacha20_use_avx512vl &&
+			 (impl & CHACHA20_IMPL_AVX512VL) &&
 			 len >= CHACHA20_BLOCK_SIZE * 4)
 			chacha20_avx512vl(dst, src, bytes, ctx->key, ctx->counter);
 		else if (IS_ENABLED(CONFIG_AS_AVX2) && chacha20_use_avx2 &&
+			 (impl & CHACHA20_IMPL_AVX2) &&
 			 len >= CHACHA20_BLOCK_SIZE * 4)
 			chacha20_avx2(dst, src, bytes, ctx->key, ctx->counter);
 		else
@@ -91,6 +120,30 @@ static inline bool chacha20_arch(struct chacha20_ctx *ctx, u8 *dst,
 	return true;
 }
 
+static u8 chacha20_calibrate_buf[CALIBRATE_MAX_LEN] __initdata;
+
+static void __init chacha20_calibrate_one(size_t len)
+{
+	static const u8 key[CHACHA20_KEY_SIZE] __initconst = { 0 };
+	struct chacha20_ctx ctx;
+	simd_context_t simd_context;
+
+	chacha20_init(&ctx, key, 0);
+	simd_get(&simd_context);
+	chacha20(&ctx, chacha20_calibrate_buf, chacha20_calibrate_buf, len,
+		 &simd_context);
+	simd_put(&simd_context);
+}
+
+static void __init chacha20_calibrate_init(void)
+{
+	if (!chacha20_calibrate)
+		return;
+	calibrate_run("chacha20", chacha20_calibrate_one, chacha20_nobs,
+		      ARRAY_SIZE(chacha20_nobs), chacha20_impl,
+		      chacha20_impl_nsecs);
+}
+
 static inline bool hchacha20_arch(u32 derived_key[CHACHA20_KEY_WORDS],
 				  const u8 nonce[HCHACHA20_NONCE_SIZE],
 				  const u8 key[HCHACHA20_KEY_SIZE],
@@ -9,6 +9,7 @@
 
 #include <zinc/chacha20.h>
 #include "../selftest/run.h"
+#include "../calibrate.h"
 
 #include <linux/kernel.h>
 #include <linux/module.h>
@@ -27,6 +28,9 @@ static bool *const chacha20_nobs[] __initconst = { };
 static void __init chacha20_fpu_init(void)
 {
 }
+static void __init chacha20_calibrate_init(void)
+{
+}
 static inline bool chacha20_arch(struct chacha20_ctx *ctx, u8 *dst,
 				 const u8 *src, size_t len,
 				 simd_context_t *simd_context)
@@ -176,6 +180,8 @@ static int __init mod_init(void)
 	if (!selftest_run("chacha20", chacha20_selftest, chacha20_nobs,
 			  ARRAY_SIZE(chacha20_nobs)))
 		return -ENOTRECOVERABLE;
+	if (!nosimd)
+		chacha20_calibrate_init();
 	return 0;
 }
 
@@ -120,14 +120,14 @@ bool chacha20poly1305_encrypt_sg_inplace(struct scatterlist *src,
 		if (__predict_true(length >= CHACHA20_BLOCK_SIZE || length == sl)) {
 			size_t l = length;
 
-			if (un__predict_true(length < sl))
+			if (__predict_false(length < sl))
 				l &= ~(CHACHA20_BLOCK_SIZE - 1);
 			chacha20(&chacha20_state, addr, addr, l, simd_context);
 			addr += l;
 			length -= l;
 		}
 
-		if (un__predict_true(length > 0)) {
+		if (__predict_false(length > 0)) {
 			chacha20(&chacha20_state, b.chacha20_stream, pad0,
 				 CHACHA20_BLOCK_SIZE, simd_context);
 			crypto_xor(addr, b.chacha20_stream, length);
@@ -154,7 +154,7 @@ bool chacha20poly1305_encrypt_sg_inplace(struct scatterlist *src,
 
 	sg_miter_stop(&miter);
 
-	if (un__predict_true(sl > -POLY1305_MAC_SIZE)) {
+	if (__predict_false(sl > -POLY1305_MAC_SIZE)) {
 		poly1305_final(&poly1305_state, b.mac, simd_context);
 		scatterwalk_map_and_copy(b.mac, src, src_len, sizeof(b.mac), 1);
 	}
@@ -181,7 +181,7 @@ __chacha20poly1305_decrypt(u8 *dst, const u8 *src, const size_t src_len,
 		__le64 lens[2];
 	} b = { { 0 } };
 
-	if (un__predict_true(src_len < POLY1305_MAC_SIZE))
+	if (__predict_false(src_len < POLY1305_MAC_SIZE))
 		return false;
 
 	chacha20_init(&chacha20_state, key, nonce);
@@ -220,7 +220,8 @@ bool chacha20poly1305_decrypt(u8 *dst, const u8 *src, const size_t src_len,
 			      const u64 nonce,
 			      const u8 key[CHACHA20POLY1305_KEY_SIZE])
 {
-	simd_context_t simd_context, ret;
+	simd_context_t simd_context;
+	bool ret;
 
 	simd_get(&simd_context);
 	ret = __chacha20poly1305_decrypt(dst, src, src_len, ad, ad_len, nonce,
@@ -253,7 +254,7 @@ bool chacha20poly1305_decrypt_sg_inplace(struct scatterlist *src,
 	} b __aligned(16) = { { 0 } };
 	bool ret = false;
 
-	if (un__predict_true(src_len < POLY1305_MAC_SIZE))
+	if (__predict_false(src_len < POLY1305_MAC_SIZE))
 		return ret;
 	src_len -= POLY1305_MAC_SIZE;
 
@@ -273,7 +274,7 @@ bool chacha20poly1305_decrypt_sg_inplace(struct scatterlist *src,
 
 		poly1305_update(&poly1305_state, addr, length, simd_context);
 
-		if (un__predict_true(partial)) {
+		if (__predict_false(partial)) {
 			size_t l = min(length, CHACHA20_BLOCK_SIZE - partial);
 
 			crypto_xor(addr, b.chacha20_stream + partial, l);
@@ -286,14 +287,14 @@ bool chacha20poly1305_decrypt_sg_inplace(struct scatterlist *src,
 		if (__predict_true(length >= CHACHA20_BLOCK_SIZE || length == sl)) {
 			size_t l = length;
 
-			if (un__predict_true(length < sl))
+			if (__predict_false(length < sl))
 				l &= ~(CHACHA20_BLOCK_SIZE - 1);
 			chacha20(&chacha20_state, addr, addr, l, simd_context);
 			addr += l;
 			length -= l;
 		}
 
-		if (un__predict_true(length > 0)) {
+		if (__predict_false(length > 0)) {
 			chacha20(&chacha20_state, b.chacha20_stream, pad0,
 				 CHACHA20_BLOCK_SIZE, simd_context);
 			crypto_xor(addr, b.chacha20_stream, length);
@@ -320,7 +321,7 @@ bool chacha20poly1305_decrypt_sg_inplace(struct scatterlist *src,
 
 	sg_miter_stop(&miter);
 
-	if (un__predict_true(sl > -POLY1305_MAC_SIZE)) {
+	if (__predict_false(sl > -POLY1305_MAC_SIZE)) {
 		poly1305_final(&poly1305_state, b.computed_mac, simd_context);
 		scatterwalk_map_and_copy(b.read_mac, src, src_len,
 					 sizeof(b.read_mac), 0);
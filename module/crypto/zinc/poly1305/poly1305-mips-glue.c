@@ -13,6 +13,10 @@ static void __init poly1305_fpu_init(void)
 {
 }
 
+static void __init poly1305_calibrate_init(void)
+{
+}
+
 static inline bool poly1305_init_arch(void *ctx,
 				      const u8 key[POLY1305_KEY_SIZE])
 {
@@ -28,6 +28,27 @@ static bool poly1305_use_avx512 __ro_after_init;
 static bool *const poly1305_nobs[] __initconst = {
 	&poly1305_use_avx, &poly1305_use_avx2, &poly1305_use_avx512 };
 
+/* Bits follow the order of poly1305_nobs. */
+enum poly1305_impl_bits {
+	POLY1305_IMPL_AVX = BIT(0),
+	POLY1305_IMPL_AVX2 = BIT(1),
+	POLY1305_IMPL_AVX512 = BIT(2)
+};
+
+static bool poly1305_calibrate __ro_after_init;
+static unsigned long poly1305_impl[CALIBRATE_CLASSES] = {
+	[0 ... CALIBRATE_CLASSES - 1] = ~0UL };
+static unsigned long poly1305_impl_nsecs[CALIBRATE_CLASSES];
+static int poly1305_impl_override = CALIBRATE_AUTO;
+module_param(poly1305_calibrate, bool, 0444);
+MODULE_PARM_DESC(poly1305_calibrate, "Time each Poly1305 implementation at load");
+module_param_array(poly1305_impl, ulong, NULL, 0444);
+MODULE_PARM_DESC(poly1305_impl, "Implementation mask chosen per size class");
+module_param_array(poly1305_impl_nsecs, ulong, NULL, 0444);
+MODULE_PARM_DESC(poly1305_impl_nsecs, "Calibrated cost per size class in ns");
+module_param(poly1305_impl_override, int, 0644);
+MODULE_PARM_DESC(poly1305_impl_override, "Force an implementation mask, -1 for auto");
+
 static void __init poly1305_fpu_init(void)
 {
 	poly1305_use_avx =
@@ -108,12 +129,15 @@ static inline bool poly1305_blocks_arch(void *ctx, const u8 *inp,
 					simd_context_t *simd_context)
 {
 	struct poly1305_arch_internal *state = ctx;
+	const unsigned long impl = calibrate_mask(poly1305_impl,
+			READ_ONCE(poly1305_impl_override), len);
 
 	/* SIMD disables preemption, so relax after processing each page. */
 	BUILD_BUG_ON(PAGE_SIZE < POLY1305_BLOCK_SIZE ||
 		     PAGE_SIZE % POLY1305_BLOCK_SIZE);
 
 	if (!IS_ENABLED(CONFIG_AS_AVX) || !poly1305_use_avx ||
+	    !(impl & POLY1305_IMPL_AVX) ||
 	    (len < (POLY1305_BLOCK_SIZE * 18) && !state->is_base2_26) ||
 	    !simd_use(simd_context)) {
 		convert_to_base2_64(ctx);
@@ -124,9 +148,11 @@ static inline bool poly1305_blocks_arch(void *ctx, const u8 *inp,
 	for (;;) {
 		const size_t bytes = min_t(size_t, len, PAGE_SIZE);
 
-		if (IS_ENABLED(CONFIG_AS_AVX512) && poly1305_use_avx512)
+		if (IS_ENABLED(CONFIG_AS_AVX512) && poly1305_use_avx512 &&
+		    (impl & POLY1305_IMPL_AVX512))
 			poly1305_blocks_avx512(ctx, inp, bytes, padbit);
-		else if (IS_ENABLED(CONFIG_AS_AVX2) && poly1305_use_avx2)
+		else if (IS_ENABLED(CONFIG_AS_AVX2) && poly1305_use_avx2 &&
+			 (impl & POLY1305_IMPL_AVX2))
 			poly1305_blocks_avx2(ctx, inp, bytes, padbit);
 		else
 			poly1305_blocks_avx(ctx, inp, bytes, padbit);
@@ -154,3 +180,28 @@ static inline bool poly1305_emit_arch(void *ctx, u8 mac[POLY1305_MAC_SIZE],
 		poly1305_emit_avx(ctx, mac, nonce);
 	return true;
 }
+
+static u8 poly1305_calibrate_buf[CALIBRATE_MAX_LEN] __initdata;
+
+static void __init poly1305_calibrate_one(size_t len)
+{
+	static const u8 key[POLY1305_KEY_SIZE] __initconst = { 1 };
+	struct poly1305_ctx ctx;
+	simd_context_t simd_context;
+	u8 mac[POLY1305_MAC_SIZE];
+
+	poly1305_init(&ctx, key);
+	simd_get(&simd_context);
+	poly1305_update(&ctx, poly1305_calibrate_buf, len, &simd_context);
+	poly1305_final(&ctx, mac, &simd_context);
+	simd_put(&simd_context);
+}
+
+static void __init poly1305_calibrate_init(void)
+{
+	if (!poly1305_calibrate)
+		return;
+	calibrate_run("poly1305", poly1305_calibrate_one, poly1305_nobs,
+		      ARRAY_SIZE(poly1305_nobs), poly1305_impl,
+		      poly1305_impl_nsecs);
+}
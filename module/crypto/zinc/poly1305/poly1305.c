@@ -9,6 +9,7 @@
 
 #include <zinc/poly1305.h>
 #include "../selftest/run.h"
+#include "../calibrate.h"
 
 #include <asm/unaligned.h>
 #include <linux/kernel.h>
@@ -44,6 +45,9 @@ static bool *const poly1305_nobs[] __initconst = { };
 static void __init poly1305_fpu_init(void)
 {
 }
+static void __init poly1305_calibrate_init(void)
+{
+}
 #endif
 
 #if defined(CONFIG_ARCH_SUPPORTS_INT128) && defined(__SIZEOF_INT128__)
@@ -151,6 +155,8 @@ static int __init mod_init(void)
 	if (!selftest_run("poly1305", poly1305_selftest, poly1305_nobs,
 			  ARRAY_SIZE(poly1305_nobs)))
 		return -ENOTRECOVERABLE;
+	if (!nosimd)
+		poly1305_calibrate_init();
 	return 0;
 }
 
@@ -0,0 +1,1349 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/* Generated by curve25519-comb-table.py, do not edit. */
+
+static const ge_precomp curve25519_comb_table[32][8] = {
+	{
+		{
+			{ { 0x18c3b85, 0x124f1bd, 0x1c325f7, 0x037dc60, 0x33e4cb7, 0x03d42c2, 0x1a44c32, 0x14ca4e1, 0x3a33d4b, 0x01f3e74 } },
+			{ { 0x340913e, 0x00e4175, 0x3d673a2, 0x02e8a05, 0x3f4e67c, 0x08f8a09, 0x0c21a34, 0x04cf4b8, 0x1298f81, 0x113f4be } },
+			{ { 0x37aaa68, 0x0448161, 0x093d579, 0x11e6556, 0x09b67a0, 0x143598c, 0x1bee5ee, 0x0b50b43, 0x289f0c6, 0x1bc45ed } },
+		},
+		{
+			{ { 0x33c71d7, 0x139ff24, 0x2b6b244, 0x0b3d07f, 0x27d1a76, 0x1d60702, 0x34d32f0, 0x1c5cb54, 0x3fa87d2, 0x1643018 } },
+			{ { 0x2b4d5a8, 0x0695810, 0x19ed153, 0x0627305, 0x23cae04, 0x16e37aa, 0x311b5d8, 0x0aabc13, 0x2669c92, 0x1aed656 } },
+			{ { 0x19b7a5f, 0x0aa2ce9, 0x1ef087f, 0x0eaecd6, 0x0db05af, 0x13d6a31, 0x3d04205, 0x16e6a01, 0x313ea50, 0x1c06bd6 } },
+		},
+		{
+			{ { 0x0ee9730, 0x16c2a13, 0x17155e4, 0x1874432, 0x0096a10, 0x1016732, 0x1a8014f, 0x11e9823, 0x1b9a80f, 0x1e85938 } },
+			{ { 0x0fcd265, 0x047fa29, 0x34faacc, 0x1ef2e0d, 0x0ef4d4f, 0x14bd6bd, 0x0f98d10, 0x14c5026, 0x07555bd, 0x0aae456 } },
+			{ { 0x1d0d889, 0x1a4cfc3, 0x34c4295, 0x110e1ae, 0x162508c, 0x0f2db4c, 0x072a2c6, 0x098da2e, 0x2f12b9b, 0x168a09a } },
+		},
+		{
+			{ { 0x2fc099f, 0x0d46e63, 0x0a7050e, 0x1a3efe9, 0x19d971b, 0x10a9265, 0x2469efd, 0x0e4f946, 0x0321e58, 0x1a03a44 } },
+			{ { 0x16818bf, 0x1814281, 0x35532bf, 0x18ab307, 0x0c9fa25, 0x0a05073, 0x071e683, 0x093587d, 0x0c7445a, 0x09e4cfd } },
+			{ { 0x076ff09, 0x0fefa71, 0x02e4b42, 0x02bdae6, 0x1ba78e5, 0x02b4494, 0x1ee7c88, 0x1c56bbb, 0x3f63553, 0x1fe7432 } },
+		},
+		{
+			{ { 0x0a5bb33, 0x0af1102, 0x1a05442, 0x01e3af7, 0x2354123, 0x0bfec44, 0x1f5862d, 0x0dd7ba3, 0x3146e20, 0x0a51733 } },
+			{ { 0x047d6ba, 0x060b0e9, 0x136eff2, 0x08a5939, 0x3540053, 0x064a087, 0x2788e5c, 0x0be7c67, 0x33eb1b5, 0x05529f9 } },
+			{ { 0x12a8285, 0x0f6fc60, 0x23f9797, 0x03e85ee, 0x09c3820, 0x1bda72d, 0x1b3858d, 0x0d35683, 0x296b3bb, 0x10eaaf9 } },
+		},
+		{
+			{ { 0x3157131, 0x13bbadd, 0x1f10741, 0x0480645, 0x26c9c56, 0x059a736, 0x2db346d, 0x117b00c, 0x36a2cc3, 0x14795ee } },
+			{ { 0x37d8ca4, 0x001ad9e, 0x0e72933, 0x0213e91, 0x15d6f8a, 0x04553b9, 0x02e7390, 0x1109761, 0x01ae417, 0x0e2d931 } },
+			{ { 0x2ea4b71, 0x10c99c0, 0x36030b5, 0x01a0d0d, 0x2f9c380, 0x03bc144, 0x2512584, 0x03c6a7c, 0x1a9f0d6, 0x042e3a4 } },
+		},
+		{
+			{ { 0x04ea3bf, 0x0973425, 0x01a4d63, 0x1d59cee, 0x1d1c0d4, 0x0542e49, 0x1294114, 0x04fce36, 0x29283c9, 0x1186fa9 } },
+			{ { 0x23221b1, 0x1cb26aa, 0x074f74d, 0x099ddd1, 0x1b28085, 0x0192c3a, 0x13b27c9, 0x0fc13bd, 0x1d2e531, 0x075bb75 } },
+			{ { 0x1b8b3a2, 0x0db7200, 0x0935e30, 0x03829f5, 0x2cc0d7d, 0x077adf3, 0x220dd2c, 0x014ea53, 0x1c6a0f9, 0x1ea7eec } },
+		},
+		{
+			{ { 0x0dd3e8f, 0x1d65981, 0x2058b36, 0x1bf1443, 0x1b2cc0d, 0x0d9c323, 0x1ce332f, 0x0a5f626, 0x2061bce, 0x024579d } },
+			{ { 0x39234d9, 0x1d77b7c, 0x31f3c54, 0x0070daa, 0x258f5da, 0x03c23fb, 0x3a0d637, 0x0386584, 0x21320e0, 0x0ea4092 } },
+			{ { 0x1a2911a, 0x07d7672, 0x0fafcf8, 0x1c45e65, 0x2e28dc5, 0x0b62a32, 0x2090c87, 0x1d2ac6c, 0x1c2ecc4, 0x09a41f1 } },
+		},
+	},
+	{
+		{
+			{ { 0x32f9c1d, 0x1374398, 0x222a5d9, 0x0b3b449, 0x14742da, 0x0637a58, 0x3dbb5d4, 0x1e72a5b, 0x09a00ee, 0x1b74df5 } },
+			{ { 0x1aa515e, 0x0d8d512, 0x0475dab, 0x0f85e34, 0x2a19712, 0x142d1c4, 0x20ff4ad, 0x0b730a1, 0x2f03d31, 0x0c35db5 } },
+			{ { 0x106e4c7, 0x11105c8, 0x3ed2d88, 0x004946b, 0x3ed4f5a, 0x14d3f26, 0x1cf5234, 0x176168e, 0x112e864, 0x0431a5c } },
+		},
+		{
+			{ { 0x358c805, 0x18aa820, 0x048e194, 0x11bd102, 0x1a8f52b, 0x111eddc, 0x269d31d, 0x0ddee8c, 0x2f55080, 0x00efe6e } },
+			{ { 0x1be5fde, 0x0f109df, 0x3d44c92, 0x168cd6b, 0x099753e, 0x0304590, 0x06fe423, 0x1c121c0, 0x2bed66f, 0x0979872 } },
+			{ { 0x0586604, 0x0f84a33, 0x28fc7e2, 0x165a2cb, 0x1bd61cf, 0x01268f5, 0x31ef6e6, 0x0459416, 0x234586e, 0x159b5e1 } },
+		},
+		{
+			{ { 0x25a2fd0, 0x150a171, 0x0f87420, 0x15798b3, 0x1b19044, 0x11aee58, 0x1712039, 0x0454d01, 0x334793b, 0x053ee97 } },
+			{ { 0x0c10834, 0x1e927e7, 0x08a22c6, 0x0ad44de, 0x2f2395b, 0x17fd2db, 0x2f607bf, 0x0bb2396, 0x0a5ecc3, 0x0ce5d6f } },
+			{ { 0x185f7d4, 0x1d1859a, 0x00ae79a, 0x0264e40, 0x164f97a, 0x161131e, 0x1f95b3d, 0x04d85f8, 0x2a83fc5, 0x0520a73 } },
+		},
+		{
+			{ { 0x271ecb8, 0x1c2cbd3, 0x2fc643c, 0x1ca0523, 0x3995b76, 0x01d4f80, 0x2ab6767, 0x16fd7ec, 0x04535d7, 0x017f0ef } },
+			{ { 0x3dd95c2, 0x0dee125, 0x2b4ffe8, 0x1855275, 0x1b1d138, 0x085e88b, 0x22eb09e, 0x02e73c1, 0x1e5f758, 0x0bf671c } },
+			{ { 0x2afdedd, 0x02ceb94, 0x219e497, 0x06769d9, 0x0d2558e, 0x1be8195, 0x25e41d4, 0x1e08674, 0x075c651, 0x0dcdd9d } },
+		},
+		{
+			{ { 0x0246590, 0x02572c5, 0x2a6ac68, 0x000b60a, 0x3bc4851, 0x110bc60, 0x00a0644, 0x19193c7, 0x1730907, 0x1afd641 } },
+			{ { 0x0d1add9, 0x0a67f50, 0x204e5f7, 0x17cb7a6, 0x2cc1c59, 0x1f03bae, 0x1f8290a, 0x133286c, 0x2c3b18f, 0x07efa95 } },
+			{ { 0x1415b8a, 0x1de3c78, 0x0efc1f4, 0x1bdd61d, 0x019027f, 0x0a29a50, 0x16bdc4d, 0x14acdea, 0x367a635, 0x0094873 } },
+		},
+		{
+			{ { 0x32f5ee4, 0x119c81d, 0x359d622, 0x18cb03c, 0x3a3e252, 0x0ac824a, 0x0112680, 0x198895f, 0x19f7cd6, 0x0005d4f } },
+			{ { 0x29d5294, 0x1fb82c2, 0x34cca27, 0x0e07efa, 0x23e639d, 0x1e107ce, 0x0c3445f, 0x19dba8c, 0x3e71382, 0x0fe8029 } },
+			{ { 0x23ddb34, 0x048cb65, 0x30b078d, 0x0d5a4b9, 0x0777a1f, 0x091f285, 0x3e8fcd0, 0x1b6d55a, 0x2fa048e, 0x04ad7f8 } },
+		},
+		{
+			{ { 0x16f1e92, 0x0df09ab, 0x1227be5, 0x11a825c, 0x12d9b4c, 0x11c8bc3, 0x04ee03a, 0x0f71188, 0x020796c, 0x1bdfa4f } },
+			{ { 0x2fce34d, 0x03ef125, 0x37dae3e, 0x15d6f9a, 0x1cee609, 0x128c561, 0x23930ff, 0x00dfa40, 0x396fb12, 0x1d26ddb } },
+			{ { 0x2a6ae05, 0x0bd812b, 0x39323eb, 0x18df724, 0x3048d47, 0x0ff6b66, 0x0045af7, 0x02a2c35, 0x0f01e02, 0x03f3b04 } },
+		},
+		{
+			{ { 0x0244e45, 0x0b4a771, 0x3c147be, 0x1a49ec6, 0x0ac0839, 0x00c214d, 0x0033f41, 0x1214d99, 0x166feab, 0x104dde4 } },
+			{ { 0x1fe1e44, 0x1562992, 0x2efcc89, 0x1118d6b, 0x087f2ba, 0x07fd0d2, 0x20e2d44, 0x03e6048, 0x3183c51, 0x12406a9 } },
+			{ { 0x01af8f0, 0x06dd523, 0x3368116, 0x1e12314, 0x3383de9, 0x006d939, 0x0587c8f, 0x0427eec, 0x3b726d1, 0x106ee21 } },
+		},
+	},
+	{
+		{
+			{ { 0x06691ae, 0x0d3165f, 0x2990fc4, 0x1e8542d, 0x1922274, 0x14afae7, 0x164861a, 0x1c3bb5c, 0x070c6a9, 0x02a1c78 } },
+			{ { 0x04346be, 0x01f511d, 0x164a81d, 0x0a0ada9, 0x075236b, 0x13b603e, 0x1450c50, 0x1beef87, 0x012fcdb, 0x13adca3 } },
+			{ { 0x3bc8989, 0x06d6652, 0x04c0660, 0x1d2deea, 0x1cdaeb8, 0x1d59e3c, 0x0d6f10c, 0x08c81ac, 0x0f2685d, 0x0fb9cc0 } },
+		},
+		{
+			{ { 0x01e7518, 0x09e51e1, 0x0dae87f, 0x0cb1ce2, 0x3971be9, 0x1052b74, 0x32f0ef1, 0x0061420, 0x22cfb89, 0x1f51f1a } },
+			{ { 0x27dd6b7, 0x0957927, 0x3d59eba, 0x0e30858, 0x2005845, 0x0e187ca, 0x0cbaec9, 0x0b84793, 0x2297912, 0x04e055d } },
+			{ { 0x2f0d6e0, 0x0b40523, 0x1e787fb, 0x0d48aa3, 0x274f9d2, 0x0bb8157, 0x2310813, 0x1900e3d, 0x0d34c9e, 0x05233d6 } },
+		},
+		{
+			{ { 0x2e4756d, 0x1cbdf66, 0x10ffc4a, 0x1dc479a, 0x15b0d16, 0x160a88d, 0x085b6b4, 0x03733fa, 0x2d4eaea, 0x09e3fae } },
+			{ { 0x134f027, 0x124bd9e, 0x15528d4, 0x1f7b420, 0x11a6612, 0x1611854, 0x0de1544, 0x17a8b94, 0x1ebd5db, 0x0ffcbe8 } },
+			{ { 0x0933966, 0x09a07e3, 0x1931635, 0x0e10148, 0x2308652, 0x19d3c52, 0x0a94890, 0x0ef6722, 0x02fe9c6, 0x1041374 } },
+		},
+		{
+			{ { 0x3096ab8, 0x05381b6, 0x1e6b024, 0x0486722, 0x086a2db, 0x09e2af5, 0x2609520, 0x0902ca4, 0x248efca, 0x00596d6 } },
+			{ { 0x124422a, 0x0afd784, 0x356ae56, 0x19cc519, 0x287e830, 0x052b666, 0x1b080fd, 0x07ab299, 0x00afaf5, 0x0b218ec } },
+			{ { 0x0846a76, 0x0291d28, 0x3981e32, 0x026697b, 0x04bbfe6, 0x0aa2b8f, 0x314832c, 0x1170d2b, 0x19bffec, 0x1646d9f } },
+		},
+		{
+			{ { 0x318b55d, 0x06cdc67, 0x083d337, 0x1d50c63, 0x3919797, 0x09f05ed, 0x0089b61, 0x0516c21, 0x0670301, 0x1226d3e } },
+			{ { 0x0b49bfa, 0x1c34720, 0x1914625, 0x0f55f9f, 0x165e545, 0x0f01c88, 0x019e04f, 0x1796e4e, 0x07ca8f7, 0x0f780bb } },
+			{ { 0x2eb92ef, 0x0840b4e, 0x10c3a46, 0x1a308b5, 0x385894e, 0x10baa24, 0x355f38c, 0x1d7e7af, 0x3a496cb, 0x127d7ee } },
+		},
+		{
+			{ { 0x29c572e, 0x158a307, 0x0e822ab, 0x1662c42, 0x229361a, 0x15763eb, 0x1a97b28, 0x02b7234, 0x0288675, 0x01a869b } },
+			{ { 0x25bcfd4, 0x1268422, 0x27d6612, 0x185e323, 0x3710375, 0x07c0d1c, 0x14a6098, 0x1ce9258, 0x2dcbfa6, 0x15812a1 } },
+			{ { 0x01764b6, 0x034751f, 0x16a2e51, 0x007020c, 0x1c95045, 0x0acf6d1, 0x18d300c, 0x058d3e0, 0x09fe274, 0x082627a } },
+		},
+		{
+			{ { 0x1eaec2e, 0x109e2e1, 0x17be2ce, 0x03bd659, 0x1588770, 0x1cbf45a, 0x1260b30, 0x0ba6c81, 0x10f7059, 0x1cc2e65 } },
+			{ { 0x22dcc7f, 0x1ddff4e, 0x3124932, 0x1652a7e, 0x0ca15f0, 0x007e3a0, 0x0ec3269, 0x1c5344f, 0x1d0ca67, 0x0100fb4 } },
+			{ { 0x34ec552, 0x0cb4d61, 0x1f1b929, 0x07cc123, 0x3179b23, 0x0c035ce, 0x1a37d0b, 0x1b99ef9, 0x0308303, 0x16f5d15 } },
+		},
+		{
+			{ { 0x1e7792a, 0x124c845, 0x3b930b8, 0x115ee6e, 0x3193226, 0x1a3d762, 0x31ed456, 0x10593a3, 0x123067f, 0x16edf6c } },
+			{ { 0x0b24cc2, 0x0b4654a, 0x0302ff3, 0x12b19ae, 0x1fdad51, 0x1c07236, 0x05b3727, 0x1b06cd7, 0x007380a, 0x04ce9e0 } },
+			{ { 0x2ca62be, 0x07d19f1, 0x25dc12c, 0x0b108ca, 0x013b087, 0x1d54770, 0x1b03bcd, 0x01a4304, 0x2d58f0e, 0x1d03729 } },
+		},
+	},
+	{
+		{
+			{ { 0x078433c, 0x0a315c1, 0x073a463, 0x076140a, 0x2ded49c, 0x1d9079f, 0x14cf571, 0x07b3b75, 0x256c2b0, 0x0b00fd4 } },
+			{ { 0x2cfce4e, 0x03b81d4, 0x116fbe9, 0x1983760, 0x30fffeb, 0x15459c4, 0x085955c, 0x071a0ae, 0x3a963ea, 0x0587497 } },
+			{ { 0x353a47d, 0x1c61d5e, 0x30f2f21, 0x1867862, 0x0c1ec04, 0x17ef7f9, 0x01ebb92, 0x175e632, 0x3dbd96b, 0x1a651a2 } },
+		},
+		{
+			{ { 0x2a91948, 0x14f799a, 0x2599b1b, 0x0117e06, 0x1214193, 0x0fdea2f, 0x012331a, 0x1c75369, 0x0e6c4a2, 0x0a4f871 } },
+			{ { 0x0dafecf, 0x1cbd1bd, 0x2def7a3, 0x0a523fe, 0x1f3bc04, 0x047b37f, 0x3feed25, 0x0f0ba63, 0x2473905, 0x1494866 } },
+			{ { 0x25112e1, 0x184d2e4, 0x3b406ed, 0x1aee50a, 0x1c0dde2, 0x01c3111, 0x2c4d7a3, 0x1047608, 0x047f032, 0x16d8171 } },
+		},
+		{
+			{ { 0x0e7f04c, 0x07fb1bc, 0x12c477d, 0x0f3af1a, 0x219a95e, 0x01de61a, 0x1778b0f, 0x1baaaa8, 0x34cc5ab, 0x0bc4bfb } },
+			{ { 0x0c47c89, 0x1601648, 0x1f9972c, 0x06491dc, 0x39fc040, 0x0e2ef77, 0x092b281, 0x07dc000, 0x0ea8aeb, 0x0929db7 } },
+			{ { 0x3c0c740, 0x148acb7, 0x080e148, 0x1fa064d, 0x04341b9, 0x0cff668, 0x38a20bc, 0x0f218d9, 0x2518a43, 0x17981ec } },
+		},
+		{
+			{ { 0x196cf14, 0x110c729, 0x0801405, 0x005769f, 0x38f10b5, 0x00f26db, 0x2934017, 0x00d1a48, 0x139e457, 0x0807ccc } },
+			{ { 0x0df1818, 0x0c763db, 0x3144b16, 0x07e1b12, 0x0d73e9d, 0x0e61d6e, 0x1ffa7b3, 0x0befc36, 0x2b6ccdd, 0x1419eb2 } },
+			{ { 0x0039d51, 0x09fdac2, 0x000dfaa, 0x1200be0, 0x062c525, 0x025a4a8, 0x1075817, 0x06ebaa4, 0x0862460, 0x0e5f2ea } },
+		},
+		{
+			{ { 0x01379e7, 0x170fef2, 0x15e2f02, 0x106ef09, 0x2998650, 0x1a8fdd5, 0x0e07c42, 0x04a5ff5, 0x22c1e1c, 0x1dc6d00 } },
+			{ { 0x05959b2, 0x04c24fc, 0x32ec618, 0x06f4d4b, 0x388ea86, 0x01d5e26, 0x3ea48b9, 0x1874445, 0x20766e6, 0x08ce74c } },
+			{ { 0x13a2fa7, 0x1766194, 0x1e11b0f, 0x18fcea6, 0x3d6b26d, 0x0a283b3, 0x1e18d8f, 0x14eda0d, 0x1219971, 0x0cc6862 } },
+		},
+		{
+			{ { 0x17572af, 0x04bcea7, 0x153c4ca, 0x043403a, 0x16f2f8a, 0x180f7c4, 0x2e0e088, 0x0cf709d, 0x1ff649a, 0x06b2586 } },
+			{ { 0x34f80c6, 0x19bd17e, 0x2b9fea2, 0x0f30e3b, 0x270db1f, 0x041d91c, 0x2740dc8, 0x1c43c7a, 0x2b83bdf, 0x0c459f1 } },
+			{ { 0x24b1068, 0x0ce1094, 0x130fe45, 0x1df74e7, 0x141a0d0, 0x06250c8, 0x2b8c225, 0x0223f93, 0x341f08b, 0x18490d8 } },
+		},
+		{
+			{ { 0x22d2638, 0x0d278c6, 0x3a6b16c, 0x004de9f, 0x2777edc, 0x1a06ba4, 0x1f8dc51, 0x088aff1, 0x3178d90, 0x0548aa8 } },
+			{ { 0x34e898d, 0x15076e1, 0x3841b33, 0x18b603e, 0x027fa97, 0x00f9bbc, 0x29633e8, 0x1e80f27, 0x309e5ef, 0x11baf88 } },
+			{ { 0x1614938, 0x00bd4da, 0x1a20587, 0x0d5b96b, 0x36bf902, 0x046f227, 0x019c8db, 0x00d9d19, 0x3505243, 0x117f9c3 } },
+		},
+		{
+			{ { 0x0951491, 0x0924832, 0x1944c5e, 0x041fb18, 0x017c01f, 0x1c9d4b8, 0x1a2e97a, 0x048adf7, 0x2db57a2, 0x059867d } },
+			{ { 0x20c0b8c, 0x01d69a5, 0x1e41b49, 0x1b77871, 0x16da341, 0x10b8fd4, 0x1a8e79e, 0x05a80ff, 0x23a0e39, 0x10a3458 } },
+			{ { 0x1a308fd, 0x1d29100, 0x1558109, 0x01bb52e, 0x2a08867, 0x1d1bc7d, 0x06f2321, 0x118dbd7, 0x2d60bd3, 0x0760564 } },
+		},
+	},
+	{
+		{
+			{ { 0x385c5e8, 0x16da7de, 0x35650ec, 0x05e8b45, 0x1bfc19e, 0x1330f9b, 0x073be0e, 0x1cf874e, 0x11b0af8, 0x0e97db5 } },
+			{ { 0x20dac5f, 0x1a1d5a9, 0x38aec26, 0x1575d5e, 0x05f80bd, 0x0ce0f7d, 0x09f96a6, 0x19e0fe3, 0x3789ecd, 0x0808d29 } },
+			{ { 0x178b252, 0x0836d9c, 0x22c0eda, 0x1cea8f6, 0x01c70d3, 0x1e41170, 0x1251059, 0x06cdec5, 0x353cffe, 0x1f35a08 } },
+		},
+		{
+			{ { 0x0acf4f3, 0x173581a, 0x07a74cc, 0x0c1e6bf, 0x10b64b4, 0x16025d9, 0x09c4e99, 0x11feaeb, 0x3b2b2cd, 0x0fbc094 } },
+			{ { 0x087fab6, 0x06916f6, 0x36dc17c, 0x195d201, 0x0aa11a8, 0x16e6000, 0x1080974, 0x1287b32, 0x063bdc0, 0x0a0e322 } },
+			{ { 0x2465030, 0x0ec33d2, 0x2f57a2d, 0x008ae2b, 0x3e925ad, 0x0ab419d, 0x3d7457a, 0x1025059, 0x2606a82, 0x08772e2 } },
+		},
+		{
+			{ { 0x27731ba, 0x1403eaf, 0x3113351, 0x1f314f0, 0x2080d81, 0x1f3d97f, 0x2011ba1, 0x0f17659, 0x3f6c6f6, 0x1761036 } },
+			{ { 0x09d9fc8, 0x00111a3, 0x0796b8c, 0x176a155, 0x0950025, 0x0ee2f9c, 0x1a6a609, 0x1b5624b, 0x0194a31, 0x02f0f42 } },
+			{ { 0x09fe18b, 0x18e034c, 0x0b8ee0d, 0x135cf0b, 0x1bac0b6, 0x1ae20ab, 0x1dd4cbe, 0x0dbaaf7, 0x232ac19, 0x0e909d8 } },
+		},
+		{
+			{ { 0x3447ecb, 0x0305cb6, 0x1b7a77f, 0x0fe3141, 0x17f3f10, 0x1aa15fe, 0x27fe03a, 0x13f3015, 0x2824e1a, 0x01dc327 } },
+			{ { 0x27084fa, 0x090cb22, 0x0a8a968, 0x11efdcf, 0x2262867, 0x058e45d, 0x38010ce, 0x17a37d3, 0x0ea16de, 0x07fc5df } },
+			{ { 0x1b5b5fd, 0x0766691, 0x32499ec, 0x148d9d3, 0x2182613, 0x03e3e89, 0x0048c98, 0x163dce6, 0x3d41500, 0x0e7c993 } },
+		},
+		{
+			{ { 0x2097be1, 0x0d2aaff, 0x3253a33, 0x10eff00, 0x291b7f3, 0x0a6f1ff, 0x0844a16, 0x029d879, 0x272c35f, 0x1971884 } },
+			{ { 0x3e7e29c, 0x14d05f6, 0x27394f5, 0x1515ce0, 0x2f650dd, 0x1597ba9, 0x08dc749, 0x108141d, 0x3468889, 0x05c4b5c } },
+			{ { 0x23193dd, 0x0e27e33, 0x0177ce5, 0x0b5092e, 0x13440cd, 0x01cfe83, 0x0d49e97, 0x04e4083, 0x0ab19ce, 0x08be600 } },
+		},
+		{
+			{ { 0x26efdac, 0x0a7f766, 0x1282840, 0x1f1a52a, 0x2e44b3a, 0x1bdf37b, 0x3b25cc3, 0x1568c81, 0x138598c, 0x105c693 } },
+			{ { 0x29ef8cb, 0x08da28f, 0x0e2ac0b, 0x1152a82, 0x38fa700, 0x124248f, 0x2a4582f, 0x0dcaaa7, 0x0d64762, 0x04fd05b } },
+			{ { 0x1c94c8c, 0x1d62aa6, 0x300ff44, 0x17d8005, 0x08c01bd, 0x1da5392, 0x148eed6, 0x0357f7a, 0x3a574bd, 0x1420853 } },
+		},
+		{
+			{ { 0x3d003d6, 0x0856ed4, 0x12ca8c3, 0x045e79e, 0x2c840a2, 0x0683a5a, 0x2bb3ab6, 0x088e4f8, 0x24c86cb, 0x0e9dd62 } },
+			{ { 0x2d6fe4b, 0x09a454f, 0x2f89840, 0x1ca88eb, 0x299699c, 0x014af94, 0x3132316, 0x0e9797b, 0x2c6faba, 0x08be583 } },
+			{ { 0x3ae5076, 0x0447da4, 0x294ca90, 0x0f8efea, 0x076b887, 0x1115e65, 0x2464879, 0x0928244, 0x1f8de7f, 0x1767f45 } },
+		},
+		{
+			{ { 0x2d7521e, 0x1134abb, 0x2c2a7e4, 0x1421974, 0x238ea40, 0x09c16d4, 0x25d3b97, 0x11b1c2c, 0x3a47eb9, 0x0ef061f } },
+			{ { 0x163727f, 0x10234db, 0x2a66062, 0x17ebe3d, 0x1a8de6b, 0x0aee24b, 0x0c7e2e6, 0x1da753c, 0x114f8fb, 0x0ccbcd6 } },
+			{ { 0x286c20c, 0x1c0457a, 0x224ada8, 0x05b6236, 0x2662adf, 0x0660188, 0x0195a9d, 0x1407aef, 0x0e906fb, 0x1143607 } },
+		},
+	},
+	{
+		{
+			{ { 0x0ae743f, 0x1362587, 0x07dba0e, 0x1af70e3, 0x3e1b463, 0x1f4ed29, 0x2e2adf3, 0x02112f7, 0x39663ab, 0x132eb49 } },
+			{ { 0x2205275, 0x0eda869, 0x1d06dcf, 0x0ba09e4, 0x2a93c87, 0x08f5cb2, 0x368aaf4, 0x17c2dea, 0x0ba6345, 0x0b78975 } },
+			{ { 0x0d71fcd, 0x0640928, 0x15f101a, 0x057d944, 0x3149708, 0x13a6419, 0x1cba5af, 0x0467634, 0x2fe2007, 0x1f5fef3 } },
+		},
+		{
+			{ { 0x3c29094, 0x117717c, 0x0b579af, 0x0d15488, 0x31e068a, 0x01c3058, 0x30e9b21, 0x09af018, 0x16dcd8d, 0x13e7346 } },
+			{ { 0x26b2801, 0x1c79a89, 0x3e2df5d, 0x026ab9c, 0x219b1a3, 0x103762c, 0x117de0d, 0x151bed1, 0x1e87b75, 0x165d50d } },
+			{ { 0x27b3768, 0x0a5f61a, 0x34c6332, 0x120d68b, 0x3434160, 0x01c0c17, 0x14e56ae, 0x060f740, 0x04387a0, 0x1f33742 } },
+		},
+		{
+			{ { 0x360cc93, 0x1210619, 0x1533361, 0x1d0d599, 0x336b801, 0x00bda18, 0x2f64331, 0x1489511, 0x048190c, 0x0d64f2a } },
+			{ { 0x1260417, 0x1908b1b, 0x017bb94, 0x084a412, 0x2b854f5, 0x168c677, 0x060da7d, 0x1ea7538, 0x2d61d0c, 0x10a2f43 } },
+			{ { 0x2849aa7, 0x0c62697, 0x359b242, 0x1ab2ec7, 0x353630c, 0x1fdbbd1, 0x12a2da9, 0x07cd18a, 0x08da2d6, 0x09ce60c } },
+		},
+		{
+			{ { 0x2702453, 0x0439302, 0x37bd734, 0x136abe8, 0x03e8961, 0x127daf7, 0x0ecdae6, 0x07fbff7, 0x05492c3, 0x15cb0a5 } },
+			{ { 0x35ed413, 0x0e34a10, 0x1992858, 0x10193c6, 0x2f543cd, 0x1da03ef, 0x3d58d3c, 0x06ab760, 0x2ebe8c3, 0x09a565e } },
+			{ { 0x2cd30be, 0x1f1d175, 0x1df78ef, 0x09f1dd5, 0x3937fa3, 0x05dda0c, 0x2441855, 0x1501445, 0x18c05bc, 0x1fe6152 } },
+		},
+		{
+			{ { 0x3bf6363, 0x1855483, 0x374da6a, 0x02e7a6f, 0x0201169, 0x13fa0c2, 0x127de43, 0x05cfdd8, 0x3cd69b1, 0x0c3c994 } },
+			{ { 0x30be117, 0x073a227, 0x0510709, 0x0dbdaa5, 0x20016b4, 0x1fc921c, 0x1e1cf91, 0x06087b4, 0x070a31f, 0x1db0bb1 } },
+			{ { 0x2c10c85, 0x0324e2a, 0x1797141, 0x106d93b, 0x1185e6d, 0x06fac70, 0x0600f07, 0x07b5524, 0x3159647, 0x0bc49cf } },
+		},
+		{
+			{ { 0x1a70bc0, 0x022f5d5, 0x05ce609, 0x1278ea2, 0x01b5ad6, 0x0596162, 0x0d34f5e, 0x0f09d5a, 0x17edc5f, 0x0e2b066 } },
+			{ { 0x2e01e11, 0x07f1f22, 0x173e8e7, 0x0825355, 0x3f549d2, 0x1728f2e, 0x0c54143, 0x13e483b, 0x2ad85b6, 0x176795c } },
+			{ { 0x351b13b, 0x1ad45e9, 0x0b180cc, 0x033f4dc, 0x1d1f41a, 0x14dde49, 0x26008a2, 0x0d39595, 0x1cbfe9e, 0x08b7f36 } },
+		},
+		{
+			{ { 0x03be0a1, 0x1166d04, 0x32d2add, 0x16692cf, 0x0bb8eeb, 0x1f5cd32, 0x2594a09, 0x08e4f2f, 0x3824cde, 0x03fa61d } },
+			{ { 0x30d0cd9, 0x0f4b830, 0x06671bb, 0x0fd65da, 0x2b63999, 0x02a961f, 0x192c619, 0x038f1ed, 0x005448c, 0x1aca45b } },
+			{ { 0x2ba913b, 0x0cd3442, 0x181cfdb, 0x011736d, 0x13a8f36, 0x178f815, 0x01effb2, 0x142ecc1, 0x307ff00, 0x130c0fc } },
+		},
+		{
+			{ { 0x1d94500, 0x100d603, 0x192653f, 0x1237ddf, 0x3b349ea, 0x0e2a7f8, 0x10aafe1, 0x03aa261, 0x1ab706a, 0x105ac54 } },
+			{ { 0x3b28c85, 0x08ef585, 0x37d5a61, 0x1b9cbb9, 0x3174dde, 0x06a5cbf, 0x373c60f, 0x0f898d8, 0x378b2ab, 0x03586e3 } },
+			{ { 0x1c136b0, 0x035fbfa, 0x1640ad5, 0x06ac722, 0x2f41f97, 0x157e0ab, 0x317ed0d, 0x11a55fc, 0x374277e, 0x06468ab } },
+		},
+	},
+	{
+		{
+			{ { 0x3460efb, 0x18ad0d3, 0x0fad3fc, 0x0a531b0, 0x37b4c0f, 0x1a0da24, 0x110875b, 0x1727e0a, 0x3e00545, 0x08df9f6 } },
+			{ { 0x13c1431, 0x1bdd2f1, 0x1bbd9c2, 0x0710397, 0x0ae5c97, 0x1b23ee7, 0x0e1b7da, 0x1211717, 0x050b5cc, 0x1f8b839 } },
+			{ { 0x301b430, 0x15d7b59, 0x3a20026, 0x134f85f, 0x08c4253, 0x1e47f22, 0x1078ac1, 0x0bc6ea6, 0x19b1115, 0x1c6be9a } },
+		},
+		{
+			{ { 0x33b50d6, 0x08f0711, 0x1e21d48, 0x0f9d9c7, 0x147a1e8, 0x0c9be95, 0x25fafd9, 0x1439370, 0x3c78f89, 0x001cc7e } },
+			{ { 0x153b61d, 0x19be6ce, 0x03cccb9, 0x1557d0a, 0x31960e7, 0x1f759fe, 0x1affed4, 0x051c1e8, 0x29c2b1c, 0x008450b } },
+			{ { 0x0f81880, 0x031c612, 0x0233c86, 0x112f676, 0x2fe5830, 0x1ba15e3, 0x17041b5, 0x10116db, 0x3347e15, 0x13135bc } },
+		},
+		{
+			{ { 0x08f1970, 0x1377f26, 0x2a365e1, 0x13d85cf, 0x1ae4588, 0x19176be, 0x3db623b, 0x1f50dd8, 0x00a88f9, 0x0e2fe54 } },
+			{ { 0x17d1fc9, 0x1fb33f0, 0x382831e, 0x1328a01, 0x1b1d7d6, 0x1ee0cdf, 0x33895fb, 0x1445b7b, 0x2aa7e47, 0x064ff76 } },
+			{ { 0x3e8876f, 0x0b24f0d, 0x0c583fa, 0x0d0c68a, 0x28bd879, 0x1241276, 0x07ac11c, 0x12d2a10, 0x1ebf0d4, 0x1a9bee6 } },
+		},
+		{
+			{ { 0x2e423c6, 0x048ad6d, 0x3f1ddd6, 0x0879437, 0x24e75c0, 0x1cf5d8c, 0x095418e, 0x1621215, 0x1f42c5e, 0x04dbf6a } },
+			{ { 0x20855eb, 0x1b06ed5, 0x213ad48, 0x1c7c49f, 0x0905aec, 0x171acc1, 0x2889bc7, 0x0dd5ae3, 0x14a3189, 0x1d7dda4 } },
+			{ { 0x305bdd1, 0x137ec68, 0x1811f29, 0x0ecffc1, 0x03cd92e, 0x1bb588a, 0x3ec52e1, 0x1974550, 0x110be8d, 0x008860d } },
+		},
+		{
+			{ { 0x3307a7f, 0x09c4050, 0x08bf3ab, 0x0f623ed, 0x2c18f7a, 0x0927ad3, 0x1ff295f, 0x04d8457, 0x01fd404, 0x04e1f11 } },
+			{ { 0x2ad2d14, 0x1d98e17, 0x306095e, 0x00653e2, 0x2823b62, 0x0211e3d, 0x1d37308, 0x18061a2, 0x217b806, 0x1a81c73 } },
+			{ { 0x3978af8, 0x0f0f461, 0x08276ba, 0x1ebf872, 0x1c8ad68, 0x1477ca0, 0x1a4245d, 0x19241af, 0x2aaf1ed, 0x0c5c6c9 } },
+		},
+		{
+			{ { 0x28a47d1, 0x16df62c, 0x09e34c1, 0x0b0bb85, 0x29afc53, 0x1ddbd58, 0x0fc49a9, 0x07d3a94, 0x2334424, 0x1b14529 } },
+			{ { 0x3564ca8, 0x1cc6425, 0x0233525, 0x06113af, 0x3fdeee1, 0x0875150, 0x2ff1bd2, 0x06b49ea, 0x073cf08, 0x0887f52 } },
+			{ { 0x2156341, 0x08813ce, 0x065a464, 0x14dd050, 0x3edcf83, 0x10f030e, 0x06ea620, 0x1555f9c, 0x16fb924, 0x1236a96 } },
+		},
+		{
+			{ { 0x04c9793, 0x1875772, 0x040c29e, 0x11f7a0c, 0x26507e7, 0x06277ac, 0x2dc479a, 0x13539be, 0x3a0e8a7, 0x16320df } },
+			{ { 0x0a59cc7, 0x0a39997, 0x1940dd9, 0x05971c5, 0x2a11c95, 0x01e17ce, 0x3e38469, 0x15ee635, 0x3ccad84, 0x19db75b } },
+			{ { 0x2fc9058, 0x05a2165, 0x003619f, 0x19bdab5, 0x07772ef, 0x135d66a, 0x173bea4, 0x1e15b98, 0x32c6a57, 0x0713dcf } },
+		},
+		{
+			{ { 0x07c3484, 0x19c1bbf, 0x1ec366d, 0x1a61e0e, 0x1cf7f26, 0x01cc7e5, 0x2bce4bc, 0x0eb9d63, 0x1b7daf6, 0x1c1166b } },
+			{ { 0x05fa0bb, 0x093ef4c, 0x075a1cf, 0x102a633, 0x20a7533, 0x1e33848, 0x0e1c197, 0x1885e84, 0x0d1bf64, 0x1e56b20 } },
+			{ { 0x1b42bb3, 0x076d264, 0x3994372, 0x11a5816, 0x15c9a58, 0x18c78dc, 0x3cf728f, 0x1fa73fb, 0x048ce21, 0x17f858a } },
+		},
+	},
+	{
+		{
+			{ { 0x17cb208, 0x0614b57, 0x25ce50f, 0x18343ef, 0x2e37b75, 0x1687891, 0x1ffd590, 0x146bb81, 0x03677da, 0x0ad1301 } },
+			{ { 0x194961a, 0x04853f8, 0x1a9e9cb, 0x0386b8e, 0x126f9f7, 0x150f22d, 0x067e91d, 0x0465260, 0x06fc917, 0x11e2751 } },
+			{ { 0x34eb78e, 0x121eac1, 0x28ce343, 0x074ced7, 0x3eb1b46, 0x04f9067, 0x25de6a4, 0x09c87d5, 0x2f2bb9a, 0x18314bb } },
+		},
+		{
+			{ { 0x0ae6d11, 0x0f1709f, 0x1956e05, 0x0daa524, 0x1131da6, 0x0492eb2, 0x2202b5d, 0x0edbdf7, 0x08d9b66, 0x1c35dc9 } },
+			{ { 0x3fd8bf1, 0x1626f0e, 0x2a3416b, 0x1be4f9a, 0x2c1ae48, 0x13028f5, 0x20b586a, 0x15561c9, 0x312ccfc, 0x042f270 } },
+			{ { 0x2c2a05b, 0x0ba12cf, 0x03c1551, 0x1a768bc, 0x261a67b, 0x08e85d1, 0x289f238, 0x0826f28, 0x13a976f, 0x18dd56f } },
+		},
+		{
+			{ { 0x3f1acb7, 0x1c40625, 0x37b07b8, 0x0f60b2d, 0x17769f5, 0x1a1020f, 0x32dce07, 0x14aca11, 0x1737c52, 0x09d8dd4 } },
+			{ { 0x2d10853, 0x1e80f8a, 0x2ad36ab, 0x084f731, 0x0d5bdd6, 0x069b890, 0x0f8fedf, 0x1f093ff, 0x048bc16, 0x0363307 } },
+			{ { 0x2b419a9, 0x100b4db, 0x014a052, 0x1f3bda3, 0x3c2d139, 0x03c4956, 0x031186a, 0x0dcf9f5, 0x0a7ad16, 0x1c30b76 } },
+		},
+		{
+			{ { 0x0ed7e13, 0x1259f6e, 0x02f523a, 0x056bbb4, 0x1d094bc, 0x1852564, 0x0c17006, 0x19cbc81, 0x3816a53, 0x0cae184 } },
+			{ { 0x36fec0e, 0x0651427, 0x231acac, 0x14a3632, 0x3b8b9fa, 0x1e09b5c, 0x1e0f9b3, 0x092b2e6, 0x2363948, 0x0b83eb1 } },
+			{ { 0x048cd64, 0x1fdefb9, 0x0da0f3c, 0x13843c4, 0x1ab20e9, 0x0e4db2e, 0x3ea6cd0, 0x1e83f13, 0x1c735a4, 0x105e485 } },
+		},
+		{
+			{ { 0x06bcd34, 0x18cee4a, 0x2db9c95, 0x1b2acee, 0x2dfbdfa, 0x1d38e1f, 0x18a0fd9, 0x050c4f1, 0x262241c, 0x0c7ea15 } },
+			{ { 0x3dced2a, 0x02539f5, 0x38e118e, 0x01a3e9c, 0x25fee2b, 0x106d902, 0x1f019d4, 0x1aedc27, 0x230cd99, 0x1c00d12 } },
+			{ { 0x23622f4, 0x09b108b, 0x205b5f0, 0x03cc19a, 0x30480a6, 0x1389123, 0x0dbf095, 0x0913378, 0x12a9952, 0x092ec8c } },
+		},
+		{
+			{ { 0x1f85c6b, 0x0030abd, 0x0f2883f, 0x01827d3, 0x1a1ca13, 0x1ba1bad, 0x2efccd1, 0x1a2d128, 0x39ffeb5, 0x03474ab } },
+			{ { 0x2de67c3, 0x03b45cc, 0x1291635, 0x0c230da, 0x0f2d250, 0x0cfbcd2, 0x2a1a1bb, 0x00111d7, 0x071e188, 0x03fb8fa } },
+			{ { 0x2621edf, 0x0a2a84c, 0x0af353b, 0x10ac913, 0x0c2e08a, 0x19ac193, 0x20cbdd3, 0x1aec800, 0x1718531, 0x05ab35e } },
+		},
+		{
+			{ { 0x087b6ad, 0x071b15e, 0x3d7592b, 0x16afc87, 0x253867a, 0x142f504, 0x1273151, 0x0e002dc, 0x0b18161, 0x0593b4d } },
+			{ { 0x19b1d3d, 0x1dcabcb, 0x08b4e5b, 0x1b52191, 0x18d18a8, 0x0b39637, 0x3503c8b, 0x06127d9, 0x36b9302, 0x048f83b } },
+			{ { 0x12fe69a, 0x1b65306, 0x2a2690f, 0x151d488, 0x186b8b3, 0x1a4de27, 0x1fb69dc, 0x07d70ef, 0x061073f, 0x1e3683f } },
+		},
+		{
+			{ { 0x00c3a94, 0x1e03c5a, 0x0fcd453, 0x0a8d74f, 0x1c7ddf8, 0x0017973, 0x078ac24, 0x1bba220, 0x3316b38, 0x0152a92 } },
+			{ { 0x12bc66a, 0x0574a39, 0x351cb7e, 0x0c38780, 0x0b11f8c, 0x0c28bdd, 0x0d7de03, 0x0e74483, 0x2b256b1, 0x0b4977b } },
+			{ { 0x1267cb8, 0x011a346, 0x1b5fbf9, 0x0e3372a, 0x02ca1e2, 0x06eec17, 0x18e9533, 0x0ec055d, 0x26ab7da, 0x04d1842 } },
+		},
+	},
+	{
+		{
+			{ { 0x3d1f515, 0x09979dd, 0x01e39a5, 0x03c7d53, 0x1522646, 0x0bc06e5, 0x39dde6d, 0x13f7636, 0x0ba97cc, 0x19521e3 } },
+			{ { 0x1f6b0fe, 0x0e3b1e3, 0x2a36a22, 0x04f2baf, 0x14e5f6a, 0x17af1b9, 0x03d0eb8, 0x0ca0124, 0x3a2b20d, 0x0840bf6 } },
+			{ { 0x15ce6a1, 0x1b90141, 0x1a532d3, 0x140928d, 0x0daf29d, 0x07da415, 0x17a8bd5, 0x0574743, 0x1b29ecb, 0x02b5c97 } },
+		},
+		{
+			{ { 0x3056f85, 0x1ef0326, 0x3faffd8, 0x1473faf, 0x14df549, 0x112aefa, 0x3e33121, 0x1fb2ef5, 0x1302399, 0x13d9d7d } },
+			{ { 0x34e2457, 0x099ec60, 0x378bb88, 0x1ab8670, 0x2d9d512, 0x1d15ed7, 0x03d05fb, 0x0ca035e, 0x3b71a03, 0x12bbf3f } },
+			{ { 0x015171e, 0x14d8d81, 0x1077865, 0x08c4cc2, 0x334afbc, 0x0945110, 0x13756e8, 0x0ac30e1, 0x32a2a86, 0x02f32ed } },
+		},
+		{
+			{ { 0x0fe1296, 0x1579314, 0x3efc30d, 0x017f744, 0x380e5ee, 0x07031b0, 0x3fb62a8, 0x0f84778, 0x29108f3, 0x199e3f5 } },
+			{ { 0x2b1a9c8, 0x1a58bfa, 0x3b9a30b, 0x1ab28a3, 0x21b9f98, 0x15b6df2, 0x17018dd, 0x0e7d612, 0x2b59d6b, 0x10093c2 } },
+			{ { 0x36863c2, 0x1be8c58, 0x27e42b0, 0x042b969, 0x01fda31, 0x09eaefc, 0x1e64fbc, 0x0e029ee, 0x108ead4, 0x0b50b88 } },
+		},
+		{
+			{ { 0x3537593, 0x05ec343, 0x0c9842e, 0x05898f0, 0x24539a4, 0x12ae09f, 0x343d73a, 0x18dc376, 0x279b423, 0x1082fce } },
+			{ { 0x0dfd29b, 0x144c565, 0x18d52fe, 0x0e989fa, 0x1855661, 0x0455010, 0x09f8384, 0x0645d74, 0x08b8d2d, 0x19dac98 } },
+			{ { 0x05b2b47, 0x02e9947, 0x3701027, 0x16188d8, 0x219c6db, 0x03135b0, 0x38658de, 0x03c0f7f, 0x3a9c0cf, 0x1d174bf } },
+		},
+		{
+			{ { 0x1d34e6a, 0x1b7d5c8, 0x27a0c06, 0x13ccbdd, 0x2c76e20, 0x0756afa, 0x104e1e4, 0x1073a78, 0x254c1dc, 0x01b856f } },
+			{ { 0x3c9c8bd, 0x096878a, 0x3b037ea, 0x041323c, 0x3a96c98, 0x10155db, 0x0e3876f, 0x0ba1aa2, 0x2b960cf, 0x06b88f3 } },
+			{ { 0x132994a, 0x09761c6, 0x3560b6e, 0x1ae758e, 0x0c8d472, 0x0b7ca05, 0x20aa4ed, 0x03eefb8, 0x21278ec, 0x1637b61 } },
+		},
+		{
+			{ { 0x2c2c9a8, 0x0d6ea2d, 0x33185bf, 0x077a962, 0x123bbbe, 0x12d1573, 0x04883f8, 0x17b0670, 0x2b531d5, 0x022e9a5 } },
+			{ { 0x266c55c, 0x1cde4fc, 0x1c93b02, 0x02e622a, 0x32325db, 0x026c3a8, 0x1c17c5e, 0x0df2b9c, 0x285485f, 0x0bfce77 } },
+			{ { 0x3efc57a, 0x14fbbb0, 0x1022efd, 0x0bea7fa, 0x0138154, 0x1a671cb, 0x2bd1ff8, 0x1ca9d47, 0x34947cf, 0x04818ce } },
+		},
+		{
+			{ { 0x112100a, 0x14c51d2, 0x3c0d057, 0x16bf37d, 0x3788ded, 0x1ea79c6, 0x33b0c88, 0x17bdc23, 0x23cb393, 0x01d0cef } },
+			{ { 0x1610042, 0x1261e24, 0x35d0172, 0x1e7675f, 0x13b9ec4, 0x0f0a4c0, 0x339caca, 0x030ae17, 0x19b4d59, 0x0d74c2a } },
+			{ { 0x0e997f4, 0x0513017, 0x2347fef, 0x12582e2, 0x15d74f7, 0x076847c, 0x1c0fead, 0x153eb06, 0x1e7af6d, 0x0b61cfb } },
+		},
+		{
+			{ { 0x25df981, 0x080b853, 0x03eb54c, 0x0ba80af, 0x2883564, 0x0e21d6c, 0x13ae9dd, 0x04a6314, 0x0a01600, 0x0150d86 } },
+			{ { 0x3373409, 0x08c5910, 0x03b22af, 0x177a554, 0x3eae2df, 0x1a64806, 0x1ff737a, 0x0f6d612, 0x14707fa, 0x0b9dcd9 } },
+			{ { 0x34c23c1, 0x0af7d25, 0x0d261bd, 0x12cee72, 0x2a9bc28, 0x09aba2c, 0x0165c51, 0x0c1a084, 0x362d079, 0x12c510c } },
+		},
+	},
+	{
+		{
+			{ { 0x0529ccb, 0x1153a47, 0x2bf72cf, 0x0932631, 0x0c3d89a, 0x0121965, 0x3d7fa3c, 0x1eb84e8, 0x18eaf66, 0x05c0e10 } },
+			{ { 0x26e1f7a, 0x12df1ed, 0x1efd998, 0x12fa861, 0x11055f8, 0x13eaf1c, 0x036fe38, 0x07ee7de, 0x2752da6, 0x160bd11 } },
+			{ { 0x0324ce4, 0x05ef4c8, 0x17898c6, 0x1452244, 0x2a0410b, 0x05a1364, 0x378c5a7, 0x1b93643, 0x0bcda28, 0x030a871 } },
+		},
+		{
+			{ { 0x1bd6945, 0x120521a, 0x1a45db8, 0x1edf0e4, 0x035b641, 0x15cc5ab, 0x1e9096a, 0x19078c7, 0x30a314d, 0x169aa6c } },
+			{ { 0x31f0447, 0x171f41b, 0x00b3a49, 0x1f6dc3e, 0x2c89a78, 0x1b2d28f, 0x181397d, 0x10efa2b, 0x11c6f64, 0x1f1562f } },
+			{ { 0x396463d, 0x1054934, 0x09e1a1d, 0x0561ad1, 0x04aed8a, 0x0bc5fa4, 0x21d3c8e, 0x1f874a1, 0x0a0afba, 0x0101297 } },
+		},
+		{
+			{ { 0x2416fd1, 0x12786ca, 0x3316c57, 0x1471a82, 0x2d71bdc, 0x15d6967, 0x21fec1e, 0x1d30086, 0x16e7f8e, 0x0e549d4 } },
+			{ { 0x2a743d6, 0x1d001c2, 0x3dd1183, 0x05ad932, 0x332eb43, 0x08fd2de, 0x18235b3, 0x0c66ae9, 0x3dcadd9, 0x118e56f } },
+			{ { 0x25d9a9c, 0x1f6cb46, 0x385422f, 0x1e68802, 0x271dd16, 0x0d56fea, 0x25f78aa, 0x002ddfa, 0x29e822d, 0x1d95e68 } },
+		},
+		{
+			{ { 0x2b434f2, 0x12d44d4, 0x01c2667, 0x04c9ef4, 0x360c8a1, 0x10d35ce, 0x09443ba, 0x0f836aa, 0x3b2a277, 0x00b1452 } },
+			{ { 0x1c02a17, 0x1a39f92, 0x06fe8b6, 0x115e54d, 0x08f3546, 0x0224c1b, 0x32f88f6, 0x1b627da, 0x1c9e05b, 0x10e8e13 } },
+			{ { 0x3f1b645, 0x0f576a2, 0x16a6d09, 0x1f7b5aa, 0x3ee2f4d, 0x1b0d253, 0x08b6bd4, 0x00b2627, 0x0961548, 0x0458248 } },
+		},
+		{
+			{ { 0x29b4dcd, 0x015858d, 0x2ac6f47, 0x13b2ae1, 0x1d700b2, 0x0f18021, 0x10dfcea, 0x0084fb8, 0x3491e6e, 0x0bd8df5 } },
+			{ { 0x1dacfaa, 0x1459a4a, 0x331f689, 0x064209a, 0x3694a7d, 0x13d5559, 0x3b1e522, 0x1c17d3d, 0x1bc5698, 0x0d47849 } },
+			{ { 0x2f67bbe, 0x126d186, 0x12c3a96, 0x1d6455c, 0x3580c0d, 0x1a699fb, 0x370cffc, 0x1534e3b, 0x06e7ce2, 0x1fc60b4 } },
+		},
+		{
+			{ { 0x2217522, 0x152dca3, 0x31b0128, 0x1a6a425, 0x2a963a3, 0x146903c, 0x012a6bf, 0x042fa6b, 0x03241c5, 0x112b301 } },
+			{ { 0x30168ec, 0x123992a, 0x0a86f4f, 0x0a8af6e, 0x32d6929, 0x1cd0eda, 0x28ce9a3, 0x076012a, 0x0c343e9, 0x19f52b2 } },
+			{ { 0x37a5777, 0x15aeed3, 0x27c238f, 0x0a48c18, 0x22cd7fb, 0x16b4684, 0x250e364, 0x037a95b, 0x0312ad7, 0x155b472 } },
+		},
+		{
+			{ { 0x11be821, 0x019d5ac, 0x27bb03e, 0x118851f, 0x03ebfe0, 0x099465d, 0x1682ab5, 0x1e0bf16, 0x38cc8c7, 0x025eaf8 } },
+			{ { 0x08d3982, 0x1d038c3, 0x34682fd, 0x1f0ad1f, 0x0c7dc1c, 0x173646e, 0x0f9e583, 0x1dfe9e4, 0x2d1d824, 0x1d1b1b1 } },
+			{ { 0x2a52da4, 0x07261df, 0x3a86189, 0x0acdee0, 0x1310da5, 0x1ccebd2, 0x21c04fb, 0x097a045, 0x234bee8, 0x15df852 } },
+		},
+		{
+			{ { 0x14dd72b, 0x1b3afaf, 0x042329f, 0x0d03079, 0x3d1a93f, 0x0c8d1ff, 0x12cbbe0, 0x052a249, 0x38fb009, 0x1c14c12 } },
+			{ { 0x1a73b0a, 0x09a2b18, 0x0bebe1c, 0x081bc8d, 0x3cbebe8, 0x16d00e9, 0x09f4135, 0x1e8583c, 0x296fd78, 0x183e9fb } },
+			{ { 0x1296ec6, 0x1474d53, 0x23b16c7, 0x1f2fd69, 0x3cf0c14, 0x0bd42ec, 0x1cac65a, 0x07face1, 0x0ca1635, 0x084e638 } },
+		},
+	},
+	{
+		{
+			{ { 0x0b75601, 0x02abe6d, 0x1ae44f3, 0x09ae46d, 0x17ab1c8, 0x1b7a023, 0x35530b0, 0x1a9da59, 0x04e98f7, 0x06efeca } },
+			{ { 0x02b33f3, 0x141628e, 0x016913e, 0x05d6a46, 0x16b8ae8, 0x13db36e, 0x1da81d2, 0x05cd1f2, 0x1d95a23, 0x16a8fb6 } },
+			{ { 0x3d96561, 0x1ddfa71, 0x006ccac, 0x0a3963c, 0x32cac49, 0x1506eee, 0x2994cec, 0x0f98ca0, 0x0e5e895, 0x1281f85 } },
+		},
+		{
+			{ { 0x077a49b, 0x0d63371, 0x202e481, 0x0f3223f, 0x3f4e36b, 0x1c86aad, 0x1469953, 0x0102332, 0x2d84afa, 0x142bdeb } },
+			{ { 0x00df999, 0x104b2e6, 0x0ee29dc, 0x179e376, 0x28c575d, 0x05c77fd, 0x2f6ef49, 0x0805774, 0x391d313, 0x0fc2eb0 } },
+			{ { 0x1f65be5, 0x1f78045, 0x1364dc9, 0x1090b08, 0x0a66098, 0x1add6d9, 0x102c085, 0x000cf00, 0x16baebd, 0x064868c } },
+		},
+		{
+			{ { 0x1f3c18b, 0x0ab66b6, 0x0339aeb, 0x17b058e, 0x159a83b, 0x15c0ed9, 0x105d612, 0x0fea7d3, 0x2ca062c, 0x1ec1277 } },
+			{ { 0x3b870fc, 0x08bdfb7, 0x277b128, 0x15a7bb5, 0x0b0a5af, 0x0c24df7, 0x078ea1b, 0x1d600e7, 0x01e273a, 0x191637d } },
+			{ { 0x1444483, 0x0f8de8d, 0x3d27b99, 0x1987f6d, 0x1d621e4, 0x0c5dd87, 0x0026189, 0x1cc8f0c, 0x0bc2950, 0x1824f73 } },
+		},
+		{
+			{ { 0x084034b, 0x1bbaf98, 0x30a8d7b, 0x1b3c07d, 0x0c6670a, 0x02d0695, 0x1bb55db, 0x1b212e6, 0x098b647, 0x1b8c603 } },
+			{ { 0x1e0706d, 0x0e6a161, 0x32663fe, 0x0c59f39, 0x0db4297, 0x18f453b, 0x0f970b8, 0x12f8877, 0x084827a, 0x15f47a8 } },
+			{ { 0x128b071, 0x0adb9e8, 0x1755dcf, 0x16c9d44, 0x2930565, 0x0216130, 0x26f4159, 0x1a31ef6, 0x1ddd97b, 0x0d8fa66 } },
+		},
+		{
+			{ { 0x24baec6, 0x0123738, 0x1ec05e3, 0x0add5e5, 0x1da6dc9, 0x0efe931, 0x19e371e, 0x06ab219, 0x1bc6f9b, 0x08c7e5e } },
+			{ { 0x1ee1fc4, 0x010f04d, 0x119f2d5, 0x0a84726, 0x25dbacd, 0x18cd330, 0x3b400da, 0x0a57685, 0x38693a0, 0x123ba6d } },
+			{ { 0x02af3c6, 0x07792f3, 0x1a3eb86, 0x187f104, 0x2c12ec0, 0x14fb466, 0x2b804e0, 0x08276f1, 0x1b08792, 0x01e6fea } },
+		},
+		{
+			{ { 0x2d54245, 0x07b6028, 0x32a5e79, 0x1c3bfb1, 0x02a822d, 0x1085475, 0x2d631e8, 0x06d7aed, 0x1594706, 0x07bd3ec } },
+			{ { 0x2300df4, 0x00e9476, 0x3561c72, 0x119ed4a, 0x210e590, 0x1356480, 0x2789685, 0x0329da7, 0x3684817, 0x00e31df } },
+			{ { 0x3167bec, 0x197b996, 0x1b850a9, 0x014b686, 0x1656429, 0x0102199, 0x16f9a4c, 0x1eace56, 0x2a4a0bf, 0x15d7ba4 } },
+		},
+		{
+			{ { 0x2a4d801, 0x1af1142, 0x33b0ba8, 0x13d299d, 0x30ebc48, 0x18906c2, 0x31d9315, 0x1036713, 0x3e382f5, 0x0802879 } },
+			{ { 0x2182fcf, 0x0202422, 0x3b7ba98, 0x014ca44, 0x0c385c3, 0x0f733de, 0x15eaba9, 0x1a000b7, 0x112cd3f, 0x10f539c } },
+			{ { 0x2f93ac5, 0x16e59fa, 0x2580a31, 0x0d82b32, 0x1c6f262, 0x07197f5, 0x1c2ecab, 0x1c71fc5, 0x12651e4, 0x0143b29 } },
+		},
+		{
+			{ { 0x0e668ea, 0x10e5d98, 0x292f2f5, 0x1f0a9d5, 0x26c66ef, 0x0eca79f, 0x0bcda9a, 0x1cae996, 0x1fa131a, 0x1854702 } },
+			{ { 0x13f0c9c, 0x0c6b791, 0x3737868, 0x0f7fb81, 0x3a7d411, 0x1847b3d, 0x0bd64f6, 0x098df9b, 0x021c58f, 0x12c3b9b } },
+			{ { 0x1f05d96, 0x157037f, 0x1cf475e, 0x10155a7, 0x37498bb, 0x0171709, 0x15dc389, 0x0616236, 0x3a800f0, 0x07fbc93 } },
+		},
+	},
+	{
+		{
+			{ { 0x0976b86, 0x0abfd4c, 0x0c0845a, 0x0361692, 0x23642e0, 0x1e5bae5, 0x0c4b626, 0x182fb94, 0x26c8340, 0x0a0017f } },
+			{ { 0x2a73196, 0x194fec6, 0x08306fa, 0x181febb, 0x03e5254, 0x13a17b2, 0x00584fd, 0x027d5a4, 0x292fc86, 0x1513524 } },
+			{ { 0x0528688, 0x1eea7cd, 0x3b42d5d, 0x0a12883, 0x1706ffe, 0x0d94b36, 0x1dde6b3, 0x1bf5eeb, 0x130f316, 0x1cb91ca } },
+		},
+		{
+			{ { 0x32a7627, 0x0fd8d74, 0x0de00fe, 0x032fb2b, 0x1eaa936, 0x0d04450, 0x2f3cb94, 0x0870790, 0x000fe06, 0x07fb9fc } },
+			{ { 0x381084f, 0x1482325, 0x1dc24d2, 0x0591a28, 0x2c540a8, 0x1efde02, 0x2d75301, 0x0699fb3, 0x0c2733a, 0x16a74ba } },
+			{ { 0x3dbf7e5, 0x0c17680, 0x1b7aeca, 0x048a1a6, 0x2936bc9, 0x04a88ec, 0x16ae6e9, 0x0a86f69, 0x11ee040, 0x003e501 } },
+		},
+		{
+			{ { 0x3af9753, 0x1e4eec1, 0x0d4fafd, 0x079edbb, 0x160fb43, 0x00b1ec5, 0x0cc5fb7, 0x08a59cd, 0x125dd40, 0x11edfff } },
+			{ { 0x3d330b2, 0x15ac8f0, 0x360d1a6, 0x0dd8238, 0x3c8722e, 0x042b83c, 0x218b637, 0x021b66d, 0x3e8beab, 0x01f5e71 } },
+			{ { 0x008dd12, 0x0fee72f, 0x05370ff, 0x1d70f76, 0x22819ac, 0x11fc1bf, 0x39215ed, 0x176c1aa, 0x235ea64, 0x070d482 } },
+		},
+		{
+			{ { 0x16bc059, 0x01bd008, 0x30fd9b5, 0x0e895e6, 0x07eec8c, 0x1c70990, 0x2b54f0b, 0x1cab692, 0x3b66d12, 0x0e1d430 } },
+			{ { 0x0cba34a, 0x094e9af, 0x033701a, 0x109c1c1, 0x0f9870e, 0x082e396, 0x1db00cc, 0x0cdf218, 0x375d0ee, 0x070f415 } },
+			{ { 0x022e51a, 0x1bc5025, 0x2ce2d25, 0x1e15aef, 0x32f031c, 0x04ce029, 0x0a7f3ba, 0x10f8420, 0x07d3304, 0x018878b } },
+		},
+		{
+			{ { 0x0dbf0f3, 0x185e5ac, 0x032d6f5, 0x1cf0be7, 0x1537ebe, 0x1aaa3b4, 0x11838f4, 0x1d3a4b2, 0x1ca1002, 0x1763962 } },
+			{ { 0x259838d, 0x0183320, 0x35b95f3, 0x00e34fc, 0x243a923, 0x1581e30, 0x3241bb2, 0x0b78ca4, 0x097bd3a, 0x0001f58 } },
+			{ { 0x042a94b, 0x1c76542, 0x1c7d817, 0x11ac479, 0x2cb4f0d, 0x151e2ef, 0x30a1c5d, 0x1f0c152, 0x383c1cb, 0x0560f5d } },
+		},
+		{
+			{ { 0x09d28c7, 0x0d1c133, 0x0b1f200, 0x0f7b966, 0x0746d9e, 0x05b8726, 0x095afdf, 0x10142dc, 0x0e83c55, 0x1256019 } },
+			{ { 0x1a27ae1, 0x1a8bbd7, 0x02e9d9d, 0x0a2ab38, 0x165f0e8, 0x009167a, 0x3150933, 0x1ee1934, 0x2e81ed8, 0x094a97c } },
+			{ { 0x066e80d, 0x0250994, 0x18d61a5, 0x02983e4, 0x3f30fde, 0x01112fd, 0x1ed3c06, 0x071036a, 0x0bd843b, 0x01e705c } },
+		},
+		{
+			{ { 0x0d5d056, 0x1b35430, 0x2e779ba, 0x16dd81a, 0x26bdda1, 0x1c3ef48, 0x3391ff9, 0x1598794, 0x17317b8, 0x19da303 } },
+			{ { 0x0fa6fff, 0x1bb3919, 0x0a460a0, 0x0f3102f, 0x2fb8d0c, 0x1b8ea42, 0x0a11228, 0x16006af, 0x234ac9f, 0x1b7b017 } },
+			{ { 0x155c1b3, 0x189797c, 0x3723296, 0x13ccbdb, 0x105efce, 0x16b2600, 0x25eee36, 0x05e9845, 0x14ddcd5, 0x1451178 } },
+		},
+		{
+			{ { 0x3bea455, 0x051eaca, 0x2253126, 0x07c903c, 0x2314e89, 0x030f7a7, 0x0fca45f, 0x087a969, 0x086e4fd, 0x04ba640 } },
+			{ { 0x3144951, 0x00ad2ce, 0x3966aea, 0x15a225d, 0x2399ffd, 0x06385db, 0x2b4938b, 0x0b91717, 0x31e3929, 0x04c61bc } },
+			{ { 0x3dfbb2e, 0x125acdf, 0x15f3e21, 0x0f090e7, 0x27e6a4d, 0x05b983f, 0x09b621d, 0x135fbe2, 0x305d3e9, 0x1decb8f } },
+		},
+	},
+	{
+		{
+			{ { 0x2ddb0a4, 0x018e704, 0x0cd7ab3, 0x1860124, 0x297467c, 0x0fce460, 0x21781ac, 0x1d15a2f, 0x152e095, 0x01e8654 } },
+			{ { 0x02ec4de, 0x1ea7167, 0x279652d, 0x1fa7c27, 0x2f22d86, 0x1a8f908, 0x3836c8b, 0x0aba38e, 0x3c7ad32, 0x18ede57 } },
+			{ { 0x09e5fc8, 0x1a3c08e, 0x0877506, 0x0167c6f, 0x2410cec, 0x1412643, 0x0feaee2, 0x026f5f4, 0x3d032f0, 0x0fa3fa0 } },
+		},
+		{
+			{ { 0x0efd13c, 0x013237a, 0x2e6210e, 0x0719f01, 0x37f146a, 0x060cde3, 0x2aed289, 0x190d4b3, 0x19a6258, 0x08b5822 } },
+			{ { 0x170a294, 0x0c56e41, 0x0a925f1, 0x1833842, 0x253c909, 0x1bbfd84, 0x22d70b0, 0x000fbc3, 0x397fac4, 0x1d6e8ed } },
+			{ { 0x0cdd196, 0x076f01c, 0x1534c47, 0x05b63ec, 0x183fa2a, 0x1401260, 0x023de75, 0x1cbd671, 0x3b87779, 0x0241341 } },
+		},
+		{
+			{ { 0x0f940b9, 0x08b5992, 0x1873e86, 0x065e968, 0x01a54bc, 0x081f931, 0x34bd6d0, 0x14d82ce, 0x0ebaf72, 0x18902ab } },
+			{ { 0x1ba919c, 0x187f537, 0x1b55699, 0x1f63a64, 0x33cc76c, 0x186cc51, 0x1e631d6, 0x1c0e58c, 0x3fbc1dd, 0x10f8850 } },
+			{ { 0x3a295a0, 0x11d2716, 0x24b5f06, 0x0de51be, 0x35a51f1, 0x1c9316a, 0x09dd3f3, 0x1958cde, 0x238db40, 0x15af6bc } },
+		},
+		{
+			{ { 0x19d3bb2, 0x034db30, 0x0d72262, 0x1bb111c, 0x018a9ae, 0x1a14f5c, 0x1c2c8eb, 0x0ea8f93, 0x107e1e5, 0x00ea8c5 } },
+			{ { 0x13533eb, 0x0ae78fd, 0x3a806c5, 0x0ab75c9, 0x0ce15a3, 0x15a5572, 0x30a290e, 0x06313c1, 0x2d83741, 0x07492a1 } },
+			{ { 0x3d4ce1f, 0x11d923f, 0x1839e9d, 0x182a564, 0x38117ab, 0x109357c, 0x112c10e, 0x10b311a, 0x1c9aeb4, 0x10ec987 } },
+		},
+		{
+			{ { 0x0951364, 0x04f62db, 0x28f632a, 0x130005f, 0x253f9c4, 0x14f9567, 0x2886eea, 0x12c8051, 0x2242940, 0x00ad357 } },
+			{ { 0x0bb79bb, 0x0c78662, 0x2b3bcab, 0x1ee0bd1, 0x2827b41, 0x03dea33, 0x2177130, 0x1785605, 0x0f5b276, 0x0c98157 } },
+			{ { 0x0d18df2, 0x05572ca, 0x0a11694, 0x030c367, 0x3ab3119, 0x0824389, 0x27a49b6, 0x0821893, 0x09ae5d3, 0x09e9b20 } },
+		},
+		{
+			{ { 0x03d6954, 0x109c2b1, 0x15659a5, 0x0bb5336, 0x37528f9, 0x1d7036c, 0x12c9234, 0x0b32f3f, 0x203d8c2, 0x088540d } },
+			{ { 0x30db188, 0x1baf347, 0x37d1174, 0x1d33ad2, 0x0df4f5c, 0x1f5585a, 0x36fd18a, 0x02fde45, 0x34ff60a, 0x0b2d9c5 } },
+			{ { 0x10be1d0, 0x1b37e4e, 0x07e2b3d, 0x0239467, 0x2a50881, 0x094f0f4, 0x08e333d, 0x086d051, 0x373890f, 0x1ec77d2 } },
+		},
+		{
+			{ { 0x3f8f58c, 0x1888601, 0x13a8be5, 0x0fea4a0, 0x38d5572, 0x1b6a630, 0x154468f, 0x007b655, 0x05d352e, 0x1a1a609 } },
+			{ { 0x3b2a224, 0x0bcb82c, 0x22c1c92, 0x0315aa8, 0x1f1b278, 0x17f7b0e, 0x1c7f106, 0x13242bd, 0x2658fc5, 0x187f3bc } },
+			{ { 0x218187a, 0x057614a, 0x19afb76, 0x09c36ed, 0x3cf92ab, 0x1f6c482, 0x1714087, 0x039e897, 0x073daf0, 0x11b3d31 } },
+		},
+		{
+			{ { 0x1498140, 0x11ba9fc, 0x10a8427, 0x1c1c95a, 0x1f079fb, 0x029ceba, 0x061c62b, 0x0b76491, 0x250d8cc, 0x04196ab } },
+			{ { 0x2c4e5f9, 0x1497b67, 0x260684c, 0x008b481, 0x0397b68, 0x1e5cadc, 0x0d3f965, 0x1e80e56, 0x0d14eb5, 0x0a4e1ef } },
+			{ { 0x3200d57, 0x1114977, 0x0e94385, 0x0b5fe53, 0x170ecb7, 0x1834030, 0x3f3d8f0, 0x0e2c140, 0x264f1ce, 0x1a68663 } },
+		},
+	},
+	{
+		{
+			{ { 0x0c5caed, 0x0510d37, 0x3667c20, 0x0b1e427, 0x11fb576, 0x186a0e7, 0x0cabb76, 0x13c8e00, 0x3bd267f, 0x096c9a5 } },
+			{ { 0x11a78bc, 0x0acb836, 0x2ccf20c, 0x0e64284, 0x11f2622, 0x05070b8, 0x2a53320, 0x037f3be, 0x292493a, 0x1cda79a } },
+			{ { 0x3986864, 0x1cffec4, 0x0f713ac, 0x0ca0aee, 0x0f297ef, 0x1273b5e, 0x3661def, 0x19a5c09, 0x3db54e4, 0x05081a0 } },
+		},
+		{
+			{ { 0x1cc5ad0, 0x1aedbf0, 0x191669d, 0x14cb235, 0x1a86c33, 0x06bde53, 0x06d24d3, 0x0383a76, 0x0161d08, 0x0c7a0ed } },
+			{ { 0x09dd197, 0x02f4789, 0x020568f, 0x002f2c6, 0x18830d4, 0x0baac5c, 0x16997e6, 0x0e5bf60, 0x2bf508a, 0x182d8ef } },
+			{ { 0x2062b4f, 0x031c4a7, 0x15b12fd, 0x0794990, 0x127923d, 0x118683f, 0x270a5b7, 0x062eb7d, 0x362d550, 0x1573c7a } },
+		},
+		{
+			{ { 0x1f58c52, 0x1ad78df, 0x186c60e, 0x0ef3cce, 0x35ceae7, 0x113ee20, 0x18e71a4, 0x02677b0, 0x2a62ba0, 0x0695bee } },
+			{ { 0x1c23d58, 0x0440419, 0x0338b0f, 0x16a84a4, 0x22e7421, 0x0c55fa7, 0x017d489, 0x03a9c48, 0x2457089, 0x19a6995 } },
+			{ { 0x09dc9ec, 0x19ad417, 0x2e35287, 0x1dd3be1, 0x0c0955e, 0x1347651, 0x1d72b20, 0x14b930e, 0x2799c58, 0x04f120d } },
+		},
+		{
+			{ { 0x18bd080, 0x13eda97, 0x108589b, 0x162b8d2, 0x37baf13, 0x0e55365, 0x17441dc, 0x104fa96, 0x3dc8e5b, 0x142f721 } },
+			{ { 0x2b3e1b9, 0x0975196, 0x3ec2847, 0x03e3f89, 0x3f04f06, 0x0b5b9b6, 0x01b3276, 0x0c0e33f, 0x13a637b, 0x19be032 } },
+			{ { 0x2dfe111, 0x14de0db, 0x17b2c0d, 0x0af808d, 0x0c8d4f8, 0x1b73b96, 0x01d6192, 0x0b5cc96, 0x04725fd, 0x0775591 } },
+		},
+		{
+			{ { 0x0bac89a, 0x1f98002, 0x07c1852, 0x08f570e, 0x1f533a8, 0x1e7977c, 0x1c5f0cf, 0x0b9be7c, 0x0f63a30, 0x0e8e914 } },
+			{ { 0x362127d, 0x11ffe0c, 0x382b1f4, 0x0238e6b, 0x2f27dab, 0x1220c8b, 0x0a2a1a4, 0x065cdce, 0x12219f7, 0x0399164 } },
+			{ { 0x0394627, 0x1cbcc76, 0x0a200f1, 0x01ef4a5, 0x0e274c6, 0x1996f80, 0x1b6368b, 0x10f7a3c, 0x1393a9a, 0x0c63236 } },
+		},
+		{
+			{ { 0x31dd398, 0x1a78a6a, 0x3c76bac, 0x0c1a16c, 0x3f24859, 0x15973cd, 0x28efef9, 0x15ecab0, 0x0325950, 0x1426907 } },
+			{ { 0x2fffe19, 0x11740ca, 0x36cde4e, 0x04bf926, 0x0327cf1, 0x08598ef, 0x069f1dd, 0x0629793, 0x279a1d5, 0x08931f1 } },
+			{ { 0x2f925e9, 0x01bb729, 0x3e677b8, 0x1a320d8, 0x1e4fbcf, 0x1833e89, 0x209404e, 0x071305d, 0x2328a11, 0x016ffc0 } },
+		},
+		{
+			{ { 0x1c512e4, 0x0683743, 0x35fcd10, 0x042252f, 0x13f9c37, 0x14a5240, 0x24735c7, 0x07d43ee, 0x0dee01a, 0x15d89df } },
+			{ { 0x3cae00b, 0x084dc08, 0x1eb26c6, 0x0568d66, 0x1512b3c, 0x01a1c88, 0x20824e9, 0x094f2ce, 0x03fa2a4, 0x1e02e33 } },
+			{ { 0x34f305f, 0x0e2af08, 0x3c103de, 0x1e8a02e, 0x2695dfe, 0x0e62a0d, 0x1528a1a, 0x0f42bd0, 0x326271b, 0x17fd061 } },
+		},
+		{
+			{ { 0x3b69540, 0x0d1fa04, 0x21c3cbb, 0x1da1930, 0x3cd74a8, 0x0781276, 0x393749c, 0x16d3583, 0x0ca0a0c, 0x0a7536e } },
+			{ { 0x389db9d, 0x1820305, 0x31ea731, 0x12f9f3b, 0x29d8080, 0x0bd035d, 0x044a603, 0x0d7df53, 0x1c25a96, 0x041a80f } },
+			{ { 0x33353d0, 0x142abcc, 0x13cbb35, 0x12d6698, 0x0e19a76, 0x088f7f0, 0x3b2c564, 0x1df478a, 0x11052cb, 0x12ace29 } },
+		},
+	},
+	{
+		{
+			{ { 0x3ddc09c, 0x1f47bd7, 0x3b9dad9, 0x1efbaba, 0x3a0acfb, 0x01634c2, 0x2b5ae90, 0x17364ba, 0x3b04ed2, 0x0c1071a } },
+			{ { 0x368d593, 0x10ac959, 0x1427b4f, 0x0ba2116, 0x2630701, 0x00ace1d, 0x005eae5, 0x0d21e35, 0x2dc088a, 0x0a73746 } },
+			{ { 0x156e148, 0x0bcbe76, 0x165c1fe, 0x1acf9ab, 0x2b79e5d, 0x16c025c, 0x34c5daf, 0x14f6348, 0x2814049, 0x0412ef5 } },
+		},
+		{
+			{ { 0x27ff163, 0x16697f5, 0x2d0352b, 0x0ea663a, 0x3a4af9a, 0x020f257, 0x001266f, 0x1beb6ff, 0x20fb072, 0x0813ca8 } },
+			{ { 0x0f1ed67, 0x03f4c5a, 0x3784a3e, 0x06ec379, 0x0b20477, 0x0d2f2de, 0x22e2182, 0x029289b, 0x17092a7, 0x16fa331 } },
+			{ { 0x0ebb079, 0x10ecf4c, 0x1c61902, 0x0d5eb29, 0x1d62455, 0x16d5c31, 0x21e18c7, 0x0c3eca7, 0x17c2791, 0x095c3ec } },
+		},
+		{
+			{ { 0x3b8245a, 0x1aa5542, 0x21a2325, 0x1447c82, 0x3239bee, 0x0a4c935, 0x37516c4, 0x0cd0f30, 0x11de018, 0x090717e } },
+			{ { 0x0b61575, 0x08d9fcb, 0x04d87df, 0x1b0e6b0, 0x3d7e5bd, 0x1b52562, 0x38a1532, 0x159bd18, 0x2a53030, 0x0f72d97 } },
+			{ { 0x0de6caa, 0x005ca50, 0x267451b, 0x18116cb, 0x23efcb3, 0x15b01d1, 0x3fe6e91, 0x01ca2da, 0x1d5fcdf, 0x021083b } },
+		},
+		{
+			{ { 0x0f410ce, 0x030d381, 0x0d0a06b, 0x0d13b70, 0x2d84d6d, 0x1b91521, 0x33863f5, 0x1138bb2, 0x3321db8, 0x0135953 } },
+			{ { 0x362fa4a, 0x1c82ae0, 0x3cdd9bf, 0x0a710d1, 0x15f8463, 0x039e62b, 0x3cb0bfe, 0x13fbc62, 0x2fbc176, 0x036694f } },
+			{ { 0x1bdb5d5, 0x17045b7, 0x3a5abcf, 0x1b46d2e, 0x0a5537a, 0x134a292, 0x3040b99, 0x15ae396, 0x2618991, 0x129e93c } },
+		},
+		{
+			{ { 0x3372a4b, 0x0eca46b, 0x0fe4498, 0x1838c0a, 0x24f6a09, 0x0899ef2, 0x242b243, 0x1c67bb0, 0x0223e0e, 0x12a58c5 } },
+			{ { 0x3b15f95, 0x1c60097, 0x371fe94, 0x1a35ae0, 0x0f7d97c, 0x0e01112, 0x2784280, 0x10919bf, 0x0cddd31, 0x046d431 } },
+			{ { 0x0a4ffd6, 0x009d102, 0x2db34dd, 0x1f4e0ab, 0x1ce385d, 0x102b3f2, 0x1a45b1e, 0x18a2ee6, 0x0dce6bc, 0x13d2f39 } },
+		},
+		{
+			{ { 0x09d0b6f, 0x0985bb1, 0x062e61c, 0x07e5761, 0x39159c6, 0x06b4fa6, 0x1a04df9, 0x1e6e91d, 0x2561595, 0x0c10b3b } },
+			{ { 0x2242584, 0x1f396b8, 0x153d4e3, 0x0b497ac, 0x09ba9c9, 0x0ea3cf4, 0x104eb8e, 0x03cda43, 0x14b71c0, 0x1cff374 } },
+			{ { 0x09bac41, 0x19c1e51, 0x221484f, 0x16de711, 0x2156b8d, 0x1841a7c, 0x33b10af, 0x03ac995, 0x0c9a9ce, 0x0e279d0 } },
+		},
+		{
+			{ { 0x30eac28, 0x15e3d95, 0x39c3937, 0x1913c8c, 0x3956c2c, 0x19b91ed, 0x21f55d0, 0x0d20cbf, 0x25d6263, 0x0971097 } },
+			{ { 0x0dcb9ce, 0x12ceb8d, 0x215ac9f, 0x11f1a46, 0x25d400c, 0x0c6381b, 0x1f83eb1, 0x0f108b6, 0x39465a6, 0x185514d } },
+			{ { 0x1d7de6e, 0x181a9bc, 0x06107e7, 0x13c7031, 0x0fbe5d8, 0x08a6c77, 0x27b1327, 0x0eb3182, 0x0915484, 0x194e682 } },
+		},
+		{
+			{ { 0x0bb4a19, 0x136f505, 0x1f1dbb8, 0x1e4c212, 0x066caf0, 0x0ca7169, 0x04feb9b, 0x1b20915, 0x0ef019b, 0x03d94c8 } },
+			{ { 0x3d2f773, 0x087dd30, 0x108bd3a, 0x0092e23, 0x3054151, 0x1b99e33, 0x32e747c, 0x10d8c49, 0x2ac5cd1, 0x0471792 } },
+			{ { 0x2fde0c6, 0x1b46c72, 0x2303a90, 0x118b1da, 0x13cff9b, 0x0f2939a, 0x05786fd, 0x0e54b35, 0x3dec330, 0x132af1e } },
+		},
+	},
+	{
+		{
+			{ { 0x378d289, 0x1de23cf, 0x1b3f811, 0x1650a02, 0x3f8c29c, 0x165cc9d, 0x3c5fe67, 0x0043e4e, 0x165acb2, 0x1fb9260 } },
+			{ { 0x09c0a2e, 0x1a58902, 0x0e70473, 0x001d7f2, 0x31d2313, 0x04fa12a, 0x1f6953b, 0x0b042fb, 0x30321c8, 0x18e6e4f } },
+			{ { 0x111a1c3, 0x14238e4, 0x2912f7a, 0x0a40483, 0x0acae43, 0x072fd19, 0x1576157, 0x054dcfa, 0x3c85b60, 0x03b7d24 } },
+		},
+		{
+			{ { 0x0764113, 0x1f134a1, 0x306acec, 0x1ffbfaf, 0x2824100, 0x0e6bede, 0x3e7fd65, 0x06d2391, 0x14d1dfa, 0x0130031 } },
+			{ { 0x19b5a68, 0x1205616, 0x041d5d9, 0x07f5d6f, 0x3a95d3c, 0x0b67f07, 0x20eba11, 0x1f689fc, 0x23019d4, 0x100ee4b } },
+			{ { 0x3465cf8, 0x08be062, 0x1ff09b8, 0x0d0a407, 0x1c683cd, 0x0c7d657, 0x05fd682, 0x0de95dd, 0x2ab2617, 0x0d56ec4 } },
+		},
+		{
+			{ { 0x28c7318, 0x076b1d6, 0x1423460, 0x0ed9e75, 0x3b6400e, 0x1ae3f2d, 0x3be5f9d, 0x1b1cde0, 0x38e052a, 0x1d463ab } },
+			{ { 0x093bbf4, 0x199331d, 0x21874e3, 0x0cf651d, 0x396f613, 0x005e785, 0x1e2867d, 0x062414d, 0x32182ec, 0x03e6e04 } },
+			{ { 0x37f6c32, 0x0167106, 0x2531491, 0x1e7a1c1, 0x03cb582, 0x1b1d1d9, 0x2d494e4, 0x0b88302, 0x1bbb175, 0x11f0e1c } },
+		},
+		{
+			{ { 0x05066b0, 0x1975432, 0x3361f7c, 0x1859d14, 0x18bb312, 0x01ae8e0, 0x3aa7522, 0x1abfca6, 0x2ce8d48, 0x023fa80 } },
+			{ { 0x1ec4f48, 0x114e5dc, 0x3adca28, 0x1ee4c62, 0x3e016c5, 0x1c3c66b, 0x1608d23, 0x13b9eec, 0x0576469, 0x002e26e } },
+			{ { 0x0deead0, 0x1775d9a, 0x3a47049, 0x1025b42, 0x3219114, 0x189d665, 0x267e6ae, 0x0a6f6a2, 0x274f75d, 0x11ce0a6 } },
+		},
+		{
+			{ { 0x13902c9, 0x054ceab, 0x311e47b, 0x077781a, 0x1930b77, 0x1e12fb4, 0x2b9c867, 0x07202a4, 0x0d44e4d, 0x1b19a2d } },
+			{ { 0x279c418, 0x0b69d51, 0x1be105a, 0x0c5930c, 0x398ef5f, 0x047eb0a, 0x3779256, 0x0d686ab, 0x0c4833c, 0x081e1a1 } },
+			{ { 0x278820c, 0x033c85e, 0x3d2e769, 0x1940939, 0x3dda82a, 0x08eed7b, 0x232d3c6, 0x067f52d, 0x054f8a4, 0x1d04698 } },
+		},
+		{
+			{ { 0x0b175b4, 0x0b94f46, 0x0204af3, 0x0cf9c95, 0x1a1c4c5, 0x0ef35f5, 0x2f65d0f, 0x131f08a, 0x32458c3, 0x07b26a1 } },
+			{ { 0x19dc86d, 0x1674cae, 0x222a9ac, 0x1ab01d7, 0x0113371, 0x0c2e488, 0x238966e, 0x09ff669, 0x34fb813, 0x1f04d95 } },
+			{ { 0x0a2509b, 0x1a93500, 0x056971c, 0x0105e44, 0x26e075c, 0x1957561, 0x3e64df8, 0x08c0afc, 0x25c7cd6, 0x0eb7622 } },
+		},
+		{
+			{ { 0x1393046, 0x0a63516, 0x33d90b8, 0x0c2ffb2, 0x23df8d6, 0x0f66e3a, 0x2511579, 0x0e403a5, 0x31a406a, 0x186e844 } },
+			{ { 0x235dcf2, 0x055dc2d, 0x3f79571, 0x167b360, 0x00b7fbd, 0x0b6d187, 0x181345f, 0x1ce90aa, 0x3ccc879, 0x09264a7 } },
+			{ { 0x2959029, 0x0283c45, 0x3b1347a, 0x165d3f5, 0x008edad, 0x0783307, 0x0ad1f13, 0x19cef7e, 0x0cbbd8e, 0x15880c4 } },
+		},
+		{
+			{ { 0x3e285d6, 0x1ad7d1d, 0x0326cc8, 0x13b647b, 0x103a3fd, 0x1b594dd, 0x23988d5, 0x189b4dd, 0x33658ce, 0x1fb211b } },
+			{ { 0x134d643, 0x064d0d2, 0x05eaa51, 0x0352891, 0x2e76fe0, 0x1f41c22, 0x2c3c7e1, 0x0e611ed, 0x2a4d9d9, 0x0dd9da8 } },
+			{ { 0x1a22ec7, 0x1a3cfc7, 0x1a2736b, 0x1bb600e, 0x04c3c75, 0x0989fb8, 0x247e7d1, 0x1baa429, 0x23399b9, 0x1b6abdc } },
+		},
+	},
+	{
+		{
+			{ { 0x0ad8ea2, 0x0c12feb, 0x1108b07, 0x140a45f, 0x0a6dd0f, 0x010c5db, 0x32c1d84, 0x1754563, 0x258eb3b, 0x0ad5127 } },
+			{ { 0x33dbe47, 0x09d58ba, 0x0170be7, 0x0a475ed, 0x3dfa8e1, 0x1747299, 0x1f298a2, 0x0aa2018, 0x271627d, 0x04c13a7 } },
+			{ { 0x2dc9cfe, 0x005349a, 0x3a16f13, 0x1fc5a46, 0x0f06eac, 0x179c60a, 0x3f0fffc, 0x0d27b41, 0x2d7c2dd, 0x111a378 } },
+		},
+		{
+			{ { 0x06307ce, 0x0b631be, 0x1850973, 0x18a1ae8, 0x08444d4, 0x17a772c, 0x03362b2, 0x06a5a95, 0x3e63247, 0x1769909 } },
+			{ { 0x019469e, 0x0cd57a5, 0x0ea8a37, 0x0611eee, 0x0cf9b71, 0x07f9962, 0x2db6b22, 0x1ac7274, 0x2ffb44b, 0x1b339f1 } },
+			{ { 0x2ac22ca, 0x131a237, 0x3ff0352, 0x1bddd70, 0x2e419bb, 0x159580f, 0x2c61c46, 0x1951115, 0x3fe79f2, 0x163ca6a } },
+		},
+		{
+			{ { 0x10ecdf6, 0x0992fdc, 0x127896b, 0x1c23161, 0x2c53394, 0x10b3ab9, 0x1e82b6a, 0x10e06c8, 0x24185b4, 0x1abe4dc } },
+			{ { 0x1e73e68, 0x1b3eae3, 0x2d4bd21, 0x0f9bbf3, 0x1500dbe, 0x0015982, 0x0ad85df, 0x1c6de09, 0x04a7f41, 0x15dd8a7 } },
+			{ { 0x1c6a888, 0x0009142, 0x12e6644, 0x09a5aac, 0x34b80d8, 0x033289f, 0x11b119e, 0x031f07c, 0x3b0caec, 0x1c07c96 } },
+		},
+		{
+			{ { 0x0bec113, 0x03db65f, 0x37c93a3, 0x133a5fe, 0x211281b, 0x04e60d6, 0x2da9156, 0x1ca241e, 0x0050955, 0x1c8296f } },
+			{ { 0x0616ced, 0x02c3e39, 0x10fb875, 0x074f12d, 0x3dc0198, 0x0bca59c, 0x1830ffa, 0x17d2c3c, 0x3fbdc40, 0x0b8324a } },
+			{ { 0x3805a35, 0x1c250e6, 0x17f8187, 0x1bb1215, 0x3a13a2c, 0x0229346, 0x20bf9ae, 0x01d8d22, 0x3b144ef, 0x03a6e72 } },
+		},
+		{
+			{ { 0x1b1beee, 0x1a6f557, 0x3f731bd, 0x1b85391, 0x3270eac, 0x068d791, 0x078df8e, 0x19bc895, 0x191cfd3, 0x0d9b510 } },
+			{ { 0x35720ad, 0x0b523fe, 0x1a1df77, 0x15edfc8, 0x3ba0645, 0x15543bf, 0x098a931, 0x17b1a90, 0x2b3f337, 0x0884413 } },
+			{ { 0x2bc8c14, 0x105d0fc, 0x18773c7, 0x1e5ac2b, 0x0bb689b, 0x0a7fb97, 0x0178734, 0x0489997, 0x26bc593, 0x1059e93 } },
+		},
+		{
+			{ { 0x0ce8fee, 0x189997e, 0x2c59857, 0x0a74406, 0x3a59ffc, 0x1364eee, 0x3373f17, 0x05ede25, 0x30cb7ed, 0x0d2cccd } },
+			{ { 0x2f62700, 0x0e74a1d, 0x11d6c87, 0x00073b3, 0x1747675, 0x1fc0684, 0x1a18190, 0x08d4369, 0x3e22552, 0x1e4e2ed } },
+			{ { 0x281d6cc, 0x1647ba1, 0x0ea79b8, 0x0e76c2d, 0x3380842, 0x0808883, 0x242e0ac, 0x0bc9dae, 0x2e2dfe6, 0x045dbf1 } },
+		},
+		{
+			{ { 0x1770eb8, 0x038a252, 0x0147b72, 0x15567a2, 0x263ef30, 0x0d7879b, 0x2a7ff6f, 0x0d6c426, 0x14f2690, 0x07da8f9 } },
+			{ { 0x39c619b, 0x1db3416, 0x0901695, 0x1a5952c, 0x0b77f27, 0x1e94dc4, 0x3d28175, 0x1e687a9, 0x0c677d5, 0x023f0e9 } },
+			{ { 0x30734ea, 0x1306674, 0x39acc14, 0x1b188b2, 0x1030216, 0x1598295, 0x19f11fb, 0x01a3c46, 0x0116b90, 0x13cbeb4 } },
+		},
+		{
+			{ { 0x33bb638, 0x136476d, 0x38112c5, 0x157e094, 0x39815de, 0x1b61689, 0x0cd9cf9, 0x1d02dec, 0x1f2944e, 0x0d14665 } },
+			{ { 0x0ae4e54, 0x1ac9065, 0x1ed8897, 0x088c2bf, 0x17d5071, 0x08d0498, 0x335969b, 0x0f574c3, 0x24972ef, 0x1115212 } },
+			{ { 0x3ea7d7c, 0x0bf3427, 0x39ed22a, 0x0a5849a, 0x12a05b2, 0x1285c40, 0x34d5523, 0x076e4b1, 0x2604289, 0x042e272 } },
+		},
+	},
+	{
+		{
+			{ { 0x245f06e, 0x0506f96, 0x3ecaea7, 0x16b6ce2, 0x341f2bb, 0x0ff51b6, 0x3b5ce39, 0x1b5222e, 0x19ef0d4, 0x05f4b47 } },
+			{ { 0x318289c, 0x051d265, 0x3e4c7ab, 0x0292299, 0x04bafe3, 0x0c3ef15, 0x15fe58a, 0x031c04c, 0x1577b75, 0x082e1e3 } },
+			{ { 0x33f3e6a, 0x0abc601, 0x20d24fe, 0x0ceba90, 0x3f4ff94, 0x0a60022, 0x1db961e, 0x0d4e45c, 0x23cc65c, 0x1c8853d } },
+		},
+		{
+			{ { 0x03b29c9, 0x16dee7d, 0x1eea3b3, 0x0527a8c, 0x3581609, 0x12f9dc4, 0x0395e98, 0x0b61e58, 0x055a154, 0x07c92b2 } },
+			{ { 0x307a693, 0x0dfd014, 0x0f2b69c, 0x0b9799b, 0x2ae9c53, 0x1761099, 0x1e853b9, 0x1793adf, 0x058171c, 0x17f7d23 } },
+			{ { 0x29505aa, 0x1820ca3, 0x01dc49a, 0x08860a1, 0x11d2307, 0x0fb25a2, 0x3f22e03, 0x0bcd8ff, 0x1e2ae39, 0x002e9ce } },
+		},
+		{
+			{ { 0x288bb26, 0x109bd7a, 0x37f75c8, 0x0cc24b9, 0x0d819e7, 0x0694e50, 0x3818613, 0x044cb93, 0x27d518d, 0x1c8a5f7 } },
+			{ { 0x08790d6, 0x1a63797, 0x05beb25, 0x09a2e15, 0x396fedf, 0x1b49922, 0x11db07c, 0x11e622b, 0x3e67ad7, 0x00ca0e8 } },
+			{ { 0x20cb939, 0x10771ef, 0x2100904, 0x06c5b19, 0x0cbc66d, 0x0289308, 0x3e48681, 0x128ba7b, 0x2846271, 0x01784a5 } },
+		},
+		{
+			{ { 0x02c4550, 0x1eef209, 0x03b35b7, 0x1668184, 0x2f32033, 0x1c8df92, 0x2b3537a, 0x1c99086, 0x138258c, 0x1e33c97 } },
+			{ { 0x19c495a, 0x0bbaccb, 0x32f9750, 0x1e7895d, 0x33bbf23, 0x1b5d1e0, 0x2d5d749, 0x1b37605, 0x1c13698, 0x0e70032 } },
+			{ { 0x1489d68, 0x19ae38c, 0x210e2b5, 0x15ce15f, 0x2aa1472, 0x04efa05, 0x3ad4bf8, 0x1065934, 0x076b3ff, 0x001ad48 } },
+		},
+		{
+			{ { 0x1ce082d, 0x0df85ae, 0x3853eb9, 0x0620bd5, 0x0d01fc5, 0x1f4a7ab, 0x1b5e715, 0x0b9da96, 0x161a9f7, 0x1f78ba5 } },
+			{ { 0x195781c, 0x033f867, 0x21c453c, 0x0c4b318, 0x2da077c, 0x0516b39, 0x39ce9b8, 0x0244afb, 0x043bc76, 0x1355f8d } },
+			{ { 0x2a55ecb, 0x0353d2d, 0x3733bce, 0x1faec2e, 0x1200549, 0x1ee9a81, 0x0e22069, 0x13dbb79, 0x2f1a602, 0x1acaa42 } },
+		},
+		{
+			{ { 0x3b2d80a, 0x0fcc916, 0x0f36efd, 0x0397dc8, 0x360c06d, 0x0ee7333, 0x3f37926, 0x02138c8, 0x08276c2, 0x119604b } },
+			{ { 0x2e61e97, 0x0fd3f26, 0x3fa2d24, 0x0ef01fa, 0x15cd4a0, 0x0edd12d, 0x25721f3, 0x1c954ec, 0x29d12d3, 0x17f63d3 } },
+			{ { 0x21062d9, 0x0efac8a, 0x382c9a8, 0x1a9c18e, 0x1c197ed, 0x02968d7, 0x2a53def, 0x0f20301, 0x2b1cb16, 0x016ccb0 } },
+		},
+		{
+			{ { 0x2d58195, 0x1290b1e, 0x2799eff, 0x172199f, 0x0c850a1, 0x00b979d, 0x14e869a, 0x0fc36d8, 0x0856730, 0x0c5dc69 } },
+			{ { 0x24da8fd, 0x017b334, 0x1f07918, 0x1602eff, 0x2873c6a, 0x1f9cd61, 0x377f93e, 0x1d33b77, 0x237b471, 0x0ed555a } },
+			{ { 0x14dd482, 0x0314938, 0x096c656, 0x0a0d15d, 0x3b6cd45, 0x02b5af3, 0x0b02414, 0x0dd747a, 0x127a733, 0x13f01e7 } },
+		},
+		{
+			{ { 0x086c50d, 0x122d103, 0x0ca3b86, 0x04e64a7, 0x04cdf2f, 0x03e3cb9, 0x17ba6b2, 0x1a10c84, 0x02bae3c, 0x09045c3 } },
+			{ { 0x1bf2f7f, 0x04e2c22, 0x134ea39, 0x12816ff, 0x0925ef5, 0x080e453, 0x3e04e3c, 0x1d25fff, 0x0ecaf98, 0x049159f } },
+			{ { 0x2c473b4, 0x06ae182, 0x086a7ff, 0x170089f, 0x3c24477, 0x1c6c4af, 0x3a83075, 0x001a95c, 0x166c870, 0x0fe184a } },
+		},
+	},
+	{
+		{
+			{ { 0x2048d13, 0x03f3e8d, 0x3bbb383, 0x19b9c4c, 0x0a45676, 0x192d0aa, 0x39a85cf, 0x13a9b93, 0x2e878a1, 0x09bd5fb } },
+			{ { 0x02a0dde, 0x083325e, 0x070aab3, 0x197538c, 0x1547736, 0x1ef238c, 0x1432d98, 0x027afec, 0x3679736, 0x1412a9d } },
+			{ { 0x287efb1, 0x0cb3555, 0x22f6195, 0x11123d7, 0x1460345, 0x15a2467, 0x0ad1a27, 0x00d30b8, 0x3d9dba3, 0x1010650 } },
+		},
+		{
+			{ { 0x26caadd, 0x05dd0e8, 0x2f9c964, 0x1232455, 0x11e9ad0, 0x1fbc9e3, 0x2a7bd01, 0x0033963, 0x029800d, 0x04b64c5 } },
+			{ { 0x3ebcc96, 0x03bae90, 0x395f878, 0x0e13754, 0x235d272, 0x077ccc6, 0x14af70e, 0x081fb3f, 0x1976843, 0x0508287 } },
+			{ { 0x337594f, 0x19de674, 0x08f6018, 0x00591d5, 0x178f145, 0x15ff395, 0x0142a71, 0x0024883, 0x314359a, 0x06d3e48 } },
+		},
+		{
+			{ { 0x09866b1, 0x1cc0c29, 0x10b2679, 0x0910afa, 0x0947dcf, 0x1def4f6, 0x1552028, 0x07ed570, 0x156f9a2, 0x17fc647 } },
+			{ { 0x1150951, 0x1042762, 0x12d47cb, 0x0896f4b, 0x0e73bea, 0x15f3020, 0x1721fcb, 0x1b5c41d, 0x2a7f132, 0x08e6d5c } },
+			{ { 0x02d9068, 0x1b50ceb, 0x0a47033, 0x1cafe4c, 0x0a20ead, 0x193eb3d, 0x2b9402a, 0x0d97de8, 0x2a758f3, 0x0083149 } },
+		},
+		{
+			{ { 0x042cc89, 0x07bd67c, 0x176dd26, 0x0ec7092, 0x0b16272, 0x0c75997, 0x070c557, 0x0a195b9, 0x0a5602c, 0x114b3f8 } },
+			{ { 0x2d8dbbc, 0x00d3e27, 0x08d8ef3, 0x1cee3e5, 0x323caab, 0x1e1b074, 0x1266e51, 0x10ef52a, 0x0615313, 0x00aab31 } },
+			{ { 0x07877df, 0x03de819, 0x393f0d4, 0x1387303, 0x2ef1190, 0x1fb11c9, 0x3f512f8, 0x0ef7562, 0x3b304b8, 0x133edf5 } },
+		},
+		{
+			{ { 0x389ef12, 0x1a670a5, 0x321bc50, 0x18efab8, 0x0adbb35, 0x0c970d0, 0x1e42bf6, 0x158b868, 0x3c434d3, 0x16c7532 } },
+			{ { 0x09b75fe, 0x10f5b2e, 0x3900e56, 0x0cce356, 0x1531a53, 0x0e34c9f, 0x1d51b9f, 0x06c9718, 0x2b39075, 0x052d188 } },
+			{ { 0x00a9f26, 0x0c98573, 0x19cb6df, 0x15dc46e, 0x0e93c38, 0x169a705, 0x0a4c599, 0x1ba2260, 0x1258592, 0x0be63dc } },
+		},
+		{
+			{ { 0x354a701, 0x0ab9113, 0x2fbc5c2, 0x1854e5e, 0x3f3f8fb, 0x1835de0, 0x3c486ba, 0x0aa99d7, 0x29e7614, 0x076018b } },
+			{ { 0x10f9e56, 0x129d32d, 0x2640192, 0x14c7470, 0x16c7fd2, 0x0300f67, 0x16610c1, 0x15f3345, 0x09d806a, 0x0e9ab89 } },
+			{ { 0x1907c5a, 0x0b6a16a, 0x1ec4caf, 0x1ac8dc8, 0x0683aa2, 0x134b4e9, 0x30efdef, 0x1fe71a1, 0x28aef25, 0x0a62e33 } },
+		},
+		{
+			{ { 0x22165de, 0x09cba82, 0x33ed06f, 0x1a05e7b, 0x0feac1e, 0x138ae70, 0x31b63bb, 0x0fb8a42, 0x1803a7d, 0x1ae989c } },
+			{ { 0x3f70cb2, 0x09e54fb, 0x20ec552, 0x153c8ab, 0x12e2724, 0x0a7cf6a, 0x022bd18, 0x090b283, 0x004d5ce, 0x0d2e2a1 } },
+			{ { 0x3693335, 0x1bb2d60, 0x3dfb84d, 0x0fb1daf, 0x356a04f, 0x0b22573, 0x1d54d52, 0x18d5452, 0x1d465e1, 0x1c758af } },
+		},
+		{
+			{ { 0x1f75ef5, 0x16d76ac, 0x0beb9a5, 0x078b583, 0x35dfe57, 0x149f085, 0x38ff51f, 0x167a28a, 0x21262b2, 0x070ccd8 } },
+			{ { 0x378df80, 0x0f30a34, 0x0968ca6, 0x1c8507d, 0x3db6d0d, 0x101da5a, 0x22ffcfb, 0x1749c6c, 0x17f3172, 0x1d357cc } },
+			{ { 0x3d9ca81, 0x1f95519, 0x186f50d, 0x1a9594c, 0x0e62df1, 0x1ac623b, 0x2844971, 0x1319b4d, 0x0547e9d, 0x12baf31 } },
+		},
+	},
+	{
+		{
+			{ { 0x354b610, 0x023679c, 0x36dc168, 0x09add42, 0x201acc9, 0x058a207, 0x31d01a5, 0x1e59b7c, 0x1dc9a1d, 0x05cef67 } },
+			{ { 0x36d01c9, 0x001c6c9, 0x18e025e, 0x02c3624, 0x39ee2eb, 0x1d6fba9, 0x0094db8, 0x0f24a61, 0x395a3db, 0x17623ef } },
+			{ { 0x25872df, 0x003c7bf, 0x318256a, 0x176a1c8, 0x1635960, 0x1673ae0, 0x293c764, 0x0633cdd, 0x13b19ea, 0x01b8734 } },
+		},
+		{
+			{ { 0x25b0353, 0x0ebd8a7, 0x088e8e5, 0x0813c68, 0x0eea82e, 0x043bf27, 0x02fa34b, 0x162618f, 0x1a8d837, 0x1fce9a8 } },
+			{ { 0x3166f23, 0x02b545b, 0x157c81a, 0x098fd5b, 0x04638ca, 0x04d088e, 0x1af0a50, 0x04cc7fc, 0x3526e16, 0x0c20180 } },
+			{ { 0x13d800b, 0x1910e57, 0x1bedefc, 0x0ae480f, 0x256a355, 0x12c6339, 0x2bc182c, 0x00fcd19, 0x2d2e513, 0x0c343f7 } },
+		},
+		{
+			{ { 0x0b84750, 0x125c79a, 0x379f396, 0x14b3325, 0x28255c8, 0x0fa412b, 0x2f39339, 0x13b2b91, 0x0351c58, 0x1185421 } },
+			{ { 0x21233b3, 0x05346bc, 0x1b39c0b, 0x0778662, 0x06f6f9e, 0x1499a77, 0x28c3fc7, 0x10d0d2c, 0x202c099, 0x02a4850 } },
+			{ { 0x2b9a02e, 0x006702b, 0x195d792, 0x068b01a, 0x1571c44, 0x19932ec, 0x2fa80b2, 0x1bfc1cd, 0x2895ca5, 0x0ef2834 } },
+		},
+		{
+			{ { 0x2cc01bf, 0x023ada7, 0x12df38d, 0x16d3224, 0x3c2f20e, 0x17a9fe2, 0x2caafaf, 0x0483945, 0x038df28, 0x13aa2d0 } },
+			{ { 0x05d62a4, 0x00c6f0f, 0x34c081e, 0x1f67f83, 0x067f22c, 0x10fb545, 0x01ed109, 0x079b303, 0x1dae8f1, 0x158c77b } },
+			{ { 0x1cad202, 0x15182bc, 0x1d0655d, 0x02d2467, 0x118c14c, 0x1f11a5f, 0x0bba2a4, 0x08c7224, 0x30542ca, 0x0933824 } },
+		},
+		{
+			{ { 0x1f30b85, 0x1e8557f, 0x1d487f9, 0x071b1b9, 0x34bdc5a, 0x092f844, 0x0326f32, 0x050165c, 0x27324f4, 0x15264a2 } },
+			{ { 0x106c106, 0x0243d7f, 0x21e43fd, 0x1aaec40, 0x2d711a0, 0x08caf3e, 0x0047f37, 0x0e9704f, 0x028a06d, 0x107538f } },
+			{ { 0x3ee1a2e, 0x18ca9d8, 0x3bd5e4d, 0x1be92ff, 0x2ba4792, 0x17f4d69, 0x1e99de8, 0x1ed5787, 0x1ec0dcf, 0x1246d9b } },
+		},
+		{
+			{ { 0x0da64a1, 0x012a3b4, 0x1096ebe, 0x17b3f11, 0x3b488b2, 0x17b7ba4, 0x251bc8f, 0x16cf046, 0x30b7018, 0x133dae2 } },
+			{ { 0x3ea32a7, 0x16c4f71, 0x373131e, 0x063f0b6, 0x38f57e3, 0x1f8d947, 0x15fa965, 0x0959581, 0x10c85ee, 0x023cce3 } },
+			{ { 0x11a73bd, 0x0ea0866, 0x18f5870, 0x00ef990, 0x2ac9ef0, 0x0777063, 0x2998dc2, 0x1533827, 0x02eb078, 0x14c352a } },
+		},
+		{
+			{ { 0x09abf9e, 0x05cd15b, 0x1100dad, 0x1e24805, 0x095fecb, 0x0cfb850, 0x27a0964, 0x1ab6575, 0x200cbfb, 0x036cf9f } },
+			{ { 0x1f94825, 0x10d8c38, 0x26b4009, 0x134655a, 0x1f8b5e0, 0x084ff8b, 0x01191e6, 0x01738e9, 0x3f10177, 0x197a9d4 } },
+			{ { 0x2096363, 0x1bf0fb8, 0x16d67ac, 0x1fb0dae, 0x20758b1, 0x1443b1a, 0x3022109, 0x03b61f7, 0x1921e1a, 0x00a93b0 } },
+		},
+		{
+			{ { 0x1cf795f, 0x01858bc, 0x2fe5eb9, 0x0c93772, 0x0463218, 0x0063578, 0x092428e, 0x1f9e2e4, 0x1dec067, 0x0db44ad } },
+			{ { 0x324b8a2, 0x189668e, 0x0170b9c, 0x0622d7d, 0x2e15deb, 0x1a07037, 0x1f37445, 0x137f999, 0x1112780, 0x0f450f1 } },
+			{ { 0x1154557, 0x149e45e, 0x341424d, 0x0e7e3c1, 0x357923d, 0x1179bac, 0x2db746f, 0x10b26d7, 0x085ba82, 0x0bbd45e } },
+		},
+	},
+	{
+		{
+			{ { 0x05b2f51, 0x1affecc, 0x2d712dd, 0x16c44ac, 0x34fe4e2, 0x0d5dd25, 0x296e3a3, 0x012be1e, 0x10bb3a0, 0x15e5a0a } },
+			{ { 0x058aedc, 0x1e5d3a3, 0x03488c6, 0x1dd5f82, 0x2e7bc8b, 0x180718a, 0x2ecab74, 0x114dc30, 0x3ab143a, 0x0bc6de3 } },
+			{ { 0x220e101, 0x0ae10c2, 0x188fee3, 0x0692787, 0x3ce4d96, 0x0e2eed1, 0x284d437, 0x07c39ee, 0x35dc2aa, 0x1f710f8 } },
+		},
+		{
+			{ { 0x33e9718, 0x00a9709, 0x3b28b4f, 0x0caf277, 0x0d5db1a, 0x1237d3e, 0x36c028f, 0x15321e5, 0x1d82d50, 0x0113ee0 } },
+			{ { 0x07dd9c3, 0x1999962, 0x26ab0b2, 0x18a5d82, 0x3243e6c, 0x12079b1, 0x046fc77, 0x025f8dc, 0x16758cc, 0x1fbdc80 } },
+			{ { 0x107e3d9, 0x1c6316a, 0x06b383b, 0x0ee7263, 0x15eccdc, 0x001bb49, 0x0229a59, 0x1a5d94e, 0x3f9c30d, 0x1fde608 } },
+		},
+		{
+			{ { 0x0f587ba, 0x107fc1a, 0x11bcd53, 0x0700286, 0x0209e25, 0x1ed5be7, 0x3ccaabe, 0x0de0797, 0x031c06d, 0x192a6c1 } },
+			{ { 0x3b513e8, 0x1348e68, 0x11b1066, 0x0a5c8fd, 0x304d9c3, 0x190bd33, 0x2a09b7a, 0x1368256, 0x33d784d, 0x029380d } },
+			{ { 0x37d2919, 0x0f5a856, 0x046a5d6, 0x106a9d4, 0x2c2d3da, 0x1a45d47, 0x36721c4, 0x08d8e2a, 0x0ace183, 0x01c69f4 } },
+		},
+		{
+			{ { 0x0e14431, 0x10d5488, 0x2283981, 0x0384d8a, 0x0359654, 0x09d5f36, 0x2b10d90, 0x0ba735e, 0x3761775, 0x1f1a6f3 } },
+			{ { 0x087ba0b, 0x1cb6ab2, 0x05dda60, 0x02dfd2b, 0x00498a4, 0x0ef768b, 0x2180160, 0x1d399ea, 0x3146ea7, 0x0b0ef31 } },
+			{ { 0x0e8295f, 0x035fac1, 0x26fa0fe, 0x1297a87, 0x0436c60, 0x11798d7, 0x0d4d18b, 0x0a3bd2a, 0x3322aca, 0x1bd6a69 } },
+		},
+		{
+			{ { 0x3d944be, 0x0753ae8, 0x1f3dce5, 0x00403c5, 0x2367825, 0x1869c03, 0x2ab3d23, 0x16488a4, 0x00ee8d3, 0x00aae5a } },
+			{ { 0x341c6c5, 0x040030b, 0x3737174, 0x00867f7, 0x3127de7, 0x0c51c9f, 0x123b81e, 0x1f949df, 0x22e147a, 0x1253886 } },
+			{ { 0x1e50d9a, 0x122a177, 0x0493df4, 0x0707dcd, 0x0866889, 0x11ef6d9, 0x08f8eec, 0x1669f41, 0x0bea46b, 0x1ad75db } },
+		},
+		{
+			{ { 0x2782522, 0x05045c7, 0x2da7c1f, 0x1a01b49, 0x3c79ab9, 0x0fcc746, 0x19f5168, 0x027c811, 0x1c03dd3, 0x05bee1a } },
+			{ { 0x00cd994, 0x1d55b3b, 0x3b7510a, 0x17ae680, 0x191cb71, 0x142b477, 0x0b48a47, 0x06a95e0, 0x3685277, 0x02b8ccf } },
+			{ { 0x3b60962, 0x18665cc, 0x0266511, 0x1a6c55f, 0x093f1ca, 0x191d03e, 0x0fbf684, 0x00ea902, 0x0b8f70d, 0x0fe078e } },
+		},
+		{
+			{ { 0x317c824, 0x0dfcd57, 0x334815b, 0x01eba14, 0x1d2e48f, 0x1f8eaf7, 0x21f45e5, 0x187baaf, 0x134cded, 0x02b4f8b } },
+			{ { 0x2d9affe, 0x043f31f, 0x0e96ff2, 0x109232c, 0x15172e2, 0x10c4704, 0x0bf6925, 0x1327507, 0x0104f50, 0x141443f } },
+			{ { 0x36e249d, 0x103f14c, 0x1fb2de1, 0x0ce198e, 0x1d17b78, 0x1eefe1c, 0x37e8004, 0x1d7de5a, 0x0bf0fa1, 0x049f056 } },
+		},
+		{
+			{ { 0x251b974, 0x0a3f12b, 0x3d2dbd4, 0x09ba26f, 0x07665cf, 0x13848a8, 0x03405c3, 0x1f2ac48, 0x39d167d, 0x13b6091 } },
+			{ { 0x29879a2, 0x05f108b, 0x2c8fec3, 0x0a29651, 0x2912b77, 0x14eaccb, 0x09fe0a5, 0x1ed1368, 0x3d07ef4, 0x0d53be1 } },
+			{ { 0x0c5d975, 0x0ed4898, 0x2171fdc, 0x1e75a0d, 0x140d4bb, 0x1f6653c, 0x0561854, 0x06db101, 0x1205392, 0x0c0b64b } },
+		},
+	},
+	{
+		{
+			{ { 0x0e0f177, 0x11bedb9, 0x15265b7, 0x14d25eb, 0x01386fc, 0x07af6e8, 0x0b36a3c, 0x00c0bc3, 0x1eb426d, 0x03b717d } },
+			{ { 0x0a4283d, 0x0f068af, 0x3bb2f02, 0x08d0c31, 0x3b58bc2, 0x068fa86, 0x3de5c61, 0x1c995d8, 0x376f1ca, 0x043974e } },
+			{ { 0x3da8e67, 0x0eff594, 0x2c82a8a, 0x161254f, 0x3a7707b, 0x1578a23, 0x3931d81, 0x14e57f0, 0x11361cb, 0x116d1b1 } },
+		},
+		{
+			{ { 0x27fe3e4, 0x1537762, 0x1c619d3, 0x0b3b310, 0x2ac4d91, 0x10e9958, 0x0a7bdd9, 0x13be96b, 0x2f32122, 0x170702b } },
+			{ { 0x14f7fa1, 0x00aafcc, 0x28a1528, 0x0e47467, 0x3895fc7, 0x1a8be84, 0x1eaa591, 0x02763b7, 0x236dcb7, 0x085defe } },
+			{ { 0x279db8f, 0x006ef3e, 0x33666e1, 0x0f612fa, 0x1812204, 0x0832487, 0x13b32ce, 0x0b7610f, 0x387d8ab, 0x12b9864 } },
+		},
+		{
+			{ { 0x05bfb83, 0x05f9126, 0x226cc22, 0x1538cb1, 0x3f38118, 0x025904b, 0x21a246a, 0x1ac9075, 0x3e5ba43, 0x1d5a16a } },
+			{ { 0x344a32e, 0x0fdaa94, 0x00f11bb, 0x1a5a0da, 0x1f623aa, 0x0130d60, 0x075cba5, 0x1c06bd6, 0x1b17bf3, 0x0680364 } },
+			{ { 0x361f2b2, 0x1824cfa, 0x12a4dd2, 0x1464ffa, 0x150f43e, 0x0f66569, 0x13a883d, 0x0d55bee, 0x3623b0e, 0x04d54a6 } },
+		},
+		{
+			{ { 0x22e83fe, 0x1c5af38, 0x0b83eb8, 0x0cf404c, 0x2d0afac, 0x0254aae, 0x2d31b8a, 0x0c27d93, 0x051590a, 0x165cba8 } },
+			{ { 0x1d1d518, 0x036f5eb, 0x3e2231e, 0x0467e08, 0x25e7de2, 0x114759b, 0x170f838, 0x14030e6, 0x1a65ca3, 0x1e6d6e0 } },
+			{ { 0x08f7811, 0x12b0837, 0x1f501fa, 0x0a5626a, 0x26a6b4a, 0x1360434, 0x196b259, 0x17b7803, 0x15905f3, 0x13dfa72 } },
+		},
+		{
+			{ { 0x15299fe, 0x0110f4d, 0x15aee39, 0x0e6df5f, 0x22f34ec, 0x1a49466, 0x124cf78, 0x1b91012, 0x04a144a, 0x0650bbb } },
+			{ { 0x381302e, 0x1d2ef15, 0x381ec4c, 0x1cc4d6e, 0x361483c, 0x1fbd9c6, 0x0ccd729, 0x1c99185, 0x192e638, 0x0c664eb } },
+			{ { 0x2234992, 0x114c66b, 0x3d24fb5, 0x0886751, 0x0b06cf6, 0x13c1122, 0x2724a12, 0x14eaaa7, 0x314ef9c, 0x0a82994 } },
+		},
+		{
+			{ { 0x01c793a, 0x186b34f, 0x38779e6, 0x162d1ad, 0x0be7af2, 0x0cda6ab, 0x03074d4, 0x1426c1d, 0x1b6dea1, 0x015770e } },
+			{ { 0x3f927c2, 0x1e4dffd, 0x0c6a5b6, 0x030be85, 0x36dd07c, 0x155af76, 0x179d108, 0x1bdab30, 0x18647c2, 0x133db88 } },
+			{ { 0x28d5bb6, 0x0489f30, 0x3f57623, 0x1e3ba6f, 0x01f893a, 0x0a32c89, 0x23c6772, 0x096d507, 0x3710aa2, 0x04868c1 } },
+		},
+		{
+			{ { 0x37483c9, 0x05c4fb1, 0x2d5facb, 0x1bdc15c, 0x222ff81, 0x097bcd3, 0x3141188, 0x1536513, 0x0a6ced3, 0x149eee5 } },
+			{ { 0x3034a97, 0x0d757a7, 0x385bc9b, 0x04981a5, 0x3854ff0, 0x151d3b1, 0x2a348ca, 0x0a5a8c0, 0x2c7a40e, 0x0ccff1d } },
+			{ { 0x15b482e, 0x1664aa6, 0x3002ac7, 0x1e371c1, 0x0d01741, 0x164d8e5, 0x01aef17, 0x13ee90a, 0x1b20a7a, 0x1ae241a } },
+		},
+		{
+			{ { 0x1c7db77, 0x0bea32d, 0x02aa810, 0x1c639a6, 0x01a1a1b, 0x0e7a57e, 0x3646cfb, 0x179e53c, 0x08a7639, 0x011cf4c } },
+			{ { 0x270220d, 0x0a81058, 0x369d025, 0x1d7c922, 0x2656a27, 0x072ef05, 0x2e26728, 0x16e7ff5, 0x03aa73e, 0x08ef084 } },
+			{ { 0x3589e05, 0x19e4980, 0x092595d, 0x09236e6, 0x0ad2d08, 0x001a94f, 0x0f7ba73, 0x0834054, 0x3fde043, 0x040bdce } },
+		},
+	},
+	{
+		{
+			{ { 0x1511c9a, 0x136b82d, 0x3e0d456, 0x1495fff, 0x1eb2180, 0x1504234, 0x39baefa, 0x025b303, 0x25da4ea, 0x0fdaf5c } },
+			{ { 0x35745c6, 0x02e6adf, 0x0d21d63, 0x172bc3e, 0x008ea2b, 0x1f7afa9, 0x3896d16, 0x027b6e4, 0x25ea5c0, 0x0d965f4 } },
+			{ { 0x06058ac, 0x1635ec4, 0x20bee69, 0x0f37e34, 0x365015e, 0x002932d, 0x37c7cc9, 0x0da0c8c, 0x19da60d, 0x1edfb30 } },
+		},
+		{
+			{ { 0x37cfa9b, 0x1929469, 0x0ca0db5, 0x0a73d1c, 0x20898d9, 0x12d82db, 0x1ffe6c7, 0x1574137, 0x261bf5c, 0x00efb71 } },
+			{ { 0x15c690d, 0x08dcf1a, 0x20dcf18, 0x1303214, 0x37494b9, 0x0e12bd2, 0x2a22225, 0x12ad2a3, 0x3601743, 0x108d6b5 } },
+			{ { 0x38975f5, 0x032c341, 0x2530c4b, 0x0a48c4f, 0x124a509, 0x0e36ee4, 0x15a11f1, 0x0d43419, 0x30cdf06, 0x039f38a } },
+		},
+		{
+			{ { 0x14b70f9, 0x1bfb7f6, 0x345bfd4, 0x08e0fe5, 0x3c4c301, 0x12fab89, 0x16a3f3f, 0x1d6a910, 0x138aece, 0x1854958 } },
+			{ { 0x08c85a3, 0x1190eb1, 0x335b892, 0x1a1e309, 0x3f4d877, 0x0e94d48, 0x18bee9d, 0x0e9413b, 0x1d8fb46, 0x199b829 } },
+			{ { 0x070cb0d, 0x0fd9392, 0x16d6557, 0x185522c, 0x33596f3, 0x1e8985d, 0x3275d3a, 0x1dc9357, 0x10d514d, 0x1fc2f20 } },
+		},
+		{
+			{ { 0x37213a0, 0x1276b5c, 0x1d31075, 0x1d177b9, 0x27fdbe2, 0x1ec6957, 0x3176ea1, 0x16ea623, 0x3ddec5a, 0x074ea41 } },
+			{ { 0x2f4136f, 0x01ae909, 0x206b720, 0x0f2bf01, 0x2359cda, 0x1463c28, 0x06feca7, 0x17eb979, 0x3cf8eed, 0x0347e36 } },
+			{ { 0x2d081dc, 0x1a4cc4f, 0x2901742, 0x16c28d9, 0x0a4ca7e, 0x10321cb, 0x0009e01, 0x1bc6025, 0x04a31bf, 0x000046d } },
+		},
+		{
+			{ { 0x20aa75c, 0x187da5a, 0x3ad42ca, 0x0e2c295, 0x306fdc9, 0x07966ad, 0x06ebfcd, 0x004c235, 0x22d2851, 0x18f6622 } },
+			{ { 0x3c66c0c, 0x1e81b0f, 0x1ba47fb, 0x0726eb0, 0x175038e, 0x08e4d71, 0x1c59c13, 0x0fc2f5c, 0x116e835, 0x0eb1236 } },
+			{ { 0x3bd232e, 0x081d4eb, 0x2d06002, 0x1c7eec7, 0x3a4af3a, 0x0e72b91, 0x334d9c2, 0x00cdf02, 0x2b2368a, 0x0cfeb54 } },
+		},
+		{
+			{ { 0x022cfe8, 0x1323431, 0x35971a5, 0x1d82d09, 0x01cad3d, 0x0f6a56f, 0x35b7376, 0x03c547f, 0x0cb90a7, 0x0f30d57 } },
+			{ { 0x1e41e16, 0x19271b1, 0x2e6aa80, 0x18199fb, 0x02be190, 0x105e746, 0x27e6979, 0x194f655, 0x29a256d, 0x05b03d0 } },
+			{ { 0x03e9131, 0x1a510e4, 0x2f9dd36, 0x05bd2b1, 0x2e29253, 0x0ba9244, 0x268d25d, 0x0ad190f, 0x026bae7, 0x18c7abd } },
+		},
+		{
+			{ { 0x3700de8, 0x05d6e68, 0x0aa48fb, 0x1df17c0, 0x1ca0317, 0x0e45de1, 0x2c79399, 0x016aa6c, 0x3f665f8, 0x10c7cb1 } },
+			{ { 0x266fe9f, 0x0410436, 0x0b4d67d, 0x09360b7, 0x217752d, 0x0f9bf83, 0x2cbb08f, 0x136b787, 0x0b1ea91, 0x1566592 } },
+			{ { 0x18f7b19, 0x098d121, 0x2295ac0, 0x17d0f52, 0x052acd4, 0x090a9d7, 0x0220d10, 0x164d120, 0x1f91253, 0x1ec11c5 } },
+		},
+		{
+			{ { 0x0e6bac6, 0x1b0a031, 0x361766e, 0x0eb68ec, 0x25c3b4f, 0x10bf944, 0x14aac22, 0x0447613, 0x3a57cde, 0x12342b3 } },
+			{ { 0x0f6ae43, 0x16f4a2b, 0x356907d, 0x05beae3, 0x218d5f2, 0x1eb2c44, 0x023b4db, 0x107f808, 0x35c2f65, 0x166cdef } },
+			{ { 0x1abe671, 0x1c9b91f, 0x346f6c1, 0x0bb1179, 0x3c74686, 0x1960394, 0x0673f74, 0x17b6841, 0x11336d3, 0x0588d06 } },
+		},
+	},
+	{
+		{
+			{ { 0x3f38640, 0x0673587, 0x0b41ba9, 0x01831b1, 0x0a7366f, 0x1d73dc3, 0x16c011e, 0x0462a3c, 0x3a203b9, 0x12895c1 } },
+			{ { 0x2267ff6, 0x12677bd, 0x108773c, 0x1dba160, 0x1ddcb29, 0x1a4f2b1, 0x00a9ff4, 0x000c474, 0x2cd5d05, 0x0b37f7f } },
+			{ { 0x3f6ed6a, 0x1d9a294, 0x2142556, 0x0c0ee8b, 0x0c10909, 0x0e20161, 0x00a261d, 0x13f8800, 0x2d248e4, 0x15c8625 } },
+		},
+		{
+			{ { 0x1d0da4e, 0x1542468, 0x3c1050b, 0x13daff1, 0x12ea9be, 0x19393b3, 0x28bbe70, 0x01fac7c, 0x2fc4b03, 0x00f24d6 } },
+			{ { 0x1181bae, 0x19545ff, 0x076816d, 0x0f95dcb, 0x240898a, 0x0064625, 0x0de7499, 0x07b4aa1, 0x34f63c1, 0x15e3b75 } },
+			{ { 0x12b0c3d, 0x09db192, 0x0bf932e, 0x026ff10, 0x11f330b, 0x1623a3c, 0x14dc26e, 0x0f45b9a, 0x190288c, 0x0fb0aad } },
+		},
+		{
+			{ { 0x232d1cb, 0x04e826b, 0x05ab4e4, 0x0fa07ae, 0x03cae1f, 0x01eab29, 0x3526374, 0x18bc175, 0x2c6adba, 0x0386fd9 } },
+			{ { 0x0d87bb9, 0x0349ef9, 0x35db434, 0x15b09c8, 0x2a62d37, 0x1cb9b83, 0x06ee839, 0x159d334, 0x1a200fc, 0x0b75709 } },
+			{ { 0x12c887e, 0x0f57a5e, 0x1abbc55, 0x0c65c93, 0x0680800, 0x0ae5f1e, 0x134e6dd, 0x1ebf7f7, 0x335ae88, 0x1cc1522 } },
+		},
+		{
+			{ { 0x1d6e334, 0x0c252e8, 0x3e3300b, 0x1b849a9, 0x2fcfbc5, 0x022702b, 0x3836583, 0x0bba847, 0x37d8784, 0x1616889 } },
+			{ { 0x3a8b8ee, 0x15468f2, 0x3e2d886, 0x0ed908a, 0x19689bc, 0x18c3850, 0x3a7a955, 0x1194ec1, 0x3b411db, 0x0c10d10 } },
+			{ { 0x3d48962, 0x097e08c, 0x0aff431, 0x1af63c1, 0x19a6312, 0x13e41ff, 0x337d29b, 0x103f4f1, 0x0950ef9, 0x1d9589e } },
+		},
+		{
+			{ { 0x286cf9d, 0x01ce8fa, 0x3fb9c2e, 0x1b838aa, 0x0ea33ee, 0x1838a8e, 0x1f3fe18, 0x0c2c90a, 0x04b613f, 0x0a2efd2 } },
+			{ { 0x11fc8c0, 0x0f3d675, 0x2de4718, 0x1e82835, 0x26fb74b, 0x1570e8f, 0x3884fd5, 0x0d4c4d7, 0x28c1b84, 0x0fd0582 } },
+			{ { 0x3136c7c, 0x04bd71b, 0x237de4c, 0x03fb6e8, 0x2bfab44, 0x1de6f33, 0x34d6909, 0x0ebaa4f, 0x358188f, 0x079e72c } },
+		},
+		{
+			{ { 0x1e08181, 0x054f63d, 0x3db2efd, 0x0214cee, 0x2129431, 0x04525e5, 0x2168643, 0x05e9b8d, 0x2d39d1f, 0x11e2ad4 } },
+			{ { 0x2f7e3f1, 0x10db0fb, 0x21f0026, 0x1fff4f0, 0x20a2da9, 0x0f9defc, 0x08472de, 0x1062fff, 0x1b3a3b3, 0x1975e54 } },
+			{ { 0x252d159, 0x1a934e4, 0x100ecd4, 0x1e438d6, 0x3977786, 0x0c1c96f, 0x235a053, 0x0429705, 0x011a212, 0x05b61e9 } },
+		},
+		{
+			{ { 0x14e0583, 0x13578b5, 0x33f5f74, 0x0b975ec, 0x3887ebf, 0x0e9778f, 0x16139b7, 0x1bbc92f, 0x177a5a6, 0x07e642d } },
+			{ { 0x2066215, 0x15f9690, 0x0983677, 0x06862d1, 0x21e6f8f, 0x0f994b7, 0x02ed8eb, 0x194caf8, 0x0165f38, 0x0a3e1f2 } },
+			{ { 0x3e8f7d6, 0x113ab46, 0x331f466, 0x15d6753, 0x1f47943, 0x00de052, 0x32b4f29, 0x1a7cef8, 0x21534d6, 0x11620bf } },
+		},
+		{
+			{ { 0x03c6fe4, 0x1264a65, 0x2545b15, 0x10d1c1c, 0x2d7e7c5, 0x0c89af3, 0x0ed89df, 0x00e84d3, 0x3ce405f, 0x1f73e10 } },
+			{ { 0x17983d6, 0x04d175d, 0x234cccd, 0x088bd50, 0x18adbb4, 0x05e128f, 0x28c2bcc, 0x0dbafbb, 0x38f626f, 0x1a23f96 } },
+			{ { 0x24732c0, 0x0359212, 0x2532d92, 0x1ee52b1, 0x354850f, 0x15dc6e1, 0x31461c8, 0x1237677, 0x3e73271, 0x19ce5a1 } },
+		},
+	},
+	{
+		{
+			{ { 0x00c1ac0, 0x1732772, 0x086d4cd, 0x1a0d9c5, 0x25e8173, 0x1dbd7c6, 0x1f9df4a, 0x1b574fd, 0x368d7e7, 0x1f682e3 } },
+			{ { 0x05675a6, 0x008050e, 0x13d1def, 0x18557ed, 0x289927c, 0x0dfa8cb, 0x0f5a82e, 0x016699a, 0x3a1d4dc, 0x118456a } },
+			{ { 0x3b5da76, 0x1c654f0, 0x3d37a81, 0x199088c, 0x076b1bd, 0x0b25960, 0x23010ff, 0x1696079, 0x3e83674, 0x1697e21 } },
+		},
+		{
+			{ { 0x0a643b9, 0x18a34e8, 0x00c93d2, 0x0073619, 0x2d70f2c, 0x02dec32, 0x18144be, 0x0e1936a, 0x22d5d1c, 0x10f8deb } },
+			{ { 0x0a13d11, 0x0c073dc, 0x21891ec, 0x0a9a86e, 0x33f3ae0, 0x0bca47e, 0x14bea52, 0x0869ee0, 0x16e44d1, 0x0d9a6d9 } },
+			{ { 0x1a6e133, 0x18fc1bb, 0x358070f, 0x08ccd09, 0x19cc075, 0x0263811, 0x16c7c1b, 0x137d7ab, 0x0d4fd5e, 0x1a8879b } },
+		},
+		{
+			{ { 0x299b2e3, 0x04a4499, 0x2603de8, 0x03b8468, 0x1c74c21, 0x182b0bd, 0x2196808, 0x166c64a, 0x07001e8, 0x114dc6c } },
+			{ { 0x046e65f, 0x185c28c, 0x2a49e38, 0x1500691, 0x161c4a8, 0x082b755, 0x1de9e46, 0x1eaed3b, 0x31a195f, 0x161afe7 } },
+			{ { 0x2f8790b, 0x0c22357, 0x2fcb4db, 0x0e30849, 0x149e3c3, 0x1a16eb8, 0x1a4e930, 0x02f3580, 0x3790e52, 0x03abec0 } },
+		},
+		{
+			{ { 0x375ae1d, 0x0201783, 0x1860a28, 0x1193316, 0x3b00bef, 0x092396d, 0x1ef8f75, 0x176659d, 0x04c5435, 0x112b8cd } },
+			{ { 0x348042f, 0x155704d, 0x14232c0, 0x134105d, 0x0866907, 0x1486d0c, 0x0fb9c39, 0x0cc2390, 0x275a02c, 0x0c26b31 } },
+			{ { 0x3a543ee, 0x0a26e6e, 0x228539e, 0x0ead64b, 0x3cdd83a, 0x19360aa, 0x172e327, 0x0f1e3b0, 0x1b7f946, 0x18b5488 } },
+		},
+		{
+			{ { 0x2f77a3c, 0x175098e, 0x289aeb0, 0x08ff748, 0x37eb9ec, 0x1f7193d, 0x338402c, 0x006f4a0, 0x1383922, 0x053ca69 } },
+			{ { 0x0d0936d, 0x10a6706, 0x3418a49, 0x1645060, 0x321aed5, 0x14a8631, 0x282976d, 0x0ac546e, 0x24bc754, 0x1703bf7 } },
+			{ { 0x1b2d7f5, 0x05fb709, 0x2081bee, 0x0dccda9, 0x087e5c3, 0x1ed4c62, 0x11a5be1, 0x127db52, 0x1c7bee0, 0x179c8d9 } },
+		},
+		{
+			{ { 0x308b33e, 0x0ce418b, 0x257cfb2, 0x12efcf9, 0x16e5967, 0x19ebdfd, 0x39ed68f, 0x136f59f, 0x15cb734, 0x1c2c815 } },
+			{ { 0x171217f, 0x0ff01d1, 0x32b6aeb, 0x0e834a6, 0x0dde59d, 0x0191e33, 0x11bddfa, 0x1579341, 0x0c47b4e, 0x1dfc441 } },
+			{ { 0x1112c4c, 0x044f155, 0x3f9b7ca, 0x1d4d440, 0x19a2108, 0x0503b47, 0x33bc2af, 0x009488c, 0x0f4a064, 0x038d0e6 } },
+		},
+		{
+			{ { 0x24b1928, 0x0c2c24f, 0x2c80312, 0x0739f9f, 0x1f78f84, 0x1395d6f, 0x10bed39, 0x187de86, 0x16ca379, 0x1be2b7b } },
+			{ { 0x2cebde8, 0x148b64f, 0x1e0f6cf, 0x0093c11, 0x026cfa1, 0x05b6d8d, 0x3d30fd8, 0x06e4e87, 0x368a362, 0x1795014 } },
+			{ { 0x1b7b29a, 0x0048f7f, 0x2523c68, 0x10d10d5, 0x121ee5f, 0x1e6949e, 0x33e817e, 0x1d2ff32, 0x2ec8d3d, 0x1e0379c } },
+		},
+		{
+			{ { 0x0f42772, 0x1fabcc0, 0x0354ce3, 0x1515462, 0x23dcbac, 0x1373292, 0x0bfebcb, 0x0f4c534, 0x2d32b58, 0x077bf1a } },
+			{ { 0x09ae7bc, 0x0a15142, 0x1a0c15c, 0x078e3fa, 0x0e2377b, 0x04811b8, 0x20aa885, 0x19c8715, 0x3671928, 0x03aca2f } },
+			{ { 0x35195a7, 0x0ef86bb, 0x2bdb5eb, 0x1bc8bd8, 0x0523049, 0x0e5da2e, 0x0fbfdbd, 0x10ce532, 0x1bf8dd2, 0x119f480 } },
+		},
+	},
+	{
+		{
+			{ { 0x27ae7a9, 0x1bd2f55, 0x317b783, 0x196b224, 0x0fd8932, 0x01f4ec8, 0x0326916, 0x0003c82, 0x25ba384, 0x0bbe716 } },
+			{ { 0x0ef4fad, 0x1a4669d, 0x11452bf, 0x167b518, 0x0ea09ef, 0x1a47b01, 0x300e984, 0x0f2f2c9, 0x0f5ba3c, 0x1c710f1 } },
+			{ { 0x29e74cd, 0x15b7dbe, 0x0cf56df, 0x1e72579, 0x3c609e2, 0x1ef990e, 0x2d9e878, 0x052704a, 0x2390c5f, 0x169d632 } },
+		},
+		{
+			{ { 0x161dc94, 0x02462c7, 0x20cd19c, 0x034d409, 0x237b4d9, 0x1e8aad3, 0x35414d7, 0x087fa9c, 0x27f639d, 0x029ce00 } },
+			{ { 0x1462495, 0x1c9c436, 0x2007456, 0x096abea, 0x0eaa31b, 0x0b487ca, 0x2005fd0, 0x05d9c7a, 0x04b3eb7, 0x0b6eb89 } },
+			{ { 0x3ffe1cc, 0x1d28bd5, 0x3087301, 0x06f0c1c, 0x0019c34, 0x1fb15fd, 0x21fa524, 0x0d3820b, 0x235126a, 0x09a6329 } },
+		},
+		{
+			{ { 0x23dd90e, 0x15c0bd7, 0x270c5c7, 0x0c72692, 0x278fc24, 0x04da96a, 0x39f7b01, 0x0664bce, 0x0c4afa3, 0x0f0012c } },
+			{ { 0x2b0ba78, 0x14c620c, 0x3f17cec, 0x1bc92e7, 0x0e060c7, 0x0291fcc, 0x00dc8d0, 0x160e115, 0x0c49cae, 0x07ed0f7 } },
+			{ { 0x2f4b82b, 0x051ab01, 0x09e7355, 0x12d4036, 0x0728a12, 0x0cd4787, 0x1932fe3, 0x042e7da, 0x01cd1fd, 0x1ad0ff4 } },
+		},
+		{
+			{ { 0x2760ef3, 0x1d0960f, 0x33216b8, 0x1cf7055, 0x1d7714a, 0x12b923f, 0x213e103, 0x13e17e2, 0x2d6ff0d, 0x1cd082c } },
+			{ { 0x297c544, 0x1d752d1, 0x3f7f8f4, 0x046f87f, 0x057f7e1, 0x046785a, 0x05cf5d5, 0x0e2850d, 0x105b52f, 0x169a35c } },
+			{ { 0x2851e06, 0x13db2e7, 0x31895e5, 0x09e3111, 0x23d64e4, 0x1fbf373, 0x15c4b4c, 0x193db51, 0x2fea34b, 0x0f6d58c } },
+		},
+		{
+			{ { 0x29825d5, 0x0642c60, 0x13225c9, 0x039f4d4, 0x3b7abae, 0x0704af8, 0x01e9ca6, 0x161ddde, 0x2495df2, 0x16465fa } },
+			{ { 0x35dd9d8, 0x1bb8afd, 0x334be8d, 0x1b1cb3a, 0x0345ec7, 0x19e7273, 0x16898a4, 0x1e2637e, 0x1f49d75, 0x010c86b } },
+			{ { 0x0e55aae, 0x0580679, 0x25d209c, 0x1d3f17c, 0x39ded0d, 0x1159aa4, 0x316e0b7, 0x19818f9, 0x01f4d70, 0x117abf7 } },
+		},
+		{
+			{ { 0x3ccb1ed, 0x1918933, 0x072b6c1, 0x095eae0, 0x1676f0a, 0x00481c9, 0x04e8eee, 0x1280634, 0x2a5d56d, 0x0fdcf3b } },
+			{ { 0x045d72b, 0x1006160, 0x0ca2d30, 0x1167978, 0x1308bea, 0x1222dc6, 0x11b32b5, 0x15bd283, 0x080362d, 0x1697baf } },
+			{ { 0x24e8dc6, 0x1eff442, 0x26736f4, 0x1f2264d, 0x2f95c01, 0x157aefa, 0x0903f8a, 0x11b6c18, 0x1126621, 0x0981622 } },
+		},
+		{
+			{ { 0x276e542, 0x0638f31, 0x195a990, 0x0981e76, 0x17908b2, 0x0129f08, 0x3e6655a, 0x0771d80, 0x10b2444, 0x037b7e8 } },
+			{ { 0x360ff04, 0x1c129a0, 0x0de8b3e, 0x0f3b30f, 0x30f64ff, 0x0873551, 0x1953989, 0x1aaf063, 0x2e4e615, 0x152b430 } },
+			{ { 0x02b522a, 0x0d9f56e, 0x03d7dc7, 0x034fd2e, 0x0dbc58d, 0x0c19fd3, 0x2697937, 0x08114b6, 0x3aa77a9, 0x18bb2ca } },
+		},
+		{
+			{ { 0x3b62874, 0x1ca0dab, 0x094b240, 0x02bcf08, 0x17f357a, 0x030a14a, 0x280d6e3, 0x1f30b55, 0x1075663, 0x18644f5 } },
+			{ { 0x1152b3d, 0x15e5498, 0x2fa3cbd, 0x1e876ee, 0x12588d5, 0x16b4c71, 0x164685c, 0x117ce90, 0x19a966d, 0x0b967e4 } },
+			{ { 0x23231da, 0x18b4d86, 0x04e01b8, 0x194a100, 0x3e91d60, 0x19594ce, 0x000a89f, 0x1ab805b, 0x2131c05, 0x0f76f0a } },
+		},
+	},
+	{
+		{
+			{ { 0x396bb14, 0x095e889, 0x3443e75, 0x1bcd83e, 0x220eaea, 0x1a0391c, 0x1f10c18, 0x0bf3ca9, 0x38d8320, 0x17b9fec } },
+			{ { 0x25ec54b, 0x103fe73, 0x261b35b, 0x15c6178, 0x00e70a9, 0x0f89515, 0x003e3f8, 0x06d6050, 0x14ac04b, 0x1e25a0c } },
+			{ { 0x1446a8e, 0x17f72d0, 0x2ff2a71, 0x14a1a49, 0x296b3f6, 0x03c8c78, 0x3c84693, 0x1a128d5, 0x3c9bca0, 0x187418c } },
+		},
+		{
+			{ { 0x0fc73df, 0x0ca2f3e, 0x2ff95b4, 0x0ed3781, 0x3ba11a5, 0x0c2a909, 0x3da6d9c, 0x17b8c6f, 0x2df8067, 0x16c8eb0 } },
+			{ { 0x3db2566, 0x1124d7f, 0x1176c6e, 0x04bc05b, 0x316f5ae, 0x13eec03, 0x199402a, 0x0feade3, 0x1847aed, 0x1ba597f } },
+			{ { 0x280527b, 0x0ae54fb, 0x1b1b35a, 0x157d6f3, 0x3a23c66, 0x10e82cf, 0x08b820a, 0x1db81ce, 0x39dd95d, 0x1e6e6ee } },
+		},
+		{
+			{ { 0x29f7374, 0x05f6ba3, 0x102da33, 0x1c67dd8, 0x280ca8b, 0x1445f0a, 0x25d0936, 0x10699ad, 0x060accb, 0x06ea045 } },
+			{ { 0x23126c2, 0x0d5501a, 0x0727d76, 0x1434646, 0x3498e0e, 0x1b97a82, 0x23214f2, 0x028ed81, 0x18c9fd2, 0x14197c5 } },
+			{ { 0x0429954, 0x05a7ec3, 0x1ecee10, 0x166bb76, 0x3851802, 0x0e645ba, 0x15cc538, 0x15e45d5, 0x1e58a4f, 0x0e607ce } },
+		},
+		{
+			{ { 0x1e66fde, 0x177e95b, 0x1075908, 0x0016202, 0x3854a94, 0x1b4f632, 0x170b1e3, 0x16cbd3a, 0x2edcbc1, 0x0c3d114 } },
+			{ { 0x1230a93, 0x0e29d56, 0x28ba31f, 0x14b0737, 0x0745a3d, 0x0a93cb5, 0x2d4a28a, 0x01fa750, 0x3705acd, 0x0e37020 } },
+			{ { 0x1759740, 0x149e0b1, 0x3d990ad, 0x14fcce5, 0x3e84d15, 0x0ea4e71, 0x27e39e0, 0x08d3108, 0x1a593f2, 0x18cb668 } },
+		},
+		{
+			{ { 0x10c84a7, 0x07f447b, 0x12757e1, 0x0086cfb, 0x18fc1c6, 0x1cf8779, 0x04616ab, 0x1744432, 0x328af64, 0x0e969f7 } },
+			{ { 0x007cba6, 0x0dac56e, 0x21afed7, 0x0fde2a7, 0x0608f1f, 0x029670b, 0x2cb81b7, 0x14af763, 0x0847ed4, 0x02c93d2 } },
+			{ { 0x11beac7, 0x0b52f94, 0x19e5b9b, 0x1af6936, 0x2914e01, 0x05f9a65, 0x27fcf80, 0x1ec7c33, 0x0475481, 0x0d3f3dd } },
+		},
+		{
+			{ { 0x0cfaa98, 0x0c76ade, 0x25e54b7, 0x138c85b, 0x173b689, 0x092608e, 0x0e48885, 0x0961261, 0x042fb37, 0x004668c } },
+			{ { 0x09767ca, 0x1f8131e, 0x0cfb832, 0x059c6ca, 0x2e1c537, 0x1f95fa8, 0x3444141, 0x07eeabb, 0x164dfa6, 0x0f4ef70 } },
+			{ { 0x0c2177d, 0x0b6273a, 0x2182cf4, 0x1b344ae, 0x19a7697, 0x082a2b0, 0x2cc72d9, 0x14e7eac, 0x31ede20, 0x15b0223 } },
+		},
+		{
+			{ { 0x0f38f02, 0x0d7eb09, 0x197ab03, 0x1f5d718, 0x2a42fa7, 0x0cf92f0, 0x0b48145, 0x071f344, 0x2483590, 0x00e2dfa } },
+			{ { 0x0a86e17, 0x14f4444, 0x25f466d, 0x1905bad, 0x35fce20, 0x1072988, 0x299bb12, 0x170ff22, 0x2b99108, 0x0259d31 } },
+			{ { 0x1316ff8, 0x1be0866, 0x1a9f3e9, 0x017553c, 0x0bd274a, 0x0ef3174, 0x0d2d5ad, 0x16ca12e, 0x025969e, 0x1b978c4 } },
+		},
+		{
+			{ { 0x3066222, 0x13ec398, 0x347e660, 0x04c3d65, 0x3ecd41a, 0x01061a3, 0x0923bc6, 0x0c417a3, 0x03d1838, 0x0c162b5 } },
+			{ { 0x3e593fb, 0x118bd61, 0x3ce362d, 0x0f652e9, 0x12667b7, 0x0cc3e6d, 0x0e0f00a, 0x1751692, 0x0789a8d, 0x023d445 } },
+			{ { 0x17663d0, 0x103ff79, 0x0c20647, 0x1c51175, 0x0170f7c, 0x0994f9a, 0x3c55ed6, 0x19337b8, 0x24efe3d, 0x099527e } },
+		},
+	},
+	{
+		{
+			{ { 0x33f666e, 0x1a1526b, 0x1d4bb68, 0x0278a50, 0x35dff3c, 0x0ba0c47, 0x11ffbd2, 0x190a7be, 0x2132ce3, 0x0e8437f } },
+			{ { 0x26bf9d6, 0x1569187, 0x0b02e83, 0x1e3bbbd, 0x08c16cf, 0x074d3d9, 0x2ba5132, 0x01ffa8a, 0x1c6401e, 0x0649b87 } },
+			{ { 0x217cea0, 0x1d3a2ba, 0x03fbc0f, 0x031d0fe, 0x0bf5455, 0x1f2c0f1, 0x1917e98, 0x1a2a2ea, 0x1d861e5, 0x07e8740 } },
+		},
+		{
+			{ { 0x1df94ab, 0x12b0034, 0x1bd271b, 0x0ee8840, 0x0b9c4af, 0x1d5e262, 0x1f49f7e, 0x03cafe2, 0x18ee9a0, 0x1cff3b4 } },
+			{ { 0x1599832, 0x015651f, 0x2a41990, 0x0d1bf8a, 0x079195b, 0x0059320, 0x37bba27, 0x1e6733e, 0x3c6a75c, 0x1dcd58e } },
+			{ { 0x3139cb3, 0x07a4218, 0x3d9a0d6, 0x13e2d01, 0x2924f69, 0x1638932, 0x3e76456, 0x1e891ae, 0x301b864, 0x07d09ad } },
+		},
+		{
+			{ { 0x1a12552, 0x18d7224, 0x38ede2f, 0x09abaf4, 0x2ddae05, 0x19b723e, 0x1a03786, 0x0871f50, 0x1b3fa7e, 0x02ddaec } },
+			{ { 0x1911c01, 0x0499310, 0x184bdf9, 0x1c0bd11, 0x3c68ede, 0x10f1447, 0x2ed35f9, 0x0120b0e, 0x271d31b, 0x1386bd4 } },
+			{ { 0x392939b, 0x0307e5f, 0x16dc117, 0x05ea225, 0x2f99dc7, 0x1bb8017, 0x2b231cc, 0x12aa45c, 0x1eb772a, 0x1edb758 } },
+		},
+		{
+			{ { 0x301d2c7, 0x02afe6a, 0x3630ae6, 0x0e200a1, 0x05beddb, 0x0cbb281, 0x25f32d0, 0x15fd0cd, 0x259bff6, 0x14fea6d } },
+			{ { 0x0f33d92, 0x1707a14, 0x2b9f6f5, 0x07b0466, 0x1e663e9, 0x1fc5bdb, 0x316dec6, 0x1e9f5b2, 0x0eaf1d2, 0x1c0fa6f } },
+			{ { 0x0885455, 0x1323a65, 0x29cad82, 0x1332d76, 0x210e975, 0x0d65af1, 0x1db9f5e, 0x1ea0303, 0x25c4c61, 0x0e6364f } },
+		},
+		{
+			{ { 0x2e7e3f2, 0x1df1834, 0x1763870, 0x1018414, 0x0ecd2aa, 0x19ef138, 0x31373b9, 0x0aee507, 0x1002c30, 0x1a67272 } },
+			{ { 0x3e248f3, 0x0f459cc, 0x14be389, 0x038adf8, 0x2f6784a, 0x10b0376, 0x3c67850, 0x1627a87, 0x1ddf191, 0x14ec26d } },
+			{ { 0x146f1cc, 0x1a9c8d6, 0x32fbe60, 0x1ae672e, 0x2485c62, 0x1b4e975, 0x2e923c0, 0x120e519, 0x0c6fcdd, 0x1472bcc } },
+		},
+		{
+			{ { 0x0ac54c7, 0x0be6686, 0x261ee6f, 0x0e628e5, 0x240cde3, 0x0e10cc7, 0x0de19a6, 0x1334571, 0x0189f8e, 0x04ab8a7 } },
+			{ { 0x274e00a, 0x0e9d09d, 0x37e74c1, 0x1850bd3, 0x18c3a15, 0x13324cc, 0x02b1ee7, 0x1b546eb, 0x292383f, 0x15412a8 } },
+			{ { 0x30d01cf, 0x1b032c7, 0x2f5d533, 0x061d1a7, 0x03747bf, 0x09c4e22, 0x13a90e8, 0x0bd4ab9, 0x2958eba, 0x17f453f } },
+		},
+		{
+			{ { 0x393cb8e, 0x0bf97af, 0x2cbe788, 0x089b6a2, 0x2fb7ea1, 0x04220e8, 0x042cf44, 0x0251c1e, 0x160725d, 0x1f75cfe } },
+			{ { 0x045ab2c, 0x10b77ca, 0x13276bb, 0x18853ff, 0x01a5246, 0x002e346, 0x179eb20, 0x09a29b5, 0x2e58647, 0x024ffc9 } },
+			{ { 0x0059829, 0x1493f9a, 0x07cb621, 0x196dd79, 0x1d5cc19, 0x057ac29, 0x3929d5a, 0x014826c, 0x3c86b47, 0x0bd66f2 } },
+		},
+		{
+			{ { 0x291c301, 0x075582d, 0x0e3ce08, 0x1fd6ebf, 0x214806c, 0x1335585, 0x170b188, 0x11622d8, 0x3d01082, 0x0aa9578 } },
+			{ { 0x117135f, 0x11f50a6, 0x07af070, 0x0fab3e8, 0x2b46e44, 0x077aad1, 0x3a46cdf, 0x1e94fce, 0x2e2e51a, 0x15162d0 } },
+			{ { 0x007444f, 0x064b983, 0x3a21daa, 0x16ba210, 0x10b1538, 0x1b5c864, 0x1a6417e, 0x0cc86a5, 0x0a8a768, 0x04fa401 } },
+		},
+	},
+	{
+		{
+			{ { 0x13b877f, 0x1803246, 0x20d7765, 0x08706e2, 0x3b38ea2, 0x0de649f, 0x1dbe01b, 0x1c35d9e, 0x0898de9, 0x17d1810 } },
+			{ { 0x32fcedb, 0x1621160, 0x30c6e73, 0x04d735f, 0x3e8e35b, 0x14ffef7, 0x206e55b, 0x08bc657, 0x0814bce, 0x1ce4dfa } },
+			{ { 0x17bf48d, 0x0dc458a, 0x1069720, 0x116a783, 0x2a744ec, 0x096bdc6, 0x38aaba3, 0x106bc32, 0x2891d5e, 0x0b3e293 } },
+		},
+		{
+			{ { 0x3d06ba2, 0x1521f85, 0x32d6596, 0x0e1ca80, 0x09348e0, 0x1978a30, 0x2ce40c2, 0x09edaec, 0x2891d6a, 0x1e9bdfc } },
+			{ { 0x3110f67, 0x0ff61c1, 0x2a92db2, 0x09be1c5, 0x3753027, 0x0736a86, 0x0b52661, 0x1412f96, 0x2e58252, 0x08126f5 } },
+			{ { 0x29aef49, 0x07f635a, 0x3216fa1, 0x1f2d9ed, 0x3c3b982, 0x19ebfd4, 0x0da9628, 0x083a984, 0x1fc5459, 0x18046ab } },
+		},
+		{
+			{ { 0x2cbf890, 0x1b43200, 0x1554c7b, 0x0506ffb, 0x3ef4263, 0x1b6ed99, 0x2857edc, 0x163cc49, 0x3779340, 0x1a73862 } },
+			{ { 0x395f83c, 0x1e49b73, 0x20e2bec, 0x10b8944, 0x1f1fa15, 0x18f7a5b, 0x0f3f9cc, 0x13c1ad4, 0x1b0b62f, 0x1bf1730 } },
+			{ { 0x29879cb, 0x1d54a2c, 0x2125a3d, 0x1e6a3f4, 0x3746ab8, 0x09f2352, 0x302210c, 0x03e224f, 0x3ae5710, 0x05565ac } },
+		},
+		{
+			{ { 0x25124ca, 0x1cc459f, 0x0bbe13f, 0x05ece3a, 0x02f9056, 0x0f556e5, 0x1be913f, 0x0270525, 0x01afb6d, 0x0ea9389 } },
+			{ { 0x39179a2, 0x1ce748f, 0x3b9e8c4, 0x18cbeb6, 0x3fe0c48, 0x1f2148a, 0x3ef5aa9, 0x1bb4260, 0x287b5f4, 0x03488dd } },
+			{ { 0x23305f5, 0x04e2fca, 0x0d86598, 0x07d1749, 0x12160fe, 0x149d2eb, 0x158d12a, 0x06d8107, 0x2e4687a, 0x0cbf2a9 } },
+		},
+		{
+			{ { 0x387ccdf, 0x1e91cc9, 0x07f0640, 0x047909f, 0x05f8c64, 0x00d964e, 0x1766bfb, 0x17d3ab6, 0x36c2600, 0x1d1bd8c } },
+			{ { 0x17d9af5, 0x15ba371, 0x3be4f78, 0x16cef85, 0x0f82f4b, 0x0efe4a3, 0x00a6f11, 0x14b9558, 0x0efebd6, 0x1189fa7 } },
+			{ { 0x36c971c, 0x0bcd16a, 0x263e7e9, 0x194ca1b, 0x38a23ad, 0x144186d, 0x0b54501, 0x052666b, 0x007ed66, 0x1ed245c } },
+		},
+		{
+			{ { 0x153a2dd, 0x106ca37, 0x387ea86, 0x0defa17, 0x2a85e41, 0x1d2f8f4, 0x2c96ca6, 0x06fa1fe, 0x0fe08cd, 0x0740d88 } },
+			{ { 0x384b064, 0x17ed72a, 0x38285b0, 0x0944f9d, 0x125e043, 0x115ce0c, 0x16e223d, 0x1af68ed, 0x36f844f, 0x048ae8d } },
+			{ { 0x2b4e554, 0x08cb368, 0x30ff840, 0x0108ae8, 0x27b43f5, 0x1d479d9, 0x1da5f3e, 0x18985d5, 0x352b68e, 0x00b1c2f } },
+		},
+		{
+			{ { 0x18d72e1, 0x14cafd1, 0x396b59c, 0x103e5b9, 0x16f9da3, 0x08bbde7, 0x3beca77, 0x1406ad9, 0x23feb43, 0x1ac1a5f } },
+			{ { 0x10b2fbb, 0x1fb12d7, 0x0595450, 0x0803a44, 0x105715e, 0x1d0815c, 0x2530f60, 0x0bc1c08, 0x0a409ef, 0x098cd3c } },
+			{ { 0x362a3c0, 0x03c12b7, 0x08bb6d9, 0x1783b6d, 0x0fbc003, 0x1f0d2a9, 0x25cac24, 0x1f5d393, 0x03441b2, 0x0730dfd } },
+		},
+		{
+			{ { 0x1ceaeb9, 0x195bc72, 0x0ad5aec, 0x1c0c72b, 0x0716c57, 0x04c2334, 0x3941942, 0x10704dc, 0x372f196, 0x0e8d1bd } },
+			{ { 0x0c7324f, 0x1d59697, 0x1244a11, 0x0072835, 0x3418713, 0x045ac19, 0x055edae, 0x0295f63, 0x0103803, 0x1b1a027 } },
+			{ { 0x2da6ac8, 0x15444b8, 0x23dba5a, 0x18d8f42, 0x3a6f40c, 0x0c67262, 0x3a36ec7, 0x0ba12c0, 0x1f6ef7c, 0x016446e } },
+		},
+	},
+	{
+		{
+			{ { 0x12eeaef, 0x06b3cd4, 0x1692a69, 0x098e60e, 0x0830507, 0x19a688d, 0x00603d4, 0x1a2e483, 0x11c64b2, 0x1557be7 } },
+			{ { 0x1df0ebb, 0x0e660fd, 0x1959826, 0x07a8962, 0x303cdd6, 0x1b398e1, 0x0898505, 0x18c459e, 0x39aa270, 0x1acf3b3 } },
+			{ { 0x373bd08, 0x1dc2e8e, 0x3e186d4, 0x0451d7d, 0x1892bbc, 0x00946f2, 0x3ffcc5a, 0x093aae6, 0x2133817, 0x19d7d37 } },
+		},
+		{
+			{ { 0x3dab31d, 0x1fdb64e, 0x1bfd425, 0x07ceb29, 0x01c9760, 0x0be9487, 0x227f9cd, 0x1886033, 0x3882cd3, 0x183d142 } },
+			{ { 0x31782fc, 0x11480da, 0x07681c5, 0x00b656c, 0x19205b2, 0x164073e, 0x25eecb4, 0x0a41a1b, 0x370164c, 0x04f6677 } },
+			{ { 0x1e5c0ca, 0x0d7b0c8, 0x3f44029, 0x04eb8cd, 0x13f2da7, 0x10023a0, 0x38e0c3a, 0x19009cb, 0x1e55eda, 0x0701b7a } },
+		},
+		{
+			{ { 0x36d69aa, 0x14ad03f, 0x1377ffa, 0x0c6e202, 0x0d14c2c, 0x14d9897, 0x12e17d1, 0x145abc9, 0x0e7d32b, 0x1e025be } },
+			{ { 0x33ec4e2, 0x1deb5a8, 0x011d321, 0x1c5f177, 0x19823e4, 0x1284515, 0x0a1e2b1, 0x0c1b394, 0x1fec2db, 0x133ce28 } },
+			{ { 0x1fa5ce7, 0x0aa9943, 0x0f19415, 0x15245aa, 0x3e71278, 0x003725b, 0x0e63eb8, 0x157c9e1, 0x3a26091, 0x0dcf2b4 } },
+		},
+		{
+			{ { 0x1ddbbad, 0x1aa3ee2, 0x1d97e37, 0x1e30d75, 0x0ef2cb2, 0x19b8d9d, 0x053dd8f, 0x0d0d1eb, 0x1a5112a, 0x08551fb } },
+			{ { 0x2c9f57c, 0x118d360, 0x0a6d652, 0x109249a, 0x07f2ff7, 0x18cdb5a, 0x226d9a0, 0x13f93d3, 0x1945441, 0x00103cf } },
+			{ { 0x15986d3, 0x17a4e7f, 0x3019bdf, 0x04a8851, 0x3d09cb2, 0x13119b9, 0x1d203dd, 0x1be96e5, 0x334a254, 0x18d5428 } },
+		},
+		{
+			{ { 0x2547b49, 0x096115c, 0x11c1377, 0x1d71620, 0x3cc171b, 0x134f18d, 0x07d34e3, 0x0cf4c1d, 0x2faa7d7, 0x0e6a4ae } },
+			{ { 0x169cf37, 0x1f5bb6d, 0x1dc2ca0, 0x1806529, 0x05e10a6, 0x16bd65d, 0x2004875, 0x1ea3d4f, 0x07daf78, 0x0fba98b } },
+			{ { 0x293274e, 0x131c4f9, 0x26eb3a4, 0x1bb46de, 0x17d8e15, 0x18ab39a, 0x12ab075, 0x099ae0a, 0x0665c9c, 0x1a10da8 } },
+		},
+		{
+			{ { 0x020107c, 0x1b4c5fa, 0x12ca3ca, 0x0242057, 0x31499a1, 0x00ffc7a, 0x050e319, 0x08e583c, 0x1c91611, 0x14dcd9a } },
+			{ { 0x02f3f27, 0x08d7a08, 0x2b61780, 0x11327cb, 0x31d7003, 0x18c2416, 0x274ead1, 0x13f3234, 0x368ab78, 0x05edb9f } },
+			{ { 0x20e5257, 0x0052ae6, 0x27f8ba5, 0x0264e55, 0x2423c82, 0x12d1eca, 0x17ac42d, 0x1a235f9, 0x2678f87, 0x072d2d6 } },
+		},
+		{
+			{ { 0x2a007e7, 0x12a98a8, 0x0f62d6e, 0x187838e, 0x3cc4782, 0x00be223, 0x3f21c00, 0x1d58ae0, 0x2d82ef6, 0x0b703f4 } },
+			{ { 0x14afc6c, 0x1301ace, 0x3f636cc, 0x124c6d2, 0x0322378, 0x1cad834, 0x2818b25, 0x09449f1, 0x38de743, 0x0cc2f29 } },
+			{ { 0x119744e, 0x1bfe104, 0x0e49305, 0x0b1583a, 0x3e5a57a, 0x1c953fb, 0x160a7df, 0x19eb8b1, 0x1b369f1, 0x0f0c6f8 } },
+		},
+		{
+			{ { 0x1cb4272, 0x02f24fe, 0x373182d, 0x0fe3e76, 0x2bae1c4, 0x0ac8d7a, 0x329551a, 0x0b76fe1, 0x097e7d5, 0x1073b04 } },
+			{ { 0x0948aee, 0x1219342, 0x38df61e, 0x1748dd0, 0x01f7067, 0x0aca158, 0x2e6d753, 0x0976f2e, 0x134262d, 0x0cc2d84 } },
+			{ { 0x26d808a, 0x18675e8, 0x2adbef2, 0x0f0ecf0, 0x2ec7f52, 0x1a1df27, 0x3e1b66d, 0x0efae7a, 0x191f287, 0x09ad133 } },
+		},
+	},
+	{
+		{
+			{ { 0x2730383, 0x1fca4d8, 0x1459c36, 0x1ff5e54, 0x12d49e7, 0x1d41314, 0x23bc55f, 0x021fb5f, 0x149c726, 0x1f7ac40 } },
+			{ { 0x3387475, 0x01211e3, 0x1678a3e, 0x1a4e5f6, 0x2c976f3, 0x19f2055, 0x189226c, 0x0bad355, 0x2c1c10a, 0x0b1c279 } },
+			{ { 0x366ee7a, 0x0abdaa1, 0x1a1d96c, 0x022aa9e, 0x19b2fb0, 0x10be4b5, 0x0009c07, 0x05d4b10, 0x1ff62ce, 0x0239a3a } },
+		},
+		{
+			{ { 0x2b8f2f9, 0x1427542, 0x07be5e5, 0x06e2ac9, 0x2b2e486, 0x1766cb9, 0x39a1339, 0x13ea951, 0x1738f71, 0x132c4ef } },
+			{ { 0x3c130ad, 0x1540292, 0x2938695, 0x049e85e, 0x234e36d, 0x00a89be, 0x21ecc28, 0x161344b, 0x07eeba3, 0x0bc7cfe } },
+			{ { 0x115b64a, 0x1231d79, 0x2071ef0, 0x1d6da54, 0x2965406, 0x1751b50, 0x2989f9f, 0x1dd1841, 0x13c0ae2, 0x066878d } },
+		},
+		{
+			{ { 0x196bdbd, 0x05cb375, 0x3881684, 0x01cc777, 0x24f8115, 0x04109b5, 0x0a9a3da, 0x1c693f6, 0x190266a, 0x1cdaf4e } },
+			{ { 0x2fa05c3, 0x11d582e, 0x3cc2fa3, 0x106372a, 0x2cf8682, 0x0d66473, 0x14b8c60, 0x090dc6a, 0x11c20c3, 0x10551ac } },
+			{ { 0x334b3b4, 0x0cb5424, 0x0ae70aa, 0x05b040b, 0x11bf445, 0x05c8375, 0x3af9821, 0x16b998b, 0x22b87fa, 0x1048a56 } },
+		},
+		{
+			{ { 0x293eac6, 0x1549878, 0x19b65cc, 0x019099d, 0x2116a48, 0x100996b, 0x0bae5bc, 0x1b008c1, 0x0d195ad, 0x01d82ee } },
+			{ { 0x17ed6e9, 0x066e23d, 0x104a339, 0x1336fc6, 0x14e4f2c, 0x10ad273, 0x31909d9, 0x1c68b9d, 0x2bb52d2, 0x053854f } },
+			{ { 0x1e6818a, 0x18685f3, 0x0108827, 0x14f6b4d, 0x15c55b6, 0x0caccb1, 0x39347a3, 0x0be4597, 0x1bc33ac, 0x1acd2fa } },
+		},
+		{
+			{ { 0x171f2d3, 0x11a5959, 0x26f423f, 0x02a9873, 0x31b27a1, 0x0fe5035, 0x173d16a, 0x0617c67, 0x362e6dd, 0x006e71e } },
+			{ { 0x278c0b2, 0x1cbd90e, 0x04f9e7b, 0x0f79170, 0x130fa5c, 0x1c1b5a3, 0x28e2f24, 0x1a5bd8f, 0x0f0922d, 0x0804b06 } },
+			{ { 0x2c89d29, 0x0d57956, 0x0ec7101, 0x0fa2d05, 0x0520c90, 0x0e76c1f, 0x377efe1, 0x1bd07a6, 0x384e4ba, 0x022bd6d } },
+		},
+		{
+			{ { 0x1cc2c4b, 0x0c534a2, 0x2f1bc4e, 0x08d1438, 0x12f92f4, 0x03364ce, 0x2946b7d, 0x04dc31a, 0x15afd98, 0x1908f07 } },
+			{ { 0x01f2533, 0x1267722, 0x076c506, 0x0d3bc99, 0x2741497, 0x13441f4, 0x16efdb3, 0x0d1b12f, 0x31163a1, 0x0cade75 } },
+			{ { 0x1fcb36a, 0x17e367b, 0x0bf3990, 0x079ba37, 0x08af30a, 0x1e5d3cd, 0x2f19c7c, 0x1b99c93, 0x3bc13e2, 0x120297b } },
+		},
+		{
+			{ { 0x2ce221f, 0x0533910, 0x32516cc, 0x0626029, 0x1b86677, 0x01cbe03, 0x3da526e, 0x1c0ccc7, 0x07691c8, 0x092cc75 } },
+			{ { 0x1622071, 0x079c2c0, 0x1f8a16a, 0x07c58ed, 0x01ad417, 0x15aabcd, 0x1d830f7, 0x1e6258d, 0x200cb7b, 0x11ea89d } },
+			{ { 0x015f8c3, 0x107bb70, 0x3ef854a, 0x1f3e349, 0x04693f9, 0x0a278d6, 0x3b309a7, 0x0129e15, 0x1d14dda, 0x1516d61 } },
+		},
+		{
+			{ { 0x3b321e1, 0x1393438, 0x3d2ac40, 0x1d147f8, 0x0eea98d, 0x199bd9e, 0x267fead, 0x00e2161, 0x3e64c8d, 0x1348b70 } },
+			{ { 0x0d43a0f, 0x1c9d7a8, 0x1d7ccf7, 0x1a044df, 0x2b79a38, 0x079e72e, 0x089a66a, 0x08a8851, 0x0332ba5, 0x03d8be7 } },
+			{ { 0x23b5f39, 0x1196275, 0x1ec3f96, 0x1fabe5e, 0x172b9a8, 0x13afa05, 0x161694a, 0x086dfd7, 0x1a36371, 0x0703e80 } },
+		},
+	},
+	{
+		{
+			{ { 0x0936a50, 0x00ac3a3, 0x0b6cd21, 0x1ae0ed6, 0x3e72680, 0x0dfb634, 0x39f2a62, 0x0280df6, 0x1b1d2bc, 0x1001506 } },
+			{ { 0x2943dff, 0x1812d88, 0x2741a58, 0x072267d, 0x2f232fb, 0x1808678, 0x2a7f9cb, 0x0d7eba4, 0x0f3b1ca, 0x03e8d85 } },
+			{ { 0x1be82f0, 0x0ffaf6e, 0x1921400, 0x179d225, 0x0822706, 0x154fa8e, 0x0cfc88c, 0x1685f09, 0x0aef40a, 0x07ee886 } },
+		},
+		{
+			{ { 0x27b0194, 0x195c10f, 0x1efe9e7, 0x17046d5, 0x2a074fb, 0x1dcdef1, 0x0e355cc, 0x03ab907, 0x13ff776, 0x1b14d74 } },
+			{ { 0x2c8f53e, 0x125123e, 0x2e8356a, 0x0d3dd31, 0x207dba2, 0x02b5e01, 0x2b63eb6, 0x1c84e9f, 0x0aa8c86, 0x0e4b8eb } },
+			{ { 0x28a35af, 0x14d3a4f, 0x102c997, 0x022c43f, 0x0b81e05, 0x09ab0ab, 0x0ce3b79, 0x0276326, 0x24d50ac, 0x09785ff } },
+		},
+		{
+			{ { 0x2f121a7, 0x1dffd5d, 0x0fc722b, 0x1397e6c, 0x30d28c8, 0x11be526, 0x117ef26, 0x1337997, 0x0f89698, 0x1aeea0a } },
+			{ { 0x204f676, 0x026f5c7, 0x1f2a145, 0x096b210, 0x0823871, 0x0691fab, 0x36c581a, 0x06a2a30, 0x042a9fb, 0x0955d45 } },
+			{ { 0x0fe3901, 0x06f19a4, 0x35abc5a, 0x0c504cb, 0x132d528, 0x18460d4, 0x2b48a57, 0x17c92e3, 0x0f7f6b7, 0x1567541 } },
+		},
+		{
+			{ { 0x2d266fd, 0x02479fd, 0x3037389, 0x0d8183b, 0x01d1286, 0x061e23b, 0x0478eb0, 0x0a1d107, 0x23354bd, 0x048fa9a } },
+			{ { 0x3eb54d5, 0x0e0de2c, 0x38f94ee, 0x1352aa9, 0x075a74d, 0x12800ba, 0x367b17c, 0x042e144, 0x15807e3, 0x006ac4b } },
+			{ { 0x1e32d96, 0x1462410, 0x3090231, 0x016c18a, 0x2e7b78f, 0x03245d9, 0x1a138ec, 0x02a83d5, 0x22c918a, 0x128e587 } },
+		},
+		{
+			{ { 0x3233f1e, 0x1f5913c, 0x202c064, 0x071a7e7, 0x1266898, 0x0dab979, 0x2d38b79, 0x023f076, 0x2d9bd41, 0x1a2b3ba } },
+			{ { 0x0e6bba0, 0x10ef83e, 0x0614e3b, 0x1a3f7ff, 0x35b3be0, 0x13a476a, 0x1212ff0, 0x0ec7532, 0x23fb1db, 0x0b35af3 } },
+			{ { 0x3d7c210, 0x13243bc, 0x0818716, 0x125bd68, 0x0c239b8, 0x1e73e23, 0x06cf8db, 0x0b2e70c, 0x15b508f, 0x1655d83 } },
+		},
+		{
+			{ { 0x1022790, 0x0b2faff, 0x2ec1105, 0x02e208a, 0x226bccc, 0x13473f4, 0x24971be, 0x1456cbe, 0x1f54515, 0x0b2cb17 } },
+			{ { 0x0aa6397, 0x06ff841, 0x3996c25, 0x045253f, 0x23e5800, 0x1909458, 0x1e044be, 0x03527f1, 0x3edcb29, 0x1c27e90 } },
+			{ { 0x3fd2aca, 0x0976318, 0x1dffd61, 0x131734a, 0x348af05, 0x0cbb03a, 0x1f9b77c, 0x063e4e4, 0x2cf0c81, 0x1c3c0a7 } },
+		},
+		{
+			{ { 0x210b0b9, 0x0abea97, 0x355254d, 0x1877820, 0x1e3c28d, 0x03ad61f, 0x37dbbd5, 0x13c2ee7, 0x22a74bd, 0x113b296 } },
+			{ { 0x2ed3e33, 0x0c1eccb, 0x03ce8c2, 0x19d22ac, 0x2b810bc, 0x15f0366, 0x224e98c, 0x10b1928, 0x0a6c314, 0x02df576 } },
+			{ { 0x395d543, 0x1120c9e, 0x1e3a4ba, 0x00519a0, 0x1c34e0c, 0x0e1c52b, 0x2298e30, 0x13c9bc3, 0x112c7de, 0x09c8891 } },
+		},
+		{
+			{ { 0x2a975fc, 0x0eee290, 0x06b17ef, 0x1bcb56d, 0x23170e5, 0x1edaa48, 0x3e3b7e6, 0x014dc4f, 0x17f6bc2, 0x065cd7f } },
+			{ { 0x1c5342e, 0x124abd2, 0x35a0357, 0x08d9737, 0x3ffbb60, 0x0c84e29, 0x14646fe, 0x0a87df4, 0x18a44cc, 0x046d77c } },
+			{ { 0x2c84266, 0x0e43410, 0x28fdc75, 0x07bf8ca, 0x3ae1238, 0x1a497b9, 0x1d0e832, 0x12be4a0, 0x1191df8, 0x03fbe44 } },
+		},
+	},
+};
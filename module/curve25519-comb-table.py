@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0 OR MIT
+#
+# Copyright (C) 2019-2020 Netgate, Inc.
+#
+# Generates curve25519-comb-table.h, the fixed-base table used by
+# curve25519-comb.c: entry [i][j] is (j + 1) * 256^i * B on edwards25519,
+# in affine (y + x, y - x, 2dxy) form, as fiat32 field elements.
+#
+#   python3 curve25519-comb-table.py > curve25519-comb-table.h
+
+p = 2**255 - 19
+d = -121665 * pow(121666, p - 2, p) % p
+
+
+def inv(x):
+    return pow(x, p - 2, p)
+
+
+def add(P, Q):
+    (x1, y1), (x2, y2) = P, Q
+    t = d * x1 * x2 * y1 * y2 % p
+    return ((x1 * y2 + x2 * y1) * inv(1 + t) % p,
+            (y1 * y2 + x1 * x2) * inv(1 - t) % p)
+
+
+def base():
+    y = 4 * inv(5) % p
+    xx = (y * y - 1) * inv(d * y * y + 1) % p
+    x = pow(xx, (p + 3) // 8, p)
+    if x * x % p != xx:
+        x = x * pow(2, (p - 1) // 4, p) % p
+    assert x * x % p == xx
+    return (p - x if x & 1 else x, y)
+
+
+def limbs(v):
+    out = []
+    for i in range(10):
+        bits = 25 if i & 1 else 26
+        out.append(v & ((1 << bits) - 1))
+        v >>= bits
+    return out
+
+
+def fe(v):
+    return "{ { " + ", ".join("0x%07x" % l for l in limbs(v % p)) + " } }"
+
+
+def main():
+    print("/* SPDX-License-Identifier: GPL-2.0 OR MIT */")
+    print("/* Generated by curve25519-comb-table.py, do not edit. */")
+    print()
+    print("static const ge_precomp curve25519_comb_table[32][8] = {")
+    B = base()
+    for i in range(32):
+        P = B
+        print("\t{")
+        for j in range(8):
+            x, y = P
+            print("\t\t{")
+            print("\t\t\t%s," % fe(y + x))
+            print("\t\t\t%s," % fe(y - x))
+            print("\t\t\t%s," % fe(2 * d * x * y))
+            print("\t\t},")
+            P = add(P, B)
+        print("\t},")
+        for _ in range(8):
+            B = add(B, B)
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
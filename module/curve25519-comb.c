@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Fixed-base X25519 for the fiat32 field arithmetic: the scalar times the
+ * base point is computed on the birationally equivalent edwards25519 curve
+ * from a precomputed table, in the manner of ref10's ge_scalarmult_base, and
+ * mapped back to a Montgomery u coordinate. The scalar is recoded into 64
+ * signed radix-16 digits; the odd ones are added from the table, the sum is
+ * multiplied by 16, and the even ones are added in turn. Each addition looks
+ * at every entry of its row, so that the memory access pattern and the
+ * running time do not depend on the scalar.
+ *
+ * This file is included after the field arithmetic, by module/curve25519.c
+ * and by tools/curve25519.c, and is not built on its own.
+ */
+
+typedef struct { fe X, Y, Z; } ge_p2;
+typedef struct { fe X, Y, Z, T; } ge_p3;
+typedef struct { fe_loose X, Y, Z, T; } ge_p1p1;
+typedef struct { fe yplusx, yminusx, xy2d; } ge_precomp;
+
+#include "curve25519-comb-table.h"
+
+/* h = f, brought back within the bounds of a tight element. */
+static __always_inline void fe_carry(fe *h, const fe_loose *f)
+{
+	u32 c;
+	int i;
+
+	memmove(h, f, sizeof(u32) * 10);
+	for (i = 0; i < 9; ++i) {
+		c = h->v[i] >> ((i & 1) ? 25 : 26);
+		h->v[i] &= (i & 1) ? 0x1ffffff : 0x3ffffff;
+		h->v[i + 1] += c;
+	}
+	c = h->v[9] >> 25;
+	h->v[9] &= 0x1ffffff;
+	h->v[0] += 19 * c;
+	c = h->v[0] >> 26;
+	h->v[0] &= 0x3ffffff;
+	h->v[1] += c;
+}
+
+/* h = f if b == 1, h unchanged if b == 0. */
+static __always_inline void fe_cmov(fe *h, const fe *f, u32 b)
+{
+	unsigned i;
+
+	b = 0 - b;
+	for (i = 0; i < 10; i++)
+		h->v[i] ^= (h->v[i] ^ f->v[i]) & b;
+}
+
+static __always_inline void ge_p3_0(ge_p3 *h)
+{
+	fe_0(&h->X);
+	fe_1(&h->Y);
+	fe_1(&h->Z);
+	fe_0(&h->T);
+}
+
+static __always_inline void ge_precomp_0(ge_precomp *h)
+{
+	fe_1(&h->yplusx);
+	fe_1(&h->yminusx);
+	fe_0(&h->xy2d);
+}
+
+static __always_inline void ge_p1p1_to_p2(ge_p2 *r, const ge_p1p1 *p)
+{
+	fe_mul_tll(&r->X, &p->X, &p->T);
+	fe_mul_tll(&r->Y, &p->Y, &p->Z);
+	fe_mul_tll(&r->Z, &p->Z, &p->T);
+}
+
+static __always_inline void ge_p1p1_to_p3(ge_p3 *r, const ge_p1p1 *p)
+{
+	fe_mul_tll(&r->X, &p->X, &p->T);
+	fe_mul_tll(&r->Y, &p->Y, &p->Z);
+	fe_mul_tll(&r->Z, &p->Z, &p->T);
+	fe_mul_tll(&r->T, &p->X, &p->Y);
+}
+
+/* r = 2 * p */
+static void ge_p2_dbl(ge_p1p1 *r, const ge_p2 *p)
+{
+	fe xx, yy, b, aa, t;
+	fe_loose a, b2;
+
+	fe_sq_tt(&xx, &p->X);
+	fe_sq_tt(&yy, &p->Y);
+	fe_sq_tt(&b, &p->Z);
+	fe_add(&b2, &b, &b);
+	fe_add(&a, &p->X, &p->Y);
+	fe_sq_tl(&aa, &a);
+
+	fe_add(&r->Y, &yy, &xx);
+	fe_sub(&r->Z, &yy, &xx);
+	fe_carry(&t, &r->Y);
+	fe_sub(&r->X, &aa, &t);
+	fe_carry(&b, &b2);
+	fe_carry(&t, &r->Z);
+	fe_sub(&r->T, &b, &t);
+}
+
+/* r = p + q */
+static void ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q)
+{
+	fe a, b, c, d;
+	fe_loose ypx, ymx, dl;
+
+	fe_add(&ypx, &p->Y, &p->X);
+	fe_sub(&ymx, &p->Y, &p->X);
+	fe_mul_tlt(&a, &ypx, &q->yplusx);
+	fe_mul_tlt(&b, &ymx, &q->yminusx);
+	fe_mul_ttt(&c, &q->xy2d, &p->T);
+	fe_add(&dl, &p->Z, &p->Z);
+	fe_carry(&d, &dl);
+
+	fe_sub(&r->X, &a, &b);
+	fe_add(&r->Y, &a, &b);
+	fe_add(&r->Z, &d, &c);
+	fe_sub(&r->T, &d, &c);
+}
+
+static __always_inline u32 ge_equal(int8_t b, int8_t c)
+{
+	u32 x = (u8)b ^ (u8)c;
+
+	return (x - 1) >> 31;
+}
+
+static __always_inline u32 ge_negative(int8_t b)
+{
+	return (u32)(int32_t)b >> 31;
+}
+
+/* t = b * 256^pos * B, looking at every entry of the row. */
+static void ge_select(ge_precomp *t, int pos, int8_t b)
+{
+	const u32 bneg = ge_negative(b);
+	const int8_t babs = b - (int8_t)((-(int8_t)bneg & b) << 1);
+	ge_precomp minust;
+	fe_loose l;
+	int i;
+
+	ge_precomp_0(t);
+	for (i = 0; i < 8; i++) {
+		const ge_precomp *e = &curve25519_comb_table[pos][i];
+		const u32 eq = ge_equal(babs, i + 1);
+
+		fe_cmov(&t->yplusx, &e->yplusx, eq);
+		fe_cmov(&t->yminusx, &e->yminusx, eq);
+		fe_cmov(&t->xy2d, &e->xy2d, eq);
+	}
+	fe_copy(&minust.yplusx, &t->yminusx);
+	fe_copy(&minust.yminusx, &t->yplusx);
+	fe_0(&minust.xy2d);
+	fe_sub(&l, &minust.xy2d, &t->xy2d);
+	fe_carry(&minust.xy2d, &l);
+	fe_cmov(&t->yplusx, &minust.yplusx, bneg);
+	fe_cmov(&t->yminusx, &minust.yminusx, bneg);
+	fe_cmov(&t->xy2d, &minust.xy2d, bneg);
+	memzero_explicit(&minust, sizeof(minust));
+}
+
+static void curve25519_comb_base(u8 out[CURVE25519_KEY_SIZE],
+				 const u8 scalar[CURVE25519_KEY_SIZE])
+{
+	ge_p1p1 r;
+	ge_p2 s;
+	ge_p3 h;
+	ge_precomp t;
+	fe_loose zplusy, zminusy;
+	fe zinv, u;
+	int8_t e[64], carry;
+	u8 a[32];
+	int i;
+
+	memcpy(a, scalar, 32);
+	a[0] &= 248;
+	a[31] = (a[31] & 127) | 64;
+
+	/* Clamping leaves the top digit no larger than 8. */
+	for (i = 0; i < 32; ++i) {
+		e[2 * i + 0] = (a[i] >> 0) & 15;
+		e[2 * i + 1] = (a[i] >> 4) & 15;
+	}
+	carry = 0;
+	for (i = 0; i < 63; ++i) {
+		e[i] += carry;
+		carry = e[i] + 8;
+		carry >>= 4;
+		e[i] -= carry << 4;
+	}
+	e[63] += carry;
+
+	ge_p3_0(&h);
+	for (i = 1; i < 64; i += 2) {
+		ge_select(&t, i / 2, e[i]);
+		ge_madd(&r, &h, &t);
+		ge_p1p1_to_p3(&h, &r);
+	}
+
+	s.X = h.X;
+	s.Y = h.Y;
+	s.Z = h.Z;
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p3(&h, &r);
+
+	for (i = 0; i < 64; i += 2) {
+		ge_select(&t, i / 2, e[i]);
+		ge_madd(&r, &h, &t);
+		ge_p1p1_to_p3(&h, &r);
+	}
+
+	/* u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y) */
+	fe_add(&zplusy, &h.Z, &h.Y);
+	fe_sub(&zminusy, &h.Z, &h.Y);
+	fe_loose_invert(&zinv, &zminusy);
+	fe_mul_tlt(&u, &zplusy, &zinv);
+	fe_tobytes(out, &u);
+
+	memzero_explicit(a, sizeof(a));
+	memzero_explicit(e, sizeof(e));
+	memzero_explicit(&r, sizeof(r));
+	memzero_explicit(&s, sizeof(s));
+	memzero_explicit(&h, sizeof(h));
+	memzero_explicit(&t, sizeof(t));
+	memzero_explicit(&zplusy, sizeof(zplusy));
+	memzero_explicit(&zminusy, sizeof(zminusy));
+	memzero_explicit(&zinv, sizeof(zinv));
+	memzero_explicit(&u, sizeof(u));
+}
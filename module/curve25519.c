@@ -755,9 +755,10 @@ static __always_inline void fe_mul121666(fe *h, const fe_loose *f)
 	fe_mul_121666_impl(h->v, f->v);
 }
 
-void curve25519_generic(u8 out[CURVE25519_KEY_SIZE],
-			       const u8 scalar[CURVE25519_KEY_SIZE],
-			       const u8 point[CURVE25519_KEY_SIZE])
+/* The ladder, leaving scalar * point in projective (x2 : z2) form. */
+static void curve25519_ladder(fe *x2_out, fe *z2_out,
+			      const u8 scalar[CURVE25519_KEY_SIZE],
+			      const u8 point[CURVE25519_KEY_SIZE])
 {
 	fe x1, x2, z2, x3, z3;
 	fe_loose x2l, z2l, x3l;
@@ -849,9 +850,8 @@ void curve25519_generic(u8 out[CURVE25519_KEY_SIZE],
 	fe_cswap(&x2, &x3, swap);
 	fe_cswap(&z2, &z3, swap);
 
-	fe_invert(&z2, &z2);
-	fe_mul_ttt(&x2, &x2, &z2);
-	fe_tobytes(out, &x2);
+	fe_copy(x2_out, &x2);
+	fe_copy(z2_out, &z2);
 
 	memzero_explicit(&x1, sizeof(x1));
 	memzero_explicit(&x2, sizeof(x2));
@@ -863,3 +863,90 @@ void curve25519_generic(u8 out[CURVE25519_KEY_SIZE],
 	memzero_explicit(&x3l, sizeof(x3l));
 	memzero_explicit(&e, sizeof(e));
 }
+
+void curve25519_generic(u8 out[CURVE25519_KEY_SIZE],
+			       const u8 scalar[CURVE25519_KEY_SIZE],
+			       const u8 point[CURVE25519_KEY_SIZE])
+{
+	fe x2, z2;
+
+	curve25519_ladder(&x2, &z2, scalar, point);
+	fe_invert(&z2, &z2);
+	fe_mul_ttt(&x2, &x2, &z2);
+	fe_tobytes(out, &x2);
+
+	memzero_explicit(&x2, sizeof(x2));
+	memzero_explicit(&z2, sizeof(z2));
+}
+
+#include "curve25519-comb.c"
+
+/* 1 if f is zero, 0 otherwise, without branching on f. */
+static __always_inline u32 fe_iszero(const fe *f)
+{
+	u8 s[32];
+	u32 acc = 0;
+	int i;
+
+	fe_tobytes(s, f);
+	for (i = 0; i < 32; i++)
+		acc |= s[i];
+	memzero_explicit(s, sizeof(s));
+	return 1 & ((acc - 1) >> 8);
+}
+
+/*
+ * n ladders, of which the final inversions are shared with Montgomery's
+ * simultaneous inversion trick: one inversion and 3(n - 1) multiplications
+ * instead of n inversions. A z of zero, which the single ladder maps to an
+ * output of zero, is swapped for one ahead of the trick and its output is
+ * zeroed after, so that it cannot spoil the rest of the batch. Nothing
+ * branches on the scalars, the points or the results.
+ */
+void curve25519_generic_batch(u8 *out[], const u8 *scalar[],
+			      const u8 *point[], int n)
+{
+	fe x[CURVE25519_BATCH_MAX], z[CURVE25519_BATCH_MAX];
+	fe acc[CURVE25519_BATCH_MAX], inv, one, zero;
+	u32 iszero[CURVE25519_BATCH_MAX];
+	int i;
+
+	KASSERT(n > 0 && n <= CURVE25519_BATCH_MAX,
+	    ("%s: batch of %d", __func__, n));
+
+	fe_1(&one);
+	fe_0(&zero);
+	for (i = 0; i < n; i++) {
+		curve25519_ladder(&x[i], &z[i], scalar[i], point[i]);
+		iszero[i] = fe_iszero(&z[i]);
+		fe_cmov(&z[i], &one, iszero[i]);
+		if (i == 0)
+			fe_copy(&acc[0], &z[0]);
+		else
+			fe_mul_ttt(&acc[i], &acc[i - 1], &z[i]);
+	}
+
+	fe_invert(&inv, &acc[n - 1]);
+	for (i = n - 1; i > 0; i--) {
+		fe_mul_ttt(&acc[i], &inv, &acc[i - 1]);
+		fe_mul_ttt(&inv, &inv, &z[i]);
+	}
+	fe_copy(&acc[0], &inv);
+
+	for (i = 0; i < n; i++) {
+		fe_mul_ttt(&x[i], &x[i], &acc[i]);
+		fe_cmov(&x[i], &zero, iszero[i]);
+		fe_tobytes(out[i], &x[i]);
+	}
+
+	memzero_explicit(x, sizeof(x));
+	memzero_explicit(z, sizeof(z));
+	memzero_explicit(acc, sizeof(acc));
+	memzero_explicit(&inv, sizeof(inv));
+}
+
+void curve25519_generic_base(u8 out[CURVE25519_KEY_SIZE],
+			     const u8 scalar[CURVE25519_KEY_SIZE])
+{
+	curve25519_comb_base(out, scalar);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/time.h>
+
+#include <sys/if_wg_codel.h>
+
+static u_int		wg_codel_sqrt(u_int);
+static sbintime_t	wg_codel_control(sbintime_t, u_int);
+static bool		wg_codel_ok_to_drop(struct wg_codel *, sbintime_t,
+			    sbintime_t, bool);
+
+void
+wg_codel_init(struct wg_codel *c)
+{
+	c->c_first_above = 0;
+	c->c_drop_next = 0;
+	c->c_count = 0;
+	c->c_lastcount = 0;
+	c->c_dropping = false;
+}
+
+/*
+ * Whether a packet that waited sojourn, taken off at now, is to be dropped.
+ * empty says whether it was the last one queued.
+ */
+bool
+wg_codel_drop(struct wg_codel *c, sbintime_t now, sbintime_t sojourn,
+    bool empty)
+{
+	u_int delta;
+
+	if (!wg_codel_ok_to_drop(c, now, sojourn, empty)) {
+		c->c_dropping = false;
+		return (false);
+	}
+	if (c->c_dropping) {
+		if (now < c->c_drop_next)
+			return (false);
+		c->c_count++;
+		c->c_drop_next = wg_codel_control(c->c_drop_next, c->c_count);
+		return (true);
+	}
+
+	/*
+	 * Entering the dropping state soon after leaving it picks up near
+	 * the rate it left at.
+	 */
+	c->c_dropping = true;
+	delta = c->c_count - c->c_lastcount;
+	if (delta > 1 && now - c->c_drop_next < 16 * WG_CODEL_INTERVAL)
+		c->c_count = delta;
+	else
+		c->c_count = 1;
+	c->c_lastcount = c->c_count;
+	c->c_drop_next = wg_codel_control(now, c->c_count);
+	return (true);
+}
+
+static bool
+wg_codel_ok_to_drop(struct wg_codel *c, sbintime_t now, sbintime_t sojourn,
+    bool empty)
+{
+	if (sojourn < WG_CODEL_TARGET || empty) {
+		c->c_first_above = 0;
+		return (false);
+	}
+	if (c->c_first_above == 0) {
+		c->c_first_above = now + WG_CODEL_INTERVAL;
+		return (false);
+	}
+	return (now >= c->c_first_above);
+}
+
+static sbintime_t
+wg_codel_control(sbintime_t t, u_int count)
+{
+	return (t + WG_CODEL_INTERVAL / wg_codel_sqrt(count));
+}
+
+static u_int
+wg_codel_sqrt(u_int x)
+{
+	u_int r = 0, bit = 1U << 30;
+
+	while (bit > x)
+		bit >>= 2;
+	while (bit != 0) {
+		if (x >= r + bit) {
+			x -= r + bit;
+			r = (r >> 1) + bit;
+		} else {
+			r >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (MAX(r, 1));
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+
+#include <netinet/in.h>
+
+#include <crypto/blake2s.h>
+#include <zinc/chacha20poly1305.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_cookie.h>
+
+static bool
+	wg_cookie_check_mac2(struct wg_cookie_checker *, struct mbuf *);
+
+void
+wg_precompute_key(uint8_t key[WG_KEY_SIZE],
+    const uint8_t pubkey[WG_KEY_SIZE],
+    const char *label)
+{
+	struct blake2s_state blake;
+
+	blake2s_init(&blake, WG_KEY_SIZE);
+	blake2s_update(&blake, label, strlen(label));
+	blake2s_update(&blake, pubkey, WG_KEY_SIZE);
+	blake2s_final(&blake, key, WG_KEY_SIZE);
+}
+
+void
+wg_cookie_checker_init(struct wg_cookie_checker *checker)
+{
+	mtx_init(&checker->cc_mtx, "cookie checker", NULL, MTX_DEF);
+	getnanotime(&checker->cc_secret_birthdate);
+	arc4random_buf(checker->cc_secret, WG_HASH_SIZE);
+	blake2s_init_key_compressed(&checker->cc_mac1_state, WG_COOKIE_SIZE,
+	    checker->cc_message_mac1_key, WG_KEY_SIZE);
+}
+
+/*
+ * Sets up the local identity and the cookie checker at attach, from the
+ * private key that wg_cloneattach copied into l_private before the locks
+ * existed.
+ */
+void
+wg_cookie_checker_attach(struct wg_softc *sc)
+{
+	noise_local_init(&sc->sc_local);
+	wg_cookie_checker_init(&sc->sc_cookie_checker);
+	wg_cookie_checker_set_private(sc, sc->sc_local.l_private);
+}
+
+/*
+ * Installs the interface's private key, and derives from its public half
+ * the keys MAC1 is checked and cookie replies are sealed with.
+ */
+void
+wg_cookie_checker_set_private(struct wg_softc *sc,
+    const uint8_t key[WG_KEY_SIZE])
+{
+	uint8_t private[WG_KEY_SIZE];
+
+	/* key may be l_private itself. */
+	memcpy(private, key, sizeof(private));
+	noise_local_set_private(&sc->sc_local, private);
+	explicit_bzero(private, sizeof(private));
+	wg_cookie_checker_precompute_device_keys(sc);
+}
+
+void
+wg_cookie_checker_precompute_device_keys(struct wg_softc *sc)
+{
+	mtx_lock(&sc->sc_cookie_checker.cc_mtx);
+	if (sc->sc_local.l_has_identity) {
+		wg_precompute_key(sc->sc_cookie_checker.cc_cookie_key,
+				  sc->sc_local.l_public, COOKIE_KEY_LABEL);
+		wg_precompute_key(sc->sc_cookie_checker.cc_message_mac1_key,
+				  sc->sc_local.l_public, MAC1_KEY_LABEL);
+	} else {
+		bzero(sc->sc_cookie_checker.cc_cookie_key, WG_KEY_SIZE);
+		bzero(sc->sc_cookie_checker.cc_message_mac1_key, WG_KEY_SIZE);
+	}
+	blake2s_init_key_compressed(&sc->sc_cookie_checker.cc_mac1_state,
+	    WG_COOKIE_SIZE, sc->sc_cookie_checker.cc_message_mac1_key,
+	    WG_KEY_SIZE);
+	mtx_unlock(&sc->sc_cookie_checker.cc_mtx);
+}
+
+void
+wg_cookie_init(struct wg_cookie *cookie)
+{
+	bzero(cookie, sizeof(*cookie));
+	mtx_init(&cookie->c_mtx, "cookie lock", NULL, MTX_DEF);
+}
+
+void
+wg_cookie_precompute_peer_keys(struct wg_peer *peer)
+{
+	mtx_lock(&peer->p_cookie.c_mtx);
+	wg_precompute_key(peer->p_cookie.c_decryption_key,
+			peer->p_remote.r_public, COOKIE_KEY_LABEL);
+	wg_precompute_key(peer->p_cookie.c_message_mac1_key,
+			peer->p_remote.r_public, MAC1_KEY_LABEL);
+	mtx_unlock(&peer->p_cookie.c_mtx);
+}
+
+void
+wg_compute_mac1(uint8_t mac1[WG_COOKIE_SIZE], const void *message, size_t len,
+    const uint8_t key[WG_KEY_SIZE])
+{
+	len = len - sizeof(struct wg_pkt_macs) +
+	      offsetof(struct wg_pkt_macs, mac1);
+	blake2s(mac1, message, key, WG_COOKIE_SIZE, len, WG_KEY_SIZE);
+}
+
+void
+wg_compute_mac2(uint8_t mac2[WG_COOKIE_SIZE], const void *message, size_t len,
+    const uint8_t cookie[WG_COOKIE_SIZE])
+{
+	len = len - sizeof(struct wg_pkt_macs) +
+	      offsetof(struct wg_pkt_macs, mac2);
+	blake2s(mac2, message, cookie, WG_COOKIE_SIZE, len, WG_COOKIE_SIZE);
+}
+
+void
+wg_make_cookie(uint8_t cookie[WG_COOKIE_SIZE], struct wg_endpoint *e,
+    struct wg_cookie_checker *checker)
+{
+	struct blake2s_state state;
+
+	if (wg_timers_expired(&checker->cc_secret_birthdate,
+				COOKIE_SECRET_MAX_AGE, 0)) {
+		arc4random_buf(checker->cc_secret, WG_HASH_SIZE);
+		getnanotime(&checker->cc_secret_birthdate);
+	}
+
+	blake2s_init_key(&state, WG_COOKIE_SIZE, checker->cc_secret,
+			 WG_HASH_SIZE);
+
+	if (e->e_remote.r_sa.sa_family == AF_INET) {
+		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin.sin_addr,
+			       sizeof(struct in_addr));
+		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin.sin_port,
+			       sizeof(in_port_t));
+	} else if (e->e_remote.r_sa.sa_family == AF_INET6) {
+		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin6.sin6_addr,
+			       sizeof(struct in6_addr));
+		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin6.sin6_port,
+			       sizeof(in_port_t));
+	} else {
+		panic("how did we receive this packet?");
+	}
+
+	blake2s_final(&state, cookie, WG_COOKIE_SIZE);
+}
+
+/*
+ * Checks MAC1 of a contiguous handshake packet from a copy of the keyed
+ * state, which costs one compression less than keying BLAKE2s afresh. This
+ * runs in wg_input, so that unauthenticated packets never reach the
+ * handshake queue.
+ */
+bool
+wg_cookie_check_mac1(struct wg_cookie_checker *checker, struct mbuf *m)
+{
+	struct blake2s_state state;
+	uint8_t computed_mac[WG_COOKIE_SIZE];
+	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
+		(mtod(m, uint8_t *) + m->m_pkthdr.len - sizeof(*macs));
+	bool valid;
+
+	mtx_lock(&checker->cc_mtx);
+	state = checker->cc_mac1_state;
+	mtx_unlock(&checker->cc_mtx);
+
+	blake2s_update(&state, mtod(m, uint8_t *), m->m_pkthdr.len -
+	    sizeof(*macs) + offsetof(struct wg_pkt_macs, mac1));
+	blake2s_final(&state, computed_mac, WG_COOKIE_SIZE);
+	valid = timingsafe_bcmp(computed_mac, macs->mac1, WG_COOKIE_SIZE) == 0;
+	explicit_bzero(computed_mac, sizeof(computed_mac));
+	return (valid);
+}
+
+/*
+ * Whether the packet carries MAC2 under the cookie of the endpoint it came
+ * from. Senders without a cookie zero MAC2, which costs nothing to turn
+ * away.
+ */
+static bool
+wg_cookie_check_mac2(struct wg_cookie_checker *checker, struct mbuf *m)
+{
+	static const uint8_t zero_mac[WG_COOKIE_SIZE];
+	struct wg_endpoint *e;
+	uint8_t cookie[WG_COOKIE_SIZE];
+	uint8_t computed_mac[WG_COOKIE_SIZE];
+	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
+		(mtod(m, uint8_t *) + m->m_pkthdr.len - sizeof(*macs));
+	bool valid;
+
+	if (timingsafe_bcmp(macs->mac2, zero_mac, WG_COOKIE_SIZE) == 0)
+		return (false);
+
+	e = wg_mbuf_endpoint_get(m);
+	mtx_lock(&checker->cc_mtx);
+	wg_make_cookie(cookie, e, checker);
+	mtx_unlock(&checker->cc_mtx);
+
+	wg_compute_mac2(computed_mac, mtod(m, uint8_t *), m->m_pkthdr.len,
+	    cookie);
+	valid = timingsafe_bcmp(computed_mac, macs->mac2, WG_COOKIE_SIZE) == 0;
+	explicit_bzero(cookie, sizeof(cookie));
+	return (valid);
+}
+
+/* MAC1 was checked by wg_cookie_check_mac1 before the packet was queued. */
+enum wg_cookie_mac_state
+wg_cookie_validate_packet(struct wg_cookie_checker *checker, struct mbuf *m,
+    int check_cookie)
+{
+	if (!check_cookie || !wg_cookie_check_mac2(checker, m))
+		return VALID_MAC_BUT_NO_COOKIE;
+	if (wg_ratelimiter_allow(NULL, m) != 0)
+		return VALID_MAC_WITH_COOKIE_BUT_RATELIMITED;
+	return VALID_MAC_WITH_COOKIE;
+}
+
+void
+wg_cookie_add_mac_to_packet(struct wg_cookie *cookie, void *message, size_t len)
+{
+	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
+		((uint8_t *)message + len - sizeof(*macs));
+
+	mtx_lock(&cookie->c_mtx);
+	wg_compute_mac1(macs->mac1, message, len, cookie->c_message_mac1_key);
+	memcpy(cookie->c_last_mac1_sent, macs->mac1, WG_COOKIE_SIZE);
+	cookie->c_have_sent_mac1 = 1;
+
+	if (!wg_timers_expired(&cookie->c_birthdate,
+	    COOKIE_SECRET_MAX_AGE - COOKIE_SECRET_LATENCY, 0))
+		wg_compute_mac2(macs->mac2, message, len, cookie->c_cookie);
+	else
+		bzero(macs->mac2, WG_COOKIE_SIZE);
+	mtx_unlock(&cookie->c_mtx);
+}
+
+void
+wg_cookie_message_create(struct wg_pkt_cookie *dst, struct mbuf *m,
+		uint32_t index, struct wg_cookie_checker *checker)
+{
+	struct wg_endpoint *e;
+	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
+		(mtod(m, uint8_t *) + m->m_pkthdr.len - sizeof(*macs));
+	uint8_t cookie[WG_COOKIE_SIZE];
+
+	dst->header.type = WG_PKT_COOKIE;
+	dst->receiver_index = index;
+	arc4random_buf(dst->nonce, WG_XNONCE_SIZE);
+
+	e = wg_mbuf_endpoint_get(m);
+
+	mtx_lock(&checker->cc_mtx);
+	wg_make_cookie(cookie, e, checker);
+	xchacha20poly1305_encrypt(dst->encrypted_cookie, cookie, WG_COOKIE_SIZE,
+			  macs->mac1, WG_MAC_SIZE, dst->nonce,
+			  checker->cc_cookie_key);
+	mtx_unlock(&checker->cc_mtx);
+
+	explicit_bzero(cookie, sizeof(cookie));
+}
+
+void
+wg_cookie_message_consume(struct wg_pkt_cookie *src, struct wg_softc *sc)
+{
+	struct wg_peer *peer;
+	struct noise_keypair *keypair;
+	uint8_t cookie[WG_COOKIE_SIZE];
+
+	if ((keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
+			src->receiver_index)) == NULL)
+		return;
+
+	peer = keypair->k_peer;
+
+	mtx_lock(&peer->p_cookie.c_mtx);
+
+	if (!peer->p_cookie.c_have_sent_mac1)
+		goto out;
+
+	if (xchacha20poly1305_decrypt(cookie, src->encrypted_cookie,
+			sizeof(src->encrypted_cookie),
+			peer->p_cookie.c_last_mac1_sent, WG_MAC_SIZE,
+			src->nonce, peer->p_cookie.c_decryption_key) != 0) {
+		DPRINTF(sc, "Could not decrypt invalid cookie response\n");
+		goto out;
+	}
+
+	memcpy(peer->p_cookie.c_cookie, cookie, WG_COOKIE_SIZE);
+	getnanotime(&peer->p_cookie.c_birthdate);
+	peer->p_cookie.c_have_sent_mac1 = 0;
+
+out:
+	mtx_unlock(&peer->p_cookie.c_mtx);
+	explicit_bzero(cookie, sizeof(cookie));
+	noise_keypair_put(keypair);
+}
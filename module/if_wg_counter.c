@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+
+/*
+ * The nonces of a keypair: handed out in order to the packets sent with it,
+ * and checked against a sliding window of COUNTER_WINDOW_SIZE on receipt, so
+ * that each is accepted at most once.
+ */
+void
+wg_counter_init(struct wg_counter *ctr)
+{
+	bzero(ctr, sizeof(*ctr));
+	mtx_init(&ctr->c_mtx, "counter lock", NULL, MTX_DEF);
+}
+
+/* The first of n consecutive nonces, reserved together. */
+uint64_t
+wg_counter_next(struct wg_counter *ctr, u_int n)
+{
+	return (atomic_fetchadd_64(&ctr->c_send, n));
+}
+
+int
+wg_counter_validate(struct wg_counter *ctr, uint64_t recv)
+{
+	uint64_t i, top, index_recv, index_ctr;
+	COUNTER_TYPE bit;
+	int ret = EEXIST;
+
+	mtx_lock(&ctr->c_mtx);
+
+	/* Check that the recv counter is valid */
+	if (ctr->c_recv >= REJECT_AFTER_MESSAGES ||
+	    recv >= REJECT_AFTER_MESSAGES)
+		goto invalid;
+
+	/* If the packet is out of the window, invalid */
+	if (recv + COUNTER_WINDOW_SIZE < ctr->c_recv)
+		goto invalid;
+
+	/* If the new counter is ahead of the current counter, we'll need to
+	 * zero out the bitmap that has previously been used */
+	index_recv = recv / COUNTER_TYPE_BITS;
+	index_ctr = ctr->c_recv / COUNTER_TYPE_BITS;
+
+	if (index_recv > index_ctr) {
+		top = MIN(index_recv - index_ctr, COUNTER_TYPE_NUM);
+		for (i = 1; i <= top; i++)
+			ctr->c_backtrack[
+			    (i + index_ctr) & (COUNTER_TYPE_NUM - 1)] = 0;
+		atomic_store_rel_64(&ctr->c_recv, recv);
+	}
+
+	index_recv %= COUNTER_TYPE_NUM;
+	bit = 1 << (recv % COUNTER_TYPE_BITS);
+
+	if (ctr->c_backtrack[index_recv] & bit)
+		goto invalid;
+
+	ctr->c_backtrack[index_recv] |= bit;
+
+	ret = 0;
+invalid:
+	mtx_unlock(&ctr->c_mtx);
+	return ret;
+}
+
+/*
+ * Whether wg_counter_validate is bound to refuse recv, judged without the
+ * lock. The window only moves forward, so a nonce that has fallen behind it
+ * stays behind. A bit seen set may belong to a later word that has taken
+ * over the slot since c_recv was read, but only once recv's own word has
+ * left the window; and a bit that is cleared under us lets the packet
+ * through, to be judged again after it is decrypted.
+ */
+bool
+wg_counter_stale(struct wg_counter *ctr, uint64_t recv)
+{
+	uint64_t cur;
+
+	cur = atomic_load_acq_64(&ctr->c_recv);
+	if (cur >= REJECT_AFTER_MESSAGES || recv >= REJECT_AFTER_MESSAGES)
+		return (true);
+	if (recv + COUNTER_WINDOW_SIZE < cur)
+		return (true);
+	if (recv / COUNTER_TYPE_BITS > cur / COUNTER_TYPE_BITS)
+		return (false);
+	return ((ctr->c_backtrack[(recv / COUNTER_TYPE_BITS) %
+	    COUNTER_TYPE_NUM] & (1 << (recv % COUNTER_TYPE_BITS))) != 0);
+}
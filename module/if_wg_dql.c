@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+
+#include <sys/if_wg_dql.h>
+
+static void	wg_dql_fold(struct wg_dql *, u_int, u_int);
+
+/* Starts at limit, taken to be delay ms of work. */
+void
+wg_dql_init(struct wg_dql *d, u_int limit, u_int min, u_int max,
+    u_int delay)
+{
+	d->d_min = min;
+	d->d_max = max;
+	d->d_delay = delay;
+	d->d_limit = limit;
+	d->d_rate = (uint64_t)limit * 1000 / delay;
+	d->d_watermark = 0;
+	d->d_start = ticks;
+	d->d_served = 0;
+	d->d_high = 0;
+	d->d_drained = 0;
+}
+
+/* The consumer took n off the queue and left len on it. */
+void
+wg_dql_served(struct wg_dql *d, u_int n, u_int len)
+{
+	u_int now, start;
+
+	atomic_add_int(&d->d_served, n);
+	if (len == 0)
+		atomic_store_int(&d->d_drained, 1);
+
+	now = ticks;
+	start = atomic_load_int(&d->d_start);
+	if ((int)(now - start) < MAX(hz * WG_DQL_INTERVAL_MS / 1000, 1))
+		return;
+	if (atomic_cmpset_int(&d->d_start, start, now))
+		wg_dql_fold(d, start, now);
+}
+
+/*
+ * Folds the interval from start to now into the rate and the limit. One
+ * that ran to twice its length went without reports for a while, so the
+ * consumer sat idle in it.
+ */
+static void
+wg_dql_fold(struct wg_dql *d, u_int start, u_int now)
+{
+	uint64_t rate, limit;
+	u_int served;
+	bool drained;
+
+	served = atomic_readandclear_int(&d->d_served);
+	drained = atomic_readandclear_int(&d->d_drained) != 0 ||
+	    (int)(now - start) > 2 * MAX(hz * WG_DQL_INTERVAL_MS / 1000, 1);
+	rate = (uint64_t)served * hz / (int)(now - start);
+
+	if (!drained) {
+		d->d_rate -= d->d_rate >> WG_DQL_RATE_WEIGHT;
+		d->d_rate += MIN(rate, UINT_MAX) >> WG_DQL_RATE_WEIGHT;
+	} else if (rate > d->d_rate) {
+		d->d_rate = MIN(rate, UINT_MAX);
+	}
+
+	limit = (uint64_t)d->d_rate * d->d_delay / 1000;
+	atomic_store_int(&d->d_limit, MAX(d->d_min, MIN(limit, d->d_max)));
+	d->d_watermark = atomic_readandclear_int(&d->d_high);
+}
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+
+#include <net/if.h>
+#include <net/if_var.h>
+
+#include <netinet/in.h>
+#include <netinet/ip.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_mbuf.h>
+#include <sys/wg_module.h>
+
+/* How a peer's turn at the encrypt queue ended. */
+enum wg_drr_turn {
+	WG_DRR_DONE,	/* Nothing more to queue, or no key to queue it with. */
+	WG_DRR_NEXT,	/* Out of deficit; to the back of the line. */
+	WG_DRR_FULL,	/* Out of room; first in line when there is more. */
+};
+
+static bool
+	wg_peer_encrypt_staged_packets(struct wg_peer *);
+static enum wg_drr_turn
+	wg_peer_drr_turn(struct wg_peer *, u_int, bool *);
+static bool
+	wg_softc_encrypt_stop(struct wg_softc *, u_int);
+
+/*
+ * Stages a packet for encryption, stamped with the time for CoDel. The
+ * packet is consumed either way. While the encrypt path is stopped a peer
+ * that already has packets waiting is refused with ENOBUFS, which reaches
+ * the sender through ip_output; TCP backs off on it at once, where a drop
+ * further on would cost it a retransmit timeout or duplicate ACKs.
+ *
+ * A TCP segment left to TSO is cut here, on the sending CPU, and its
+ * packets are staged together or not at all. The first of them records how
+ * many there are, so the encrypt queue takes them in one turn, under one
+ * keypair lookup and with consecutive nonces.
+ */
+int
+wg_peer_stage(struct wg_peer *peer, struct mbuf *m)
+{
+	struct wg_softc *sc = peer->p_sc;
+	struct wg_queue_pkt *pkt, *first = NULL;
+	struct mbufq mq;
+	struct mbuf *n;
+	sbintime_t now;
+	u_int len, train;
+	int error;
+
+	mbufq_init(&mq, IP_MAXPACKET);
+	if (m->m_pkthdr.csum_flags & CSUM_TSO) {
+		if ((error = wg_mbuf_tso(m, &mq)) != 0) {
+			if_inc_counter(sc->sc_ifp, IFCOUNTER_OERRORS, 1);
+			return (error);
+		}
+	} else {
+		wg_mbuf_csum(m);
+		mbufq_enqueue(&mq, m);
+	}
+
+	now = sbinuptime();
+	train = mbufq_len(&mq);
+	for (n = mbufq_first(&mq); n != NULL; n = STAILQ_NEXT(n, m_stailqpkt)) {
+		if ((pkt = wg_mbuf_pkt_get(n)) == NULL)
+			goto drop;
+		pkt->p_staged = now;
+		pkt->p_train = 0;
+		pkt->p_train_len = 0;
+		if (first == NULL)
+			first = pkt;
+		first->p_train_len += n->m_pkthdr.len;
+	}
+	first->p_train = train;
+
+	mtx_lock(&peer->p_lock);
+	len = mbufq_len(&peer->p_staged_packets);
+	if (len != 0 && atomic_load_int(&sc->sc_encrypt_stopped) != 0) {
+		mtx_unlock(&peer->p_lock);
+		counter_u64_add(wg_send_refused, train);
+		goto drop;
+	}
+	if (len != 0 && len + train > wg_dql_limit(&sc->sc_encrypt_dql)) {
+		mtx_unlock(&peer->p_lock);
+		goto drop;
+	}
+	mbufq_concat(&peer->p_staged_packets, &mq);
+	mtx_unlock(&peer->p_lock);
+	return (0);
+drop:
+	if_inc_counter(sc->sc_ifp, IFCOUNTER_OQDROPS, train);
+	mbufq_drain(&mq);
+	return (ENOBUFS);
+}
+
+/*
+ * Like wg_peer_send_keepalive, but leaves kicking sc_encrypt to the caller,
+ * which it has to do if this returns true.
+ */
+bool
+wg_peer_stage_keepalive(struct wg_peer *peer)
+{
+	struct mbuf *m;
+
+	if (mbufq_len(&peer->p_staged_packets) == 0 &&
+	    (m = m_gethdr(M_NOWAIT, MT_DATA)) != NULL &&
+	    wg_peer_stage(peer, m) == 0) {
+		DPRINTF(peer->p_sc, "Sending keepalive packet to peer %llu\n",
+				peer->p_id);
+	}
+
+	return (wg_peer_encrypt_staged_packets(peer));
+}
+
+void
+wg_peer_send_keepalive(struct wg_peer *peer)
+{
+	if (wg_peer_stage_keepalive(peer))
+		GROUPTASK_ENQUEUE(&peer->p_sc->sc_encrypt);
+}
+
+void
+wg_peer_send_staged_packets(struct wg_peer *peer)
+{
+	if (wg_peer_encrypt_staged_packets(peer))
+		GROUPTASK_ENQUEUE(&peer->p_sc->sc_encrypt);
+}
+
+/*
+ * Puts the peer in line for the encrypt queue and serves the line, returning
+ * true if any packets were queued. The caller kicks sc_encrypt.
+ */
+static bool
+wg_peer_encrypt_staged_packets(struct wg_peer *peer)
+{
+	struct wg_softc *sc = peer->p_sc;
+
+	mtx_lock(&sc->sc_drr.d_mtx);
+	if (!peer->p_drr_active) {
+		wg_peer_ref(peer);
+		peer->p_drr_active = true;
+		peer->p_drr_deficit = WG_DRR_QUANTUM;
+		TAILQ_INSERT_TAIL(&sc->sc_drr.d_active, peer, p_drr_entry);
+	}
+	mtx_unlock(&sc->sc_drr.d_mtx);
+	return (wg_softc_drr_run(sc, false));
+}
+
+/*
+ * Serves the peers in line, deficit round-robin, until none is left or the
+ * encrypt path is full, and returns true if any packets were queued. A
+ * caller that finds the line already being served may leave it, unless
+ * block is set: whoever serves it sees every peer put in line before it
+ * lets go, and the encrypt path serves it again once it has room.
+ */
+bool
+wg_softc_drr_run(struct wg_softc *sc, bool block)
+{
+	struct wg_drr *d = &sc->sc_drr;
+	struct wg_peer *peer;
+	enum wg_drr_turn turn;
+	u_int limit, len;
+	bool queued = false;
+
+	if (block)
+		mtx_lock(&d->d_mtx);
+	else if (!mtx_trylock(&d->d_mtx))
+		return (false);
+
+	while ((peer = TAILQ_FIRST(&d->d_active)) != NULL) {
+		limit = wg_dql_limit(&sc->sc_encrypt_dql);
+		len = atomic_load_int(&sc->sc_encrypt_pending);
+		if (len >= limit) {
+			if (wg_softc_encrypt_stop(sc, limit))
+				break;
+			continue;
+		}
+		turn = wg_peer_drr_turn(peer, limit - len, &queued);
+		if (turn == WG_DRR_FULL)
+			break;
+		TAILQ_REMOVE(&d->d_active, peer, p_drr_entry);
+		if (turn == WG_DRR_NEXT) {
+			peer->p_drr_deficit += WG_DRR_QUANTUM;
+			TAILQ_INSERT_TAIL(&d->d_active, peer, p_drr_entry);
+			continue;
+		}
+		peer->p_drr_active = false;
+		wg_peer_put(peer);
+	}
+	mtx_unlock(&d->d_mtx);
+
+	if (queued)
+		wg_dql_queued(&sc->sc_encrypt_dql,
+		    atomic_load_int(&sc->sc_encrypt_pending));
+	return (queued);
+}
+
+/*
+ * Stops the encrypt path taking staged packets, the peers in line waiting
+ * for encryptions to complete. It starts again once they are down to half
+ * the limit; if they already are, this leaves it running and returns false.
+ */
+static bool
+wg_softc_encrypt_stop(struct wg_softc *sc, u_int limit)
+{
+	if (atomic_cmpset_int(&sc->sc_encrypt_stopped, 0, 1))
+		counter_u64_add(wg_send_stops, 1);
+	/* Either wg_softc_encrypt_done sees it stopped, or this sees room. */
+	atomic_thread_fence_seq_cst();
+	if (atomic_load_int(&sc->sc_encrypt_pending) > limit / 2)
+		return (true);
+	atomic_cmpset_int(&sc->sc_encrypt_stopped, 1, 0);
+	return (false);
+}
+
+/* A packet admitted by wg_softc_drr_run is done with encryption. */
+void
+wg_softc_encrypt_done(struct wg_softc *sc)
+{
+	u_int pending;
+
+	pending = atomic_fetchadd_int(&sc->sc_encrypt_pending, -1) - 1;
+	wg_dql_served(&sc->sc_encrypt_dql, 1, pending);
+	atomic_thread_fence_seq_cst();
+	if (atomic_load_int(&sc->sc_encrypt_stopped) != 0 &&
+	    pending <= wg_dql_limit(&sc->sc_encrypt_dql) / 2 &&
+	    atomic_cmpset_int(&sc->sc_encrypt_stopped, 1, 0))
+		GROUPTASK_ENQUEUE(&sc->sc_encrypt);
+}
+
+void
+wg_softc_drr_remove(struct wg_softc *sc, struct wg_peer *peer)
+{
+	bool active;
+
+	mtx_lock(&sc->sc_drr.d_mtx);
+	if ((active = peer->p_drr_active)) {
+		TAILQ_REMOVE(&sc->sc_drr.d_active, peer, p_drr_entry);
+		peer->p_drr_active = false;
+	}
+	mtx_unlock(&sc->sc_drr.d_mtx);
+	if (active)
+		wg_peer_put(peer);
+}
+
+/*
+ * One turn of the peer at the encrypt queue. Its staged packets are queued
+ * for as long as they fit its deficit and the room left, less those CoDel
+ * drops for having waited too long. Without a valid key they stay staged,
+ * and the handshake puts the peer back in line when it completes. The
+ * packets of a TSO segment go together, and into an empty turn even if
+ * they overrun the room, or a segment cut finer than it would never fit.
+ */
+static enum wg_drr_turn
+wg_peer_drr_turn(struct wg_peer *peer, u_int room, bool *queued)
+{
+	struct wg_softc *sc = peer->p_sc;
+	struct noise_keypair *keypair;
+	struct wg_queue_pkt *pkt, *head;
+	struct mbufq mq, ready, drops;
+	struct mbuf *m;
+	enum wg_drr_turn turn = WG_DRR_DONE;
+	sbintime_t now;
+	uint64_t nonce;
+	u_int train, train_len;
+	bool stale = false;
+
+	NET_EPOCH_ASSERT();
+	mtx_assert(&sc->sc_drr.d_mtx, MA_OWNED);
+
+	/* First we make sure we have a valid reference to a valid key. */
+	keypair = noise_keypairs_lookup(&peer->p_keypairs,
+	    NOISE_KEYPAIR_CURRENT);
+
+	if (keypair == NULL || wg_timers_expired(&keypair->k_birthdate,
+						 REJECT_AFTER_TIME, 0)) {
+		/*
+		 * If we're exiting because there's something wrong with the
+		 * key, it means we should initiate a new handshake.
+		 */
+		wg_peer_queue_handshake_initiation(peer, 0);
+		noise_keypair_put(keypair);
+		return (WG_DRR_DONE);
+	}
+
+	mbufq_init(&mq, WG_PKTQ_MAX);
+	mbufq_init(&drops, WG_PKTQ_MAX);
+	now = sbinuptime();
+	mtx_lock(&peer->p_lock);
+	while ((m = mbufq_first(&peer->p_staged_packets)) != NULL) {
+		pkt = wg_mbuf_pkt_get(m);
+		if (pkt != NULL && pkt->p_train != 0) {
+			train = pkt->p_train;
+			train_len = pkt->p_train_len;
+		} else {
+			train = 1;
+			train_len = m->m_pkthdr.len;
+		}
+		if (mbufq_len(&mq) != 0 && mbufq_len(&mq) + train > room) {
+			turn = WG_DRR_FULL;
+			break;
+		}
+		if (train_len > peer->p_drr_deficit) {
+			turn = WG_DRR_NEXT;
+			break;
+		}
+		peer->p_drr_deficit -= train_len;
+		for (head = NULL; train > 0; train--) {
+			m = mbufq_dequeue(&peer->p_staged_packets);
+			if ((pkt = wg_mbuf_pkt_get(m)) == NULL ||
+			    wg_codel_drop(&peer->p_codel, now,
+			    now - pkt->p_staged,
+			    mbufq_len(&peer->p_staged_packets) == 0)) {
+				peer->p_drr_deficit += m->m_pkthdr.len;
+				mbufq_enqueue(&drops, m);
+				continue;
+			}
+			/* What CoDel leaves of the train is still one. */
+			pkt->p_train = 0;
+			if (head == NULL) {
+				head = pkt;
+				head->p_train_len = 0;
+			}
+			head->p_train++;
+			head->p_train_len += m->m_pkthdr.len;
+			mbufq_enqueue(&mq, m);
+		}
+	}
+	mtx_unlock(&peer->p_lock);
+
+	if (mbufq_len(&drops) != 0) {
+		if_inc_counter(sc->sc_ifp, IFCOUNTER_OQDROPS,
+		    mbufq_len(&drops));
+		counter_u64_add(wg_send_codel_drops, mbufq_len(&drops));
+		mbufq_drain(&drops);
+	}
+
+	/*
+	 * After we know we have a somewhat valid key, we now try to assign
+	 * nonces to all of the packets in the queue. If we can't assign nonces
+	 * for all of them, we just consider it a failure and wait for the next
+	 * handshake. A train takes its nonces in one go, so it goes out whole
+	 * under this keypair or waits whole for the next.
+	 */
+	mbufq_init(&ready, WG_PKTQ_MAX);
+	while ((m = mbufq_first(&mq)) != NULL) {
+		train = wg_mbuf_pkt_get(m)->p_train;
+		nonce = wg_counter_next(&keypair->k_counter, train);
+		if (nonce > REJECT_AFTER_MESSAGES - train) {
+			stale = true;
+			break;
+		}
+
+		for (; train > 0; train--) {
+			m = mbufq_dequeue(&mq);
+			pkt = wg_mbuf_pkt_get(m);
+			pkt->p_state = WG_PKT_STATE_CLEAR;
+			pkt->p_nonce = nonce++;
+			pkt->p_keypair = keypair;
+			mbufq_enqueue(&ready, m);
+		}
+	}
+
+	/*
+	 * Every queued packet owns a keypair reference. They are taken in
+	 * one go before the packets become visible to the encrypt workers,
+	 * and the lookup's own reference goes to the first packet.
+	 */
+	if (mbufq_len(&ready) == 0)
+		noise_keypair_put(keypair);
+	else if (mbufq_len(&ready) > 1)
+		refcount_acquiren(&keypair->k_refcnt, mbufq_len(&ready) - 1);
+	if (mbufq_len(&ready) != 0) {
+		atomic_add_int(&sc->sc_encrypt_pending, mbufq_len(&ready));
+		*queued = true;
+	}
+	while ((m = mbufq_dequeue(&ready)) != NULL)
+		wg_pktq_enqueue(&sc->sc_encrypt_queue, &peer->p_send_queue,
+				wg_mbuf_pkt_get(m));
+
+	if (!stale)
+		return (turn);
+	wg_peer_queue_handshake_initiation(peer, 0);
+
+	/*
+	 * The packets that found the nonces used up go back ahead of any that
+	 * were staged since, to wait for the next key, trains and all.
+	 */
+	if (mbufq_len(&mq) != 0) {
+		mtx_lock(&peer->p_lock);
+		mbufq_concat(&mq, &peer->p_staged_packets);
+		mbufq_concat(&peer->p_staged_packets, &mq);
+		mtx_unlock(&peer->p_lock);
+	}
+	return (WG_DRR_DONE);
+}
+
+void
+wg_peer_send_staged_packets_ref(struct wg_peer *peer)
+{
+	wg_peer_send_staged_packets(peer);
+	wg_peer_put(peer);
+}
+
+void
+wg_peer_flush_staged_packets(struct wg_peer *peer)
+{
+	mbufq_drain(&peer->p_staged_packets);
+}
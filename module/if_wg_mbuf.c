@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/endian.h>
+#include <vm/uma.h>
+
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/ip_var.h>
+#include <netinet/ip6.h>
+#include <netinet6/ip6_var.h>
+#include <netinet/tcp.h>
+#include <machine/in_cksum.h>
+
+#include <zinc/chacha20poly1305.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_mbuf.h>
+
+/* The room a data message takes around its plaintext of len bytes. */
+#define WG_MBUF_LEAD		(WG_IPUDP_HDR_MAX + sizeof(struct wg_pkt_data))
+#define WG_MBUF_TRAIL(len)	(WG_PADDING_SIZE(len) + WG_MAC_SIZE)
+
+static struct mbuf *
+	wg_mbuf_get(int);
+static struct mbuf *
+	wg_mbuf_unshare(struct mbuf *, int, int);
+static struct mbuf *
+	wg_mbuf_tso_segment(struct mbuf *, int, int, int);
+static struct wg_pkt_tag *
+	wg_mbuf_tag_find(struct mbuf *);
+static void
+	wg_mbuf_tag_free(struct m_tag *);
+
+/*
+ * Per-packet state is an mbuf tag whose storage comes from this zone,
+ * preallocated for a full parallel queue per CPU, so the data path takes
+ * it from a per-CPU bucket and it goes back when the mbuf is freed.
+ */
+uma_zone_t wg_pkt_zone;
+
+/* A packet header mbuf with one buffer of at least size bytes. */
+static struct mbuf *
+wg_mbuf_get(int size)
+{
+	if (size <= MJUMPAGESIZE)
+		return (m_get2(size, M_NOWAIT, MT_DATA, M_PKTHDR));
+	if (size <= MJUM9BYTES)
+		return (m_getjcl(M_NOWAIT, MT_DATA, M_PKTHDR, MJUM9BYTES));
+	if (size <= MJUM16BYTES)
+		return (m_getjcl(M_NOWAIT, MT_DATA, M_PKTHDR, MJUM16BYTES));
+	return (NULL);
+}
+
+/*
+ * Returns m as a single writable mbuf with lead bytes free in front of the
+ * data and trail behind, or NULL with m untouched if that takes a buffer
+ * that cannot be had. A copy takes over the packet header and its tags, so
+ * a queue entry kept in a tag follows it, and m is freed.
+ */
+static struct mbuf *
+wg_mbuf_unshare(struct mbuf *m, int lead, int trail)
+{
+	struct mbuf *n;
+	int len = m->m_pkthdr.len;
+
+	if (m->m_next == NULL && M_WRITABLE(m) &&
+	    M_LEADINGSPACE(m) >= lead && M_TRAILINGSPACE(m) >= trail)
+		return (m);
+
+	if ((n = wg_mbuf_get(lead + len + trail)) == NULL)
+		return (NULL);
+	m_move_pkthdr(n, m);
+	n->m_data += lead;
+	m_copydata(m, 0, len, mtod(n, caddr_t));
+	n->m_len = len;
+	m_freem(m);
+	return (n);
+}
+
+/*
+ * Frames the plaintext in m as a data message to the receiver index with
+ * the counter nonce: header in front, zero padding and room for the tag
+ * behind, all in one writable mbuf, which is returned. Room for the outer
+ * IP and UDP header is left in front as well, so that prepending it later
+ * cannot fail and take the queue entry with it. NULL means no buffer could
+ * be had, and m is left as it was.
+ */
+struct mbuf *
+wg_mbuf_data_frame(struct mbuf *m, uint32_t index, uint64_t nonce)
+{
+	struct wg_pkt_data *data;
+	int padding_len;
+
+	padding_len = WG_PADDING_SIZE(m->m_pkthdr.len);
+	m = wg_mbuf_unshare(m, WG_MBUF_LEAD, WG_MBUF_TRAIL(m->m_pkthdr.len));
+	if (m == NULL)
+		return (NULL);
+
+	bzero(mtod(m, caddr_t) + m->m_len, padding_len + WG_MAC_SIZE);
+	m->m_data -= sizeof(struct wg_pkt_data);
+	m->m_len += sizeof(struct wg_pkt_data) + padding_len + WG_MAC_SIZE;
+	m->m_pkthdr.len = m->m_len;
+
+	data = mtod(m, struct wg_pkt_data *);
+	data->header.type = WG_PKT_DATA;
+	data->receiver_index = index;
+	data->nonce = htole64(nonce);
+	return (m);
+}
+
+/* Encrypts a framed data message in place, the tag into the room left. */
+void
+wg_mbuf_data_seal(struct mbuf *m, const uint8_t *key)
+{
+	struct wg_pkt_data *data;
+
+	MPASS(m->m_next == NULL && M_WRITABLE(m));
+	data = mtod(m, struct wg_pkt_data *);
+	chacha20poly1305_encrypt(data->buf, data->buf,
+	    m->m_len - sizeof(struct wg_pkt_data) - WG_MAC_SIZE, NULL, 0,
+	    le64toh(data->nonce), key);
+}
+
+/*
+ * One packet of a TSO segment: the hlen bytes of headers of m and the len
+ * bytes of payload at off, copied into a buffer of its own with the room
+ * wg_mbuf_data_frame leaves around a data message, so it is framed where it
+ * lies. NULL means no buffer could be had.
+ */
+static struct mbuf *
+wg_mbuf_tso_segment(struct mbuf *m, int hlen, int off, int len)
+{
+	struct mbuf *n;
+
+	if ((n = wg_mbuf_get(WG_MBUF_LEAD + hlen + len +
+	    WG_MBUF_TRAIL(hlen + len))) == NULL)
+		return (NULL);
+	if (m_dup_pkthdr(n, m, M_NOWAIT) == 0) {
+		m_freem(n);
+		return (NULL);
+	}
+	n->m_data += WG_MBUF_LEAD;
+	m_copydata(m, 0, hlen, mtod(n, caddr_t));
+	m_copydata(m, off, len, mtod(n, caddr_t) + hlen);
+	n->m_len = n->m_pkthdr.len = hlen + len;
+	n->m_pkthdr.csum_flags = 0;
+	n->m_pkthdr.tso_segsz = 0;
+	return (n);
+}
+
+/*
+ * Cuts a TCP segment left to TSO into packets of at most tso_segsz payload
+ * bytes, appended to mq with their checksums done. Each is one writable
+ * mbuf, whatever chain and shared clusters the segment came in, and is
+ * sealed without being copied again. m is consumed either way.
+ */
+int
+wg_mbuf_tso(struct mbuf *m, struct mbufq *mq)
+{
+	struct ip *ip;
+	struct ip6_hdr *ip6;
+	struct tcphdr *th;
+	struct mbuf *n;
+	uint32_t seq;
+	uint16_t id;
+	int iphlen, hlen, tlen, off, len, segsz, total, error = EINVAL;
+	bool v4;
+
+	segsz = m->m_pkthdr.tso_segsz;
+	total = m->m_pkthdr.len;
+	if (total < (int)sizeof(struct ip))
+		goto out;
+	if ((m = m_pullup(m, sizeof(struct ip))) == NULL)
+		return (ENOBUFS);
+	switch (mtod(m, struct ip *)->ip_v) {
+	case IPVERSION:
+		iphlen = mtod(m, struct ip *)->ip_hl << 2;
+		v4 = true;
+		break;
+	case IPV6_VERSION >> 4:
+		iphlen = sizeof(struct ip6_hdr);
+		v4 = false;
+		break;
+	default:
+		goto out;
+	}
+	if (total < iphlen + (int)sizeof(struct tcphdr))
+		goto out;
+	if ((m = m_pullup(m, iphlen + sizeof(struct tcphdr))) == NULL)
+		return (ENOBUFS);
+	if ((v4 ? mtod(m, struct ip *)->ip_p :
+	    mtod(m, struct ip6_hdr *)->ip6_nxt) != IPPROTO_TCP)
+		goto out;
+	th = (struct tcphdr *)(mtod(m, char *) + iphlen);
+	hlen = iphlen + (th->th_off << 2);
+	if (segsz <= 0 || total <= hlen || hlen > MHLEN)
+		goto out;
+	if ((m = m_pullup(m, hlen)) == NULL)
+		return (ENOBUFS);
+	th = (struct tcphdr *)(mtod(m, char *) + iphlen);
+	seq = ntohl(th->th_seq);
+	id = v4 ? ntohs(mtod(m, struct ip *)->ip_id) : 0;
+
+	for (off = hlen; off < total; off += len) {
+		len = MIN(segsz, total - off);
+		if ((n = wg_mbuf_tso_segment(m, hlen, off, len)) == NULL)
+			goto nobufs;
+		tlen = hlen - iphlen + len;
+
+		th = (struct tcphdr *)(mtod(n, char *) + iphlen);
+		th->th_seq = htonl(seq + (off - hlen));
+		if (off + len < total)
+			th->th_flags &= ~(TH_FIN | TH_PUSH);
+		if (off != hlen)
+			th->th_flags &= ~TH_CWR;
+		if (v4) {
+			ip = mtod(n, struct ip *);
+			ip->ip_len = htons(hlen + len);
+			ip->ip_id = htons(id);
+			id++;
+			ip->ip_sum = 0;
+			ip->ip_sum = in_cksum(n, iphlen);
+			th->th_sum = in_pseudo(ip->ip_src.s_addr,
+			    ip->ip_dst.s_addr, htons(tlen + IPPROTO_TCP));
+		} else {
+			ip6 = mtod(n, struct ip6_hdr *);
+			ip6->ip6_plen = htons(tlen);
+			th->th_sum = in6_cksum_pseudo(ip6, tlen, IPPROTO_TCP, 0);
+		}
+		th->th_sum = in_cksum_skip(n, hlen + len, iphlen);
+		mbufq_enqueue(mq, n);
+	}
+	error = 0;
+	goto out;
+nobufs:
+	mbufq_drain(mq);
+	error = ENOBUFS;
+out:
+	m_freem(m);
+	return (error);
+}
+
+/*
+ * Finishes the checksums the stack left to the interface, which would
+ * otherwise be sealed in unfinished.
+ */
+void
+wg_mbuf_csum(struct mbuf *m)
+{
+	struct ip *ip;
+	int nxt, off;
+
+	if (m->m_pkthdr.csum_flags & CSUM_IP) {
+		ip = mtod(m, struct ip *);
+		ip->ip_sum = 0;
+		ip->ip_sum = in_cksum(m, ip->ip_hl << 2);
+	}
+	if (m->m_pkthdr.csum_flags & CSUM_DELAY_DATA) {
+		in_delayed_cksum(m);
+	} else if (m->m_pkthdr.csum_flags & CSUM_DELAY_DATA_IPV6) {
+		nxt = -1;
+		off = ip6_lasthdr(m, 0, IPPROTO_IPV6, &nxt);
+		if (off > 0)
+			in6_delayed_cksum(m, m->m_pkthdr.len - off, off);
+	}
+	m->m_pkthdr.csum_flags &=
+	    ~(CSUM_IP | CSUM_DELAY_DATA | CSUM_DELAY_DATA_IPV6);
+}
+
+static struct wg_pkt_tag *
+wg_mbuf_tag_find(struct mbuf *m)
+{
+	MPASS(m->m_flags & M_PKTHDR);
+	return ((struct wg_pkt_tag *)m_tag_locate(m, MTAG_WG, 0, NULL));
+}
+
+/*
+ * wg_input tags every packet it accepts and records where it came from, so
+ * the handshake path always finds an endpoint here.
+ */
+struct wg_endpoint *
+wg_mbuf_endpoint_get(struct mbuf *m)
+{
+	struct wg_pkt_tag *t;
+
+	t = wg_mbuf_tag_find(m);
+	KASSERT(t != NULL, ("%s: untagged packet", __func__));
+	return (&t->t_endpoint);
+}
+
+/*
+ * Returns the queue entry of a packet, tagging it on first use. The tag is
+ * taken from wg_pkt_zone and never needs a new mbuf; NULL means the zone is
+ * exhausted and the caller drops the packet.
+ */
+struct wg_queue_pkt *
+wg_mbuf_pkt_get(struct mbuf *m)
+{
+	struct wg_pkt_tag *t;
+
+	if ((t = wg_mbuf_tag_find(m)) != NULL)
+		return (&t->t_pkt);
+	if ((t = uma_zalloc(wg_pkt_zone, M_NOWAIT)) == NULL)
+		return (NULL);
+	m_tag_setup(&t->t_tag, MTAG_WG, 0,
+	    sizeof(*t) - sizeof(struct m_tag));
+	t->t_tag.m_tag_free = wg_mbuf_tag_free;
+	bzero(&t->t_pkt, sizeof(t->t_pkt));
+	t->t_pkt.p_pkt = m;
+	m_tag_prepend(m, &t->t_tag);
+	return (&t->t_pkt);
+}
+
+/* Returns the entry to the zone before the packet leaves the driver. */
+void
+wg_mbuf_pkt_detach(struct wg_queue_pkt *pkt)
+{
+	struct wg_pkt_tag *t = __containerof(pkt, struct wg_pkt_tag, t_pkt);
+
+	m_tag_delete(pkt->p_pkt, &t->t_tag);
+}
+
+static void
+wg_mbuf_tag_free(struct m_tag *tag)
+{
+	uma_zfree(wg_pkt_zone, tag);
+}
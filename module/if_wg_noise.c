@@ -0,0 +1,1143 @@
+/*
+ * Copyright (c) 2019 Matt Dunwoodie <ncon@noconroy.net>
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/malloc.h>
+#include <sys/refcount.h>
+#include <sys/endian.h>
+#include <sys/epoch.h>
+#include <sys/pcpu.h>
+#include <sys/smp.h>
+#include <sys/taskqueue.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/wg_module.h>
+
+#include <crypto/blake2s.h>
+#include <crypto/curve25519.h>
+
+/* Globals */
+
+static volatile uint64_t keypair_counter = 0;
+
+/*
+ * The keypair slots are only written with kp_mtx held, but are read without
+ * it from inside the net epoch. Keypairs are freed through NET_EPOCH_CALL,
+ * so a pointer loaded here stays valid until the reader leaves the epoch.
+ */
+#define NOISE_KEYPAIR_LOAD(slot)					\
+	((struct noise_keypair *)atomic_load_acq_ptr((volatile uintptr_t *)&(slot)))
+#define NOISE_KEYPAIR_STORE(slot, keypair)				\
+	atomic_store_rel_ptr((volatile uintptr_t *)&(slot), (uintptr_t)(keypair))
+
+/*
+ * Ephemeral keys are generated ahead of time by a low priority task and
+ * kept in a small pool on each CPU, which takes a scalar multiplication off
+ * the handshakes that a first packet may be waiting on. A key is handed out
+ * once and wiped from the pool as it leaves.
+ */
+struct noise_ephemeral {
+	uint8_t			 e_private[WG_KEY_SIZE];
+	uint8_t			 e_public[WG_KEY_SIZE];
+};
+
+struct noise_ephemeral_pool {
+	struct mtx		 ep_mtx;
+	u_int			 ep_count;
+	struct noise_ephemeral	 ep_keys[NOISE_EPHEMERAL_POOL];
+	struct task		 ep_refill;
+} __aligned(CACHE_LINE_SIZE);
+
+static struct noise_ephemeral_pool *noise_ephemerals;
+
+/*
+ * An initiation on its way through noise_handshake_consume_initiation or,
+ * in a batch, noise_handshake_consume_initiations, kept between the steps
+ * that the batch takes for all of its initiations at once.
+ */
+struct noise_initiation {
+	struct wg_pkt_initiation	*i_src;
+	struct wg_peer			*i_peer;
+	bool				 i_valid;
+	uint8_t				 i_dh[WG_KEY_SIZE];
+	uint8_t				 i_key[WG_KEY_SIZE];
+	uint8_t				 i_chaining_key[WG_HASH_SIZE];
+	uint8_t				 i_hash[WG_HASH_SIZE];
+	uint8_t				 i_e[WG_KEY_SIZE];
+};
+
+CTASSERT(WG_HANDSHAKE_BATCH <= CURVE25519_BATCH_MAX);
+
+static void	noise_keypair_free_deferred(epoch_context_t);
+static void	noise_ephemeral_refill(void *, int);
+static bool	noise_ephemeral_take(uint8_t [WG_KEY_SIZE],
+		    uint8_t [WG_KEY_SIZE]);
+static void	noise_local_count_handshake(struct noise_local *);
+static uint32_t	noise_local_rekey_delay(struct noise_local *);
+static void	noise_initiation_mix_dh(struct noise_initiation *, int,
+		    const uint8_t [WG_KEY_SIZE], bool);
+static struct noise_keypair *
+		noise_initiation_finish(struct noise_initiation *);
+
+static const uint8_t handshake_name[37] = "Noise_IKpsk2_25519_ChaChaPoly_BLAKE2s";
+static const uint8_t identifier_name[30] = "WireGuard v1 FreeBSD.org";
+static __read_mostly uint8_t handshake_init_hash[NOISE_HASH_LEN];
+static __read_mostly uint8_t handshake_init_chaining_key[NOISE_HASH_LEN];
+//static atomic64_t keypair_counter = ATOMIC64_INIT(0);
+
+void
+wg_noise_param_init(void)
+{
+	struct blake2s_state blake;
+
+	blake2s(handshake_init_chaining_key, handshake_name, NULL,
+		NOISE_HASH_LEN, sizeof(handshake_name), 0);
+	blake2s_init(&blake, NOISE_HASH_LEN);
+	blake2s_update(&blake, handshake_init_chaining_key, NOISE_HASH_LEN);
+	blake2s_update(&blake, identifier_name, sizeof(identifier_name));
+	blake2s_final(&blake, handshake_init_hash, NOISE_HASH_LEN);
+}
+
+void
+noise_ephemeral_init(void)
+{
+	struct noise_ephemeral_pool *pool;
+	int cpu;
+
+	noise_ephemerals = malloc((mp_maxid + 1) * sizeof(*noise_ephemerals),
+	    M_WG, M_WAITOK | M_ZERO);
+	CPU_FOREACH(cpu) {
+		pool = &noise_ephemerals[cpu];
+		mtx_init(&pool->ep_mtx, "noise ephemerals", NULL, MTX_DEF);
+		TASK_INIT(&pool->ep_refill, 0, noise_ephemeral_refill, pool);
+		taskqueue_enqueue(taskqueue_thread, &pool->ep_refill);
+	}
+}
+
+void
+noise_ephemeral_uninit(void)
+{
+	struct noise_ephemeral_pool *pool;
+	int cpu;
+
+	CPU_FOREACH(cpu) {
+		pool = &noise_ephemerals[cpu];
+		taskqueue_drain(taskqueue_thread, &pool->ep_refill);
+		explicit_bzero(pool->ep_keys, sizeof(pool->ep_keys));
+		mtx_destroy(&pool->ep_mtx);
+	}
+	free(noise_ephemerals, M_WG);
+	noise_ephemerals = NULL;
+}
+
+static void
+noise_ephemeral_refill(void *arg, int pending)
+{
+	struct noise_ephemeral_pool *pool = arg;
+	struct noise_ephemeral e;
+
+	/* An unlocked look is enough to decide whether to make another. */
+	while (pool->ep_count < NOISE_EPHEMERAL_POOL) {
+		curve25519_generate_secret(e.e_private);
+		if (!curve25519_generate_public(e.e_public, e.e_private))
+			continue;
+		mtx_lock(&pool->ep_mtx);
+		if (pool->ep_count < NOISE_EPHEMERAL_POOL)
+			pool->ep_keys[pool->ep_count++] = e;
+		mtx_unlock(&pool->ep_mtx);
+	}
+	explicit_bzero(&e, sizeof(e));
+}
+
+/*
+ * Takes a key from this CPU's pool, or makes one on the spot if the pool
+ * has run dry, and has the pool topped up once it is down to half.
+ */
+static bool
+noise_ephemeral_take(uint8_t private[WG_KEY_SIZE],
+		     uint8_t public[WG_KEY_SIZE])
+{
+	struct noise_ephemeral_pool *pool;
+	struct noise_ephemeral *e;
+	bool found = false, refill;
+
+	if (noise_ephemerals != NULL) {
+		pool = &noise_ephemerals[curcpu];
+		mtx_lock(&pool->ep_mtx);
+		if (pool->ep_count > 0) {
+			e = &pool->ep_keys[--pool->ep_count];
+			memcpy(private, e->e_private, WG_KEY_SIZE);
+			memcpy(public, e->e_public, WG_KEY_SIZE);
+			explicit_bzero(e, sizeof(*e));
+			found = true;
+		}
+		refill = pool->ep_count <= NOISE_EPHEMERAL_POOL / 2;
+		mtx_unlock(&pool->ep_mtx);
+		if (refill)
+			taskqueue_enqueue(taskqueue_thread, &pool->ep_refill);
+		if (found)
+			return (true);
+	}
+	curve25519_generate_secret(private);
+	return (curve25519_generate_public(public, private));
+}
+
+/* Noise */
+void
+noise_remote_init(struct noise_remote *remote, uint8_t pubkey[WG_KEY_SIZE])
+{
+	bzero(remote, sizeof(*remote));
+	mtx_init(&remote->r_mtx, "noise remote", NULL, MTX_DEF);
+	memcpy(remote->r_public, pubkey, WG_KEY_SIZE);
+}
+
+void
+noise_remote_set_psk(struct noise_remote *remote, uint8_t key[WG_KEY_SIZE])
+{
+	mtx_lock(&remote->r_mtx);
+	memcpy(remote->r_psk, key, WG_KEY_SIZE);
+	mtx_unlock(&remote->r_mtx);
+}
+
+void
+noise_local_init(struct noise_local *local)
+{
+	rw_init(&local->l_lock, "noise_local");
+	local->l_load_count = 0;
+	local->l_load_last = 0;
+	local->l_load_second = 0;
+}
+
+/*
+ * Counts a handshake message towards the load of this second. Losing a
+ * count to a race with the rollover doesn't matter.
+ */
+static void
+noise_local_count_handshake(struct noise_local *local)
+{
+	struct timespec now;
+
+	getnanotime(&now);
+	if (now.tv_sec != local->l_load_second) {
+		local->l_load_last = now.tv_sec == local->l_load_second + 1 ?
+		    local->l_load_count : 0;
+		local->l_load_count = 0;
+		local->l_load_second = now.tv_sec;
+	}
+	atomic_add_int(&local->l_load_count, 1);
+}
+
+/*
+ * How much later than REKEY_AFTER_TIME a new initiator keypair should ask
+ * for a rekey, in milliseconds. Picked at random from a window that grows
+ * with the handshake load, so a burst of handshakes is followed by rekeys
+ * that are spread out rather than another burst.
+ */
+static uint32_t
+noise_local_rekey_delay(struct noise_local *local)
+{
+	struct timespec now;
+	uint64_t window;
+	u_int load;
+
+	getnanotime(&now);
+	if (now.tv_sec == local->l_load_second)
+		load = MAX(local->l_load_last, local->l_load_count);
+	else if (now.tv_sec == local->l_load_second + 1)
+		load = local->l_load_count;
+	else
+		load = 0;
+
+	window = MIN((uint64_t)load * 1000 / REKEY_SPREAD_RATE,
+	    REKEY_SPREAD_TIME * 1000);
+	return (window == 0 ? 0 : arc4random() % window);
+}
+
+void
+noise_local_set_private(struct noise_local *local,
+		const uint8_t key[WG_KEY_SIZE])
+{
+	rw_wlock(&local->l_lock);
+	memcpy(local->l_private, key, WG_KEY_SIZE);
+	curve25519_clamp_secret(local->l_private);
+	local->l_has_identity = curve25519_generate_public(local->l_public,
+			local->l_private);
+	rw_wunlock(&local->l_lock);
+}
+
+struct noise_keypair *
+noise_keypair_create(void)
+{
+	struct noise_keypair *keypair;
+
+	keypair = uma_zalloc(wg_keypair_zone, M_NOWAIT|M_ZERO);
+	if (__predict_false(keypair == NULL))
+		return (NULL);
+	/* The WG_CACHELINE_GROUP layout only holds on an aligned keypair. */
+	KASSERT(((uintptr_t)keypair & (CACHE_LINE_SIZE - 1)) == 0,
+	    ("%s: keypair %p not cache line aligned", __func__, keypair));
+
+	/* The initial reference belongs to the noise_keypairs slot. */
+	refcount_init(&keypair->k_refcnt, 1);
+	keypair->k_id = keypair_counter++;
+	keypair->k_peer = NULL;
+
+	wg_counter_init(&keypair->k_counter);
+	getnanotime(&keypair->k_birthdate);
+	mtx_init(&keypair->k_mtx, "keypair lock", NULL, MTX_DEF);
+	keypair->k_state = HANDSHAKE_ZEROED;
+
+	return keypair;
+}
+
+void
+noise_keypair_attach_to_peer(struct noise_keypair *keypair,
+			     struct wg_peer *peer)
+{
+	mtx_lock(&keypair->k_mtx);
+
+	MPASS(keypair->k_peer == NULL);
+	keypair->k_peer = wg_peer_ref(peer);
+	noise_keypairs_insert_new(&peer->p_keypairs, keypair);
+	wg_hashtable_keypair_insert(&peer->p_sc->sc_hashtable, keypair);
+
+	mtx_unlock(&keypair->k_mtx);
+
+	DPRINTF(keypair->k_peer->p_sc, "Keypair %llu created for peer %llu\n",
+		keypair->k_id, keypair->k_peer->p_id);
+}
+
+struct noise_keypair *
+noise_keypair_ref(struct noise_keypair *keypair)
+{
+	if (keypair != NULL)
+		refcount_acquire(&keypair->k_refcnt);
+
+	return keypair;
+}
+
+/*
+ * Turn an epoch protected pointer into a reference that may outlive the
+ * epoch. Fails if the keypair is already on its way out.
+ */
+struct noise_keypair *
+noise_keypair_ref_epoch(struct noise_keypair *keypair)
+{
+	NET_EPOCH_ASSERT();
+	if (keypair != NULL && !refcount_acquire_if_not_zero(&keypair->k_refcnt))
+		keypair = NULL;
+
+	return keypair;
+}
+
+void
+noise_keypair_put(struct noise_keypair *keypair)
+{
+	if (keypair != NULL)
+		if (refcount_release(&keypair->k_refcnt))
+			noise_keypair_free(keypair);
+}
+
+void
+noise_keypair_destroy(struct noise_keypair **keypair_p)
+{
+	struct noise_keypair *keypair = *keypair_p;
+
+	if (keypair == NULL)
+		return;
+
+	NOISE_KEYPAIR_STORE(*keypair_p, NULL);
+	wg_hashtable_keypair_remove(&keypair->k_peer->p_sc->sc_hashtable,
+	    keypair);
+	noise_keypair_put(keypair);
+}
+
+void
+noise_keypair_free(struct noise_keypair *keypair)
+{
+	NET_EPOCH_CALL(noise_keypair_free_deferred, &keypair->k_ctx);
+}
+
+static void
+noise_keypair_free_deferred(epoch_context_t ctx)
+{
+	struct noise_keypair *keypair;
+
+	keypair = __containerof(ctx, struct noise_keypair, k_ctx);
+	DPRINTF(keypair->k_peer->p_sc, "Keypair %llu destroyed\n",
+		keypair->k_id);
+	wg_peer_put(keypair->k_peer);
+	explicit_bzero(keypair, sizeof(*keypair));
+	uma_zfree(wg_keypair_zone, keypair);
+}
+
+void
+noise_keypairs_init(struct noise_keypairs *keypairs)
+{
+	bzero(keypairs, sizeof(*keypairs));
+	mtx_init(&keypairs->kp_mtx, "keypairs lock", NULL, MTX_DEF);
+}
+
+void
+noise_keypairs_clear(struct noise_keypairs *keypairs)
+{
+	mtx_lock(&keypairs->kp_mtx);
+	noise_keypair_destroy(&keypairs->kp_next_keypair);
+	noise_keypair_destroy(&keypairs->kp_previous_keypair);
+	noise_keypair_destroy(&keypairs->kp_current_keypair);
+	mtx_unlock(&keypairs->kp_mtx);
+}
+
+void
+noise_keypairs_insert_new(struct noise_keypairs *keypairs,
+			  struct noise_keypair *keypair)
+{
+	mtx_lock(&keypairs->kp_mtx);
+	noise_keypair_destroy(&keypairs->kp_next_keypair);
+	NOISE_KEYPAIR_STORE(keypairs->kp_next_keypair, keypair);
+	mtx_unlock(&keypairs->kp_mtx);
+}
+
+struct noise_keypair *
+noise_keypairs_lookup(struct noise_keypairs *keypairs,
+		      enum noise_keypair_type type)
+{
+	struct noise_keypair *keypair = NULL;
+	NET_EPOCH_ASSERT();
+
+	if (type == NOISE_KEYPAIR_CURRENT)
+		keypair = NOISE_KEYPAIR_LOAD(keypairs->kp_current_keypair);
+	else if (type == NOISE_KEYPAIR_PREVIOUS)
+		keypair = NOISE_KEYPAIR_LOAD(keypairs->kp_previous_keypair);
+	else if (type == NOISE_KEYPAIR_NEXT)
+		keypair = NOISE_KEYPAIR_LOAD(keypairs->kp_next_keypair);
+	return (noise_keypair_ref_epoch(keypair));
+}
+
+/* The current keypair, without a reference; see NOISE_KEYPAIR_LOAD. */
+struct noise_keypair *
+noise_keypairs_current(struct noise_keypairs *keypairs)
+{
+	NET_EPOCH_ASSERT();
+	return (NOISE_KEYPAIR_LOAD(keypairs->kp_current_keypair));
+}
+
+int
+noise_keypairs_begin_session(struct noise_keypairs *keypairs)
+{
+	struct noise_keypair *keypair;
+
+	mtx_lock(&keypairs->kp_mtx);
+	if (keypairs->kp_next_keypair == NULL) {
+		mtx_unlock(&keypairs->kp_mtx);
+		return ENOENT;
+	}
+
+	keypair = keypairs->kp_next_keypair;
+
+	if (keypair->k_state == HANDSHAKE_CONSUMED_RESPONSE) {
+		/*
+		 * If we're the initiator, it means we've sent a handshake, and
+		 * received a confirmation response, which means this new
+		 * keypair can now be used.
+		 */
+		noise_kdf(keypair->k_send, keypair->k_recv, NULL, NULL,
+		    WG_KEY_SIZE, WG_KEY_SIZE, 0, 0, keypair->k_chaining_key);
+
+		noise_keypair_destroy(&keypairs->kp_previous_keypair);
+		NOISE_KEYPAIR_STORE(keypairs->kp_previous_keypair,
+		    keypairs->kp_current_keypair);
+		NOISE_KEYPAIR_STORE(keypairs->kp_current_keypair,
+		    keypairs->kp_next_keypair);
+		NOISE_KEYPAIR_STORE(keypairs->kp_next_keypair, NULL);
+
+		keypair->k_rekey_delay = noise_local_rekey_delay(
+		    &keypair->k_peer->p_sc->sc_local);
+		keypair->k_state = KEYPAIR_INITIATOR;
+
+	} else if (keypair->k_state == HANDSHAKE_CREATED_RESPONSE) {
+		/*
+		 * If we're the responder, it means we can't use the new
+		 * keypair until we receive confirmation via the first data
+		 * packet, so we leave it in the next slot. It is expected to
+		 * get promoted in noise_keypairs_received_with_keypair.
+		 */
+		noise_kdf(keypair->k_recv, keypair->k_send, NULL, NULL,
+				WG_KEY_SIZE, WG_KEY_SIZE, 0, 0,
+				keypair->k_chaining_key);
+	} else {
+		mtx_unlock(&keypairs->kp_mtx);
+		return ENOTRECOVERABLE;
+	}
+
+	mtx_unlock(&keypairs->kp_mtx);
+
+	explicit_bzero(keypair->k_ephemeral_private, WG_KEY_SIZE);
+	explicit_bzero(keypair->k_remote_ephemeral, WG_KEY_SIZE);
+	explicit_bzero(keypair->k_hash, WG_HASH_SIZE);
+	explicit_bzero(keypair->k_chaining_key, WG_HASH_SIZE);
+
+	return 0;
+}
+
+int
+noise_keypairs_received_with_keypair(struct noise_keypairs *keypairs,
+				     struct noise_keypair *received_keypair)
+{
+	/* We first check without taking the mutex, then check again after */
+	if (received_keypair != NOISE_KEYPAIR_LOAD(keypairs->kp_next_keypair))
+		return EISCONN;
+
+	mtx_lock(&keypairs->kp_mtx);
+	if (received_keypair != keypairs->kp_next_keypair) {
+		mtx_unlock(&keypairs->kp_mtx);
+		return EISCONN;
+	}
+
+	/*
+	 * When we've finally received the confirmation, we slide the next
+	 * into the current, the current into the previous, and get rid of
+	 * the old previous.
+	 */
+	noise_keypair_destroy(&keypairs->kp_previous_keypair);
+	NOISE_KEYPAIR_STORE(keypairs->kp_previous_keypair,
+	    keypairs->kp_current_keypair);
+	NOISE_KEYPAIR_STORE(keypairs->kp_current_keypair,
+	    keypairs->kp_next_keypair);
+	NOISE_KEYPAIR_STORE(keypairs->kp_next_keypair, NULL);
+
+	received_keypair->k_state = KEYPAIR_RESPONDER;
+
+	mtx_unlock(&keypairs->kp_mtx);
+
+	return 0;
+}
+
+void
+noise_keypairs_keep_key_fresh_send(struct noise_keypairs *keypairs)
+{
+	struct noise_keypair *keypair;
+	uint32_t delay;
+
+	keypair = noise_keypairs_current(keypairs);
+	if (keypair == NULL)
+		return;
+
+	delay = keypair->k_rekey_delay;
+	if (keypair->k_counter.c_send > REKEY_AFTER_MESSAGES ||
+	    (keypair->k_state == KEYPAIR_INITIATOR &&
+	     wg_timers_expired(&keypair->k_birthdate,
+	      REKEY_AFTER_TIME + delay / 1000, (delay % 1000) * 1000000)))
+		wg_peer_queue_handshake_initiation(keypair->k_peer, 0);
+}
+
+void
+noise_keypairs_keep_key_fresh_recv(struct noise_keypairs *keypairs)
+{
+	struct noise_keypair *keypair;
+
+	keypair = noise_keypairs_current(keypairs);
+
+	if (keypair != NULL &&
+	    keypair->k_state == KEYPAIR_INITIATOR &&
+	     wg_timers_expired(&keypair->k_birthdate,
+	      REJECT_AFTER_TIME - KEEPALIVE_TIMEOUT - REKEY_TIMEOUT, 0))
+		wg_peer_queue_handshake_initiation(keypair->k_peer, 0);
+}
+
+/* This is Hugo Krawczyk's HKDF:
+ *  - https://eprint.iacr.org/2010/264.pdf
+ *  - https://tools.ietf.org/html/rfc5869
+ */
+void
+noise_kdf(uint8_t *a, uint8_t *b, uint8_t *c, const uint8_t *x,
+	  size_t a_len, size_t b_len, size_t c_len, size_t x_len,
+	  const uint8_t ck[WG_HASH_SIZE])
+{
+	uint8_t out[BLAKE2S_HASH_SIZE + 1];
+	uint8_t sec[BLAKE2S_HASH_SIZE];
+
+#ifdef DIAGNOSTIC
+	MPASS(a_len <= BLAKE2S_HASH_SIZE && b_len <= BLAKE2S_HASH_SIZE &&
+			c_len <= BLAKE2S_HASH_SIZE);
+	MPASS(!(b || b_len || c || c_len) || (a && a_len));
+	MPASS(!(c || c_len) || (b && b_len));
+#endif
+
+	/* Extract entropy from "x" into sec */
+	blake2s_hmac(sec, x, ck, BLAKE2S_HASH_SIZE, x_len, WG_HASH_SIZE);
+
+	if (a == NULL || a_len == 0)
+		goto out;
+
+	/* Expand first key: key = sec, data = 0x1 */
+	out[0] = 1;
+	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, 1, BLAKE2S_HASH_SIZE);
+	memcpy(a, out, a_len);
+
+	if (b == NULL || b_len == 0)
+		goto out;
+
+	/* Expand second key: key = sec, data = "a" || 0x2 */
+	out[BLAKE2S_HASH_SIZE] = 2;
+	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, BLAKE2S_HASH_SIZE + 1,
+			BLAKE2S_HASH_SIZE);
+	memcpy(b, out, b_len);
+
+	if (c == NULL || c_len == 0)
+		goto out;
+
+	/* Expand third key: key = sec, data = "b" || 0x3 */
+	out[BLAKE2S_HASH_SIZE] = 3;
+	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, BLAKE2S_HASH_SIZE + 1,
+			BLAKE2S_HASH_SIZE);
+	memcpy(c, out, c_len);
+
+out:
+	/* Clear sensitive data from stack */
+	explicit_bzero(sec, BLAKE2S_HASH_SIZE);
+	explicit_bzero(out, BLAKE2S_HASH_SIZE + 1);
+}
+
+int
+noise_mix_dh(uint8_t ck[WG_HASH_SIZE], uint8_t key[WG_KEY_SIZE],
+	const uint8_t private[WG_KEY_SIZE], const uint8_t public[WG_KEY_SIZE])
+{
+	uint8_t dh[WG_KEY_SIZE];
+
+	if (!curve25519(dh, private, public))
+		return EINVAL;
+	noise_kdf(ck, key, NULL, dh,
+		  WG_HASH_SIZE, WG_KEY_SIZE, 0, WG_KEY_SIZE, ck);
+	explicit_bzero(dh, WG_KEY_SIZE);
+	return 0;
+}
+
+void
+noise_mix_hash(uint8_t hash[WG_HASH_SIZE], const uint8_t *src, size_t src_len)
+{
+	struct blake2s_state blake;
+
+	blake2s_init(&blake, WG_HASH_SIZE);
+	blake2s_update(&blake, hash, WG_HASH_SIZE);
+	blake2s_update(&blake, src, src_len);
+	blake2s_final(&blake, hash, WG_HASH_SIZE);
+}
+
+void
+noise_mix_psk(uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE],
+	      uint8_t key[WG_KEY_SIZE], const uint8_t psk[WG_KEY_SIZE])
+{
+	uint8_t tmp[WG_HASH_SIZE];
+
+	noise_kdf(ck, tmp, key, psk,
+		  WG_HASH_SIZE, WG_HASH_SIZE, WG_KEY_SIZE, WG_KEY_SIZE, ck);
+	noise_mix_hash(hash, tmp, WG_HASH_SIZE);
+	explicit_bzero(tmp, WG_HASH_SIZE);
+}
+
+void
+noise_param_init(uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE],
+		const uint8_t remote_static[WG_KEY_SIZE])
+{
+	struct blake2s_state blake;
+
+	blake2s(ck, HANDSHAKE_NAME, NULL,
+		WG_HASH_SIZE, strlen(HANDSHAKE_NAME), 0);
+	blake2s_init(&blake, WG_HASH_SIZE);
+	blake2s_update(&blake, ck, WG_HASH_SIZE);
+	blake2s_update(&blake, IDENTIFIER_NAME, strlen(IDENTIFIER_NAME));
+	blake2s_final(&blake, hash, WG_HASH_SIZE);
+
+	noise_mix_hash(hash, remote_static, WG_KEY_SIZE);
+}
+
+void
+noise_message_encrypt(uint8_t *dst, const uint8_t *src, size_t src_len,
+		uint8_t key[WG_KEY_SIZE], uint8_t hash[WG_HASH_SIZE])
+{
+	/* Nonce always zero for Noise_IK */
+	chacha20poly1305_encrypt(dst, src, src_len, hash, WG_HASH_SIZE, 0, key);
+	noise_mix_hash(hash, dst, src_len + WG_MAC_SIZE);
+}
+
+int
+noise_message_decrypt(uint8_t *dst, const uint8_t *src, size_t src_len,
+		uint8_t key[WG_KEY_SIZE], uint8_t hash[WG_HASH_SIZE])
+{
+	/* Nonce always zero for Noise_IK */
+	if (!chacha20poly1305_decrypt(dst, src, src_len,
+				      hash, WG_HASH_SIZE, 0, key))
+		return EINVAL;
+	noise_mix_hash(hash, src, src_len);
+	return 0;
+}
+
+void
+noise_message_ephemeral(uint8_t dst[WG_KEY_SIZE],
+			const uint8_t src[WG_KEY_SIZE],
+			uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE])
+{
+	if (dst != src)
+		memcpy(dst, src, WG_KEY_SIZE);
+	noise_mix_hash(hash, src, WG_KEY_SIZE);
+	noise_kdf(ck, NULL, NULL, src, WG_HASH_SIZE, 0, 0, WG_KEY_SIZE, ck);
+}
+
+void
+noise_tai64n_now(uint8_t output[WG_TIMESTAMP_SIZE])
+{
+	struct timespec now;
+
+	getnanotime(&now);
+
+	/*
+	 * Set nsec = 0 to prevent any sort of infoleak from precise timers. As
+	 * we are restricted to sending one initiation every 5 seconds, having
+	 * single second accuracy is sufficient.
+	 */
+	now.tv_nsec = 0;
+
+	/* https://cr.yp.to/libtai/tai64.html */
+	*(uint64_t *)output = htobe64(0x400000000000000aULL + now.tv_sec);
+	*(uint32_t *)(output + sizeof(uint64_t)) = htobe32(now.tv_nsec);
+}
+
+int
+noise_handshake_create_initiation(struct wg_pkt_initiation *dst,
+				     struct wg_peer *peer)
+{
+	uint8_t timestamp[WG_TIMESTAMP_SIZE];
+	uint8_t key[WG_KEY_SIZE], ss[WG_KEY_SIZE];
+	struct noise_local *local = &peer->p_sc->sc_local;
+	struct noise_keypair *keypair;
+
+	rw_rlock(&local->l_lock);
+	noise_local_count_handshake(local);
+
+	if ((keypair = noise_keypair_create()) == NULL)
+		goto out;
+
+	if (!local->l_has_identity)
+		goto out;
+
+	noise_param_init(keypair->k_chaining_key, keypair->k_hash,
+			peer->p_remote.r_public);
+
+	/* e */
+	if (!noise_ephemeral_take(keypair->k_ephemeral_private,
+				  dst->unencrypted_ephemeral))
+		goto out;
+	noise_message_ephemeral(dst->unencrypted_ephemeral,
+				dst->unencrypted_ephemeral,
+				keypair->k_chaining_key, keypair->k_hash);
+
+	/* es */
+	if (noise_mix_dh(keypair->k_chaining_key, key,
+	    keypair->k_ephemeral_private, peer->p_remote.r_public) != 0)
+		goto out;
+
+	/* s */
+	noise_message_encrypt(dst->encrypted_static,
+			peer->p_sc->sc_local.l_public,
+			WG_KEY_SIZE, key, keypair->k_hash);
+
+	/* ss */
+	if (!curve25519(ss, local->l_private, peer->p_remote.r_public))
+		goto out;
+	noise_kdf(keypair->k_chaining_key, key, NULL, ss, WG_HASH_SIZE,
+		  WG_KEY_SIZE, 0, WG_KEY_SIZE, keypair->k_chaining_key);
+
+	/* {t} */
+	noise_tai64n_now(timestamp);
+	noise_message_encrypt(dst->encrypted_timestamp, timestamp,
+			WG_TIMESTAMP_SIZE, key, keypair->k_hash);
+
+	keypair->k_state = HANDSHAKE_CREATED_INITIATION;
+
+	noise_keypair_attach_to_peer(keypair, peer);
+
+	dst->header.type = WG_PKT_INITIATION;
+	dst->sender_index = keypair->k_local_index;
+out:
+	rw_runlock(&local->l_lock);
+	explicit_bzero(ss, WG_KEY_SIZE);
+	explicit_bzero(key, WG_KEY_SIZE);
+	return keypair != NULL &&
+	       keypair->k_state == HANDSHAKE_CREATED_INITIATION ? 0 : EINVAL;
+}
+
+struct noise_keypair *
+noise_handshake_consume_initiation(struct wg_pkt_initiation *src,
+				      struct wg_softc *sc)
+{
+	struct noise_initiation init = { .i_src = src };
+	struct noise_keypair *keypair = NULL;
+	uint8_t ss[WG_KEY_SIZE];
+	uint8_t s[WG_KEY_SIZE];
+
+	rw_rlock(&sc->sc_local.l_lock);
+	noise_local_count_handshake(&sc->sc_local);
+	if (!sc->sc_local.l_has_identity)
+		goto out;
+
+	noise_param_init(init.i_chaining_key, init.i_hash,
+			 sc->sc_local.l_public);
+
+	/* e */
+	noise_message_ephemeral(init.i_e, src->unencrypted_ephemeral,
+				init.i_chaining_key, init.i_hash);
+
+	/* es */
+	if (noise_mix_dh(init.i_chaining_key, init.i_key,
+			 sc->sc_local.l_private, init.i_e) != 0)
+		goto out;
+
+	/* s */
+	if (noise_message_decrypt(s, src->encrypted_static,
+			     sizeof(src->encrypted_static), init.i_key,
+			     init.i_hash) != 0)
+		goto out;
+
+	/* Lookup which peer we're actually talking to */
+	init.i_peer = wg_hashtable_peer_lookup(&sc->sc_hashtable, s);
+	if (init.i_peer == NULL)
+		goto out;
+
+	/* ss */
+	if (!curve25519(ss, sc->sc_local.l_private,
+				init.i_peer->p_remote.r_public))
+		goto out;
+	noise_kdf(init.i_chaining_key, init.i_key, NULL, ss, WG_HASH_SIZE,
+			WG_KEY_SIZE, 0, WG_KEY_SIZE, init.i_chaining_key);
+
+	keypair = noise_initiation_finish(&init);
+out:
+	rw_runlock(&sc->sc_local.l_lock);
+	wg_peer_put(init.i_peer);
+
+	explicit_bzero(ss, WG_KEY_SIZE);
+	explicit_bzero(&init, sizeof(init));
+
+	return keypair;
+}
+
+/*
+ * Mixes a Diffie-Hellman result into every initiation of the batch still
+ * valid, with the scalar multiplications done together so that they share
+ * one field inversion. The points are either the initiators' ephemerals or,
+ * once the peers are known, their static keys. An initiation whose result
+ * comes out as zero is no longer valid.
+ */
+static void
+noise_initiation_mix_dh(struct noise_initiation *init, int n,
+			const uint8_t private[WG_KEY_SIZE], bool remote_static)
+{
+	struct noise_initiation *batch[WG_HANDSHAKE_BATCH];
+	const uint8_t *scalar[WG_HANDSHAKE_BATCH];
+	const uint8_t *point[WG_HANDSHAKE_BATCH];
+	uint8_t *out[WG_HANDSHAKE_BATCH];
+	int i, m = 0;
+
+	for (i = 0; i < n; i++) {
+		if (!init[i].i_valid)
+			continue;
+		batch[m] = &init[i];
+		scalar[m] = private;
+		point[m] = remote_static ?
+		    init[i].i_peer->p_remote.r_public : init[i].i_e;
+		out[m++] = init[i].i_dh;
+	}
+	if (m == 0)
+		return;
+
+	curve25519_generic_batch(out, scalar, point, m);
+	for (i = 0; i < m; i++) {
+		if (timingsafe_bcmp(out[i], null_point, WG_KEY_SIZE) == 0)
+			batch[i]->i_valid = false;
+		else
+			noise_kdf(batch[i]->i_chaining_key, batch[i]->i_key,
+				  NULL, out[i], WG_HASH_SIZE, WG_KEY_SIZE, 0,
+				  WG_KEY_SIZE, batch[i]->i_chaining_key);
+		explicit_bzero(out[i], WG_KEY_SIZE);
+	}
+}
+
+/* {t}, then a new keypair if the initiation is neither replayed nor flooded. */
+static struct noise_keypair *
+noise_initiation_finish(struct noise_initiation *init)
+{
+	struct noise_keypair *keypair = NULL;
+	struct wg_pkt_initiation *src = init->i_src;
+	struct wg_peer *peer = init->i_peer;
+	uint8_t t[WG_TIMESTAMP_SIZE];
+
+	/* {t} */
+	if (noise_message_decrypt(t, src->encrypted_timestamp,
+				  sizeof(src->encrypted_timestamp),
+				  init->i_key, init->i_hash) != 0)
+		return NULL;
+
+	/* If we're all good, go ahead and create a new keypair. */
+	mtx_lock(&peer->p_remote.r_mtx);
+
+	if (memcmp(t, peer->p_remote.r_ts, WG_TIMESTAMP_SIZE) > 0)
+		memcpy(peer->p_remote.r_ts, t, WG_TIMESTAMP_SIZE);
+	else
+		goto out; /* Replay attack */
+
+	if (wg_timers_expired(&peer->p_remote.r_last_init, 0,
+			1000*1000*1000 / INITIATIONS_PER_SECOND))
+		getnanotime(&peer->p_remote.r_last_init);
+	else
+		goto out; /* Flood attack */
+
+	if ((keypair = noise_keypair_create()) == NULL)
+		goto out;
+
+	memcpy(keypair->k_remote_ephemeral, init->i_e, WG_KEY_SIZE);
+	memcpy(keypair->k_hash, init->i_hash, WG_HASH_SIZE);
+	memcpy(keypair->k_chaining_key, init->i_chaining_key, WG_HASH_SIZE);
+
+	keypair->k_remote_index = src->sender_index;
+	keypair->k_state = HANDSHAKE_CONSUMED_INITIATION;
+
+	noise_keypair_attach_to_peer(keypair, peer);
+	/* Returned referenced, like noise_handshake_consume_response. */
+	keypair = noise_keypair_ref(keypair);
+out:
+	mtx_unlock(&peer->p_remote.r_mtx);
+	return keypair;
+}
+
+/*
+ * Consumes up to WG_HANDSHAKE_BATCH initiations at once, each as
+ * noise_handshake_consume_initiation would, with keypairs[i] set to the
+ * referenced keypair for src[i] or NULL. The two Diffie-Hellman steps are
+ * taken for the whole batch in turn, which is what lets them share their
+ * inversions.
+ */
+void
+noise_handshake_consume_initiations(struct wg_pkt_initiation *src[],
+				    struct noise_keypair *keypairs[], int n,
+				    struct wg_softc *sc)
+{
+	struct noise_initiation init[WG_HANDSHAKE_BATCH], *in;
+	uint8_t s[WG_KEY_SIZE];
+	int i;
+
+	KASSERT(n > 0 && n <= WG_HANDSHAKE_BATCH,
+	    ("%s: batch of %d", __func__, n));
+
+	rw_rlock(&sc->sc_local.l_lock);
+	for (i = 0; i < n; i++) {
+		in = &init[i];
+		noise_local_count_handshake(&sc->sc_local);
+		keypairs[i] = NULL;
+		in->i_src = src[i];
+		in->i_peer = NULL;
+		if (!(in->i_valid = sc->sc_local.l_has_identity))
+			continue;
+
+		noise_param_init(in->i_chaining_key, in->i_hash,
+				 sc->sc_local.l_public);
+
+		/* e */
+		noise_message_ephemeral(in->i_e, src[i]->unencrypted_ephemeral,
+					in->i_chaining_key, in->i_hash);
+	}
+
+	/* es */
+	noise_initiation_mix_dh(init, n, sc->sc_local.l_private, false);
+
+	for (i = 0; i < n; i++) {
+		in = &init[i];
+		if (!in->i_valid)
+			continue;
+
+		/* s */
+		if (noise_message_decrypt(s, in->i_src->encrypted_static,
+		    sizeof(in->i_src->encrypted_static), in->i_key,
+		    in->i_hash) != 0) {
+			in->i_valid = false;
+			continue;
+		}
+
+		/* Lookup which peer we're actually talking to */
+		in->i_peer = wg_hashtable_peer_lookup(&sc->sc_hashtable, s);
+		in->i_valid = in->i_peer != NULL;
+	}
+
+	/* ss */
+	noise_initiation_mix_dh(init, n, sc->sc_local.l_private, true);
+
+	for (i = 0; i < n; i++) {
+		in = &init[i];
+		if (in->i_valid)
+			keypairs[i] = noise_initiation_finish(in);
+		wg_peer_put(in->i_peer);
+	}
+	rw_runlock(&sc->sc_local.l_lock);
+
+	explicit_bzero(init, sizeof(init));
+}
+
+int
+noise_handshake_create_response(struct wg_pkt_response *dst,
+					struct wg_peer *peer)
+{
+	struct noise_keypair *keypair;
+	uint8_t key[WG_KEY_SIZE];
+
+	keypair = noise_keypairs_lookup(&peer->p_keypairs, NOISE_KEYPAIR_NEXT);
+	if (keypair == NULL)
+		return 0;
+
+	rw_rlock(&peer->p_sc->sc_local.l_lock);
+	noise_local_count_handshake(&peer->p_sc->sc_local);
+
+	mtx_lock(&keypair->k_mtx);
+	if (keypair->k_state != HANDSHAKE_CONSUMED_INITIATION)
+		goto out;
+
+	dst->header.type = WG_PKT_RESPONSE;
+	dst->receiver_index = keypair->k_remote_index;
+	dst->sender_index = keypair->k_local_index;
+
+	/* e */
+	if (!noise_ephemeral_take(keypair->k_ephemeral_private,
+				  dst->unencrypted_ephemeral))
+		goto out;
+	noise_message_ephemeral(dst->unencrypted_ephemeral,
+			  dst->unencrypted_ephemeral, keypair->k_chaining_key,
+			  keypair->k_hash);
+
+	/* ee */
+	if (noise_mix_dh(keypair->k_chaining_key, NULL,
+			 keypair->k_ephemeral_private,
+			 keypair->k_remote_ephemeral) != 0)
+		goto out;
+
+	/* se */
+	if (noise_mix_dh(keypair->k_chaining_key, NULL,
+			 keypair->k_ephemeral_private,
+			 peer->p_remote.r_public) != 0)
+		goto out;
+
+	/* psk */
+	noise_mix_psk(keypair->k_chaining_key, keypair->k_hash, key,
+		      peer->p_remote.r_psk);
+
+	/* {} */
+	noise_message_encrypt(dst->encrypted_nothing, NULL, 0, key,
+			      keypair->k_hash);
+
+	keypair->k_state = HANDSHAKE_CREATED_RESPONSE;
+out:
+	mtx_unlock(&keypair->k_mtx);
+	rw_runlock(&peer->p_sc->sc_local.l_lock);
+	explicit_bzero(key, WG_KEY_SIZE);
+	return keypair != NULL &&
+	       keypair->k_state == HANDSHAKE_CREATED_RESPONSE ? 0 : EINVAL;
+}
+
+struct noise_keypair *
+noise_handshake_consume_response(struct wg_pkt_response *src,
+				    struct wg_softc *sc)
+{
+	enum noise_keypair_state state = HANDSHAKE_ZEROED;
+	struct noise_keypair *keypair;
+	uint8_t key[WG_KEY_SIZE];
+	uint8_t hash[WG_HASH_SIZE];
+	uint8_t chaining_key[WG_HASH_SIZE];
+	uint8_t e[WG_KEY_SIZE];
+	uint8_t ephemeral_private[WG_KEY_SIZE];
+	uint8_t static_private[WG_KEY_SIZE];
+
+	keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
+					      src->receiver_index);
+	if (keypair == NULL)
+		return NULL;
+
+	rw_rlock(&sc->sc_local.l_lock);
+	noise_local_count_handshake(&sc->sc_local);
+
+	if (!sc->sc_local.l_has_identity)
+		goto out;
+
+	mtx_lock(&keypair->k_mtx);
+	state = keypair->k_state;
+	memcpy(hash, keypair->k_hash, WG_HASH_SIZE);
+	memcpy(chaining_key, keypair->k_chaining_key, WG_HASH_SIZE);
+	memcpy(ephemeral_private, keypair->k_ephemeral_private,
+	       WG_KEY_SIZE);
+	mtx_unlock(&keypair->k_mtx);
+
+	if (state != HANDSHAKE_CREATED_INITIATION)
+		goto out;
+
+	/* e */
+	noise_message_ephemeral(e, src->unencrypted_ephemeral, chaining_key,
+				hash);
+
+	/* ee */
+	if (noise_mix_dh(chaining_key, NULL, ephemeral_private, e) != 0)
+		goto out;
+
+	/* se */
+	if (noise_mix_dh(chaining_key, NULL, sc->sc_local.l_private, e) != 0)
+		goto out;
+
+	/* psk */
+	noise_mix_psk(chaining_key, hash, key, keypair->k_peer->p_remote.r_psk);
+
+	/* {} */
+	if (noise_message_decrypt(NULL, src->encrypted_nothing,
+			     sizeof(src->encrypted_nothing), key, hash) != 0)
+		goto out;
+
+	/* Success! Copy everything to peer */
+	mtx_lock(&keypair->k_mtx);
+	if (keypair->k_state == state) {
+		memcpy(keypair->k_remote_ephemeral, e, WG_KEY_SIZE);
+		memcpy(keypair->k_hash, hash, WG_HASH_SIZE);
+		memcpy(keypair->k_chaining_key, chaining_key, WG_HASH_SIZE);
+		keypair->k_remote_index = src->sender_index;
+		keypair->k_state = HANDSHAKE_CONSUMED_RESPONSE;
+	}
+	mtx_unlock(&keypair->k_mtx);
+out:
+	explicit_bzero(key, WG_KEY_SIZE);
+	explicit_bzero(hash, WG_HASH_SIZE);
+	explicit_bzero(chaining_key, WG_HASH_SIZE);
+	explicit_bzero(ephemeral_private, WG_KEY_SIZE);
+	explicit_bzero(static_private, WG_KEY_SIZE);
+	rw_runlock(&sc->sc_local.l_lock);
+	if (keypair->k_state != HANDSHAKE_CONSUMED_RESPONSE) {
+		noise_keypair_put(keypair);
+		return NULL;
+	}
+	return keypair;
+}
@@ -28,6 +28,7 @@
 #include <sys/socketvar.h>
 #include <sys/errno.h>
 #include <sys/proc.h>
+#include <sys/smp.h>
 #include <sys/lock.h>
 #include <sys/rwlock.h>
 #include <sys/protosw.h>
@@ -41,20 +42,25 @@
 
 #include <sys/if_wg_session.h>
 #include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_mbuf.h>
+#include <sys/if_wg_cookie.h>
 #include <sys/wg_module.h>
 
 #include <netinet/in.h>
 #include <netinet/in_var.h>
 #include <netinet/ip.h>
 #include <netinet/ip_var.h>
+#include <netinet/ip6.h>
 #include <netinet6/ip6_var.h>
 #include <netinet6/scope6_var.h>
 #include <netinet/udp.h>
+#include <netinet/tcp.h>
 #include <netinet/ip_icmp.h>
 #include <netinet/icmp6.h>
 #include <netinet/in_pcb.h>
 #include <netinet6/in6_pcb.h>
 #include <netinet/udp_var.h>
+#include <machine/in_cksum.h>
 
 #include <crypto/blake2s.h>
 #include <crypto/curve25519.h>
@@ -64,23 +70,7 @@
 	gtaskqueue_drain((gtask)->gt_taskqueue, &(gtask)->gt_task)
 
 
-/*
- * m_dat / m_pktdat is inuse for wireguard internal state
- */
-#define	M_DAT_INUSE	M_PROTO1
-
-#define	M_DAT_TYPE_UNUSED	0x0
-#define	M_DAT_TYPE_QPKT	0x1
-#define	M_DAT_TYPE_ENDPOINT	0x2
-
-
-
-#if 0
-#define DPRINTF(sc, str, ...) do { if (ISSET((sc)->sc_if.if_flags, IFF_DEBUG)) \
-    printf("%s: " str, (sc)->sc_if.if_xname, ##__VA_ARGS__); } while (0)
-#endif
 
-#define DPRINTF(sc, s, ...)
 
 static inline uint64_t
 siphash24(const SIPHASH_KEY *key, const void *src, size_t len)
@@ -90,39 +80,34 @@ siphash24(const SIPHASH_KEY *key, const void *src, size_t len)
 	return (SipHashX(&ctx, 2, 4, (const uint8_t *)key, src, len));
 }
 
-/* Counter */
-void		wg_counter_init(struct wg_counter *);
-uint64_t	wg_counter_next(struct wg_counter *);
-int		wg_counter_validate(struct wg_counter *, uint64_t);
-
 /* Socket */
 void	wg_socket_softclose(struct wg_socket *);
 int	wg_socket_close(struct wg_socket *);
 int	wg_socket_bind(struct wg_socket *);
 int	wg_socket_port_set(struct wg_socket *, in_port_t);
 int	wg_socket_rdomain_set(struct wg_socket *, uint8_t);
-int	wg_socket_send_mbuf(struct wg_socket *, struct mbuf *, uint16_t);
+int	wg_socket_send_mbuf(struct wg_socket *, struct mbuf *, uint16_t,
+			    struct wg_dst_cache *);
 int	wg_socket_send_buffer(struct wg_socket *, void *, size_t,
 			      struct wg_endpoint *);
 
-/* Timers */
-void	wg_peer_expired_retransmit_handshake(struct wg_peer *);
-void	wg_peer_expired_send_keepalive(struct wg_peer *);
-void	wg_peer_expired_new_handshake(struct wg_peer *);
-void	wg_peer_expired_zero_key_material(struct wg_peer *);
-void	wg_peer_expired_send_persistent_keepalive(struct wg_peer *);
-void	wg_peer_timers_data_sent(struct wg_peer *);
-void	wg_peer_timers_data_received(struct wg_peer *);
-void	wg_peer_timers_any_authenticated_packet_sent(struct wg_peer *);
-void	wg_peer_timers_any_authenticated_packet_received(struct wg_peer *);
-void	wg_peer_timers_handshake_initiated(struct wg_peer *);
-void	wg_peer_timers_handshake_complete(struct wg_peer *);
-void	wg_peer_timers_session_derived(struct wg_peer *);
-void	wg_peer_timers_any_authenticated_packet_traversal(struct wg_peer *);
-void	wg_peer_timers_init(struct wg_peer *);
-void	wg_peer_timers_last_handshake(struct wg_peer *, struct timespec *);
-void	wg_peer_timers_stop(struct wg_peer *);
-int	wg_timers_expired(struct timespec *, time_t, long);
+/* Destination cache */
+void	wg_dst_cache_init(struct wg_dst_cache *);
+void	wg_dst_cache_uninit(struct wg_dst_cache *);
+void	wg_dst_cache_reset(struct wg_dst_cache *);
+static int
+	wg_dst_cache_src4(struct wg_dst_cache *, struct inpcb *,
+			  struct wg_endpoint *, struct in_addr *);
+static int
+	wg_dst_cache_src6(struct wg_dst_cache *, struct inpcb *,
+			  struct wg_endpoint *, struct in6_addr *);
+static bool
+	wg_ipudp_hdr_valid(struct wg_dst_cache *, struct wg_socket *);
+static int
+	wg_ipudp_hdr_build(struct wg_ipudp_hdr *, struct wg_socket *,
+			   struct wg_endpoint *, struct wg_dst_cache *);
+static int
+	wg_ipudp_hdr_apply(struct mbuf **, const struct wg_ipudp_hdr *);
 
 /* Queue */
 void	wg_pktq_init(struct wg_pktq *, const char *);
@@ -148,102 +133,11 @@ int	wg_route_delete(struct wg_route_table *, struct wg_peer *,
 
 /* Hashtable */
 void	wg_hashtable_peer_insert(struct wg_hashtable *, struct wg_peer *);
-struct wg_peer *
-	wg_hashtable_peer_lookup(struct wg_hashtable *,
-				 const uint8_t [WG_KEY_SIZE]);
 void	wg_hashtable_peer_remove(struct wg_hashtable *, struct wg_peer *);
 
-uint32_t
-	wg_hashtable_keypair_insert(struct wg_hashtable *,
-						     struct noise_keypair *);
-struct noise_keypair *
-	wg_hashtable_keypair_lookup(struct wg_hashtable *, const uint32_t);
-void	wg_hashtable_keypair_remove(struct wg_hashtable *,
-				    struct noise_keypair *);
-
-/* Noise */
-void	noise_remote_init(struct noise_remote *, uint8_t [WG_KEY_SIZE]);
-void	noise_remote_set_psk(struct noise_remote *, uint8_t [WG_KEY_SIZE]);
-void	noise_local_init(struct noise_local *);
-void	noise_local_set_private(struct noise_local *,
-				const uint8_t [WG_KEY_SIZE]);
-
-struct noise_keypair *
-	noise_keypair_create(void);
-void	noise_keypair_attach_to_peer(struct noise_keypair *, struct wg_peer *);
-struct noise_keypair *
-	noise_keypair_ref(struct noise_keypair *);
-void	noise_keypair_put(struct noise_keypair *);
-void	noise_keypair_destroy(struct noise_keypair **);
-void	noise_keypair_free(struct noise_keypair *);
-void	noise_keypairs_init(struct noise_keypairs *);
-void	noise_keypairs_clear(struct noise_keypairs *);
-void	noise_keypairs_insert_new(struct noise_keypairs *,
-				  struct noise_keypair *);
-struct noise_keypair *
-	noise_keypairs_lookup(struct noise_keypairs *,
-			      enum noise_keypair_type);
-int	noise_keypairs_begin_session(struct noise_keypairs *);
-int	noise_keypairs_received_with_keypair(struct noise_keypairs *,
-					     struct noise_keypair *);
-void	noise_keypairs_keep_key_fresh_send(struct noise_keypairs *);
-void	noise_keypairs_keep_key_fresh_recv(struct noise_keypairs *);
-
-void	noise_kdf(uint8_t *, uint8_t *, uint8_t *, const uint8_t *, size_t,
-		  size_t, size_t, size_t, const uint8_t [WG_HASH_SIZE]);
-int	noise_mix_dh(uint8_t [WG_HASH_SIZE], uint8_t [WG_KEY_SIZE],
-		     const uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE]);
-void	noise_mix_hash(uint8_t [WG_HASH_SIZE], const uint8_t *, size_t);
-void	noise_mix_psk(uint8_t [WG_HASH_SIZE], uint8_t [WG_HASH_SIZE],
-		      uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE]);
-void	noise_param_init(uint8_t [WG_HASH_SIZE], uint8_t [WG_HASH_SIZE],
-			 const uint8_t [WG_KEY_SIZE]);
-void	noise_message_encrypt(uint8_t *, const uint8_t *, size_t,
-			      uint8_t [WG_KEY_SIZE], uint8_t [WG_HASH_SIZE]);
-int	noise_message_decrypt(uint8_t *, const uint8_t *, size_t,
-			      uint8_t [WG_KEY_SIZE], uint8_t [WG_HASH_SIZE]);
-void	noise_message_ephemeral(uint8_t [WG_KEY_SIZE],
-				const uint8_t [WG_KEY_SIZE],
-				uint8_t [WG_HASH_SIZE],
-				uint8_t [WG_HASH_SIZE]);
-void	noise_tai64n_now(uint8_t [WG_TIMESTAMP_SIZE]);
-
-int	noise_handshake_create_initiation(struct wg_pkt_initiation *,
-					  struct wg_peer *peer);
-struct noise_keypair *
-	noise_handshake_consume_initiation(struct wg_pkt_initiation *,
-					   struct wg_softc *);
-int	noise_handshake_create_response(struct wg_pkt_response *,
-					struct wg_peer *peer);
-struct noise_keypair *
-	noise_handshake_consume_response(struct wg_pkt_response *,
-					 struct wg_softc *);
-
 /* Rate limiting */
 void	wg_ratelimiter_init(struct wg_ratelimiter *);
 void	wg_ratelimiter_uninit(struct wg_ratelimiter *);
-int	wg_ratelimiter_allow(struct wg_ratelimiter *, struct mbuf *);
-
-/* Cookie */
-void	wg_precompute_key(uint8_t [WG_KEY_SIZE], const uint8_t [WG_KEY_SIZE],
-			  const char *);
-void	wg_cookie_checker_init(struct wg_cookie_checker *);
-void	wg_cookie_checker_precompute_device_keys(struct wg_softc *);
-void	wg_cookie_init(struct wg_cookie *);
-void	wg_cookie_precompute_peer_keys(struct wg_peer *);
-void	wg_compute_mac1(uint8_t [WG_COOKIE_SIZE], const void *, size_t,
-			const uint8_t [WG_KEY_SIZE]);
-void	wg_compute_mac2(uint8_t [WG_COOKIE_SIZE], const void *, size_t,
-			const uint8_t [WG_COOKIE_SIZE]);
-void	wg_make_cookie(uint8_t [WG_COOKIE_SIZE], struct wg_endpoint *,
-		       struct wg_cookie_checker *);
-enum wg_cookie_mac_state
-	wg_cookie_validate_packet(struct wg_cookie_checker *, struct mbuf *,
-				  int);
-void	wg_cookie_add_mac_to_packet(struct wg_cookie *, void *, size_t);
-void	wg_cookie_message_create(struct wg_pkt_cookie *, struct mbuf *,
-				 uint32_t, struct wg_cookie_checker *);
-void	wg_cookie_message_consume(struct wg_pkt_cookie *, struct wg_softc *);
 
 /* Peer */
 struct wg_peer	*
@@ -251,40 +145,74 @@ struct wg_peer	*
 void	wg_peer_destroy(struct wg_peer **);
 void	wg_peer_free(epoch_context_t ctx);
 
-void	wg_peer_queue_handshake_initiation(struct wg_peer *, int);
 void	wg_peer_send_handshake_initiation(struct wg_peer *);
 void	wg_peer_send_handshake_response(struct wg_peer *);
 void	wg_softc_send_handshake_cookie(struct wg_softc *, struct mbuf *,
 				       uint32_t);
 
 void	wg_peer_set_endpoint_from_mbuf(struct wg_peer *, struct mbuf *);
-void	wg_peer_clear_src(struct wg_peer *);
 int	wg_peer_mbuf_add_ipudp(struct wg_peer *, struct mbuf **);
 
 void	wg_peer_send(struct wg_peer *);
 void	wg_peer_recv(struct wg_peer *);
+static void
+	wg_peer_serial_kick(struct wg_peer *, volatile u_int *,
+			    struct grouptask *, counter_u64_t, counter_u64_t);
+void	wg_peer_send_kick(struct wg_peer *);
+void	wg_peer_recv_kick(struct wg_peer *);
 void	wg_peer_enqueue_buffer(struct wg_peer *, void *, size_t);
 
-void	wg_peer_send_keepalive(struct wg_peer *);
-void	wg_peer_send_staged_packets_ref(struct wg_peer *);
-void	wg_peer_flush_staged_packets(struct wg_peer *);
-
 /* Packet */
-static struct wg_endpoint *
-	wg_mbuf_endpoint_get(struct mbuf *);
-static struct wg_queue_pkt *
-	wg_mbuf_pkt_get(struct mbuf *);
+static void
+	wg_endpoint_from_mbuf(struct wg_endpoint *, struct mbuf *,
+	    const struct sockaddr *);
 int	wg_mbuf_add_ipudp(struct mbuf **, struct wg_socket *,
-			  struct wg_endpoint *);
+			  struct wg_endpoint *, struct wg_dst_cache *);
 
+static bool
+	wg_handshake_admit(struct wg_softc *, struct mbuf *);
+static void
+	wg_receive_initiation(struct wg_softc *, struct mbuf *,
+	    struct noise_keypair *);
 void	wg_receive_handshake_packet(struct wg_softc *, struct mbuf *);
+static int
+	wg_queue_pkt_encrypt_prepare(struct wg_queue_pkt *);
 struct wg_peer	*
-	wg_queue_pkt_encrypt(struct wg_queue_pkt *);
+	wg_queue_pkt_encrypt(struct wg_queue_pkt *, int);
+static struct wg_peer *
+	wg_queue_pkt_encrypt_finish(struct wg_queue_pkt *, int);
+static int
+	wg_queue_pkt_decrypt_check(struct wg_queue_pkt *);
 struct wg_peer	*
-	wg_queue_pkt_decrypt(struct wg_queue_pkt *);
+	wg_queue_pkt_decrypt(struct wg_queue_pkt *, int);
+static struct wg_peer *
+	wg_queue_pkt_decrypt_finish(struct wg_queue_pkt *, int);
+
+/* Crypto */
+#define WG_CRYPTO_IV_SIZE	12
+
+enum wg_crypto_op {
+	WG_CRYPTO_ENCRYPT,
+	WG_CRYPTO_DECRYPT,
+};
+
+static int
+	wg_crypto_dispatch(struct wg_softc *, struct wg_queue_pkt *,
+			   enum wg_crypto_op);
 
+static int
+	wg_handshake_enqueue(struct wg_handshake_queue *, struct mbuf *,
+	    enum wg_handshake_class);
+static struct mbuf *
+	wg_handshake_dequeue(struct wg_handshake_queue *);
+static bool
+	wg_handshake_under_load(struct wg_handshake_queue *);
+static enum wg_handshake_class
+	wg_handshake_classify(struct wg_softc *, struct mbuf *);
 void	wg_softc_handshake_receive(struct wg_softc *);
-void	wg_softc_decrypt(struct wg_softc *);
+void	wg_softc_decrypt(struct wg_decrypt_worker *);
+static void
+	wg_decrypt_worker_done(struct wg_decrypt_worker *);
 void	wg_softc_encrypt(struct wg_softc *);
 
 /* Interface */
@@ -302,15 +230,24 @@ int	wg_clone_destroy(struct ifnet *);
 void	wgattach(int);
 
 
-struct m_dat_hdr {
-	uint8_t	mdh_types[2];
-};
+CTASSERT(sizeof(struct wg_pkt_tag) <= 2 * CACHE_LINE_SIZE);
 
 /* Globals */
 
-static volatile uint64_t keypair_counter = 0;
 static volatile unsigned long peer_counter = 0;
 
+/*
+ * Keypairs turn over every REKEY_AFTER_TIME for every peer, so peers,
+ * keypairs and routes come from their own zones rather than M_WG; UMA's
+ * per-CPU buckets keep the churn off the zone lock, and vmstat -z shows
+ * each zone's usage. Items are cache line aligned for the layout of
+ * struct wg_peer and struct noise_keypair.
+ */
+static uma_zone_t wg_peer_zone;
+static uma_zone_t wg_route_zone;
+uma_zone_t wg_keypair_zone;
+
+
 
 
 static inline int
@@ -319,88 +256,6 @@ callout_del(struct callout *c)
 	return (callout_stop(c) > 0);
 }
 
-static const uint8_t handshake_name[37] = "Noise_IKpsk2_25519_ChaChaPoly_BLAKE2s";
-static const uint8_t identifier_name[30] = "WireGuard v1 FreeBSD.org";
-static __read_mostly uint8_t handshake_init_hash[NOISE_HASH_LEN];
-static __read_mostly uint8_t handshake_init_chaining_key[NOISE_HASH_LEN];
-//static atomic64_t keypair_counter = ATOMIC64_INIT(0);
-
-void
-wg_noise_param_init(void)
-{
-	struct blake2s_state blake;
-
-	blake2s(handshake_init_chaining_key, handshake_name, NULL,
-		NOISE_HASH_LEN, sizeof(handshake_name), 0);
-	blake2s_init(&blake, NOISE_HASH_LEN);
-	blake2s_update(&blake, handshake_init_chaining_key, NOISE_HASH_LEN);
-	blake2s_update(&blake, identifier_name, sizeof(identifier_name));
-	blake2s_final(&blake, handshake_init_hash, NOISE_HASH_LEN);
-}
-
-/* Counter */
-void
-wg_counter_init(struct wg_counter *ctr)
-{
-	bzero(ctr, sizeof(*ctr));
-	mtx_init(&ctr->c_mtx, "counter lock", NULL, MTX_DEF);
-}
-
-uint64_t
-wg_counter_next(struct wg_counter *ctr)
-{
-	uint64_t ret;
-	mtx_lock(&ctr->c_mtx);
-	ret = ctr->c_send++;
-	mtx_unlock(&ctr->c_mtx);
-	return ret;
-}
-
-int
-wg_counter_validate(struct wg_counter *ctr, uint64_t recv)
-{
-	uint64_t i, top, index_recv, index_ctr;
-	COUNTER_TYPE bit;
-	int ret = EEXIST;
-
-	mtx_lock(&ctr->c_mtx);
-
-	/* Check that the recv counter is valid */
-	if (ctr->c_recv >= REJECT_AFTER_MESSAGES ||
-	    recv >= REJECT_AFTER_MESSAGES)
-		goto invalid;
-
-	/* If the packet is out of the window, invalid */
-	if (recv + COUNTER_WINDOW_SIZE < ctr->c_recv)
-		goto invalid;
-
-	/* If the new counter is ahead of the current counter, we'll need to
-	 * zero out the bitmap that has previously been used */
-	index_recv = recv / COUNTER_TYPE_BITS;
-	index_ctr = ctr->c_recv / COUNTER_TYPE_BITS;
-
-	if (index_recv > index_ctr) {
-		top = MIN(index_recv - index_ctr, COUNTER_TYPE_NUM);
-		for (i = 1; i <= top; i++)
-			ctr->c_backtrack[
-			    (i + index_ctr) & (COUNTER_TYPE_NUM - 1)] = 0;
-		ctr->c_recv = recv;
-	}
-
-	index_recv %= COUNTER_TYPE_NUM;
-	bit = 1 << (recv % COUNTER_TYPE_BITS);
-
-	if (ctr->c_backtrack[index_recv] & bit)
-		goto invalid;
-
-	ctr->c_backtrack[index_recv] |= bit;
-
-	ret = 0;
-invalid:
-	mtx_unlock(&ctr->c_mtx);
-	return ret;
-}
-
 /* Socket */
 
 int
@@ -528,18 +383,39 @@ wg_socket_rdomain_set(struct wg_socket *so, uint8_t rdomain)
 	return ret;
 }
 
+/*
+ * Hands a packet framed with its outer IP and UDP header to the stack, in
+ * the net epoch. The header is complete but for the IPv4 id and the IPv6
+ * payload length, which ip_output and ip6_output fill in. With a peer's
+ * destination cache, its route goes along, so that only the first packet
+ * after a change looks one up.
+ */
 int
-wg_socket_send_mbuf(struct wg_socket *so, struct mbuf *m, uint16_t family)
+wg_socket_send_mbuf(struct wg_socket *so, struct mbuf *m, uint16_t family,
+		    struct wg_dst_cache *dc)
 {
-#if 0
+	struct inpcb *inp;
+	rt_gen_t gen;
 	int err;
 
+	NET_EPOCH_ASSERT();
+	if (dc != NULL) {
+		inp = sotoinpcb(family == AF_INET ? so->so_so4 : so->so_so6);
+		gen = RT_GEN(inp->inp_inc.inc_fibnum, family);
+		if (dc->dc_route_gen != gen ||
+		    dc->dc_route.ro_dst.sa_family != family) {
+			RO_INVALIDATE_CACHE(&dc->dc_route);
+			dc->dc_route_gen = gen;
+		}
+	}
 	switch (family) {
 	case AF_INET:
-		err = ip_output(m, NULL, NULL, IP_RAWOUTPUT, NULL, NULL, 0);
+		err = ip_output(m, NULL, dc != NULL ? &dc->dc_route : NULL, 0,
+		    NULL, NULL);
 		break;
 	case AF_INET6:
-		err = ip6_output(m, 0, NULL, IPV6_MINMTU, 0, NULL);
+		err = ip6_output(m, NULL, dc != NULL ? &dc->dc_route6 : NULL, 0,
+		    NULL, NULL, NULL);
 		break;
 	default:
 		m_freem(m);
@@ -547,14 +423,13 @@ wg_socket_send_mbuf(struct wg_socket *so, struct mbuf *m, uint16_t family)
 	}
 
 	return err;
-#endif
-	return (0);
 }
 
 int
 wg_socket_send_buffer(struct wg_socket *so, void *buf, size_t len,
 		      struct wg_endpoint *dst)
 {
+	struct epoch_tracker et;
 	int err;
 	struct mbuf *m;
 
@@ -562,272 +437,76 @@ wg_socket_send_buffer(struct wg_socket *so, void *buf, size_t len,
 	m->m_len = 0;
 	m_copyback(m, 0, len, buf);
 
-	if ((err = wg_mbuf_add_ipudp(&m, so, dst)) != 0) {
+	if ((err = wg_mbuf_add_ipudp(&m, so, dst, NULL)) != 0) {
 		m_freem(m);
 		return err;
 	}
 
-	return wg_socket_send_mbuf(so, m, dst->e_remote.r_sa.sa_family);
-}
-
-/* Timers */
-void
-wg_peer_expired_retransmit_handshake(struct wg_peer *peer)
-{
-	rw_wlock(&peer->p_timers.t_lock);
-	if (peer->p_timers.t_handshake_attempts > MAX_TIMER_HANDSHAKES) {
-		DPRINTF(peer->p_sc, "Handshake for peer %llu did not complete "
-				"after %d attempts, giving up\n", peer->p_id,
-				peer->p_timers.t_handshake_attempts);
-
-		if (callout_del(&peer->p_timers.t_send_keepalive))
-			wg_peer_put(peer);
-
-		wg_peer_flush_staged_packets(peer);
-
-		if (!callout_pending(&peer->p_timers.t_zero_key_material))
-			if (callout_reset(&peer->p_timers.t_zero_key_material,
-							  REJECT_AFTER_TIME * 3 * hz,
-							  (timeout_t *)wg_peer_expired_zero_key_material, peer) == 0)
-				wg_peer_ref(peer);
-	} else {
-		peer->p_timers.t_handshake_attempts++;
-		DPRINTF(peer->p_sc, "Handshake for peer %llu did not complete "
-				"after %d seconds, retrying (try %d)\n",
-				peer->p_id, REKEY_TIMEOUT,
-				peer->p_timers.t_handshake_attempts);
-
-		/*
-		 * We clear the endpoint address src address, in case this is
-		 * the cause of trouble.
-		 */
-		wg_peer_clear_src(peer);
-
-		wg_peer_queue_handshake_initiation(peer, 1);
-	}
-	rw_wunlock(&peer->p_timers.t_lock);
-	wg_peer_put(peer);
-}
-
-void
-wg_peer_expired_send_keepalive(struct wg_peer *peer)
-{
-	wg_peer_send_keepalive(peer);
-
-	rw_wlock(&peer->p_timers.t_lock);
-	if (peer->p_timers.t_need_another_keepalive) {
-		peer->p_timers.t_need_another_keepalive = 0;
-		if (callout_reset(&peer->p_timers.t_send_keepalive,
-						  KEEPALIVE_TIMEOUT*hz,
-						  (timeout_t *)wg_peer_expired_send_keepalive,
-						  peer))
-			wg_peer_ref(peer);
-	}
-	rw_wunlock(&peer->p_timers.t_lock);
-	wg_peer_put(peer);
-}
-
-void
-wg_peer_expired_new_handshake(struct wg_peer *peer)
-{
-	DPRINTF(peer->p_sc, "Retrying handshake with peer %llu because we "
-			"stopped hearing back after %d seconds\n", peer->p_id,
-			NEW_HANDSHAKE_TIMEOUT);
-
-	/*
-	 * We clear the endpoint address src address, in case this is the cause
-	 * of trouble.
-	 */
-	wg_peer_clear_src(peer);
-	wg_peer_queue_handshake_initiation(peer, 0);
-	wg_peer_put(peer);
-}
-
-void
-wg_peer_expired_zero_key_material(struct wg_peer *peer)
-{
-	DPRINTF(peer->p_sc, "Zeroing out all keys for peer %llu, since we "
-			"haven't received a new one in %d seconds\n",
-			peer->p_id, REJECT_AFTER_TIME * 3);
-
-	noise_keypairs_clear(&peer->p_keypairs);
-	wg_peer_put(peer);
-}
-
-void
-wg_peer_expired_send_persistent_keepalive(struct wg_peer *peer)
-{
-	rw_rlock(&peer->p_timers.t_lock);
-	if (peer->p_timers.t_persistent_keepalive_interval != 0)
-		wg_peer_send_keepalive(peer);
-	rw_runlock(&peer->p_timers.t_lock);
-	wg_peer_put(peer);
-}
-
-/* Should be called after an authenticated data packet is sent. */
-void
-wg_peer_timers_data_sent(struct wg_peer *peer)
-{
-	rw_wlock(&peer->p_timers.t_lock);
-	if (!callout_pending(&peer->p_timers.t_new_handshake))
-		if (callout_reset(&peer->p_timers.t_new_handshake,
-						  NEW_HANDSHAKE_TIMEOUT * hz + (random() % REKEY_TIMEOUT_JITTER),
-						  (timeout_t *)wg_peer_expired_new_handshake, peer) == 0)
-			wg_peer_ref(peer);
-	rw_wunlock(&peer->p_timers.t_lock);
-}
-
-/* Should be called after an authenticated data packet is received. */
-void
-wg_peer_timers_data_received(struct wg_peer *peer)
-{
-	rw_wlock(&peer->p_timers.t_lock);
-	if (!callout_pending(&peer->p_timers.t_send_keepalive)) {
-		if (callout_reset(&peer->p_timers.t_send_keepalive,
-						  KEEPALIVE_TIMEOUT*hz,
-						  (timeout_t *)wg_peer_expired_send_persistent_keepalive, peer) == 0)
-			wg_peer_ref(peer);
-	} else {
-		peer->p_timers.t_need_another_keepalive = 1;
-	}
-	rw_wunlock(&peer->p_timers.t_lock);
-}
-
-/*
- * Should be called after any type of authenticated packet is sent, whether
- * keepalive, data, or handshake.
- */
-void
-wg_peer_timers_any_authenticated_packet_sent(struct wg_peer *peer)
-{
-	rw_rlock(&peer->p_timers.t_lock);
-	if (callout_del(&peer->p_timers.t_send_keepalive))
-		wg_peer_put(peer);
-	rw_runlock(&peer->p_timers.t_lock);
-}
-
-/*
- * Should be called after any type of authenticated packet is received, whether
- * keepalive, data, or handshake.
- */
-void
-wg_peer_timers_any_authenticated_packet_received(struct wg_peer *peer)
-{
-	rw_rlock(&peer->p_timers.t_lock);
-	if (callout_del(&peer->p_timers.t_new_handshake))
-		wg_peer_put(peer);
-	rw_runlock(&peer->p_timers.t_lock);
+	NET_EPOCH_ENTER(et);
+	err = wg_socket_send_mbuf(so, m, dst->e_remote.r_sa.sa_family, NULL);
+	NET_EPOCH_EXIT(et);
+	return err;
 }
 
-/* Should be called after a handshake initiation message is sent. */
+/* Destination cache */
 void
-wg_peer_timers_handshake_initiated(struct wg_peer *peer)
+wg_dst_cache_init(struct wg_dst_cache *dc)
 {
-	rw_rlock(&peer->p_timers.t_lock);
-	if (callout_reset(&peer->p_timers.t_retransmit_handshake,
-					  REKEY_TIMEOUT * hz + random() % REKEY_TIMEOUT_JITTER,
-					  (timeout_t *)wg_peer_expired_retransmit_handshake, peer) == 0)
-		wg_peer_ref(peer);
-	rw_runlock(&peer->p_timers.t_lock);
+	mtx_init(&dc->dc_mtx, "wg_dst_cache", NULL, MTX_DEF);
+	dc->dc_gen = 0;
+	bzero(&dc->dc_hdr, sizeof(dc->dc_hdr));
+	bzero(&dc->dc_route6, sizeof(dc->dc_route6));
+	dc->dc_route_gen = 0;
 }
 
-/*
- * Should be called after a handshake response message is received and processed
- * or when getting key confirmation via the first data message.
- */
 void
-wg_peer_timers_handshake_complete(struct wg_peer *peer)
+wg_dst_cache_uninit(struct wg_dst_cache *dc)
 {
-	rw_wlock(&peer->p_timers.t_lock);
-	if (callout_del(&peer->p_timers.t_retransmit_handshake))
-		wg_peer_put(peer);
-	peer->p_timers.t_handshake_attempts = 0;
-	getnanotime(&peer->p_timers.t_last_handshake);
-	rw_wunlock(&peer->p_timers.t_lock);
+	RO_INVALIDATE_CACHE(&dc->dc_route);
+	mtx_destroy(&dc->dc_mtx);
 }
 
-/*
- * Should be called after an ephemeral key is created, which is before sending a
- * handshake response or after receiving a handshake response.
- */
 void
-wg_peer_timers_session_derived(struct wg_peer *peer)
+wg_dst_cache_reset(struct wg_dst_cache *dc)
 {
-	rw_rlock(&peer->p_timers.t_lock);
-	if (callout_reset(&peer->p_timers.t_zero_key_material,
-					  REJECT_AFTER_TIME * 3 * hz,
-					  (timeout_t *)wg_peer_expired_zero_key_material, peer) == 0)
-		wg_peer_ref(peer);
-	rw_runlock(&peer->p_timers.t_lock);
+	mtx_lock(&dc->dc_mtx);
+	bzero(&dc->dc_hdr, sizeof(dc->dc_hdr));
+	mtx_unlock(&dc->dc_mtx);
 }
 
 /*
- * Should be called before a packet with authentication, whether
- * keepalive, data, or handshake is sent, or after one is received.
+ * Select the source address to use towards e_remote, called with dc_mtx
+ * held. The routing table generation is recorded first, so that a change
+ * racing with the selection invalidates the header built from it. Without
+ * a cache (replies to unknown endpoints) nothing is recorded.
  */
-void
-wg_peer_timers_any_authenticated_packet_traversal(struct wg_peer *peer)
+static int
+wg_dst_cache_src4(struct wg_dst_cache *dc, struct inpcb *inp,
+		  struct wg_endpoint *e, struct in_addr *src)
 {
-	rw_rlock(&peer->p_timers.t_lock);
-	if (peer->p_timers.t_persistent_keepalive_interval)
-		if (callout_reset(&peer->p_timers.t_persistent_keepalive,
-						  peer->p_timers.t_persistent_keepalive_interval *hz,
-						  (timeout_t *)wg_peer_expired_send_persistent_keepalive, peer) == 0)
-			wg_peer_ref(peer);
-	rw_runlock(&peer->p_timers.t_lock);
-}
-
-void
-wg_peer_timers_init(struct wg_peer *peer)
-{
-	rw_init(&peer->p_timers.t_lock, "wg_peer_timers");
-
-#if 0	
-	timeout_set_proc(&peer->p_timers.t_retransmit_handshake,
-	     (void (*)(void *))wg_peer_expired_retransmit_handshake, peer);
-	timeout_set_proc(&peer->p_timers.t_send_keepalive,
-	     (void (*)(void *))wg_peer_expired_send_keepalive, peer);
-	timeout_set_proc(&peer->p_timers.t_new_handshake,
-	     (void (*)(void *))wg_peer_expired_new_handshake, peer);
-	timeout_set_proc(&peer->p_timers.t_zero_key_material,
-	     (void (*)(void *))wg_peer_expired_zero_key_material, peer);
-	timeout_set_proc(&peer->p_timers.t_persistent_keepalive,
-	     (void (*)(void *))wg_peer_expired_send_persistent_keepalive, peer);
-#endif
-	peer->p_timers.t_persistent_keepalive_interval = 0;
-	peer->p_timers.t_handshake_attempts = 0;
-	peer->p_timers.t_need_another_keepalive = 0;
-	bzero(&peer->p_timers.t_last_handshake,
-	    sizeof(peer->p_timers.t_last_handshake));
-	bzero(&peer->p_timers.t_last_sent_handshake,
-	    sizeof(peer->p_timers.t_last_sent_handshake));
+	if (dc != NULL) {
+		mtx_assert(&dc->dc_mtx, MA_OWNED);
+		dc->dc_gen = RT_GEN(inp->inp_inc.inc_fibnum, AF_INET);
+	}
+	return (in_pcbladdr(inp, &e->e_remote.r_sin.sin_addr, src,
+	    curthread->td_ucred));
 }
 
-void
-wg_peer_timers_last_handshake(struct wg_peer *peer, struct timespec *time)
+static int
+wg_dst_cache_src6(struct wg_dst_cache *dc, struct inpcb *inp,
+		  struct wg_endpoint *e, struct in6_addr *src)
 {
-	rw_rlock(&peer->p_timers.t_lock);
-	*time = peer->p_timers.t_last_handshake;
-	rw_runlock(&peer->p_timers.t_lock);
-}
+	u_int fibnum = inp->inp_inc.inc_fibnum;
 
-void
-wg_peer_timers_stop(struct wg_peer *peer)
-{
-	rw_wlock(&peer->p_timers.t_lock);
-	if (callout_del(&peer->p_timers.t_retransmit_handshake))
-		wg_peer_put(peer);
-	if (callout_del(&peer->p_timers.t_send_keepalive))
-		wg_peer_put(peer);
-	if (callout_del(&peer->p_timers.t_new_handshake))
-		wg_peer_put(peer);
-	if (callout_del(&peer->p_timers.t_zero_key_material))
-		wg_peer_put(peer);
-	if (callout_del(&peer->p_timers.t_persistent_keepalive))
-		wg_peer_put(peer);
-	rw_wunlock(&peer->p_timers.t_lock);
+	if (dc != NULL) {
+		mtx_assert(&dc->dc_mtx, MA_OWNED);
+		dc->dc_gen = RT_GEN(fibnum, AF_INET6);
+	}
+	return (in6_selectsrc_addr(fibnum, &e->e_remote.r_sin6.sin6_addr,
+	    0, NULL, src, NULL));
 }
 
+/* Timers */
 int
 wg_timers_expired(struct timespec *birthdate, time_t sec, long nsec)
 {
@@ -954,7 +633,7 @@ wg_route_add(struct wg_route_table *tbl, struct wg_peer *peer,
 	else
 		return (EINVAL);
 
-	route = malloc(sizeof(*route), M_WG, M_NOWAIT|M_ZERO);
+	route = uma_zalloc(wg_route_zone, M_NOWAIT|M_ZERO);
 	if (__predict_false(route == NULL))
 		return (ENOBUFS);
 
@@ -971,7 +650,7 @@ wg_route_add(struct wg_route_table *tbl, struct wg_peer *peer,
 	}
 	RADIX_NODE_HEAD_UNLOCK(root);
 	if (needfree)
-		free(route, M_WG);
+		uma_zfree(wg_route_zone, route);
 	return (0);
 }
 
@@ -1016,7 +695,7 @@ wg_route_delete(struct wg_route_table *tbl, struct wg_peer *peer,
 	}
 	RADIX_NODE_HEAD_UNLOCK(root);
 	if (needfree)
-		free(route, M_WG);
+		uma_zfree(wg_route_zone, route);
 	return ret;
 }
 
@@ -1148,38 +827,41 @@ wg_hashtable_keypair_insert(struct wg_hashtable *ht,
 {
 	uint32_t index;
 	struct noise_keypair *i;
+	uint32_t worker;
 
 	mtx_lock(&ht->h_mtx);
 	ht->h_num_keys++;
+	worker = ht->h_next_worker++ % MAX(ht->h_workers, 1);
 assign_id:
-	index = arc4random();
-	LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry)
+	index = (arc4random() & ~WG_INDEX_WORKER_MASK) |
+	    (worker << WG_INDEX_WORKER_SHIFT);
+	CK_LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry)
 		if (i->k_local_index == index)
 			goto assign_id;
 
 	keypair->k_local_index = index;
 	keypair = noise_keypair_ref(keypair);
-	LIST_INSERT_HEAD(&ht->h_keys[index & ht->h_keys_mask], keypair, k_entry);
+	CK_LIST_INSERT_HEAD(&ht->h_keys[index & ht->h_keys_mask], keypair,
+	    k_entry);
 
 	mtx_unlock(&ht->h_mtx);
 	return index;
 }
 
+/*
+ * Called for every data packet, so the buckets are walked without h_mtx.
+ * The returned reference travels with the packet through the queues.
+ */
 struct noise_keypair *
 wg_hashtable_keypair_lookup(struct wg_hashtable *ht, const uint32_t index)
 {
-	struct noise_keypair *i, *keypair = NULL;
-
-	mtx_lock(&ht->h_mtx);
-	LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry) {
-		if (i->k_local_index == index) {
-			keypair = noise_keypair_ref(i);
-			break;
-		}
-	}
-	mtx_unlock(&ht->h_mtx);
+	struct noise_keypair *i;
 
-	return keypair;
+	NET_EPOCH_ASSERT();
+	CK_LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry)
+		if (i->k_local_index == index)
+			return (noise_keypair_ref_epoch(i));
+	return (NULL);
 }
 
 void
@@ -1188,1047 +870,136 @@ wg_hashtable_keypair_remove(struct wg_hashtable *ht,
 {
 	mtx_lock(&ht->h_mtx);
 	ht->h_num_keys--;
-	LIST_REMOVE(keypair, k_entry);
+	CK_LIST_REMOVE(keypair, k_entry);
 	noise_keypair_put(keypair);
 	mtx_unlock(&ht->h_mtx);
 }
 
-/* Noise */
+/*
+ * Ratelimiter
+ *
+ *
+ *
+ */
 void
-noise_remote_init(struct noise_remote *remote, uint8_t pubkey[WG_KEY_SIZE])
+wg_ratelimiter_init(struct wg_ratelimiter *ratelimiter)
 {
-	bzero(remote, sizeof(*remote));
-	mtx_init(&remote->r_mtx, "noise remote", NULL, MTX_DEF);
-	memcpy(remote->r_public, pubkey, WG_KEY_SIZE);
+
 }
 
 void
-noise_remote_set_psk(struct noise_remote *remote, uint8_t key[WG_KEY_SIZE])
+wg_ratelimiter_uninit(struct wg_ratelimiter *ratelimiter)
+{
+
+}
+
+int
+wg_ratelimiter_allow(struct wg_ratelimiter *ratelimiter, struct mbuf *m)
 {
-	mtx_lock(&remote->r_mtx);
-	memcpy(remote->r_psk, key, WG_KEY_SIZE);
-	mtx_unlock(&remote->r_mtx);
+	//return ECONNREFUSED;
+	return 0;
 }
 
+/* Zones */
 void
-noise_local_init(struct noise_local *local)
+wg_zones_init(void)
 {
-	rw_init(&local->l_lock, "noise_local");
+	wg_peer_zone = uma_zcreate("wg peer", sizeof(struct wg_peer),
+	    NULL, NULL, NULL, NULL, UMA_ALIGN_CACHE, 0);
+	wg_keypair_zone = uma_zcreate("wg keypair",
+	    sizeof(struct noise_keypair), NULL, NULL, NULL, NULL,
+	    UMA_ALIGN_CACHE, 0);
+	wg_route_zone = uma_zcreate("wg route", sizeof(struct wg_route),
+	    NULL, NULL, NULL, NULL, UMA_ALIGN_PTR, 0);
+	wg_pkt_zone = uma_zcreate("wg packet", sizeof(struct wg_pkt_tag),
+	    NULL, NULL, NULL, NULL, UMA_ALIGN_CACHE, 0);
+	uma_prealloc(wg_pkt_zone, MAX_QUEUED_PACKETS * mp_ncpus);
 }
 
 void
-noise_local_set_private(struct noise_local *local,
-		const uint8_t key[WG_KEY_SIZE])
+wg_zones_uninit(void)
 {
-	rw_wlock(&local->l_lock);
-	memcpy(local->l_private, key, WG_KEY_SIZE);
-	curve25519_clamp_secret(local->l_private);
-	local->l_has_identity = curve25519_generate_public(local->l_public,
-			local->l_private);
-	rw_wunlock(&local->l_lock);
+	/* Peers and keypairs go back to their zones from epoch callbacks. */
+	NET_EPOCH_DRAIN_CALLBACKS();
+	uma_zdestroy(wg_pkt_zone);
+	uma_zdestroy(wg_route_zone);
+	uma_zdestroy(wg_keypair_zone);
+	uma_zdestroy(wg_peer_zone);
 }
 
-struct noise_keypair *
-noise_keypair_create(void)
+/* Peer */
+struct wg_peer *
+wg_peer_create(struct wg_softc *sc, uint8_t pubkey[WG_KEY_SIZE])
 {
-	struct noise_keypair *keypair;
+	struct wg_peer *peer;
 
-	keypair = malloc(sizeof(*keypair), M_WG, M_NOWAIT|M_ZERO);
-	if (__predict_false(keypair == NULL))
-		return (NULL);
+	peer = uma_zalloc(wg_peer_zone, M_ZERO|M_NOWAIT);
+	if (peer == NULL)
+		return NULL;
+	/* As for keypairs, the layout of wg_peer assumes this. */
+	KASSERT(((uintptr_t)peer & (CACHE_LINE_SIZE - 1)) == 0,
+	    ("%s: peer %p not cache line aligned", __func__, peer));
 
-	refcount_init(&keypair->k_refcnt, 0);
-	keypair->k_id = keypair_counter++;
-	keypair->k_peer = NULL;
+	peer->p_id = atomic_fetchadd_long(&peer_counter, 1);
+	if_ref(sc->sc_ifp);
 
-	wg_counter_init(&keypair->k_counter);
-	getnanotime(&keypair->k_birthdate);
-	mtx_init(&keypair->k_mtx, "keypair lock", NULL, MTX_DEF);
-	keypair->k_state = HANDSHAKE_ZEROED;
 
-	return keypair;
-}
+	refcount_init(&peer->p_refcnt, 0);
 
-void
-noise_keypair_attach_to_peer(struct noise_keypair *keypair,
-			     struct wg_peer *peer)
-{
-	mtx_lock(&keypair->k_mtx);
+	noise_remote_init(&peer->p_remote, pubkey);
 
-	MPASS(keypair->k_peer == NULL);
-	keypair->k_peer = wg_peer_ref(peer);
-	noise_keypairs_insert_new(&peer->p_keypairs, keypair);
-	wg_hashtable_keypair_insert(&peer->p_sc->sc_hashtable, keypair);
+	wg_cookie_init(&peer->p_cookie);
+	wg_cookie_precompute_peer_keys(peer);
+	wg_peer_timers_init(peer);
+	noise_keypairs_init(&peer->p_keypairs);
 
-	mtx_unlock(&keypair->k_mtx);
+	rw_init(&peer->p_endpoint_lock, "wg_peer_endpoint");
+	bzero(&peer->p_endpoint, sizeof(peer->p_endpoint));
+	wg_dst_cache_init(&peer->p_dst_cache);
 
-	DPRINTF(keypair->k_peer->p_sc, "Keypair %llu created for peer %llu\n",
-		keypair->k_id, keypair->k_peer->p_id);
-}
+	/* wg_peer_stage holds the staged packets to sc_encrypt_dql's limit. */
+	mbufq_init(&peer->p_staged_packets, WG_PKTQ_MAX);
+	wg_codel_init(&peer->p_codel);
+	GROUPTASK_INIT(&peer->p_send_staged, 0,
+	    (gtask_fn_t *)wg_peer_send_staged_packets_ref, peer);
 
-struct noise_keypair *
-noise_keypair_ref(struct noise_keypair *keypair)
-{
-	if (keypair != NULL)
-		refcount_acquire(&keypair->k_refcnt);
+	wg_pktq_init(&peer->p_send_queue, "sendq");
+	wg_pktq_init(&peer->p_recv_queue, "rxq");
+	GROUPTASK_INIT(&peer->p_send, 0, (gtask_fn_t *)wg_peer_send, peer);
+	GROUPTASK_INIT(&peer->p_recv, 0, (gtask_fn_t *)wg_peer_recv, peer);
 
-	return keypair;
-}
+	GROUPTASK_INIT(&peer->p_tx_initiation, 0,
+	    (gtask_fn_t *)wg_peer_send_handshake_initiation, peer);
 
-void
-noise_keypair_put(struct noise_keypair *keypair)
-{
-	if (keypair != NULL)
-		if (refcount_release(&keypair->k_refcnt))
-			noise_keypair_free(keypair);
-}
+	peer->p_tx_bytes = counter_u64_alloc(M_WAITOK);
+	peer->p_rx_bytes = counter_u64_alloc(M_WAITOK);
 
-void
-noise_keypair_destroy(struct noise_keypair **keypair_p)
-{
-	struct noise_keypair *keypair = *keypair_p;
+	CK_LIST_INIT(&peer->p_routes);
 
-	if (keypair == NULL)
-		return;
+	wg_hashtable_peer_insert(&sc->sc_hashtable, peer);
 
-	*keypair_p = NULL;
-	wg_hashtable_keypair_remove(&keypair->k_peer->p_sc->sc_hashtable,
-	    keypair);
-	noise_keypair_put(keypair);
+	DPRINTF(sc, "Peer %llu created\n", peer->p_id);
+	return peer;
 }
 
-void
-noise_keypair_free(struct noise_keypair *keypair)
+struct wg_peer *
+wg_peer_ref(struct wg_peer *peer)
 {
-	DPRINTF(keypair->k_peer->p_sc, "Keypair %llu destroyed\n",
-		keypair->k_id);
-	wg_peer_put(keypair->k_peer);
-	zfree(keypair, M_WG);
+	if (peer != NULL)
+		refcount_acquire(&peer->p_refcnt);
+	return (peer);
 }
 
 void
-noise_keypairs_init(struct noise_keypairs *keypairs)
+wg_peer_put(struct wg_peer *peer)
 {
-	bzero(keypairs, sizeof(*keypairs));
-	mtx_init(&keypairs->kp_mtx, "keypairs lock", NULL, MTX_DEF);
-}
 
-void
-noise_keypairs_clear(struct noise_keypairs *keypairs)
-{
-	mtx_lock(&keypairs->kp_mtx);
-	noise_keypair_destroy(&keypairs->kp_next_keypair);
-	noise_keypair_destroy(&keypairs->kp_previous_keypair);
-	noise_keypair_destroy(&keypairs->kp_current_keypair);
-	mtx_unlock(&keypairs->kp_mtx);
+	if (peer != NULL && refcount_release(&peer->p_refcnt))
+		NET_EPOCH_CALL(wg_peer_free, &peer->p_ctx);
 }
 
 void
-noise_keypairs_insert_new(struct noise_keypairs *keypairs,
-			  struct noise_keypair *keypair)
-{
-	mtx_lock(&keypairs->kp_mtx);
-	noise_keypair_destroy(&keypairs->kp_next_keypair);
-	keypairs->kp_next_keypair = keypair;
-	mtx_unlock(&keypairs->kp_mtx);
-}
-
-struct noise_keypair *
-noise_keypairs_lookup(struct noise_keypairs *keypairs,
-		      enum noise_keypair_type type)
-{
-	struct noise_keypair *keypair = NULL;
-	NET_EPOCH_ASSERT();
-
-	if (type == NOISE_KEYPAIR_CURRENT)
-		keypair = noise_keypair_ref(keypairs->kp_current_keypair);
-	else if (type == NOISE_KEYPAIR_PREVIOUS)
-		keypair = noise_keypair_ref(keypairs->kp_previous_keypair);
-	else if (type == NOISE_KEYPAIR_NEXT)
-		keypair = noise_keypair_ref(keypairs->kp_next_keypair);
-	return (keypair);
-}
-
-int
-noise_keypairs_begin_session(struct noise_keypairs *keypairs)
-{
-	struct noise_keypair *keypair;
-
-	mtx_lock(&keypairs->kp_mtx);
-	if (keypairs->kp_next_keypair == NULL) {
-		mtx_unlock(&keypairs->kp_mtx);
-		return ENOENT;
-	}
-
-	keypair = keypairs->kp_next_keypair;
-
-	if (keypair->k_state == HANDSHAKE_CONSUMED_RESPONSE) {
-		/*
-		 * If we're the initiator, it means we've sent a handshake, and
-		 * received a confirmation response, which means this new
-		 * keypair can now be used.
-		 */
-		noise_kdf(keypair->k_send, keypair->k_recv, NULL, NULL,
-		    WG_KEY_SIZE, WG_KEY_SIZE, 0, 0, keypair->k_chaining_key);
-
-		noise_keypair_destroy(&keypairs->kp_previous_keypair);
-		keypairs->kp_previous_keypair = keypairs->kp_current_keypair;
-		keypairs->kp_current_keypair = keypairs->kp_next_keypair;
-		keypairs->kp_next_keypair = NULL;
-
-		keypair->k_state = KEYPAIR_INITIATOR;
-
-	} else if (keypair->k_state == HANDSHAKE_CREATED_RESPONSE) {
-		/*
-		 * If we're the responder, it means we can't use the new
-		 * keypair until we receive confirmation via the first data
-		 * packet, so we leave it in the next slot. It is expected to
-		 * get promoted in noise_keypairs_received_with_keypair.
-		 */
-		noise_kdf(keypair->k_recv, keypair->k_send, NULL, NULL,
-				WG_KEY_SIZE, WG_KEY_SIZE, 0, 0,
-				keypair->k_chaining_key);
-	} else {
-		mtx_unlock(&keypairs->kp_mtx);
-		return ENOTRECOVERABLE;
-	}
-
-	mtx_unlock(&keypairs->kp_mtx);
-
-	explicit_bzero(keypair->k_ephemeral_private, WG_KEY_SIZE);
-	explicit_bzero(keypair->k_remote_ephemeral, WG_KEY_SIZE);
-	explicit_bzero(keypair->k_hash, WG_HASH_SIZE);
-	explicit_bzero(keypair->k_chaining_key, WG_HASH_SIZE);
-
-	return 0;
-}
-
-int
-noise_keypairs_received_with_keypair(struct noise_keypairs *keypairs,
-				     struct noise_keypair *received_keypair)
-{
-	/* We first check without taking the mutex, then check again after */
-	if (received_keypair != keypairs->kp_next_keypair)
-		return EISCONN;
-
-	mtx_lock(&keypairs->kp_mtx);
-	if (received_keypair != keypairs->kp_next_keypair) {
-		mtx_unlock(&keypairs->kp_mtx);
-		return EISCONN;
-	}
-
-	/*
-	 * When we've finally received the confirmation, we slide the next
-	 * into the current, the current into the previous, and get rid of
-	 * the old previous.
-	 */
-	noise_keypair_destroy(&keypairs->kp_previous_keypair);
-	keypairs->kp_previous_keypair = keypairs->kp_current_keypair;
-	keypairs->kp_current_keypair = keypairs->kp_next_keypair;
-	keypairs->kp_next_keypair = NULL;
-
-	received_keypair->k_state = KEYPAIR_RESPONDER;
-
-	mtx_unlock(&keypairs->kp_mtx);
-
-	return 0;
-}
-
-void
-noise_keypairs_keep_key_fresh_send(struct noise_keypairs *keypairs)
-{
-	struct noise_keypair *keypair;
-
-	mtx_lock(&keypairs->kp_mtx);
-	keypair = keypairs->kp_current_keypair;
-
-	if (keypair != NULL &&
-	    (keypair->k_counter.c_send > REKEY_AFTER_MESSAGES ||
-	     (keypair->k_state == KEYPAIR_INITIATOR &&
-	      wg_timers_expired(&keypair->k_birthdate, REKEY_AFTER_TIME, 0))))
-		wg_peer_queue_handshake_initiation(keypair->k_peer, 0);
-	mtx_unlock(&keypairs->kp_mtx);
-}
-
-void
-noise_keypairs_keep_key_fresh_recv(struct noise_keypairs *keypairs)
-{
-	struct noise_keypair *keypair;
-
-	mtx_lock(&keypairs->kp_mtx);
-	keypair = keypairs->kp_current_keypair;
-
-	if (keypair != NULL &&
-	    keypair->k_state == KEYPAIR_INITIATOR &&
-	     wg_timers_expired(&keypair->k_birthdate,
-	      REJECT_AFTER_TIME - KEEPALIVE_TIMEOUT - REKEY_TIMEOUT, 0))
-		wg_peer_queue_handshake_initiation(keypair->k_peer, 0);
-	mtx_unlock(&keypairs->kp_mtx);
-}
-
-/* This is Hugo Krawczyk's HKDF:
- *  - https://eprint.iacr.org/2010/264.pdf
- *  - https://tools.ietf.org/html/rfc5869
- */
-void
-noise_kdf(uint8_t *a, uint8_t *b, uint8_t *c, const uint8_t *x,
-	  size_t a_len, size_t b_len, size_t c_len, size_t x_len,
-	  const uint8_t ck[WG_HASH_SIZE])
-{
-	uint8_t out[BLAKE2S_HASH_SIZE + 1];
-	uint8_t sec[BLAKE2S_HASH_SIZE];
-
-#ifdef DIAGNOSTIC
-	MPASS(a_len <= BLAKE2S_HASH_SIZE && b_len <= BLAKE2S_HASH_SIZE &&
-			c_len <= BLAKE2S_HASH_SIZE);
-	MPASS(!(b || b_len || c || c_len) || (a && a_len));
-	MPASS(!(c || c_len) || (b && b_len));
-#endif
-
-	/* Extract entropy from "x" into sec */
-	blake2s_hmac(sec, x, ck, BLAKE2S_HASH_SIZE, x_len, WG_HASH_SIZE);
-
-	if (a == NULL || a_len == 0)
-		goto out;
-
-	/* Expand first key: key = sec, data = 0x1 */
-	out[0] = 1;
-	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, 1, BLAKE2S_HASH_SIZE);
-	memcpy(a, out, a_len);
-
-	if (b == NULL || b_len == 0)
-		goto out;
-
-	/* Expand second key: key = sec, data = "a" || 0x2 */
-	out[BLAKE2S_HASH_SIZE] = 2;
-	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, BLAKE2S_HASH_SIZE + 1,
-			BLAKE2S_HASH_SIZE);
-	memcpy(b, out, b_len);
-
-	if (c == NULL || c_len == 0)
-		goto out;
-
-	/* Expand third key: key = sec, data = "b" || 0x3 */
-	out[BLAKE2S_HASH_SIZE] = 3;
-	blake2s_hmac(out, out, sec, BLAKE2S_HASH_SIZE, BLAKE2S_HASH_SIZE + 1,
-			BLAKE2S_HASH_SIZE);
-	memcpy(c, out, c_len);
-
-out:
-	/* Clear sensitive data from stack */
-	explicit_bzero(sec, BLAKE2S_HASH_SIZE);
-	explicit_bzero(out, BLAKE2S_HASH_SIZE + 1);
-}
-
-int
-noise_mix_dh(uint8_t ck[WG_HASH_SIZE], uint8_t key[WG_KEY_SIZE],
-	const uint8_t private[WG_KEY_SIZE], const uint8_t public[WG_KEY_SIZE])
-{
-	uint8_t dh[WG_KEY_SIZE];
-
-	if (!curve25519(dh, private, public))
-		return EINVAL;
-	noise_kdf(ck, key, NULL, dh,
-		  WG_HASH_SIZE, WG_KEY_SIZE, 0, WG_KEY_SIZE, ck);
-	explicit_bzero(dh, WG_KEY_SIZE);
-	return 0;
-}
-
-void
-noise_mix_hash(uint8_t hash[WG_HASH_SIZE], const uint8_t *src, size_t src_len)
-{
-	struct blake2s_state blake;
-
-	blake2s_init(&blake, WG_HASH_SIZE);
-	blake2s_update(&blake, hash, WG_HASH_SIZE);
-	blake2s_update(&blake, src, src_len);
-	blake2s_final(&blake, hash, WG_HASH_SIZE);
-}
-
-void
-noise_mix_psk(uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE],
-	      uint8_t key[WG_KEY_SIZE], const uint8_t psk[WG_KEY_SIZE])
-{
-	uint8_t tmp[WG_HASH_SIZE];
-
-	noise_kdf(ck, tmp, key, psk,
-		  WG_HASH_SIZE, WG_HASH_SIZE, WG_KEY_SIZE, WG_KEY_SIZE, ck);
-	noise_mix_hash(hash, tmp, WG_HASH_SIZE);
-	explicit_bzero(tmp, WG_HASH_SIZE);
-}
-
-void
-noise_param_init(uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE],
-		const uint8_t remote_static[WG_KEY_SIZE])
-{
-	struct blake2s_state blake;
-
-	blake2s(ck, HANDSHAKE_NAME, NULL,
-		WG_HASH_SIZE, strlen(HANDSHAKE_NAME), 0);
-	blake2s_init(&blake, WG_HASH_SIZE);
-	blake2s_update(&blake, ck, WG_HASH_SIZE);
-	blake2s_update(&blake, IDENTIFIER_NAME, strlen(IDENTIFIER_NAME));
-	blake2s_final(&blake, hash, WG_HASH_SIZE);
-
-	noise_mix_hash(hash, remote_static, WG_KEY_SIZE);
-}
-
-void
-noise_message_encrypt(uint8_t *dst, const uint8_t *src, size_t src_len,
-		uint8_t key[WG_KEY_SIZE], uint8_t hash[WG_HASH_SIZE])
-{
-	/* Nonce always zero for Noise_IK */
-	chacha20poly1305_encrypt(dst, src, src_len, hash, WG_HASH_SIZE, 0, key);
-	noise_mix_hash(hash, dst, src_len + WG_MAC_SIZE);
-}
-
-int
-noise_message_decrypt(uint8_t *dst, const uint8_t *src, size_t src_len,
-		uint8_t key[WG_KEY_SIZE], uint8_t hash[WG_HASH_SIZE])
-{
-	/* Nonce always zero for Noise_IK */
-	if (!chacha20poly1305_decrypt(dst, src, src_len,
-				      hash, WG_HASH_SIZE, 0, key))
-		return EINVAL;
-	noise_mix_hash(hash, src, src_len);
-	return 0;
-}
-
-void
-noise_message_ephemeral(uint8_t dst[WG_KEY_SIZE],
-			const uint8_t src[WG_KEY_SIZE],
-			uint8_t ck[WG_HASH_SIZE], uint8_t hash[WG_HASH_SIZE])
-{
-	if (dst != src)
-		memcpy(dst, src, WG_KEY_SIZE);
-	noise_mix_hash(hash, src, WG_KEY_SIZE);
-	noise_kdf(ck, NULL, NULL, src, WG_HASH_SIZE, 0, 0, WG_KEY_SIZE, ck);
-}
-
-void
-noise_tai64n_now(uint8_t output[WG_TIMESTAMP_SIZE])
-{
-	struct timespec now;
-
-	getnanotime(&now);
-
-	/*
-	 * Set nsec = 0 to prevent any sort of infoleak from precise timers. As
-	 * we are restricted to sending one initiation every 5 seconds, having
-	 * single second accuracy is sufficient.
-	 */
-	now.tv_nsec = 0;
-
-	/* https://cr.yp.to/libtai/tai64.html */
-	*(uint64_t *)output = htobe64(0x400000000000000aULL + now.tv_sec);
-	*(uint32_t *)(output + sizeof(uint64_t)) = htobe32(now.tv_nsec);
-}
-
-int
-noise_handshake_create_initiation(struct wg_pkt_initiation *dst,
-				     struct wg_peer *peer)
-{
-	uint8_t timestamp[WG_TIMESTAMP_SIZE];
-	uint8_t key[WG_KEY_SIZE], ss[WG_KEY_SIZE];
-	struct noise_local *local = &peer->p_sc->sc_local;
-	struct noise_keypair *keypair;
-
-	rw_rlock(&local->l_lock);
-
-	if ((keypair = noise_keypair_create()) == NULL)
-		goto out;
-
-	if (!local->l_has_identity)
-		goto out;
-
-	noise_param_init(keypair->k_chaining_key, keypair->k_hash,
-			peer->p_remote.r_public);
-
-	/* e */
-	curve25519_generate_secret(keypair->k_ephemeral_private);
-	if (!curve25519_generate_public(dst->unencrypted_ephemeral,
-					keypair->k_ephemeral_private))
-		goto out;
-	noise_message_ephemeral(dst->unencrypted_ephemeral,
-				dst->unencrypted_ephemeral,
-				keypair->k_chaining_key, keypair->k_hash);
-
-	/* es */
-	if (noise_mix_dh(keypair->k_chaining_key, key,
-	    keypair->k_ephemeral_private, peer->p_remote.r_public) != 0)
-		goto out;
-
-	/* s */
-	noise_message_encrypt(dst->encrypted_static,
-			peer->p_sc->sc_local.l_public,
-			WG_KEY_SIZE, key, keypair->k_hash);
-
-	/* ss */
-	if (!curve25519(ss, local->l_private, peer->p_remote.r_public))
-		goto out;
-	noise_kdf(keypair->k_chaining_key, key, NULL, ss, WG_HASH_SIZE,
-		  WG_KEY_SIZE, 0, WG_KEY_SIZE, keypair->k_chaining_key);
-
-	/* {t} */
-	noise_tai64n_now(timestamp);
-	noise_message_encrypt(dst->encrypted_timestamp, timestamp,
-			WG_TIMESTAMP_SIZE, key, keypair->k_hash);
-
-	keypair->k_state = HANDSHAKE_CREATED_INITIATION;
-
-	noise_keypair_attach_to_peer(keypair, peer);
-
-	dst->header.type = WG_PKT_INITIATION;
-	dst->sender_index = keypair->k_local_index;
-out:
-	rw_runlock(&local->l_lock);
-	explicit_bzero(ss, WG_KEY_SIZE);
-	explicit_bzero(key, WG_KEY_SIZE);
-	return keypair->k_state == HANDSHAKE_CREATED_INITIATION ? 0 : EINVAL;
-}
-
-struct noise_keypair *
-noise_handshake_consume_initiation(struct wg_pkt_initiation *src,
-				      struct wg_softc *sc)
-{
-	struct noise_keypair *keypair = NULL;
-	struct wg_peer *peer = NULL;
-	uint8_t key[WG_KEY_SIZE], ss[WG_KEY_SIZE];
-	uint8_t chaining_key[WG_HASH_SIZE];
-	uint8_t hash[WG_HASH_SIZE];
-	uint8_t s[WG_KEY_SIZE];
-	uint8_t e[WG_KEY_SIZE];
-	uint8_t t[WG_TIMESTAMP_SIZE];
-
-	rw_rlock(&sc->sc_local.l_lock);
-	if (!sc->sc_local.l_has_identity)
-		goto out;
-
-	noise_param_init(chaining_key, hash, sc->sc_local.l_public);
-
-	/* e */
-	noise_message_ephemeral(e, src->unencrypted_ephemeral, chaining_key,
-				hash);
-
-	/* es */
-	if (noise_mix_dh(chaining_key, key, sc->sc_local.l_private, e) != 0)
-		goto out;
-
-	/* s */
-	if (noise_message_decrypt(s, src->encrypted_static,
-			     sizeof(src->encrypted_static), key, hash) != 0)
-		goto out;
-
-	/* Lookup which peer we're actually talking to */
-	peer = wg_hashtable_peer_lookup(&sc->sc_hashtable, s);
-	if (peer == NULL)
-		goto out;
-
-	/* ss */
-	if (!curve25519(ss, sc->sc_local.l_private,
-				peer->p_remote.r_public))
-		goto out;
-	noise_kdf(chaining_key, key, NULL, ss, WG_HASH_SIZE, WG_KEY_SIZE, 0,
-			WG_KEY_SIZE, chaining_key);
-
-	/* {t} */
-	if (noise_message_decrypt(t, src->encrypted_timestamp,
-				  sizeof(src->encrypted_timestamp),
-				  key, hash) != 0)
-		goto out;
-
-	/* If we're all good, go ahead and create a new keypair. */
-	mtx_lock(&peer->p_remote.r_mtx);
-
-	if (memcmp(t, peer->p_remote.r_ts, WG_TIMESTAMP_SIZE) > 0)
-		memcpy(peer->p_remote.r_ts, t, WG_TIMESTAMP_SIZE);
-	else
-		goto out_mtx; /* Replay attack */
-
-	if (wg_timers_expired(&peer->p_remote.r_last_init, 0,
-			1000*1000*1000 / INITIATIONS_PER_SECOND))
-		getnanotime(&peer->p_remote.r_last_init);
-	else
-		goto out_mtx; /* Flood attack */
-
-	if ((keypair = noise_keypair_create()) == NULL)
-		goto out_mtx;
-
-	memcpy(keypair->k_remote_ephemeral, e, WG_KEY_SIZE);
-	memcpy(keypair->k_hash, hash, WG_HASH_SIZE);
-	memcpy(keypair->k_chaining_key, chaining_key, WG_HASH_SIZE);
-
-	keypair->k_remote_index = src->sender_index;
-	keypair->k_state = HANDSHAKE_CONSUMED_INITIATION;
-
-	noise_keypair_attach_to_peer(keypair, peer);
-
-	/* Cleanup */
-out_mtx:
-	mtx_unlock(&peer->p_remote.r_mtx);
-out:
-	rw_runlock(&sc->sc_local.l_lock);
-	wg_peer_put(peer);
-
-	explicit_bzero(ss, WG_KEY_SIZE);
-	explicit_bzero(key, WG_KEY_SIZE);
-	explicit_bzero(hash, WG_HASH_SIZE);
-	explicit_bzero(chaining_key, WG_HASH_SIZE);
-
-	return keypair;
-}
-
-int
-noise_handshake_create_response(struct wg_pkt_response *dst,
-					struct wg_peer *peer)
-{
-	struct noise_keypair *keypair;
-	uint8_t key[WG_KEY_SIZE];
-
-	keypair = noise_keypairs_lookup(&peer->p_keypairs, NOISE_KEYPAIR_NEXT);
-	if (keypair == NULL)
-		return 0;
-
-	rw_rlock(&peer->p_sc->sc_local.l_lock);
-
-	mtx_lock(&keypair->k_mtx);
-	if (keypair->k_state != HANDSHAKE_CONSUMED_INITIATION)
-		goto out;
-
-	dst->header.type = WG_PKT_RESPONSE;
-	dst->receiver_index = keypair->k_remote_index;
-	dst->sender_index = keypair->k_local_index;
-
-	/* e */
-	curve25519_generate_secret(keypair->k_ephemeral_private);
-	if (!curve25519_generate_public(dst->unencrypted_ephemeral,
-					keypair->k_ephemeral_private))
-		goto out;
-	noise_message_ephemeral(dst->unencrypted_ephemeral,
-			  dst->unencrypted_ephemeral, keypair->k_chaining_key,
-			  keypair->k_hash);
-
-	/* ee */
-	if (noise_mix_dh(keypair->k_chaining_key, NULL,
-			 keypair->k_ephemeral_private,
-			 keypair->k_remote_ephemeral) != 0)
-		goto out;
-
-	/* se */
-	if (noise_mix_dh(keypair->k_chaining_key, NULL,
-			 keypair->k_ephemeral_private,
-			 peer->p_remote.r_public) != 0)
-		goto out;
-
-	/* psk */
-	noise_mix_psk(keypair->k_chaining_key, keypair->k_hash, key,
-		      peer->p_remote.r_psk);
-
-	/* {} */
-	noise_message_encrypt(dst->encrypted_nothing, NULL, 0, key,
-			      keypair->k_hash);
-
-	keypair->k_state = HANDSHAKE_CREATED_RESPONSE;
-out:
-	mtx_unlock(&keypair->k_mtx);
-	rw_runlock(&peer->p_sc->sc_local.l_lock);
-	explicit_bzero(key, WG_KEY_SIZE);
-	return keypair != NULL &&
-	       keypair->k_state == HANDSHAKE_CREATED_RESPONSE ? 0 : EINVAL;
-}
-
-struct noise_keypair *
-noise_handshake_consume_response(struct wg_pkt_response *src,
-				    struct wg_softc *sc)
-{
-	enum noise_keypair_state state = HANDSHAKE_ZEROED;
-	struct noise_keypair *keypair;
-	uint8_t key[WG_KEY_SIZE];
-	uint8_t hash[WG_HASH_SIZE];
-	uint8_t chaining_key[WG_HASH_SIZE];
-	uint8_t e[WG_KEY_SIZE];
-	uint8_t ephemeral_private[WG_KEY_SIZE];
-	uint8_t static_private[WG_KEY_SIZE];
-
-	keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
-					      src->receiver_index);
-	if (keypair == NULL)
-		return NULL;
-
-	rw_rlock(&sc->sc_local.l_lock);
-
-	if (!sc->sc_local.l_has_identity)
-		goto out;
-
-	mtx_lock(&keypair->k_mtx);
-	state = keypair->k_state;
-	memcpy(hash, keypair->k_hash, WG_HASH_SIZE);
-	memcpy(chaining_key, keypair->k_chaining_key, WG_HASH_SIZE);
-	memcpy(ephemeral_private, keypair->k_ephemeral_private,
-	       WG_KEY_SIZE);
-	mtx_unlock(&keypair->k_mtx);
-
-	if (state != HANDSHAKE_CREATED_INITIATION)
-		goto out;
-
-	/* e */
-	noise_message_ephemeral(e, src->unencrypted_ephemeral, chaining_key,
-				hash);
-
-	/* ee */
-	if (noise_mix_dh(chaining_key, NULL, ephemeral_private, e) != 0)
-		goto out;
-
-	/* se */
-	if (noise_mix_dh(chaining_key, NULL, sc->sc_local.l_private, e) != 0)
-		goto out;
-
-	/* psk */
-	noise_mix_psk(chaining_key, hash, key, keypair->k_peer->p_remote.r_psk);
-
-	/* {} */
-	if (noise_message_decrypt(NULL, src->encrypted_nothing,
-			     sizeof(src->encrypted_nothing), key, hash) != 0)
-		goto out;
-
-	/* Success! Copy everything to peer */
-	mtx_lock(&keypair->k_mtx);
-	if (keypair->k_state == state) {
-		memcpy(keypair->k_remote_ephemeral, e, WG_KEY_SIZE);
-		memcpy(keypair->k_hash, hash, WG_HASH_SIZE);
-		memcpy(keypair->k_chaining_key, chaining_key, WG_HASH_SIZE);
-		keypair->k_remote_index = src->sender_index;
-		keypair->k_state = HANDSHAKE_CONSUMED_RESPONSE;
-	}
-	mtx_unlock(&keypair->k_mtx);
-out:
-	explicit_bzero(key, WG_KEY_SIZE);
-	explicit_bzero(hash, WG_HASH_SIZE);
-	explicit_bzero(chaining_key, WG_HASH_SIZE);
-	explicit_bzero(ephemeral_private, WG_KEY_SIZE);
-	explicit_bzero(static_private, WG_KEY_SIZE);
-	rw_runlock(&sc->sc_local.l_lock);
-	return keypair->k_state == HANDSHAKE_CONSUMED_RESPONSE ? keypair : NULL;
-}
-
-/*
- * Ratelimiter
- *
- *
- *
- */
-void
-wg_ratelimiter_init(struct wg_ratelimiter *ratelimiter)
-{
-
-}
-
-void
-wg_ratelimiter_uninit(struct wg_ratelimiter *ratelimiter)
-{
-
-}
-
-int
-wg_ratelimiter_allow(struct wg_ratelimiter *ratelimiter, struct mbuf *m)
-{
-	//return ECONNREFUSED;
-	return 0;
-}
-
-/* Cookie */
-void
-wg_precompute_key(uint8_t key[WG_KEY_SIZE],
-    const uint8_t pubkey[WG_KEY_SIZE],
-    const char *label)
-{
-	struct blake2s_state blake;
-
-	blake2s_init(&blake, WG_KEY_SIZE);
-	blake2s_update(&blake, label, strlen(label));
-	blake2s_update(&blake, pubkey, WG_KEY_SIZE);
-	blake2s_final(&blake, key, WG_KEY_SIZE);
-}
-
-void
-wg_cookie_checker_init(struct wg_cookie_checker *checker)
-{
-	mtx_init(&checker->cc_mtx, "cookie checker", NULL, MTX_DEF);
-	getnanotime(&checker->cc_secret_birthdate);
-	arc4random_buf(checker->cc_secret, WG_HASH_SIZE);
-}
-
-void
-wg_cookie_checker_precompute_device_keys(struct wg_softc *sc)
-{
-	mtx_lock(&sc->sc_cookie_checker.cc_mtx);
-	if (sc->sc_local.l_has_identity) {
-		wg_precompute_key(sc->sc_cookie_checker.cc_cookie_key,
-				  sc->sc_local.l_public, COOKIE_KEY_LABEL);
-		wg_precompute_key(sc->sc_cookie_checker.cc_message_mac1_key,
-				  sc->sc_local.l_public, MAC1_KEY_LABEL);
-	} else {
-		bzero(sc->sc_cookie_checker.cc_cookie_key, WG_KEY_SIZE);
-		bzero(sc->sc_cookie_checker.cc_message_mac1_key, WG_KEY_SIZE);
-	}
-	mtx_unlock(&sc->sc_cookie_checker.cc_mtx);
-}
-
-void
-wg_cookie_init(struct wg_cookie *cookie)
-{
-	bzero(cookie, sizeof(*cookie));
-	mtx_init(&cookie->c_mtx, "cookie lock", NULL, MTX_DEF);
-}
-
-void
-wg_cookie_precompute_peer_keys(struct wg_peer *peer)
-{
-	mtx_lock(&peer->p_cookie.c_mtx);
-	wg_precompute_key(peer->p_cookie.c_decryption_key,
-			peer->p_remote.r_public, COOKIE_KEY_LABEL);
-	wg_precompute_key(peer->p_cookie.c_message_mac1_key,
-			peer->p_remote.r_public, MAC1_KEY_LABEL);
-	mtx_unlock(&peer->p_cookie.c_mtx);
-}
-
-void
-wg_compute_mac1(uint8_t mac1[WG_COOKIE_SIZE], const void *message, size_t len,
-    const uint8_t key[WG_KEY_SIZE])
-{
-	len = len - sizeof(struct wg_pkt_macs) +
-	      offsetof(struct wg_pkt_macs, mac1);
-	blake2s(mac1, message, key, WG_COOKIE_SIZE, len, WG_KEY_SIZE);
-}
-
-void
-wg_compute_mac2(uint8_t mac2[WG_COOKIE_SIZE], const void *message, size_t len,
-    const uint8_t cookie[WG_COOKIE_SIZE])
-{
-	len = len - sizeof(struct wg_pkt_macs) +
-	      offsetof(struct wg_pkt_macs, mac2);
-	blake2s(mac2, message, cookie, WG_COOKIE_SIZE, len, WG_COOKIE_SIZE);
-}
-
-void
-wg_make_cookie(uint8_t cookie[WG_COOKIE_SIZE], struct wg_endpoint *e,
-    struct wg_cookie_checker *checker)
-{
-	struct blake2s_state state;
-
-	if (wg_timers_expired(&checker->cc_secret_birthdate,
-				COOKIE_SECRET_MAX_AGE, 0)) {
-		arc4random_buf(checker->cc_secret, WG_HASH_SIZE);
-		getnanotime(&checker->cc_secret_birthdate);
-	}
-
-	blake2s_init_key(&state, WG_COOKIE_SIZE, checker->cc_secret,
-			 WG_HASH_SIZE);
-
-	if (e->e_remote.r_sa.sa_family == AF_INET) {
-		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin.sin_addr,
-			       sizeof(struct in_addr));
-		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin.sin_port,
-			       sizeof(in_port_t));
-	} else if (e->e_remote.r_sa.sa_family == AF_INET6) {
-		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin6.sin6_addr,
-			       sizeof(struct in6_addr));
-		blake2s_update(&state, (uint8_t *)&e->e_remote.r_sin6.sin6_port,
-			       sizeof(in_port_t));
-	} else {
-		panic("how did we receive this packet?");
-	}
-
-	blake2s_final(&state, cookie, WG_COOKIE_SIZE);
-}
-
-enum wg_cookie_mac_state
-wg_cookie_validate_packet(struct wg_cookie_checker *checker, struct mbuf *m,
-    int check_cookie)
-{
-	struct wg_endpoint *e;
-	uint8_t cookie[WG_COOKIE_SIZE];
-	uint8_t computed_mac[WG_COOKIE_SIZE];
-	enum wg_cookie_mac_state ret = INVALID_MAC;
-	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
-		(mtod(m, uint8_t *) + m->m_pkthdr.len - sizeof(*macs));
-
-	mtx_lock(&checker->cc_mtx);
-	wg_compute_mac1(computed_mac, mtod(m, uint8_t *), m->m_pkthdr.len,
-	    checker->cc_message_mac1_key);
-	if (timingsafe_bcmp(computed_mac, macs->mac1, WG_COOKIE_SIZE))
-		goto out;
-
-	ret = VALID_MAC_BUT_NO_COOKIE;
-
-	if (!check_cookie)
-		goto out;
-
-	e = wg_mbuf_endpoint_get(m);
-	wg_make_cookie(cookie, e, checker);
-
-	wg_compute_mac2(computed_mac, mtod(m, uint8_t *), m->m_pkthdr.len,
-	    cookie);
-	if (timingsafe_bcmp(computed_mac, macs->mac2, WG_COOKIE_SIZE))
-		goto out;
-
-	ret = VALID_MAC_WITH_COOKIE_BUT_RATELIMITED;
-	if (wg_ratelimiter_allow(NULL, m) != 0)
-		goto out;
-
-	ret = VALID_MAC_WITH_COOKIE;
-out:
-	mtx_unlock(&checker->cc_mtx);
-	return ret;
-}
-
-void
-wg_cookie_add_mac_to_packet(struct wg_cookie *cookie, void *message, size_t len)
-{
-	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
-		((uint8_t *)message + len - sizeof(*macs));
-
-	mtx_lock(&cookie->c_mtx);
-	wg_compute_mac1(macs->mac1, message, len, cookie->c_message_mac1_key);
-	memcpy(cookie->c_last_mac1_sent, macs->mac1, WG_COOKIE_SIZE);
-	cookie->c_have_sent_mac1 = 1;
-
-	if (!wg_timers_expired(&cookie->c_birthdate,
-	    COOKIE_SECRET_MAX_AGE - COOKIE_SECRET_LATENCY, 0))
-		wg_compute_mac2(macs->mac2, message, len, cookie->c_cookie);
-	else
-		bzero(macs->mac2, WG_COOKIE_SIZE);
-	mtx_unlock(&cookie->c_mtx);
-}
-
-void
-wg_cookie_message_create(struct wg_pkt_cookie *dst, struct mbuf *m,
-		uint32_t index, struct wg_cookie_checker *checker)
-{
-	struct wg_endpoint *e;
-	struct wg_pkt_macs *macs = (struct wg_pkt_macs *)
-		(mtod(m, uint8_t *) + m->m_pkthdr.len - sizeof(*macs));
-	uint8_t cookie[WG_COOKIE_SIZE];
-
-	dst->header.type = WG_PKT_COOKIE;
-	dst->receiver_index = index;
-	arc4random_buf(dst->nonce, WG_XNONCE_SIZE);
-
-	e = wg_mbuf_endpoint_get(m);
-
-	mtx_lock(&checker->cc_mtx);
-	wg_make_cookie(cookie, e, checker);
-	xchacha20poly1305_encrypt(dst->encrypted_cookie, cookie, WG_COOKIE_SIZE,
-			  macs->mac1, WG_MAC_SIZE, dst->nonce,
-			  checker->cc_cookie_key);
-	mtx_unlock(&checker->cc_mtx);
-
-	explicit_bzero(cookie, sizeof(cookie));
-}
-
-void
-wg_cookie_message_consume(struct wg_pkt_cookie *src, struct wg_softc *sc)
-{
-	struct wg_peer *peer;
-	struct noise_keypair *keypair;
-	uint8_t cookie[WG_COOKIE_SIZE];
-
-	if ((keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
-			src->receiver_index)) == NULL)
-		return;
-
-	peer = keypair->k_peer;
-
-	mtx_lock(&peer->p_cookie.c_mtx);
-
-	if (!peer->p_cookie.c_have_sent_mac1)
-		goto out;
-
-	if (xchacha20poly1305_decrypt(cookie, src->encrypted_cookie,
-			sizeof(src->encrypted_cookie),
-			peer->p_cookie.c_last_mac1_sent, WG_MAC_SIZE,
-			src->nonce, peer->p_cookie.c_decryption_key) != 0) {
-		DPRINTF(sc, "Could not decrypt invalid cookie response\n");
-		goto out;
-	}
-
-	memcpy(peer->p_cookie.c_cookie, cookie, WG_COOKIE_SIZE);
-	getnanotime(&peer->p_cookie.c_birthdate);
-	peer->p_cookie.c_have_sent_mac1 = 0;
-
-out:
-	mtx_unlock(&peer->p_cookie.c_mtx);
-	explicit_bzero(cookie, sizeof(cookie));
-	noise_keypair_put(keypair);
-}
-
-/* Peer */
-struct wg_peer *
-wg_peer_create(struct wg_softc *sc, uint8_t pubkey[WG_KEY_SIZE])
-{
-	struct wg_peer *peer;
-
-	peer = malloc(sizeof(*peer), M_WG, M_ZERO|M_NOWAIT);
-	if (peer == NULL)
-		return NULL;
-
-	peer->p_id = atomic_fetchadd_long(&peer_counter, 1);
-	if_ref(sc->sc_ifp);
-
-
-	refcount_init(&peer->p_refcnt, 0);
-
-	noise_remote_init(&peer->p_remote, pubkey);
-
-	wg_cookie_init(&peer->p_cookie);
-	wg_cookie_precompute_peer_keys(peer);
-	wg_peer_timers_init(peer);
-	noise_keypairs_init(&peer->p_keypairs);
-
-	rw_init(&peer->p_endpoint_lock, "wg_peer_endpoint");
-	bzero(&peer->p_endpoint, sizeof(peer->p_endpoint));
-
-	mbufq_init(&peer->p_staged_packets, MAX_STAGED_PACKETS);
-	GROUPTASK_INIT(&peer->p_send_staged, 0,
-	    (gtask_fn_t *)wg_peer_send_staged_packets_ref, peer);
-
-	wg_pktq_init(&peer->p_send_queue, "sendq");
-	wg_pktq_init(&peer->p_recv_queue, "rxq");
-	GROUPTASK_INIT(&peer->p_send, 0, (gtask_fn_t *)wg_peer_send, peer);
-	GROUPTASK_INIT(&peer->p_recv, 0, (gtask_fn_t *)wg_peer_recv, peer);
-
-	GROUPTASK_INIT(&peer->p_tx_initiation, 0,
-	    (gtask_fn_t *)wg_peer_send_handshake_initiation, peer);
-
-	peer->p_tx_bytes = counter_u64_alloc(M_WAITOK);
-	peer->p_rx_bytes = counter_u64_alloc(M_WAITOK);
-
-	CK_LIST_INIT(&peer->p_routes);
-
-	wg_hashtable_peer_insert(&sc->sc_hashtable, peer);
-
-	DPRINTF(sc, "Peer %llu created\n", peer->p_id);
-	return peer;
-}
-
-struct wg_peer *
-wg_peer_ref(struct wg_peer *peer)
-{
-	if (peer != NULL)
-		refcount_acquire(&peer->p_refcnt);
-	return (peer);
-}
-
-void
-wg_peer_put(struct wg_peer *peer)
-{
-
-	if (peer != NULL && refcount_release(&peer->p_refcnt))
-		NET_EPOCH_CALL(wg_peer_free, &peer->p_ctx);
-}
-
-void
-wg_peer_destroy(struct wg_peer **peer_p)
+wg_peer_destroy(struct wg_peer **peer_p)
 {
 	struct wg_peer *peer = *peer_p;
 	struct wg_route *route, *troute;
@@ -2246,6 +1017,7 @@ wg_peer_destroy(struct wg_peer **peer_p)
 	noise_keypairs_clear(&peer->p_keypairs);
 
 	wg_peer_flush_staged_packets(peer);
+	wg_softc_drr_remove(peer->p_sc, peer);
 
 	/* TODO currently, if there is a timer added after here, then the peer
 	 * can hang around for longer than we want. */
@@ -2265,11 +1037,13 @@ wg_peer_free(epoch_context_t ctx)
 	peer = __containerof(ctx, struct wg_peer, p_ctx);
 	counter_u64_free(peer->p_tx_bytes);
 	counter_u64_free(peer->p_rx_bytes);
+	wg_dst_cache_uninit(&peer->p_dst_cache);
 
 	if_free(peer->p_sc->sc_ifp);
 
 	DPRINTF(peer->p_sc, "Peer %llu destroyed\n", peer->p_id);
-	zfree(peer, M_WG);
+	explicit_bzero(peer, sizeof(*peer));
+	uma_zfree(wg_peer_zone, peer);
 }
 
 void
@@ -2355,7 +1129,9 @@ wg_softc_send_handshake_cookie(struct wg_softc *sc, struct mbuf *m,
 
 	e = wg_mbuf_endpoint_get(m);
 	wg_cookie_message_create(&cookie, m, index, &sc->sc_cookie_checker);
-	wg_socket_send_buffer(&sc->sc_socket, &cookie, sizeof(cookie), e);
+	if (wg_socket_send_buffer(&sc->sc_socket, &cookie, sizeof(cookie),
+	    e) != 0)
+		if_inc_counter(sc->sc_ifp, IFCOUNTER_OERRORS, 1);
 }
 
 void
@@ -2368,15 +1144,17 @@ wg_peer_set_endpoint_from_mbuf(struct wg_peer *peer, struct mbuf *m)
 
 	rw_wlock(&peer->p_endpoint_lock);
 	peer->p_endpoint = *e;
+	wg_dst_cache_reset(&peer->p_dst_cache);
 	rw_wunlock(&peer->p_endpoint_lock);
 }
 
 void
 wg_peer_clear_src(struct wg_peer *peer)
 {
-	rw_rlock(&peer->p_endpoint_lock);
+	rw_wlock(&peer->p_endpoint_lock);
 	bzero(&peer->p_endpoint.e_local, sizeof(peer->p_endpoint.e_local));
-	rw_runlock(&peer->p_endpoint_lock);
+	wg_dst_cache_reset(&peer->p_dst_cache);
+	rw_wunlock(&peer->p_endpoint_lock);
 }
 
 int
@@ -2384,35 +1162,202 @@ wg_peer_mbuf_add_ipudp(struct wg_peer *peer, struct mbuf **m)
 {
 	int err;
 	rw_rlock(&peer->p_endpoint_lock);
-	err = wg_mbuf_add_ipudp(m, &peer->p_sc->sc_socket, &peer->p_endpoint);
+	err = wg_mbuf_add_ipudp(m, &peer->p_sc->sc_socket, &peer->p_endpoint,
+	    &peer->p_dst_cache);
 	rw_runlock(&peer->p_endpoint_lock);
 	return err;
 }
 
+/* Serial wakeups */
+static counter_u64_t wg_send_packets;
+static counter_u64_t wg_send_wakeups;
+static counter_u64_t wg_recv_packets;
+static counter_u64_t wg_recv_wakeups;
+/* Handshake packets turned away by wg_input. */
+static counter_u64_t wg_handshake_bad_mac1;
+/* Data packets turned away by wg_input. */
+static counter_u64_t wg_recv_stale;
+/* Staged packets dropped by CoDel. */
+counter_u64_t wg_send_codel_drops;
+/* Flow control between wg_transmit and the encrypt path. */
+counter_u64_t wg_send_stops;
+counter_u64_t wg_send_refused;
+
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, send_packets, CTLFLAG_RD,
+    &wg_send_packets, "Packets handed to the peer send tasks");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, send_wakeups, CTLFLAG_RD,
+    &wg_send_wakeups, "Times a peer send task was scheduled");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, recv_packets, CTLFLAG_RD,
+    &wg_recv_packets, "Packets handed to the peer receive tasks");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, recv_wakeups, CTLFLAG_RD,
+    &wg_recv_wakeups, "Times a peer receive task was scheduled");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, handshake_bad_mac1, CTLFLAG_RD,
+    &wg_handshake_bad_mac1, "Handshake packets dropped for a bad MAC1");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, recv_stale, CTLFLAG_RD,
+    &wg_recv_stale, "Data packets dropped as replayed or expired before "
+    "decryption");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, send_codel_drops, CTLFLAG_RD,
+    &wg_send_codel_drops, "Staged packets dropped for waiting too long");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, send_stops, CTLFLAG_RD,
+    &wg_send_stops, "Times the encrypt path stopped taking staged packets");
+SYSCTL_COUNTER_U64(_net_wg, OID_AUTO, send_refused, CTLFLAG_RD,
+    &wg_send_refused, "Packets refused with ENOBUFS while it was stopped");
+
+void
+wg_stats_init(void)
+{
+	wg_send_packets = counter_u64_alloc(M_WAITOK);
+	wg_send_wakeups = counter_u64_alloc(M_WAITOK);
+	wg_recv_packets = counter_u64_alloc(M_WAITOK);
+	wg_recv_wakeups = counter_u64_alloc(M_WAITOK);
+	wg_handshake_bad_mac1 = counter_u64_alloc(M_WAITOK);
+	wg_recv_stale = counter_u64_alloc(M_WAITOK);
+	wg_send_codel_drops = counter_u64_alloc(M_WAITOK);
+	wg_send_stops = counter_u64_alloc(M_WAITOK);
+	wg_send_refused = counter_u64_alloc(M_WAITOK);
+}
+
+void
+wg_stats_uninit(void)
+{
+	counter_u64_free(wg_send_packets);
+	counter_u64_free(wg_send_wakeups);
+	counter_u64_free(wg_recv_packets);
+	counter_u64_free(wg_recv_wakeups);
+	counter_u64_free(wg_handshake_bad_mac1);
+	counter_u64_free(wg_recv_stale);
+	counter_u64_free(wg_send_codel_drops);
+	counter_u64_free(wg_send_stops);
+	counter_u64_free(wg_send_refused);
+}
+
+static void
+wg_dql_sysctl(struct sysctl_ctx_list *ctx, struct sysctl_oid_list *parent,
+    const char *name, struct wg_dql *d, const char *descr)
+{
+	struct sysctl_oid_list *list;
+
+	list = SYSCTL_CHILDREN(SYSCTL_ADD_NODE(ctx, parent, OID_AUTO, name,
+	    CTLFLAG_RD, NULL, descr));
+	SYSCTL_ADD_UINT(ctx, list, OID_AUTO, "limit", CTLFLAG_RD,
+	    __DEVOLATILE(u_int *, &d->d_limit), 0, "Current limit");
+	SYSCTL_ADD_UINT(ctx, list, OID_AUTO, "watermark", CTLFLAG_RD,
+	    &d->d_watermark, 0, "Longest the queue got in the last interval");
+	SYSCTL_ADD_UINT(ctx, list, OID_AUTO, "rate", CTLFLAG_RD,
+	    &d->d_rate, 0, "Packets served a second, smoothed");
+	SYSCTL_ADD_UINT(ctx, list, OID_AUTO, "min", CTLFLAG_RD,
+	    &d->d_min, 0, "Lowest the limit goes");
+	SYSCTL_ADD_UINT(ctx, list, OID_AUTO, "max", CTLFLAG_RD,
+	    &d->d_max, 0, "Highest the limit goes");
+}
+
+/* The queue limits of an interface, under its device's sysctl tree. */
+void
+wg_softc_sysctl_init(struct wg_softc *sc, struct sysctl_ctx_list *ctx,
+    struct sysctl_oid_list *children)
+{
+	struct sysctl_oid_list *decrypt;
+	char name[16];
+	u_int i;
+
+	wg_dql_sysctl(ctx, children, "encrypt", &sc->sc_encrypt_dql,
+	    "Encryptions in flight, and the packets each peer may stage");
+	SYSCTL_ADD_UINT(ctx, children, OID_AUTO, "encrypt_pending",
+	    CTLFLAG_RD, __DEVOLATILE(u_int *, &sc->sc_encrypt_pending), 0,
+	    "Packets admitted for encryption and not yet encrypted");
+	SYSCTL_ADD_UINT(ctx, children, OID_AUTO, "encrypt_stopped",
+	    CTLFLAG_RD, __DEVOLATILE(u_int *, &sc->sc_encrypt_stopped), 0,
+	    "Whether staged packets wait for encryptions to complete");
+	wg_dql_sysctl(ctx, children, "handshake",
+	    &sc->sc_handshake_queue.hq_dql, "Each handshake queue class");
+	decrypt = SYSCTL_CHILDREN(SYSCTL_ADD_NODE(ctx, children, OID_AUTO,
+	    "decrypt", CTLFLAG_RD, NULL, "Decrypt worker queues"));
+	for (i = 0; i < sc->sc_decrypt_workers; i++) {
+		snprintf(name, sizeof(name), "%u", i);
+		wg_dql_sysctl(ctx, decrypt, name, &sc->sc_decrypt[i].w_dql,
+		    "Decrypt worker queue");
+	}
+}
+
+/*
+ * Hand a finished packet to a peer's serial task, scheduling the task only
+ * when it goes from idle to pending. The caller is in the net epoch, which
+ * keeps the peer alive until here; only a pending run takes a reference,
+ * which the task drops.
+ *
+ * The packet was marked done before we get here and the task clears the
+ * flag before it looks at the queue, so with the fences on both sides
+ * either we see the flag clear or the task sees the packet.
+ */
+static void
+wg_peer_serial_kick(struct wg_peer *peer, volatile u_int *pending,
+		    struct grouptask *task, counter_u64_t packets,
+		    counter_u64_t wakeups)
+{
+	counter_u64_add(packets, 1);
+	atomic_thread_fence_seq_cst();
+	if (*pending == 0 && atomic_cmpset_int(pending, 0, 1)) {
+		counter_u64_add(wakeups, 1);
+		wg_peer_ref(peer);
+		GROUPTASK_ENQUEUE(task);
+	}
+}
+
+void
+wg_peer_send_kick(struct wg_peer *peer)
+{
+	wg_peer_serial_kick(peer, &peer->p_send_pending, &peer->p_send,
+	    wg_send_packets, wg_send_wakeups);
+}
+
+void
+wg_peer_recv_kick(struct wg_peer *peer)
+{
+	wg_peer_serial_kick(peer, &peer->p_recv_pending, &peer->p_recv,
+	    wg_recv_packets, wg_recv_wakeups);
+}
+
+/*
+ * Sends the peer's packets in the order they were queued, each as soon as
+ * it and those ahead of it are done: data messages once sealed, handshake
+ * messages at once. A packet left uncrypted is dropped in its turn.
+ */
 void
 wg_peer_send(struct wg_peer *peer)
 {
-	UNIMPLEMENTED();
-#if 0
+	struct epoch_tracker et;
 	struct mbuf *m;
+	struct wg_softc *sc;
 	struct wg_queue_pkt *pkt;
+	uint16_t family;
+
+	sc = peer->p_sc;
 
-	while ((pkt = wg_queue_serial_dequeue(&peer->p_send_queue)) != NULL) {
+	NET_EPOCH_ENTER(et);
+	atomic_store_int(&peer->p_send_pending, 0);
+	atomic_thread_fence_seq_cst();
+	while ((pkt = wg_pktq_serial_dequeue(&peer->p_send_queue)) != NULL) {
 		m = pkt->p_pkt;
 		if (pkt->p_state == WG_PKT_STATE_CRYPTED) {
 			counter_u64_add(peer->p_tx_bytes, m->m_pkthdr.len);
-			//wg_socket_send_mbuf(&peer->p_sc->sc_socket, m, XXX);
+			wg_mbuf_pkt_detach(pkt);
+			family = mtod(m, struct ip *)->ip_v == IPVERSION ?
+			    AF_INET : AF_INET6;
+			if (wg_socket_send_mbuf(&sc->sc_socket, m, family,
+			    &peer->p_dst_cache) != 0)
+				if_inc_counter(sc->sc_ifp, IFCOUNTER_OERRORS, 1);
 		} else {
 			m_freem(m);
 		}
 	}
+	NET_EPOCH_EXIT(et);
 	wg_peer_put(peer);
-#endif
 }
 
 void
 wg_peer_recv(struct wg_peer *peer)
 {
+	struct epoch_tracker et;
 	struct mbuf *m;
 	struct wg_softc *sc;
 	struct wg_queue_pkt *pkt;
@@ -2420,6 +1365,9 @@ wg_peer_recv(struct wg_peer *peer)
 
 	sc = peer->p_sc;
 
+	NET_EPOCH_ENTER(et);
+	atomic_store_int(&peer->p_recv_pending, 0);
+	atomic_thread_fence_seq_cst();
 	while ((pkt = wg_pktq_serial_dequeue(&peer->p_recv_queue)) != NULL) {
 		m = pkt->p_pkt;
 		if (pkt->p_state == WG_PKT_STATE_CLEAR) {
@@ -2428,6 +1376,7 @@ wg_peer_recv(struct wg_peer *peer)
 			m->m_flags &= ~(M_MCAST | M_BCAST);
 			//pf_pkt_addr_changed(m);
 			m->m_pkthdr.rcvif = sc->sc_ifp;
+			wg_mbuf_pkt_detach(pkt);
 			version = mtod(m, struct ip *)->ip_v;
 			BPF_MTAP(sc->sc_ifp, m);
 			if (version == IPVERSION)
@@ -2440,6 +1389,7 @@ wg_peer_recv(struct wg_peer *peer)
 			m_freem(m);
 		}
 	}
+	NET_EPOCH_EXIT(et);
 	wg_peer_put(peer);
 }
 
@@ -2455,264 +1405,114 @@ wg_peer_enqueue_buffer(struct wg_peer *peer, void *buf, size_t len)
 
 	if (wg_peer_mbuf_add_ipudp(peer, &m) != 0) {
 		m_freem(m);
+		if_inc_counter(peer->p_sc->sc_ifp, IFCOUNTER_OERRORS, 1);
 		return;
 	}
 
-	pkt = wg_mbuf_pkt_get(m);
+	if ((pkt = wg_mbuf_pkt_get(m)) == NULL) {
+		m_freem(m);
+		return;
+	}
 	pkt->p_state = WG_PKT_STATE_CRYPTED;
 
 	wg_pktq_serial_enqueue(&peer->p_send_queue, pkt);
 	wg_pktq_pkt_done(pkt);
-	GROUPTASK_ENQUEUE(&peer->p_send);
-}
-
-void
-wg_peer_send_keepalive(struct wg_peer *peer)
-{
-	struct mbuf *m;
-
-	if (mbufq_len(&peer->p_staged_packets) == 0 &&
-	    (m = m_gethdr(M_NOWAIT, MT_DATA)) != NULL) {
-		mbufq_enqueue(&peer->p_staged_packets, m);
-
-		DPRINTF(peer->p_sc, "Sending keepalive packet to peer %llu\n",
-				peer->p_id);
-	}
-
-	wg_peer_send_staged_packets(peer);
-}
-
-void
-wg_peer_send_staged_packets(struct wg_peer *peer)
-{
-	struct wg_softc *sc = peer->p_sc;
-	struct noise_keypair *keypair;
-	struct wg_queue_pkt *pkt;
-	struct mbufq mq;
-	struct mbuf *m;
-
-	NET_EPOCH_ASSERT();
-	mbufq_init(&mq , MAX_QUEUED_PACKETS);
-
-	/*
-	 * The duplicated locking and unlocking with the wg_transmit caller
-	 * is kind of moronic  but it's what Linux and OpenBSD both do here,
-	 * so it is maintained in the interim
-	 */
-	mtx_lock(&peer->p_lock);
-	mbufq_concat(&mq, &peer->p_staged_packets);
-	mtx_unlock(&peer->p_lock);
-	/* First we make sure we have a valid reference to a valid key. */
-	/* XXX determine lifecycle management - epoch? */
-	keypair = noise_keypairs_lookup(&peer->p_keypairs,
-	    NOISE_KEYPAIR_CURRENT);
-
-	if (keypair == NULL || wg_timers_expired(&keypair->k_birthdate,
-						 REJECT_AFTER_TIME, 0))
-		goto invalid;
-
-	/*
-	 * After we know we have a somewhat valid key, we now try to assign
-	 * nonces to all of the packets in the queue. If we can't assign nonces
-	 * for all of them, we just consider it a failure and wait for the next
-	 * handshake.
-	 */
-	while (wg_pktq_parallel_len(&sc->sc_encrypt_queue) < MAX_QUEUED_PACKETS
-			&& (m = mbufq_dequeue(&mq)) != NULL) {
-
-		pkt = wg_mbuf_pkt_get(m);
-		pkt->p_state = WG_PKT_STATE_CLEAR;
-		pkt->p_nonce = wg_counter_next(&keypair->k_counter);
-
-		if (pkt->p_nonce >= REJECT_AFTER_MESSAGES) {
-			m_freem(m);
-			goto invalid;
-		}
-
-		pkt->p_keypair = noise_keypair_ref(keypair);
-
-		wg_pktq_enqueue(&sc->sc_encrypt_queue, &peer->p_send_queue,
-				pkt);
-	}
-
-	GROUPTASK_ENQUEUE(&sc->sc_encrypt);
-	noise_keypair_put(keypair);
-	return;
-invalid:
-	/*
-	 * If we're exiting because there's something wrong with the key, it
-	 * means we should initiate a new handshake.
-	 */
-	wg_peer_queue_handshake_initiation(peer, 0);
-	noise_keypair_put(keypair);
-}
-
-void
-wg_peer_send_staged_packets_ref(struct wg_peer *peer)
-{
-	wg_peer_send_staged_packets(peer);
-	wg_peer_put(peer);
-}
-
-void
-wg_peer_flush_staged_packets(struct wg_peer *peer)
-{
-	mbufq_drain(&peer->p_staged_packets);
+	wg_peer_send_kick(peer);
 }
 
 /* Packet */
-
-static struct mbuf *
-wg_mbuf_pkthdr_move(struct mbuf *m)
-{
-	struct mbuf *mh;
-
-	mh = m_gethdr(M_NOWAIT, MT_DATA);
-	if (mh == NULL)
-			return (NULL);
-	memcpy(&mh->m_pkthdr, &m->m_pkthdr, sizeof(struct pkthdr));
-	m_demote_pkthdr(m);
-	mh->m_next = m;
-	return (mh);
-}
-
-static struct wg_endpoint *
-wg_mbuf_endpoint_get(struct mbuf *m)
-{
-	struct m_dat_hdr *hdr;
-	struct wg_queue_pkt *wqpkt;
-
-	MPASS(m->m_flags & M_PKTHDR);
-	if ((m->m_flags  & M_EXT) == 0) {
-		/*
-		 * We can't readily use m_pktdat
-		 */
-		if ((m = wg_mbuf_pkthdr_move(m)) == NULL)
-			return (NULL);
-	}
-
-	/*
-	 * m->m_pktdat is not in use
-	 */
-	hdr = (struct m_dat_hdr *)m->m_pktdat;
-	if ((m->m_flags & M_DAT_INUSE) == 0) {
-		m->m_flags |= M_DAT_INUSE;
-		hdr->mdh_types[0] = M_DAT_TYPE_ENDPOINT;
-		hdr->mdh_types[1] = M_DAT_TYPE_UNUSED;
-	}
-	switch (hdr->mdh_types[0]) {
-		case M_DAT_TYPE_ENDPOINT:
-			return (struct wg_endpoint *)(hdr +1);
-		case M_DAT_TYPE_QPKT:
-			wqpkt = (struct wg_queue_pkt *)(hdr +1);
-			if (hdr->mdh_types[1] == M_DAT_TYPE_UNUSED)
-				hdr->mdh_types[1] = M_DAT_TYPE_ENDPOINT;
-			return (struct wg_endpoint *)(wqpkt +1);
-		default:
-			panic("invalid M_DAT type");
+/* Fills in e from a datagram that still starts with its IP header. */
+static void
+wg_endpoint_from_mbuf(struct wg_endpoint *e, struct mbuf *m,
+		      const struct sockaddr *srcsa)
+{
+	bzero(e, sizeof(*e));
+	memcpy(&e->e_remote, srcsa, MIN(srcsa->sa_len, sizeof(e->e_remote)));
+	if (srcsa->sa_family == AF_INET) {
+		e->e_local.l_in = mtod(m, struct ip *)->ip_dst;
+	} else {
+		e->e_local.l_in6 = mtod(m, struct ip6_hdr *)->ip6_dst;
+		e->e_local.l_pktinfo6.ipi6_ifindex =
+		    m->m_pkthdr.rcvif->if_index;
 	}
-	return (NULL);
 }
 
-static struct wg_queue_pkt *
-wg_mbuf_pkt_get(struct mbuf *m)
-{
-	struct m_dat_hdr *hdr;
-	struct wg_endpoint *wend;
+CTASSERT(sizeof(struct ip6_hdr) + sizeof(struct udphdr) <= WG_IPUDP_HDR_MAX);
 
-	MPASS(m->m_flags & M_PKTHDR);
-	if ((m->m_flags  & M_EXT) == 0) {
-		/*
-		 * We can't readily use m_pktdat
-		 */
-		if ((m = wg_mbuf_pkthdr_move(m)) == NULL)
-			return (NULL);
-	}
+/*
+ * A cached header is only reusable while the socket is bound to the same
+ * port and, if its source was selected here, the routing table has not
+ * changed since.
+ * Endpoint changes reset the cache outright.
+ */
+static bool
+wg_ipudp_hdr_valid(struct wg_dst_cache *dc, struct wg_socket *so)
+{
+	struct wg_ipudp_hdr *h = &dc->dc_hdr;
+	struct inpcb *inp;
 
-	/*
-	 * m->m_pktdat is not in use
-	 */
-	hdr = (struct m_dat_hdr *)m->m_pktdat;
-	if ((m->m_flags & M_DAT_INUSE) == 0) {
-		m->m_flags |= M_DAT_INUSE;
-		hdr->mdh_types[0] = M_DAT_TYPE_QPKT;
-		hdr->mdh_types[1] = M_DAT_TYPE_UNUSED;
-	}
-	switch (hdr->mdh_types[0]) {
-		case M_DAT_TYPE_QPKT:
-			return (struct wg_queue_pkt *)(hdr +1);
-		case M_DAT_TYPE_ENDPOINT:
-			wend = (struct wg_endpoint *)(hdr +1);
-			if (hdr->mdh_types[1] == M_DAT_TYPE_UNUSED)
-				hdr->mdh_types[1] = M_DAT_TYPE_QPKT;
-			return (struct wg_queue_pkt *)(wend +1);
-		default:
-			panic("invalid M_DAT type");
-	}
-	return (NULL);
+	mtx_assert(&dc->dc_mtx, MA_OWNED);
+	if (h->h_len == 0)
+		return (false);
+	inp = sotoinpcb(h->h_family == AF_INET ? so->so_so4 : so->so_so6);
+	if (h->h_sport != inp->inp_lport)
+		return (false);
+	if (h->h_routed &&
+	    dc->dc_gen != RT_GEN(inp->inp_inc.inc_fibnum, h->h_family))
+		return (false);
+	return (true);
 }
 
-
-int
-wg_mbuf_add_ipudp(struct mbuf **m0, struct wg_socket *so, struct wg_endpoint *e)
+static int
+wg_ipudp_hdr_build(struct wg_ipudp_hdr *h, struct wg_socket *so,
+		   struct wg_endpoint *e, struct wg_dst_cache *dc)
 {
-	struct mbuf *m = *m0;
-	int err, len = m->m_pkthdr.len;
 	struct inpcb *inp;
-	struct thread *td;
-
 	struct ip *ip4;
 	struct ip6_hdr *ip6;
 	struct udphdr *udp;
-
-	struct in_addr laddr4;
-	struct in6_addr laddr6;
+	struct sockaddr_in6 dst6;
 	in_port_t rport;
+	int err;
 
-
-	td = curthread;
+	bzero(h, sizeof(*h));
 	if (e->e_remote.r_sa.sa_family == AF_INET) {
-		m = m_prepend(m, sizeof(*ip4) + sizeof(*udp), M_WAITOK);
-
 		inp = sotoinpcb(so->so_so4);
 
-		ip4 = mtod(m, struct ip *);
+		ip4 = (struct ip *)h->h_buf;
 		ip4->ip_v	= IPVERSION;
 		ip4->ip_hl	= sizeof(*ip4) >> 2;
 		// XXX
 		// ip4->ip_tos	= inp->inp_ip.ip_tos; /* TODO ECN */
-		ip4->ip_len	= htons(sizeof(*ip4) + sizeof(*udp) + len);
-		//ip4->ip_id	= htons(ip_randomid());
+		/* ip_output fills in ip_id. */
 		ip4->ip_off	= 0;
-		// ip4->ip_ttl	= inp->inp_ip.ip_ttl;
+		ip4->ip_ttl	= inp->inp_ip_ttl;
 		ip4->ip_p	= IPPROTO_UDP;
 
 		if (e->e_local.l_in.s_addr == INADDR_ANY) {
-			rtfree(inp->inp_route.ro_rt);
-			inp->inp_route.ro_rt = NULL;
-			err = in_pcbladdr(inp, &e->e_remote.r_sin.sin_addr, &laddr4, td->td_ucred);
+			err = wg_dst_cache_src4(dc, inp, e, &ip4->ip_src);
 			if (err != 0)
 				return err;
-
-			e->e_local.l_in = *&laddr4;
+			h->h_routed = dc != NULL;
+		} else {
+			ip4->ip_src = e->e_local.l_in;
 		}
 
-		ip4->ip_src	= e->e_local.l_in;
 		ip4->ip_dst	= e->e_remote.r_sin.sin_addr;
 		rport		= e->e_remote.r_sin.sin_port;
 
-		udp = (struct udphdr *)(mtod(m, caddr_t) + sizeof(*ip4));
+		h->h_psum = in_pseudo(ip4->ip_src.s_addr, ip4->ip_dst.s_addr,
+		    htons(IPPROTO_UDP));
+		h->h_len = sizeof(*ip4) + sizeof(*udp);
+		udp = (struct udphdr *)(ip4 + 1);
 
 	} else if (e->e_remote.r_sa.sa_family == AF_INET6) {
-		m = m_prepend(m, sizeof(*ip6) + sizeof(*udp), M_WAITOK);
-
 		inp = sotoinpcb(so->so_so6);
 
-		ip6 = mtod(m, struct ip6_hdr *);
+		ip6 = (struct ip6_hdr *)h->h_buf;
 		/* TODO ECN */
 		//ip6->ip6_flow	 = inp->inp_flowinfo & IPV6_FLOWINFO_MASK;
-		ip6->ip6_vfc	&= ~IPV6_VERSION_MASK;
-		ip6->ip6_vfc	|= IPV6_VERSION;
+		ip6->ip6_vfc	 = IPV6_VERSION;
 #if 0	/* ip6_plen will be filled in ip6_output. */
 		ip6->ip6_plen	 = htons(XXX);
 #endif
@@ -2720,54 +1520,151 @@ wg_mbuf_add_ipudp(struct mbuf **m0, struct wg_socket *so, struct wg_endpoint *e)
 		ip6->ip6_hlim	 = in6_selecthlim(inp, NULL);
 
 		if (IN6_IS_ADDR_UNSPECIFIED(&e->e_local.l_in6)) {
-			rtfree(inp->inp_route.ro_rt);
-			inp->inp_route.ro_rt = NULL;
-			err = in6_selectsrc_addr(0, &e->e_remote.r_sin6.sin6_addr, 0,
-									 NULL, &laddr6, NULL);
+			err = wg_dst_cache_src6(dc, inp, e, &ip6->ip6_src);
 			if (err != 0)
 				return err;
-			e->e_local.l_in6 = *&laddr6;
+			h->h_routed = dc != NULL;
+		} else {
+			ip6->ip6_src = e->e_local.l_in6;
 		}
 
-		ip6->ip6_src	 = e->e_local.l_in6;
-		/* ip6->ip6_dst	 = e->e_remote.r_sin6.sin6_addr; */
-		rport		 = e->e_remote.r_sin6.sin6_port;
-
-		if (sa6_embedscope(&e->e_remote.r_sin6, 0) != 0)
+		/* Embed the scope in a copy, the endpoint is shared. */
+		dst6 = e->e_remote.r_sin6;
+		if (sa6_embedscope(&dst6, 0) != 0)
 			return ENXIO;
+		ip6->ip6_dst	 = dst6.sin6_addr;
+		rport		 = e->e_remote.r_sin6.sin6_port;
 
-		udp = (struct udphdr *)(mtod(m, caddr_t) + sizeof(*ip6));
+		h->h_psum = in6_cksum_pseudo(ip6, 0, IPPROTO_UDP, 0);
+		h->h_len = sizeof(*ip6) + sizeof(*udp);
+		udp = (struct udphdr *)(ip6 + 1);
 
 	} else {
 		return EAFNOSUPPORT;
 	}
 
-	m->m_flags &= ~(M_BCAST|M_MCAST);
-	m->m_pkthdr.csum_flags |= CSUM_UDP | CSUM_UDP_IPV6;
-
 	udp->uh_sport = inp->inp_lport;
 	udp->uh_dport = rport;
+
+	h->h_sport = inp->inp_lport;
+	h->h_family = e->e_remote.r_sa.sa_family;
+	return 0;
+}
+
+/*
+ * One copy of the template, then patch the lengths and the checksum seed.
+ * This runs under locks and in crypto(9) callbacks, so it cannot sleep: if
+ * the header takes an mbuf that cannot be had, the packet is freed, *m0 is
+ * set to NULL and ENOBUFS returned. Data messages are framed with room for
+ * the header, so theirs never fails.
+ */
+static int
+wg_ipudp_hdr_apply(struct mbuf **m0, const struct wg_ipudp_hdr *h)
+{
+	struct mbuf *m = *m0;
+	int len = m->m_pkthdr.len;
+	struct udphdr *udp;
+
+	M_PREPEND(m, h->h_len, M_NOWAIT);
+	if ((*m0 = m) == NULL)
+		return (ENOBUFS);
+	memcpy(mtod(m, void *), h->h_buf, h->h_len);
+
+	udp = (struct udphdr *)(mtod(m, caddr_t) + h->h_len - sizeof(*udp));
 	udp->uh_ulen = htons(sizeof(*udp) + len);
-	udp->uh_sum = 0;
+	udp->uh_sum = in_addword(h->h_psum, udp->uh_ulen);
+
+	if (h->h_family == AF_INET) {
+		mtod(m, struct ip *)->ip_len = htons(h->h_len + len);
+		m->m_pkthdr.csum_flags |= CSUM_UDP;
+	} else {
+		m->m_pkthdr.csum_flags |= CSUM_UDP_IPV6;
+	}
+	m->m_pkthdr.csum_data = offsetof(struct udphdr, uh_sum);
+	m->m_flags &= ~(M_BCAST|M_MCAST);
+	return (0);
+}
 
-	*m0 = m;
+int
+wg_mbuf_add_ipudp(struct mbuf **m0, struct wg_socket *so, struct wg_endpoint *e,
+		  struct wg_dst_cache *dc)
+{
+	struct wg_ipudp_hdr hdr;
+	int err = 0;
 
-	return 0;
+	if (dc == NULL) {
+		err = wg_ipudp_hdr_build(&hdr, so, e, NULL);
+	} else {
+		mtx_lock(&dc->dc_mtx);
+		if (!wg_ipudp_hdr_valid(dc, so))
+			err = wg_ipudp_hdr_build(&dc->dc_hdr, so, e, dc);
+		if (err == 0)
+			hdr = dc->dc_hdr;
+		mtx_unlock(&dc->dc_mtx);
+	}
+	if (err != 0)
+		return err;
+
+	return (wg_ipudp_hdr_apply(m0, &hdr));
+}
+
+/*
+ * Checks the MACs of a handshake packet, against a cookie as well while we
+ * are under load. Returns true if the packet is to be consumed; otherwise
+ * it has been answered with a cookie or dropped.
+ */
+static bool
+wg_handshake_admit(struct wg_softc *sc, struct mbuf *m)
+{
+	enum wg_cookie_mac_state mac_state;
+	int under_load;
+
+	under_load = wg_handshake_under_load(&sc->sc_handshake_queue);
+	mac_state = wg_cookie_validate_packet(&sc->sc_cookie_checker, m,
+					      under_load);
+	if ((under_load && mac_state == VALID_MAC_WITH_COOKIE) ||
+	    (!under_load && mac_state == VALID_MAC_BUT_NO_COOKIE))
+		return (true);
+
+	if (under_load && mac_state == VALID_MAC_BUT_NO_COOKIE) {
+		/* Initiations and responses keep sender_index in one place. */
+		wg_softc_send_handshake_cookie(sc, m,
+		    mtod(m, struct wg_pkt_initiation *)->sender_index);
+		return (false);
+	}
+	DPRINTF(sc, "Handshake packet ratelimited, dropping\n");
+	m_freem(m);
+	return (false);
+}
+
+/* Answers an initiation that has been consumed into keypair, or not. */
+static void
+wg_receive_initiation(struct wg_softc *sc, struct mbuf *m,
+    struct noise_keypair *keypair)
+{
+	if (keypair == NULL) {
+		DPRINTF(sc, "Invalid handshake initiation");
+		m_freem(m);
+		return;
+	}
+	wg_peer_set_endpoint_from_mbuf(keypair->k_peer, m);
+	DPRINTF(sc, "Receiving handshake initiation from peer %llu\n",
+			keypair->k_peer->p_id);
+	wg_peer_send_handshake_response(keypair->k_peer);
+
+	wg_peer_timers_any_authenticated_packet_received(keypair->k_peer);
+	wg_peer_timers_any_authenticated_packet_traversal(keypair->k_peer);
+
+	noise_keypair_put(keypair);
+	m_freem(m);
 }
 
 void
 wg_receive_handshake_packet(struct wg_softc *sc, struct mbuf *m)
 {
-	enum wg_cookie_mac_state mac_state;
 	struct noise_keypair *keypair;
 	struct wg_pkt_initiation *init;
-	struct wg_pkt_response *resp;
-	/* This is global, so that our load calculation applies to the whole
-	 * system. We don't care about races with it at all.
-	 */
-	static struct timespec last_under_load;
-	int packet_needs_cookie;
-	int under_load;
+	struct wg_pkt_response *resp;
 
 	if (*mtod(m, uint32_t *) == WG_PKT_COOKIE) {
 		DPRINTF(sc, "Receiving cookie response\n");
@@ -2775,52 +1672,17 @@ wg_receive_handshake_packet(struct wg_softc *sc, struct mbuf *m)
 		goto free;
 	}
 
-	under_load = mbufq_len(&sc->sc_handshake_queue) >=
-			MAX_QUEUED_INCOMING_HANDSHAKES / 8;
-	if (under_load)
-		getnanotime(&last_under_load);
-	else if (last_under_load.tv_sec != 0)
-		under_load = !wg_timers_expired(&last_under_load, 1, 0);
-
-	mac_state = wg_cookie_validate_packet(&sc->sc_cookie_checker, m,
-					      under_load);
-	if ((under_load && mac_state == VALID_MAC_WITH_COOKIE) ||
-	    (!under_load && mac_state == VALID_MAC_BUT_NO_COOKIE))
-		packet_needs_cookie = 0;
-	else if (under_load && mac_state == VALID_MAC_BUT_NO_COOKIE)
-		packet_needs_cookie = 1;
-	else {
-		DPRINTF(sc, "Handshake packet ratelimited, dropping\n");
-		goto free;
-	}
+	if (!wg_handshake_admit(sc, m))
+		return;
 
 	switch (*mtod(m, uint32_t *)) {
 	case WG_PKT_INITIATION:
 		init = mtod(m, struct wg_pkt_initiation *);
-
-		if (packet_needs_cookie) {
-			wg_softc_send_handshake_cookie(sc, m,
-						       init->sender_index);
-			return;
-		}
-		keypair = noise_handshake_consume_initiation(init, sc);
-		if (keypair == NULL) {
-			DPRINTF(sc, "Invalid handshake initiation");
-			goto free;
-		}
-		wg_peer_set_endpoint_from_mbuf(keypair->k_peer, m);
-		DPRINTF(sc, "Receiving handshake initiation from peer %llu\n",
-				keypair->k_peer->p_id);
-		wg_peer_send_handshake_response(keypair->k_peer);
-		break;
+		wg_receive_initiation(sc, m,
+		    noise_handshake_consume_initiation(init, sc));
+		return;
 	case WG_PKT_RESPONSE:
 		resp = mtod(m, struct wg_pkt_response *);
-
-		if (packet_needs_cookie) {
-			wg_softc_send_handshake_cookie(sc, m,
-						       resp->sender_index);
-			return;
-		}
 		keypair = noise_handshake_consume_response(resp, sc);
 		if (keypair == NULL) {
 			DPRINTF(sc, "Invalid handshake response\n");
@@ -2842,10 +1704,9 @@ wg_receive_handshake_packet(struct wg_softc *sc, struct mbuf *m)
 			wg_peer_send_keepalive(keypair->k_peer);
 		}
 		break;
-	}
-
-	if (keypair == NULL)
+	default:
 		panic("Wrong type of packet in handshake queue!");
+	}
 
 	wg_peer_timers_any_authenticated_packet_received(keypair->k_peer);
 	wg_peer_timers_any_authenticated_packet_traversal(keypair->k_peer);
@@ -2854,86 +1715,267 @@ wg_receive_handshake_packet(struct wg_softc *sc, struct mbuf *m)
 free:
 	m_freem(m);
 }
-#ifdef notyet
-struct wg_peer *
-wg_queue_pkt_encrypt(struct wg_queue_pkt *pkt)
+/*
+ * Crypto
+ *
+ * Data packets are normally sealed and opened inline by the encrypt and
+ * decrypt grouptasks. With net.wg.crypto_async set they are instead handed
+ * to crypto(9), which lets accelerator drivers do the work; cryptosoft is
+ * enough to exercise the path. One AEAD session is created per softc and
+ * every request carries its keypair's key, so nothing has to follow the
+ * keypairs through rekeying. Requests may complete in any order: a packet is
+ * only marked done from its callback, and the peer's serial queue still
+ * releases packets in the order they were queued.
+ */
+static int wg_crypto_async = 0;
+SYSCTL_INT(_net_wg, OID_AUTO, crypto_async, CTLFLAG_RWTUN, &wg_crypto_async,
+    0, "Encrypt and decrypt data packets through crypto(9)");
+
+int
+wg_crypto_init(struct wg_softc *sc)
 {
-	struct wg_pkt_data *data;
-	size_t padding_len, plaintext_len;
+	struct crypto_session_params csp;
+
+	bzero(&csp, sizeof(csp));
+	csp.csp_mode = CSP_MODE_AEAD;
+	/* RFC 8439 construction with a 96 bit nonce, as WireGuard uses. */
+	csp.csp_cipher_alg = CRYPTO_CHACHA20_POLY1305;
+	csp.csp_cipher_klen = CHACHA20POLY1305_KEY_SIZE;
+	csp.csp_ivlen = WG_CRYPTO_IV_SIZE;
+	csp.csp_auth_mlen = WG_MAC_SIZE;
+
+	return (crypto_newsession(&sc->sc_crypto, &csp,
+	    CRYPTOCAP_F_HARDWARE | CRYPTOCAP_F_SOFTWARE));
+}
+
+/*
+ * Sends every packet after this through the inline cipher and waits for the
+ * requests already in crypto(9), whose callbacks still kick the peers and
+ * the encrypt task.
+ */
+void
+wg_crypto_drain(struct wg_softc *sc)
+{
+	atomic_store_int(&sc->sc_crypto_draining, 1);
+	/* Either wg_crypto_dispatch sees it draining, or this sees its count. */
+	atomic_thread_fence_seq_cst();
+	while (atomic_load_int(&sc->sc_crypto_pending) != 0)
+		pause("wgcrypt", 1);
+}
+
+void
+wg_crypto_uninit(struct wg_softc *sc)
+{
+	if (sc->sc_crypto != NULL) {
+		crypto_freesession(sc->sc_crypto);
+		sc->sc_crypto = NULL;
+	}
+}
+
+static int
+wg_crypto_encrypt_done(struct cryptop *crp)
+{
+	struct wg_queue_pkt *pkt = crp->crp_opaque;
+	struct epoch_tracker et;
+	struct wg_softc *sc;
+	struct wg_peer *peer;
+	int error = crp->crp_etype;
+
+	crypto_freereq(crp);
+	NET_EPOCH_ENTER(et);
+	peer = wg_queue_pkt_encrypt_finish(pkt, error);
+	sc = peer->p_sc;
+	wg_pktq_pkt_done(pkt);
+	wg_peer_send_kick(peer);
+	wg_softc_encrypt_done(sc);
+	NET_EPOCH_EXIT(et);
+	atomic_subtract_int(&sc->sc_crypto_pending, 1);
+	return (0);
+}
+
+static int
+wg_crypto_decrypt_done(struct cryptop *crp)
+{
+	struct wg_queue_pkt *pkt = crp->crp_opaque;
+	struct wg_decrypt_worker *w;
+	struct epoch_tracker et;
+	struct wg_softc *sc;
+	struct wg_peer *peer;
+	int error = crp->crp_etype;
+
+	crypto_freereq(crp);
+	sc = pkt->p_keypair->k_peer->p_sc;
+	w = &sc->sc_decrypt[WG_INDEX_WORKER(pkt->p_keypair->k_local_index)];
+	NET_EPOCH_ENTER(et);
+	peer = wg_queue_pkt_decrypt_finish(pkt, error);
+	wg_pktq_pkt_done(pkt);
+	wg_peer_recv_kick(peer);
+	wg_decrypt_worker_done(w);
+	NET_EPOCH_EXIT(et);
+	atomic_subtract_int(&sc->sc_crypto_pending, 1);
+	return (0);
+}
+
+/*
+ * Submits a prepared data message to crypto(9). On success the packet is
+ * owned by the request until its callback runs; otherwise the request is
+ * freed and the caller still has to process the packet inline.
+ */
+static int
+wg_crypto_dispatch(struct wg_softc *sc, struct wg_queue_pkt *pkt,
+		   enum wg_crypto_op op)
+{
+	struct cryptop *crp;
 	struct mbuf *m = pkt->p_pkt;
-	void *cl;
-	struct wg_peer *peer = wg_peer_ref(pkt->p_keypair->k_peer);
-
-	padding_len = WG_PADDING_SIZE(m->m_pkthdr.len);
-	plaintext_len = m->m_pkthdr.len + padding_len;
-
-    cl = m_cljget(NULL, M_WAITOK,
-		     sizeof(struct wg_pkt_data) + plaintext_len + WG_MAC_SIZE);
-	memcpy(cl, m->m_data, m->m_len);
-	M_MOVE_PKTHDR(mc, m);
-	mc->m_len = sizeof(struct wg_pkt_data) +
-		m->m_pkthdr.len + padding_len + WG_MAC_SIZE;
-	m_calchdrlen(mc);
-
-	data = mtod(mc, struct wg_pkt_data *);
-	m_copydata(m, 0, m->m_pkthdr.len, data->buf);
-	bzero(data->buf + m->m_pkthdr.len, padding_len);
-
-	data->header.type = WG_PKT_DATA;
-	data->receiver_index = pkt->p_keypair->k_remote_index;
-	data->nonce = htole64(pkt->p_nonce);
-
-	chacha20poly1305_encrypt(data->buf, data->buf, plaintext_len, NULL, 0,
-				 data->nonce, pkt->p_keypair->k_send);
-	noise_keypair_put(pkt->p_keypair);
+	int error, len;
+
+	if (!wg_crypto_async || sc->sc_crypto == NULL)
+		return (EOPNOTSUPP);
+	atomic_add_int(&sc->sc_crypto_pending, 1);
+	atomic_thread_fence_seq_cst();
+	if (atomic_load_int(&sc->sc_crypto_draining) != 0) {
+		error = EOPNOTSUPP;
+		goto out;
+	}
+	if ((crp = crypto_getreq(sc->sc_crypto, M_NOWAIT)) == NULL) {
+		error = ENOMEM;
+		goto out;
+	}
+
+	len = m->m_pkthdr.len - sizeof(struct wg_pkt_data) - WG_MAC_SIZE;
+	crypto_use_mbuf(crp, m);
+	crp->crp_flags = CRYPTO_F_CBIFSYNC | CRYPTO_F_IV_SEPARATE;
+	crp->crp_payload_start = sizeof(struct wg_pkt_data);
+	crp->crp_payload_length = len;
+	crp->crp_digest_start = sizeof(struct wg_pkt_data) + len;
+	/* The 64 bit counter is the tail of an otherwise zero nonce. */
+	bzero(crp->crp_iv, WG_CRYPTO_IV_SIZE - sizeof(uint64_t));
+	le64enc(crp->crp_iv + WG_CRYPTO_IV_SIZE - sizeof(uint64_t),
+	    pkt->p_nonce);
+	crp->crp_opaque = pkt;
+
+	if (op == WG_CRYPTO_ENCRYPT) {
+		crp->crp_op = CRYPTO_OP_ENCRYPT | CRYPTO_OP_COMPUTE_DIGEST;
+		crp->crp_cipher_key = pkt->p_keypair->k_send;
+		crp->crp_callback = wg_crypto_encrypt_done;
+	} else {
+		crp->crp_op = CRYPTO_OP_DECRYPT | CRYPTO_OP_VERIFY_DIGEST;
+		crp->crp_cipher_key = pkt->p_keypair->k_recv;
+		crp->crp_callback = wg_crypto_decrypt_done;
+	}
+
+	if ((error = crypto_dispatch(crp)) != 0)
+		crypto_freereq(crp);
+out:
+	if (error != 0)
+		atomic_subtract_int(&sc->sc_crypto_pending, 1);
+	return (error);
+}
+
+/*
+ * Turns the plaintext in pkt->p_pkt into an unsealed data message in one
+ * writable mbuf, which both the inline cipher and crypto(9) seal in place.
+ * The queue entry is an mbuf tag and follows the packet header to a copy.
+ */
+static int
+wg_queue_pkt_encrypt_prepare(struct wg_queue_pkt *pkt)
+{
+	struct mbuf *m;
+
+	m = wg_mbuf_data_frame(pkt->p_pkt, pkt->p_keypair->k_remote_index,
+	    pkt->p_nonce);
+	if (m == NULL)
+		return (ENOBUFS);
+	pkt->p_pkt = m;
+	return (0);
+}
+
+static struct wg_peer *
+wg_queue_pkt_encrypt_finish(struct wg_queue_pkt *pkt, int error)
+{
+	struct noise_keypair *keypair = pkt->p_keypair;
+	struct wg_peer *peer = keypair->k_peer;
+
+	/* The peer outlives the keypair's last reference until the epoch ends. */
+	NET_EPOCH_ASSERT();
+	pkt->p_keypair = NULL;
+	noise_keypair_put(keypair);
+	if (error != 0)
+		return (peer);
 
 	wg_peer_timers_any_authenticated_packet_traversal(peer);
 	wg_peer_timers_any_authenticated_packet_sent(peer);
-	if (m->m_pkthdr.len > 0)
+	if (pkt->p_pkt->m_pkthdr.len > sizeof(struct wg_pkt_data) + WG_MAC_SIZE)
 		wg_peer_timers_data_sent(peer);
 
 	noise_keypairs_keep_key_fresh_send(&peer->p_keypairs);
 
-	if (wg_peer_mbuf_add_ipudp(peer, &mc) == 0)
+	/* Left uncrypted, the packet is freed when its turn to be sent comes. */
+	if (wg_peer_mbuf_add_ipudp(peer, &pkt->p_pkt) == 0)
 		pkt->p_state = WG_PKT_STATE_CRYPTED;
+	else
+		if_inc_counter(peer->p_sc->sc_ifp, IFCOUNTER_OERRORS, 1);
 
-	m_freem(m);
-	pkt->p_pkt = mc;
-
-	return peer;
+	return (peer);
 }
-#else
+
+/* Seals a packet that went through wg_queue_pkt_encrypt_prepare. */
 struct wg_peer *
-wg_queue_pkt_encrypt(struct wg_queue_pkt *pkt)
+wg_queue_pkt_encrypt(struct wg_queue_pkt *pkt, int error)
 {
-	return NULL;
+	if (error == 0)
+		wg_mbuf_data_seal(pkt->p_pkt, pkt->p_keypair->k_send);
+	return (wg_queue_pkt_encrypt_finish(pkt, error));
+}
+
+static int
+wg_queue_pkt_decrypt_check(struct wg_queue_pkt *pkt)
+{
+	struct noise_keypair *keypair = pkt->p_keypair;
+	struct wg_pkt_data *data;
+
+	data = mtod(pkt->p_pkt, struct wg_pkt_data *);
+	pkt->p_nonce = le64toh(data->nonce);
+
+	if (wg_timers_expired(&keypair->k_birthdate, REJECT_AFTER_TIME, 0) ||
+			keypair->k_counter.c_recv >= REJECT_AFTER_MESSAGES)
+		return (ESTALE);
+	return (0);
 }
-#endif
 
+/* Opens a packet that went through wg_queue_pkt_decrypt_check. */
 struct wg_peer *
-wg_queue_pkt_decrypt(struct wg_queue_pkt *pkt)
+wg_queue_pkt_decrypt(struct wg_queue_pkt *pkt, int error)
 {
 	struct mbuf *m = pkt->p_pkt;
 	struct wg_pkt_data *data;
-	struct wg_peer *peer, *routed_peer;
-	struct noise_keypair *keypair;
 	size_t plaintext_len;
-	uint8_t version;
 
 	data = mtod(m, struct wg_pkt_data *);
-	plaintext_len = m->m_pkthdr.len - sizeof(struct wg_pkt_data);
+	plaintext_len = m->m_pkthdr.len - sizeof(struct wg_pkt_data) -
+	    WG_MAC_SIZE;
 
-	keypair = pkt->p_keypair;
-	peer = wg_peer_ref(keypair->k_peer);
+	if (error == 0 &&
+	    !chacha20poly1305_decrypt(data->buf, data->buf, plaintext_len,
+				NULL, 0, data->nonce, pkt->p_keypair->k_recv))
+		error = EBADMSG;
 
-	pkt->p_nonce = le64toh(data->nonce);
+	return (wg_queue_pkt_decrypt_finish(pkt, error));
+}
 
-	if (wg_timers_expired(&keypair->k_birthdate, REJECT_AFTER_TIME, 0) ||
-			keypair->k_counter.c_recv >= REJECT_AFTER_MESSAGES)
-		goto drop;
+static struct wg_peer *
+wg_queue_pkt_decrypt_finish(struct wg_queue_pkt *pkt, int error)
+{
+	struct mbuf *m = pkt->p_pkt;
+	struct wg_peer *peer, *routed_peer;
+	struct noise_keypair *keypair;
+	uint8_t version;
 
-	if (!chacha20poly1305_decrypt(data->buf, data->buf, plaintext_len,
-				NULL, 0, data->nonce, pkt->p_keypair->k_recv))
+	NET_EPOCH_ASSERT();
+	keypair = pkt->p_keypair;
+	peer = keypair->k_peer;
+
+	if (error != 0)
 		goto drop;
 
 	if (wg_counter_validate(&keypair->k_counter, pkt->p_nonce) != 0) {
@@ -2952,6 +1994,7 @@ wg_queue_pkt_decrypt(struct wg_queue_pkt *pkt)
 	}
 
 	noise_keypair_put(pkt->p_keypair);
+	pkt->p_keypair = NULL;
 
 	/* Remove the data header, and crypto mac tail from the packet */
 	m_adj(m, sizeof(struct wg_pkt_data));
@@ -2979,7 +2022,6 @@ wg_queue_pkt_decrypt(struct wg_queue_pkt *pkt)
 	}
 
 	routed_peer = wg_route_lookup(&peer->p_sc->sc_routes, m, IN);
-	wg_peer_put(routed_peer);
 	if (routed_peer != peer) {
 		DPRINTF(peer->p_sc, "Packet has unallowed src IP from peer "
 				"%llu\n", peer->p_id);
@@ -2988,39 +2030,313 @@ wg_queue_pkt_decrypt(struct wg_queue_pkt *pkt)
 
 	pkt->p_state = WG_PKT_STATE_CLEAR;
 drop:
+	if (pkt->p_keypair != NULL) {
+		noise_keypair_put(pkt->p_keypair);
+		pkt->p_keypair = NULL;
+	}
 	return peer;
 }
 
+/* Everything wg_input and the handshake task need to take handshakes. */
+void
+wg_softc_handshake_init(struct wg_softc *sc)
+{
+	struct wg_handshake_queue *hq = &sc->sc_handshake_queue;
+	int i;
+
+	wg_cookie_checker_attach(sc);
+
+	mtx_init(&hq->hq_mtx, "wg handshake queue", NULL, MTX_DEF);
+	for (i = 0; i < WG_HANDSHAKE_CLASSES; i++)
+		mbufq_init(&hq->hq_class[i], WG_HANDSHAKEQ_MAX);
+	wg_dql_init(&hq->hq_dql, MAX_QUEUED_INCOMING_HANDSHAKES,
+	    WG_HANDSHAKEQ_MIN, WG_HANDSHAKEQ_MAX, WG_HANDSHAKEQ_DELAY);
+	hq->hq_load = 0;
+	bzero(&hq->hq_last_under_load, sizeof(hq->hq_last_under_load));
+
+	GROUPTASK_INIT(&sc->sc_handshake, 0,
+	    (gtask_fn_t *)wg_softc_handshake_receive, sc);
+	taskqgroup_attach(qgroup_if_io_tqg, &sc->sc_handshake, sc, NULL, NULL,
+	    "wg handshake");
+}
+
+void
+wg_softc_handshake_uninit(struct wg_softc *sc)
+{
+	struct wg_handshake_queue *hq = &sc->sc_handshake_queue;
+	int i;
+
+	taskqgroup_detach(qgroup_if_io_tqg, &sc->sc_handshake);
+	for (i = 0; i < WG_HANDSHAKE_CLASSES; i++)
+		mbufq_drain(&hq->hq_class[i]);
+	mtx_destroy(&hq->hq_mtx);
+
+	mtx_destroy(&sc->sc_cookie_checker.cc_mtx);
+	rw_destroy(&sc->sc_local.l_lock);
+}
+
+/*
+ * Responses and cookie replies that answer a message of ours, and
+ * initiations with a valid cookie, go ahead of everything else. Only the
+ * receiver index of an answer is looked at here; the handshake task still
+ * checks it in full.
+ */
+static enum wg_handshake_class
+wg_handshake_classify(struct wg_softc *sc, struct mbuf *m)
+{
+	struct noise_keypair *keypair;
+	uint32_t index;
+	bool ours;
+
+	switch (*mtod(m, uint32_t *)) {
+	case WG_PKT_INITIATION:
+		return (wg_cookie_check_mac2(&sc->sc_cookie_checker, m) ?
+		    WG_HANDSHAKE_PRIORITY : WG_HANDSHAKE_NORMAL);
+	case WG_PKT_RESPONSE:
+		index = mtod(m, struct wg_pkt_response *)->receiver_index;
+		break;
+	default:
+		index = mtod(m, struct wg_pkt_cookie *)->receiver_index;
+		break;
+	}
+
+	if ((keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
+	    index)) == NULL)
+		return (WG_HANDSHAKE_NORMAL);
+	/* A response can only answer an initiation still in flight. */
+	ours = *mtod(m, uint32_t *) != WG_PKT_RESPONSE ||
+	    keypair->k_state == HANDSHAKE_CREATED_INITIATION;
+	noise_keypair_put(keypair);
+	return (ours ? WG_HANDSHAKE_PRIORITY : WG_HANDSHAKE_NORMAL);
+}
+
+/* Leaves m to the caller if its class is full. */
+static int
+wg_handshake_enqueue(struct wg_handshake_queue *hq, struct mbuf *m,
+    enum wg_handshake_class class)
+{
+	int error = ENOBUFS;
+
+	mtx_lock(&hq->hq_mtx);
+	if (mbufq_len(&hq->hq_class[class]) < wg_dql_limit(&hq->hq_dql) &&
+	    (error = mbufq_enqueue(&hq->hq_class[class], m)) == 0)
+		wg_dql_queued(&hq->hq_dql, mbufq_len(&hq->hq_class[class]));
+	mtx_unlock(&hq->hq_mtx);
+	return (error);
+}
+
+static struct mbuf *
+wg_handshake_dequeue(struct wg_handshake_queue *hq)
+{
+	struct mbuf *m = NULL;
+	u_int len = 0;
+	int i;
+
+	mtx_lock(&hq->hq_mtx);
+	for (i = 0; m == NULL && i < WG_HANDSHAKE_CLASSES; i++)
+		m = mbufq_dequeue(&hq->hq_class[i]);
+	for (i = 0; i < WG_HANDSHAKE_CLASSES; i++)
+		len += mbufq_len(&hq->hq_class[i]);
+	mtx_unlock(&hq->hq_mtx);
+	if (m != NULL)
+		wg_dql_served(&hq->hq_dql, 1, len);
+	return (m);
+}
+
+/*
+ * Folds the current queue length into hq_load. The interface is under load
+ * while the smoothed length is an eighth of the class limit or more, and
+ * for a second after. Only the handshake task gets here, and the lengths
+ * are read without the lock, as a sample needs no more.
+ */
+static bool
+wg_handshake_under_load(struct wg_handshake_queue *hq)
+{
+	u_int len = 0;
+	int i;
+
+	for (i = 0; i < WG_HANDSHAKE_CLASSES; i++)
+		len += mbufq_len(&hq->hq_class[i]);
+	hq->hq_load -= hq->hq_load >> WG_HANDSHAKE_LOAD_WEIGHT;
+	hq->hq_load += (len << WG_HANDSHAKE_LOAD_SHIFT) >>
+	    WG_HANDSHAKE_LOAD_WEIGHT;
+
+	if (hq->hq_load >= (wg_dql_limit(&hq->hq_dql) / 8) <<
+	    WG_HANDSHAKE_LOAD_SHIFT) {
+		getnanotime(&hq->hq_last_under_load);
+		return (true);
+	}
+	return (hq->hq_last_under_load.tv_sec != 0 &&
+	    !wg_timers_expired(&hq->hq_last_under_load, 1, 0));
+}
+
+/*
+ * With net.wg.handshake_batch set, initiations that pass their MAC checks are
+ * gathered, up to WG_HANDSHAKE_BATCH at a time, and consumed together so that
+ * their scalar multiplications share the final inversions. Anything else is
+ * handled as it comes off the queue, as everything is when it is not set.
+ */
+static int wg_handshake_batch = 0;
+SYSCTL_INT(_net_wg, OID_AUTO, handshake_batch, CTLFLAG_RWTUN,
+    &wg_handshake_batch, 0, "Consume handshake initiations in batches");
+
 void
 wg_softc_handshake_receive(struct wg_softc *sc)
 {
+	struct wg_handshake_queue *hq = &sc->sc_handshake_queue;
+	struct wg_pkt_initiation *init[WG_HANDSHAKE_BATCH];
+	struct noise_keypair *keypairs[WG_HANDSHAKE_BATCH];
+	struct mbuf *batch[WG_HANDSHAKE_BATCH];
+	struct epoch_tracker et;
 	struct mbuf *m;
-	while ((m = mbufq_dequeue(&sc->sc_handshake_queue)) != NULL)
-		wg_receive_handshake_packet(sc, m);
+	int i, n;
+
+	NET_EPOCH_ENTER(et);
+	if (!wg_handshake_batch) {
+		while ((m = wg_handshake_dequeue(hq)) != NULL)
+			wg_receive_handshake_packet(sc, m);
+		NET_EPOCH_EXIT(et);
+		return;
+	}
+	do {
+		n = 0;
+		while (n < WG_HANDSHAKE_BATCH &&
+		    (m = wg_handshake_dequeue(hq)) != NULL) {
+			if (*mtod(m, uint32_t *) != WG_PKT_INITIATION)
+				wg_receive_handshake_packet(sc, m);
+			else if (wg_handshake_admit(sc, m)) {
+				init[n] = mtod(m, struct wg_pkt_initiation *);
+				batch[n++] = m;
+			}
+		}
+		if (n == 0)
+			break;
+		noise_handshake_consume_initiations(init, keypairs, n, sc);
+		for (i = 0; i < n; i++)
+			wg_receive_initiation(sc, batch[i], keypairs[i]);
+	} while (n == WG_HANDSHAKE_BATCH);
+	NET_EPOCH_EXIT(et);
 }
 
 void
-wg_softc_decrypt(struct wg_softc *sc)
+wg_softc_encrypt_init(struct wg_softc *sc)
 {
+	wg_pktq_init(&sc->sc_encrypt_queue, "encryptq");
+	wg_dql_init(&sc->sc_encrypt_dql, MAX_QUEUED_PACKETS, WG_PKTQ_MIN,
+	    WG_PKTQ_MAX, WG_PKTQ_DELAY);
+	mtx_init(&sc->sc_drr.d_mtx, "wg drr", NULL, MTX_DEF);
+	TAILQ_INIT(&sc->sc_drr.d_active);
+	GROUPTASK_INIT(&sc->sc_encrypt, 0, (gtask_fn_t *)wg_softc_encrypt, sc);
+	taskqgroup_attach(qgroup_if_io_tqg, &sc->sc_encrypt, sc, NULL, NULL,
+	    "wg encrypt");
+}
+
+void
+wg_softc_encrypt_uninit(struct wg_softc *sc)
+{
+	taskqgroup_detach(qgroup_if_io_tqg, &sc->sc_encrypt);
+	MPASS(STAILQ_EMPTY(&sc->sc_encrypt_queue.q_items));
+	mtx_destroy(&sc->sc_encrypt_queue.q_mtx);
+	MPASS(TAILQ_EMPTY(&sc->sc_drr.d_active));
+	mtx_destroy(&sc->sc_drr.d_mtx);
+}
+
+void
+wg_decrypt_workers_init(struct wg_softc *sc)
+{
+	struct wg_decrypt_worker *w;
+	int cpu;
+
+	sc->sc_decrypt_workers = 0;
+	CPU_FOREACH(cpu) {
+		if (sc->sc_decrypt_workers == MAX_DECRYPT_WORKERS)
+			break;
+		w = &sc->sc_decrypt[sc->sc_decrypt_workers++];
+		w->w_sc = sc;
+		w->w_pending = 0;
+		wg_pktq_init(&w->w_queue, "decryptq");
+		wg_dql_init(&w->w_dql, MAX_QUEUED_PACKETS, WG_PKTQ_MIN,
+		    WG_PKTQ_MAX, WG_PKTQ_DELAY);
+		GROUPTASK_INIT(&w->w_task, 0, (gtask_fn_t *)wg_softc_decrypt, w);
+		taskqgroup_attach_cpu(qgroup_if_io_tqg, &w->w_task, w, cpu,
+		    NULL, NULL, "wg decrypt");
+	}
+	sc->sc_hashtable.h_workers = sc->sc_decrypt_workers;
+}
+
+void
+wg_decrypt_workers_uninit(struct wg_softc *sc)
+{
+	struct wg_decrypt_worker *w;
+	u_int i;
+
+	for (i = 0; i < sc->sc_decrypt_workers; i++) {
+		w = &sc->sc_decrypt[i];
+		taskqgroup_detach(qgroup_if_io_tqg, &w->w_task);
+		MPASS(STAILQ_EMPTY(&w->w_queue.q_items));
+		mtx_destroy(&w->w_queue.q_mtx);
+	}
+	sc->sc_decrypt_workers = 0;
+}
+
+void
+wg_softc_decrypt(struct wg_decrypt_worker *w)
+{
+	struct wg_softc *sc = w->w_sc;
+	struct epoch_tracker et;
 	struct wg_queue_pkt *p;
 	struct wg_peer *peer;
-	while ((p = wg_pktq_parallel_dequeue(&sc->sc_decrypt_queue)) != NULL) {
-		peer = wg_queue_pkt_decrypt(p);
+	int error;
+
+	NET_EPOCH_ENTER(et);
+	while ((p = wg_pktq_parallel_dequeue(&w->w_queue)) != NULL) {
+		if ((error = wg_queue_pkt_decrypt_check(p)) == 0 &&
+		    wg_crypto_dispatch(sc, p, WG_CRYPTO_DECRYPT) == 0)
+			continue;
+		peer = wg_queue_pkt_decrypt(p, error);
 		wg_pktq_pkt_done(p);
-		GROUPTASK_ENQUEUE(&peer->p_recv);
+		wg_peer_recv_kick(peer);
+		wg_decrypt_worker_done(w);
 	}
+	NET_EPOCH_EXIT(et);
+}
+
+/*
+ * A packet admitted by wg_input is done with decryption, inline or in
+ * crypto(9), so the worker's limit covers the requests in flight too.
+ */
+static void
+wg_decrypt_worker_done(struct wg_decrypt_worker *w)
+{
+	u_int pending;
+
+	pending = atomic_fetchadd_int(&w->w_pending, -1) - 1;
+	wg_dql_served(&w->w_dql, 1, pending);
 }
 
 void
 wg_softc_encrypt(struct wg_softc *sc)
 {
+	struct epoch_tracker et;
 	struct wg_queue_pkt *p;
 	struct wg_peer *peer;
-	while ((p = wg_pktq_parallel_dequeue(&sc->sc_encrypt_queue)) != NULL) {
-		peer = wg_queue_pkt_encrypt(p);
-		wg_pktq_pkt_done(p);
-		GROUPTASK_ENQUEUE(&peer->p_send);
-	}
+	int error;
+
+	NET_EPOCH_ENTER(et);
+	/* Once the queue is drained, the peers waiting for room get it. */
+	do {
+		while ((p = wg_pktq_parallel_dequeue(&sc->sc_encrypt_queue)) !=
+		    NULL) {
+			if ((error = wg_queue_pkt_encrypt_prepare(p)) == 0 &&
+			    wg_crypto_dispatch(sc, p, WG_CRYPTO_ENCRYPT) == 0)
+				continue;
+			peer = wg_queue_pkt_encrypt(p, error);
+			wg_pktq_pkt_done(p);
+			wg_peer_send_kick(peer);
+			wg_softc_encrypt_done(sc);
+		}
+	} while (wg_softc_drr_run(sc, true));
+	NET_EPOCH_EXIT(et);
 }
 
 #if 0
@@ -3043,7 +2359,8 @@ wg_start(struct ifqueue *ifq)
 		if (mbufq_enqueue(&peer->p_staged_packets, m) != 0)
 			if_inc_counter(sc->sc_ifp, IFCOUNTER_OQDROPS, 1);
 
-		if (mbufq_len(&peer->p_staged_packets) > MAX_STAGED_PACKETS/8) {
+		if (mbufq_len(&peer->p_staged_packets) >
+		    wg_dql_limit(&sc->sc_encrypt_dql) / 8) {
 			gtaskqueue_cancel(peer->p_send_staged.gt_taskqueue,
 							  peer->p_send_staged.gt_task);
 			wg_peer_send_staged_packets(peer);
@@ -3128,21 +2445,30 @@ wg_input(struct mbuf *m, int offset, struct inpcb *inpcb,
 	struct wg_queue_pkt *pkt;
 	struct wg_pkt_data *data;
 	struct wg_softc *sc = _sc;
+	struct wg_decrypt_worker *w;
+	struct wg_endpoint e;
+	struct mbuf *defrag;
 	struct udphdr *uh;
 	int pktlen, pkttype, hlen;
 
 	uh = (struct udphdr *)(m->m_data + offset);
 	hlen = offset + sizeof(struct udphdr);
-	pkt = wg_mbuf_pkt_get(m);
-	if (pkt == NULL)
-		goto free;
-
-	pkt->p_state = WG_PKT_STATE_CRYPTED;
+	wg_endpoint_from_mbuf(&e, m, srcsa);
 
 	m_adj(m, hlen);
 
-	if (m_defrag(m, M_NOWAIT) != 0)
-		return;
+	/* Tag after m_defrag, which would copy the tag into malloc(9). */
+	if (m->m_next != NULL) {
+		if ((defrag = m_defrag(m, M_NOWAIT)) == NULL)
+			goto free;
+		m = defrag;
+	}
+	if ((pkt = wg_mbuf_pkt_get(m)) == NULL) {
+		if_inc_counter(sc->sc_ifp, IFCOUNTER_IQDROPS, 1);
+		goto free;
+	}
+	pkt->p_state = WG_PKT_STATE_CRYPTED;
+	__containerof(pkt, struct wg_pkt_tag, t_pkt)->t_endpoint = e;
 
 	if_inc_counter(sc->sc_ifp, IFCOUNTER_IPACKETS, 1);
 	if_inc_counter(sc->sc_ifp, IFCOUNTER_IBYTES, m->m_pkthdr.len);
@@ -3155,31 +2481,72 @@ wg_input(struct mbuf *m, int offset, struct inpcb *inpcb,
 		 pkttype == WG_PKT_RESPONSE) ||
 		(pktlen == sizeof(struct wg_pkt_cookie) &&
 		 pkttype == WG_PKT_COOKIE)) {
-		if (mbufq_enqueue(&sc->sc_handshake_queue, m) == 0)
+		if (pkttype != WG_PKT_COOKIE &&
+		    !wg_cookie_check_mac1(&sc->sc_cookie_checker, m)) {
+			counter_u64_add(wg_handshake_bad_mac1, 1);
+			if_inc_counter(sc->sc_ifp, IFCOUNTER_IERRORS, 1);
+			goto free;
+		}
+		if (wg_handshake_enqueue(&sc->sc_handshake_queue, m,
+		    wg_handshake_classify(sc, m)) == 0)
 			GROUPTASK_ENQUEUE(&sc->sc_handshake);
-		else
+		else {
 			DPRINTF(sc, "Dropping handshake packet\n");
+			if_inc_counter(sc->sc_ifp, IFCOUNTER_IQDROPS, 1);
+			goto free;
+		}
 	} else if (pktlen >= sizeof(struct wg_pkt_data) + WG_MAC_SIZE
 	    && pkttype == WG_PKT_DATA) {
 
 		data = mtod(m, struct wg_pkt_data *);
 
+		/*
+		 * The worker is in the index itself, but the lookup cannot
+		 * move there: the packet takes its place in the peer's serial
+		 * receive queue as it is queued to the worker, which keeps
+		 * the peer's packets in order, and the peer is only known
+		 * from the keypair. The lookup is a hash probe under the
+		 * epoch, and it lets the pre-check below drop replays before
+		 * they take a slot in the worker's queue.
+		 */
 		pkt->p_keypair = wg_hashtable_keypair_lookup(&sc->sc_hashtable,
 				data->receiver_index);
 
 		if (pkt->p_keypair == NULL) {
 			if_inc_counter(sc->sc_ifp, IFCOUNTER_IERRORS, 1);
 			m_freem(m);
-		} else if (wg_pktq_parallel_len(
-				&sc->sc_decrypt_queue) > MAX_QUEUED_PACKETS) {
+			return;
+		}
+
+		/*
+		 * Spare the workers a decrypt for replays and packets under
+		 * an expired key. This only reads the replay window; it is
+		 * checked again and updated once the packet is authenticated.
+		 */
+		if (wg_queue_pkt_decrypt_check(pkt) != 0 ||
+		    wg_counter_stale(&pkt->p_keypair->k_counter,
+		    pkt->p_nonce)) {
+			counter_u64_add(wg_recv_stale, 1);
+			if_inc_counter(sc->sc_ifp, IFCOUNTER_IERRORS, 1);
+			noise_keypair_put(pkt->p_keypair);
+			m_freem(m);
+			return;
+		}
+
+		w = &sc->sc_decrypt[WG_INDEX_WORKER(data->receiver_index)];
+		if (atomic_load_int(&w->w_pending) >=
+		    wg_dql_limit(&w->w_dql)) {
 			if_inc_counter(sc->sc_ifp, IFCOUNTER_IQDROPS, 1);
 			noise_keypair_put(pkt->p_keypair);
 			m_freem(m);
 		} else {
-			wg_pktq_enqueue(&sc->sc_decrypt_queue,
+			atomic_add_int(&w->w_pending, 1);
+			wg_pktq_enqueue(&w->w_queue,
 					&pkt->p_keypair->k_peer->p_recv_queue,
 					pkt);
-			GROUPTASK_ENQUEUE(&sc->sc_decrypt);
+			wg_dql_queued(&w->w_dql,
+			    atomic_load_int(&w->w_pending));
+			GROUPTASK_ENQUEUE(&w->w_task);
 		}
 	} else {
 		DPRINTF(sc, "Invalid packet\n");
@@ -3215,9 +2582,7 @@ wg_ioctl_set(struct wg_softc *sc, struct wg_device_io *dev)
 		}
 
 	if (dev->d_flags & WG_DEVICE_HAS_PRIVKEY) {
-		noise_local_set_private(&sc->sc_local, dev->d_privkey);
-
-		wg_cookie_checker_precompute_device_keys(sc);
+		wg_cookie_checker_set_private(sc, dev->d_privkey);
 		WG_HASHTABLE_PEER_FOREACH(peer, i, &sc->sc_hashtable)
 			wg_cookie_precompute_peer_keys(peer);
 	}
@@ -3251,6 +2616,7 @@ wg_ioctl_set(struct wg_softc *sc, struct wg_device_io *dev)
 			rw_wlock(&peer->p_endpoint_lock);
 			memcpy(&peer->p_endpoint.e_remote, &peer_io.p_sa,
 			    sizeof(peer->p_endpoint.e_remote));
+			wg_dst_cache_reset(&peer->p_dst_cache);
 			rw_wunlock(&peer->p_endpoint_lock);
 		}
 
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/epoch.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+
+#include <net/if.h>
+#include <net/if_var.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_wheel.h>
+#include <sys/wg_module.h>
+
+static bool
+	wg_peer_timers_run(struct wg_peer *);
+static void
+	wg_softc_timers_run(void *, struct wg_wheel_entry **, int);
+void	wg_peer_expired_retransmit_handshake(struct wg_peer *);
+bool	wg_peer_expired_send_keepalive(struct wg_peer *);
+void	wg_peer_expired_new_handshake(struct wg_peer *);
+void	wg_peer_expired_zero_key_material(struct wg_peer *);
+bool	wg_peer_expired_send_persistent_keepalive(struct wg_peer *);
+
+/*
+ * The data path only records deadlines, in ticks, and a deadline of 0 means
+ * the timer is not running. Each peer has a single entry on the interface's
+ * timer wheel, kept scheduled for the earliest deadline (t_armed), and works
+ * out which timers are due when it fires, so that neither cancelling a timer
+ * nor pushing one back touches the wheel. Only arming a timer ahead of
+ * t_armed reschedules it. The wheel hands over all the peers that expire in
+ * a tick at once, and their keepalives go to the encrypt task in one go.
+ */
+static inline int
+wg_timers_deadline(int timeout)
+{
+	int when = ticks + timeout;
+
+	return (when != 0 ? when : 1);
+}
+
+static void
+wg_timers_arm(struct wg_peer *peer, int when)
+{
+	struct wg_timers *t = &peer->p_timers;
+	int armed;
+
+	/* Pairs with the fence in wg_peer_timers_run. */
+	atomic_thread_fence_seq_cst();
+	armed = atomic_load_int(&t->t_armed);
+	if (armed != 0 && armed - when <= 0)
+		return;
+
+	rw_wlock(&t->t_lock);
+	armed = t->t_armed;
+	if (!t->t_disabled && (armed == 0 || when - armed < 0)) {
+		atomic_store_int(&t->t_armed, when);
+		if (!wg_wheel_schedule(&peer->p_sc->sc_wheel, &t->t_entry,
+		    when))
+			wg_peer_ref(peer);
+	}
+	rw_wunlock(&t->t_lock);
+}
+
+static void
+wg_timers_set(struct wg_peer *peer, volatile int *deadline, int timeout)
+{
+	int when = wg_timers_deadline(timeout);
+
+	atomic_store_int(deadline, when);
+	wg_timers_arm(peer, when);
+}
+
+/* Like wg_timers_set, but leaves a running timer alone. */
+static bool
+wg_timers_set_pending(struct wg_peer *peer, volatile int *deadline,
+		      int timeout)
+{
+	int when;
+
+	if (atomic_load_int(deadline) != 0)
+		return (false);
+	when = wg_timers_deadline(timeout);
+	if (!atomic_cmpset_int(deadline, 0, when))
+		return (false);
+	wg_timers_arm(peer, when);
+	return (true);
+}
+
+static inline void
+wg_timers_del(volatile int *deadline)
+{
+	if (atomic_load_int(deadline) != 0)
+		atomic_store_int(deadline, 0);
+}
+
+/* Claims an expired timer, so that it fires only once. */
+static bool
+wg_timers_due(volatile int *deadline, int now)
+{
+	int when = atomic_load_int(deadline);
+
+	return (when != 0 && now - when >= 0 &&
+	    atomic_cmpset_int(deadline, when, 0));
+}
+
+static inline int
+wg_timers_earliest(int next, int when)
+{
+	return (when != 0 && (next == 0 || when - next < 0) ? when : next);
+}
+
+static int
+wg_timers_persistent_deadline(struct wg_timers *t, int last)
+{
+	int when;
+
+	if (t->t_persistent_keepalive_interval == 0 || last == 0)
+		return (0);
+	when = last + t->t_persistent_keepalive_interval * hz;
+	return (when != 0 ? when : 1);
+}
+
+/*
+ * Runs the timers that are due on a peer whose wheel entry fired, and drops
+ * the reference the entry held. Returns true if a keepalive was queued for
+ * encryption, leaving the caller to kick sc_encrypt.
+ */
+static bool
+wg_peer_timers_run(struct wg_peer *peer)
+{
+	struct wg_timers *t = &peer->p_timers;
+	int now, next, last;
+	bool disabled, kick = false;
+
+	NET_EPOCH_ASSERT();
+	rw_wlock(&t->t_lock);
+	/* Unless it was rescheduled while it was on its way here. */
+	if (!wg_wheel_pending(&t->t_entry))
+		atomic_store_int(&t->t_armed, 0);
+	disabled = t->t_disabled;
+	rw_wunlock(&t->t_lock);
+	/* Either a new deadline is seen below, or its setter re-arms. */
+	atomic_thread_fence_seq_cst();
+	if (disabled)
+		goto out;
+
+	now = ticks;
+	if (wg_timers_due(&t->t_retransmit_handshake, now))
+		wg_peer_expired_retransmit_handshake(peer);
+	if (wg_timers_due(&t->t_send_keepalive, now))
+		kick |= wg_peer_expired_send_keepalive(peer);
+	if (wg_timers_due(&t->t_new_handshake, now))
+		wg_peer_expired_new_handshake(peer);
+	if (wg_timers_due(&t->t_zero_key_material, now))
+		wg_peer_expired_zero_key_material(peer);
+	last = atomic_load_int(&t->t_last_traversal);
+	next = wg_timers_persistent_deadline(t, last);
+	if (next != 0 && now - next >= 0 &&
+	    atomic_cmpset_int(&t->t_last_traversal, last, 0))
+		kick |= wg_peer_expired_send_persistent_keepalive(peer);
+
+	next = wg_timers_earliest(0, atomic_load_int(&t->t_retransmit_handshake));
+	next = wg_timers_earliest(next, atomic_load_int(&t->t_send_keepalive));
+	next = wg_timers_earliest(next, atomic_load_int(&t->t_new_handshake));
+	next = wg_timers_earliest(next,
+	    atomic_load_int(&t->t_zero_key_material));
+	next = wg_timers_earliest(next, wg_timers_persistent_deadline(t,
+	    atomic_load_int(&t->t_last_traversal)));
+	if (next != 0)
+		wg_timers_arm(peer, next);
+out:
+	wg_peer_put(peer);
+	return (kick);
+}
+
+static void
+wg_softc_timers_run(void *arg, struct wg_wheel_entry **batch, int n)
+{
+	struct epoch_tracker et;
+	struct wg_softc *sc = arg;
+	bool kick = false;
+	int i;
+
+	NET_EPOCH_ENTER(et);
+	for (i = 0; i < n; i++)
+		kick |= wg_peer_timers_run(__containerof(batch[i],
+		    struct wg_peer, p_timers.t_entry));
+	NET_EPOCH_EXIT(et);
+	if (kick)
+		GROUPTASK_ENQUEUE(&sc->sc_encrypt);
+}
+
+void
+wg_softc_timers_init(struct wg_softc *sc)
+{
+	wg_wheel_init(&sc->sc_wheel, wg_softc_timers_run, sc);
+}
+
+void
+wg_softc_timers_uninit(struct wg_softc *sc)
+{
+	wg_wheel_uninit(&sc->sc_wheel);
+}
+
+void
+wg_peer_expired_retransmit_handshake(struct wg_peer *peer)
+{
+	bool give_up;
+
+	rw_wlock(&peer->p_timers.t_lock);
+	give_up = peer->p_timers.t_handshake_attempts > MAX_TIMER_HANDSHAKES;
+	if (give_up) {
+		DPRINTF(peer->p_sc, "Handshake for peer %llu did not complete "
+				"after %d attempts, giving up\n", peer->p_id,
+				peer->p_timers.t_handshake_attempts);
+	} else {
+		peer->p_timers.t_handshake_attempts++;
+		DPRINTF(peer->p_sc, "Handshake for peer %llu did not complete "
+				"after %d seconds, retrying (try %d)\n",
+				peer->p_id, REKEY_TIMEOUT,
+				peer->p_timers.t_handshake_attempts);
+	}
+	rw_wunlock(&peer->p_timers.t_lock);
+
+	if (give_up) {
+		wg_timers_del(&peer->p_timers.t_send_keepalive);
+		wg_peer_flush_staged_packets(peer);
+		wg_timers_set_pending(peer, &peer->p_timers.t_zero_key_material,
+		    REJECT_AFTER_TIME * 3 * hz);
+	} else {
+		/*
+		 * We clear the endpoint address src address, in case this is
+		 * the cause of trouble.
+		 */
+		wg_peer_clear_src(peer);
+
+		wg_peer_queue_handshake_initiation(peer, 1);
+	}
+}
+
+bool
+wg_peer_expired_send_keepalive(struct wg_peer *peer)
+{
+	bool queued;
+
+	queued = wg_peer_stage_keepalive(peer);
+
+	if (peer->p_timers.t_need_another_keepalive) {
+		peer->p_timers.t_need_another_keepalive = 0;
+		wg_timers_set(peer, &peer->p_timers.t_send_keepalive,
+		    KEEPALIVE_TIMEOUT * hz);
+	}
+	return (queued);
+}
+
+void
+wg_peer_expired_new_handshake(struct wg_peer *peer)
+{
+	DPRINTF(peer->p_sc, "Retrying handshake with peer %llu because we "
+			"stopped hearing back after %d seconds\n", peer->p_id,
+			NEW_HANDSHAKE_TIMEOUT);
+
+	/*
+	 * We clear the endpoint address src address, in case this is the cause
+	 * of trouble.
+	 */
+	wg_peer_clear_src(peer);
+	wg_peer_queue_handshake_initiation(peer, 0);
+}
+
+void
+wg_peer_expired_zero_key_material(struct wg_peer *peer)
+{
+	DPRINTF(peer->p_sc, "Zeroing out all keys for peer %llu, since we "
+			"haven't received a new one in %d seconds\n",
+			peer->p_id, REJECT_AFTER_TIME * 3);
+
+	noise_keypairs_clear(&peer->p_keypairs);
+}
+
+bool
+wg_peer_expired_send_persistent_keepalive(struct wg_peer *peer)
+{
+	if (peer->p_timers.t_persistent_keepalive_interval == 0)
+		return (false);
+	return (wg_peer_stage_keepalive(peer));
+}
+
+/* Should be called after an authenticated data packet is sent. */
+void
+wg_peer_timers_data_sent(struct wg_peer *peer)
+{
+	wg_timers_set_pending(peer, &peer->p_timers.t_new_handshake,
+	    NEW_HANDSHAKE_TIMEOUT * hz + (random() % REKEY_TIMEOUT_JITTER));
+}
+
+/* Should be called after an authenticated data packet is received. */
+void
+wg_peer_timers_data_received(struct wg_peer *peer)
+{
+	if (!wg_timers_set_pending(peer, &peer->p_timers.t_send_keepalive,
+	    KEEPALIVE_TIMEOUT * hz) &&
+	    !peer->p_timers.t_need_another_keepalive)
+		peer->p_timers.t_need_another_keepalive = 1;
+}
+
+/*
+ * Should be called after any type of authenticated packet is sent, whether
+ * keepalive, data, or handshake.
+ */
+void
+wg_peer_timers_any_authenticated_packet_sent(struct wg_peer *peer)
+{
+	wg_timers_del(&peer->p_timers.t_send_keepalive);
+}
+
+/*
+ * Should be called after any type of authenticated packet is received, whether
+ * keepalive, data, or handshake.
+ */
+void
+wg_peer_timers_any_authenticated_packet_received(struct wg_peer *peer)
+{
+	wg_timers_del(&peer->p_timers.t_new_handshake);
+}
+
+/* Should be called after a handshake initiation message is sent. */
+void
+wg_peer_timers_handshake_initiated(struct wg_peer *peer)
+{
+	wg_timers_set(peer, &peer->p_timers.t_retransmit_handshake,
+	    REKEY_TIMEOUT * hz + random() % REKEY_TIMEOUT_JITTER);
+}
+
+/*
+ * Should be called after a handshake response message is received and processed
+ * or when getting key confirmation via the first data message.
+ */
+void
+wg_peer_timers_handshake_complete(struct wg_peer *peer)
+{
+	wg_timers_del(&peer->p_timers.t_retransmit_handshake);
+	rw_wlock(&peer->p_timers.t_lock);
+	peer->p_timers.t_handshake_attempts = 0;
+	getnanotime(&peer->p_timers.t_last_handshake);
+	rw_wunlock(&peer->p_timers.t_lock);
+}
+
+/*
+ * Should be called after an ephemeral key is created, which is before sending a
+ * handshake response or after receiving a handshake response.
+ */
+void
+wg_peer_timers_session_derived(struct wg_peer *peer)
+{
+	wg_timers_set(peer, &peer->p_timers.t_zero_key_material,
+	    REJECT_AFTER_TIME * 3 * hz);
+}
+
+/*
+ * Should be called before a packet with authentication, whether
+ * keepalive, data, or handshake is sent, or after one is received.
+ * Pushing the persistent keepalive back is a store of the current tick,
+ * done at most once per tick.
+ */
+void
+wg_peer_timers_any_authenticated_packet_traversal(struct wg_peer *peer)
+{
+	struct wg_timers *t = &peer->p_timers;
+	int now = ticks;
+
+	if (t->t_persistent_keepalive_interval == 0)
+		return;
+	if (now == 0)
+		now = 1;
+	if (atomic_load_int(&t->t_last_traversal) == now)
+		return;
+	atomic_store_int(&t->t_last_traversal, now);
+	wg_timers_arm(peer, wg_timers_persistent_deadline(t, now));
+}
+
+void
+wg_peer_timers_init(struct wg_peer *peer)
+{
+	struct wg_timers *t = &peer->p_timers;
+
+	rw_init(&t->t_lock, "wg_peer_timers");
+	wg_wheel_entry_init(&t->t_entry);
+	t->t_retransmit_handshake = 0;
+	t->t_send_keepalive = 0;
+	t->t_new_handshake = 0;
+	t->t_zero_key_material = 0;
+	t->t_last_traversal = 0;
+	t->t_armed = 0;
+	t->t_disabled = false;
+	t->t_persistent_keepalive_interval = 0;
+	t->t_handshake_attempts = 0;
+	t->t_need_another_keepalive = 0;
+	bzero(&t->t_last_handshake, sizeof(t->t_last_handshake));
+	bzero(&t->t_last_sent_handshake, sizeof(t->t_last_sent_handshake));
+}
+
+void
+wg_peer_timers_last_handshake(struct wg_peer *peer, struct timespec *time)
+{
+	rw_rlock(&peer->p_timers.t_lock);
+	*time = peer->p_timers.t_last_handshake;
+	rw_runlock(&peer->p_timers.t_lock);
+}
+
+void
+wg_peer_timers_stop(struct wg_peer *peer)
+{
+	struct wg_timers *t = &peer->p_timers;
+
+	rw_wlock(&t->t_lock);
+	t->t_disabled = true;
+	atomic_store_int(&t->t_armed, 0);
+	if (wg_wheel_remove(&peer->p_sc->sc_wheel, &t->t_entry))
+		wg_peer_put(peer);
+	rw_wunlock(&t->t_lock);
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2019-2020 Netgate, Inc.
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/callout.h>
+
+#include <sys/if_wg_wheel.h>
+
+#define WG_WHEEL_UNARMED	UINT64_MAX
+#define WG_WHEEL_SHIFT(level)	((level) * WG_WHEEL_GRAN_BITS)
+
+static void	wg_wheel_insert(struct wg_wheel *, struct wg_wheel_entry *,
+		    uint64_t);
+static void	wg_wheel_unlink(struct wg_wheel *, struct wg_wheel_entry *);
+static uint64_t	wg_wheel_next(struct wg_wheel *);
+static void	wg_wheel_advance(struct wg_wheel *);
+static void	wg_wheel_arm(struct wg_wheel *, uint64_t);
+static void	wg_wheel_run(void *);
+
+void
+wg_wheel_init(struct wg_wheel *w, wg_wheel_fn_t *fn, void *arg)
+{
+	int level, slot;
+
+	mtx_init(&w->w_mtx, "wg_wheel", NULL, MTX_DEF);
+	callout_init(&w->w_callout, 1);
+	w->w_fn = fn;
+	w->w_arg = arg;
+	w->w_tick = MAX(hz / WG_WHEEL_HZ, 1);
+	w->w_now = 0;
+	w->w_ticks = ticks;
+	w->w_armed = WG_WHEEL_UNARMED;
+	w->w_count = 0;
+	w->w_running = false;
+	w->w_dying = false;
+	for (level = 0; level < WG_WHEEL_LEVELS; ++level) {
+		w->w_used[level] = 0;
+		for (slot = 0; slot < WG_WHEEL_SLOTS; ++slot)
+			TAILQ_INIT(&w->w_slots[level][slot]);
+	}
+}
+
+void
+wg_wheel_uninit(struct wg_wheel *w)
+{
+	mtx_lock(&w->w_mtx);
+	w->w_dying = true;
+	mtx_unlock(&w->w_mtx);
+	callout_drain(&w->w_callout);
+	KASSERT(w->w_count == 0, ("%s: %u entries left", __func__,
+	    w->w_count));
+	mtx_destroy(&w->w_mtx);
+}
+
+void
+wg_wheel_entry_init(struct wg_wheel_entry *e)
+{
+	e->we_expire = 0;
+	e->we_level = WG_WHEEL_IDLE;
+	e->we_slot = 0;
+}
+
+/*
+ * Files an entry on the finest level that reaches its expiry once that is
+ * rounded up to the level's granularity. An expiry past the top level is
+ * pulled in to the last slot there, so such an entry fires early and its
+ * owner has to re-arm it.
+ */
+static void
+wg_wheel_insert(struct wg_wheel *w, struct wg_wheel_entry *e, uint64_t expire)
+{
+	uint64_t fire;
+	int level, shift;
+
+	for (level = 0; level < WG_WHEEL_LEVELS; ++level) {
+		shift = WG_WHEEL_SHIFT(level);
+		fire = roundup2(expire, 1ULL << shift);
+		if (fire - w->w_now < (uint64_t)WG_WHEEL_SLOTS << shift)
+			break;
+	}
+	if (level == WG_WHEEL_LEVELS) {
+		level--;
+		fire = roundup2(w->w_now, 1ULL << shift) +
+		    ((uint64_t)WG_WHEEL_MASK << shift);
+	}
+	e->we_expire = fire;
+	e->we_slot = (fire >> shift) & WG_WHEEL_MASK;
+	atomic_store_int(&e->we_level, level);
+	TAILQ_INSERT_TAIL(&w->w_slots[level][e->we_slot], e, we_entry);
+	w->w_used[level] |= 1ULL << e->we_slot;
+}
+
+static void
+wg_wheel_unlink(struct wg_wheel *w, struct wg_wheel_entry *e)
+{
+	struct wg_wheel_slot *slot = &w->w_slots[e->we_level][e->we_slot];
+
+	TAILQ_REMOVE(slot, e, we_entry);
+	if (TAILQ_EMPTY(slot))
+		w->w_used[e->we_level] &= ~(1ULL << e->we_slot);
+	atomic_store_int(&e->we_level, WG_WHEEL_IDLE);
+}
+
+/*
+ * The first wheel tick, from w_now on, that has a slot to run, or
+ * WG_WHEEL_UNARMED if the wheel is empty. Each level's occupied slots are
+ * rotated so that the one due next comes first.
+ */
+static uint64_t
+wg_wheel_next(struct wg_wheel *w)
+{
+	uint64_t next = WG_WHEEL_UNARMED;
+	uint64_t used, base;
+	int level, shift, idx;
+
+	for (level = 0; level < WG_WHEEL_LEVELS; ++level) {
+		if ((used = w->w_used[level]) == 0)
+			continue;
+		shift = WG_WHEEL_SHIFT(level);
+		base = roundup2(w->w_now, 1ULL << shift) >> shift;
+		if ((idx = base & WG_WHEEL_MASK) != 0)
+			used = (used >> idx) | (used << (WG_WHEEL_SLOTS - idx));
+		next = MIN(next, (base + ffsll(used) - 1) << shift);
+	}
+	return (next);
+}
+
+/*
+ * Moves w_now up to the present, but never past a slot still to run, nor
+ * while wg_wheel_run is going through them.
+ */
+static void
+wg_wheel_advance(struct wg_wheel *w)
+{
+	uint64_t skip, next;
+	int delta;
+
+	if (w->w_running || (delta = ticks - w->w_ticks) < w->w_tick)
+		return;
+	skip = delta / w->w_tick;
+	if ((next = wg_wheel_next(w)) != WG_WHEEL_UNARMED)
+		skip = MIN(skip, next - w->w_now);
+	w->w_now += skip;
+	w->w_ticks += skip * w->w_tick;
+}
+
+/* Makes sure w_callout is due no later than wheel tick next. */
+static void
+wg_wheel_arm(struct wg_wheel *w, uint64_t next)
+{
+	int when;
+
+	mtx_assert(&w->w_mtx, MA_OWNED);
+	if (w->w_dying || next >= w->w_armed)
+		return;
+	w->w_armed = next;
+	when = w->w_ticks + (int)(next - w->w_now) * w->w_tick;
+	callout_reset(&w->w_callout, MAX(when - ticks, 1), wg_wheel_run, w);
+}
+
+/*
+ * Returns true if the entry was pending, in which case it is moved, like
+ * callout_reset. The deadline is in ticks and rounded up to a wheel tick.
+ */
+bool
+wg_wheel_schedule(struct wg_wheel *w, struct wg_wheel_entry *e, int when)
+{
+	bool pending;
+	int delta;
+
+	mtx_lock(&w->w_mtx);
+	if ((pending = e->we_level != WG_WHEEL_IDLE))
+		wg_wheel_unlink(w, e);
+	else
+		w->w_count++;
+	wg_wheel_advance(w);
+	delta = when - w->w_ticks;
+	wg_wheel_insert(w, e,
+	    w->w_now + (delta > 0 ? howmany(delta, w->w_tick) : 0));
+	wg_wheel_arm(w, e->we_expire);
+	mtx_unlock(&w->w_mtx);
+	return (pending);
+}
+
+/* Returns true if the entry was pending, like callout_stop. */
+bool
+wg_wheel_remove(struct wg_wheel *w, struct wg_wheel_entry *e)
+{
+	bool pending;
+
+	mtx_lock(&w->w_mtx);
+	if ((pending = e->we_level != WG_WHEEL_IDLE)) {
+		wg_wheel_unlink(w, e);
+		w->w_count--;
+	}
+	mtx_unlock(&w->w_mtx);
+	return (pending);
+}
+
+/*
+ * Runs every slot that is due. Expired entries are idle again by the time
+ * the callback sees them, and it is called without the wheel lock so that
+ * it can schedule them anew; whatever it schedules for the tick being run
+ * is picked up before the wheel moves on.
+ */
+static void
+wg_wheel_run(void *arg)
+{
+	struct wg_wheel *w = arg;
+	struct wg_wheel_slot *slot;
+	struct wg_wheel_entry *e;
+	uint64_t next;
+	int level, shift, when, now = ticks, n = 0;
+
+	mtx_lock(&w->w_mtx);
+	w->w_armed = WG_WHEEL_UNARMED;
+	w->w_running = true;
+	while ((next = wg_wheel_next(w)) != WG_WHEEL_UNARMED) {
+		when = w->w_ticks + (int)(next - w->w_now) * w->w_tick;
+		if (now - when < 0)
+			break;
+		w->w_now = next;
+		w->w_ticks = when;
+		for (level = 0; level < WG_WHEEL_LEVELS; ++level) {
+			shift = WG_WHEEL_SHIFT(level);
+			if ((next & ((1ULL << shift) - 1)) != 0)
+				break;
+			slot = &w->w_slots[level][(next >> shift) &
+			    WG_WHEEL_MASK];
+			while ((e = TAILQ_FIRST(slot)) != NULL) {
+				wg_wheel_unlink(w, e);
+				w->w_count--;
+				w->w_batch[n++] = e;
+				if (n < WG_WHEEL_BATCH)
+					continue;
+				mtx_unlock(&w->w_mtx);
+				w->w_fn(w->w_arg, w->w_batch, n);
+				n = 0;
+				mtx_lock(&w->w_mtx);
+			}
+		}
+		if (n != 0) {
+			mtx_unlock(&w->w_mtx);
+			w->w_fn(w->w_arg, w->w_batch, n);
+			n = 0;
+			mtx_lock(&w->w_mtx);
+		}
+	}
+	w->w_running = false;
+	wg_wheel_advance(w);
+	wg_wheel_arm(w, wg_wheel_next(w));
+	mtx_unlock(&w->w_mtx);
+}
@@ -51,6 +51,9 @@ __FBSDID("$FreeBSD$");
 #include <net/bpf.h>
 #include <net/mp_ring.h>
 
+#include <netinet/in.h>
+#include <netinet/ip.h>
+
 #include "ifdi_if.h"
 
 #if 0
@@ -65,8 +68,10 @@ __FBSDID("$FreeBSD$");
 
 MALLOC_DEFINE(M_WG, "WG", "wireguard");
 
+SYSCTL_NODE(_net, OID_AUTO, wg, CTLFLAG_RW, 0, "WireGuard");
+
 #define WG_CAPS														\
-	IFCAP_TSO |IFCAP_HWCSUM | IFCAP_VLAN_HWFILTER | IFCAP_VLAN_HWTAGGING | IFCAP_VLAN_HWCSUM |	\
+	IFCAP_TSO | IFCAP_HWCSUM | IFCAP_VLAN_HWFILTER | IFCAP_VLAN_HWTAGGING | IFCAP_VLAN_HWCSUM |	\
 	IFCAP_VLAN_MTU | IFCAP_TXCSUM_IPV6 | IFCAP_HWCSUM_IPV6 | IFCAP_JUMBO_MTU | IFCAP_LINKSTATE
 
 static int clone_count;
@@ -127,15 +132,21 @@ wg_cloneattach(if_ctx_t ctx, struct if_clone *ifc, const char *name, caddr_t par
 	}
 
 	sc->sc_socket.so_port = listen_port;
+	/* Clamped, and the public and MAC1 keys derived, at attach. */
 	memcpy(sc->sc_local.l_private, priv_key, priv_size);
-	curve25519_clamp_secret(sc->sc_local.l_private);
-	curve25519_generate_public(sc->sc_local.l_public, priv_key);
 
 	atomic_add_int(&clone_count, 1);
 	scctx = sc->shared = iflib_get_softc_ctx(ctx);
 	scctx->isc_capenable = WG_CAPS;
 	scctx->isc_tx_csum_flags = CSUM_TCP | CSUM_UDP | CSUM_TSO | CSUM_IP6_TCP \
 		| CSUM_IP6_UDP | CSUM_IP6_TCP;
+	/*
+	 * wg_peer_stage cuts TSO segments itself, in software; these only
+	 * tell tcp_output how large a one it may hand over.
+	 */
+	scctx->isc_tx_tso_size_max = IP_MAXPACKET;
+	scctx->isc_tx_tso_segsize_max = IP_MAXPACKET;
+	scctx->isc_tx_tso_segments_max = IP_MAXPACKET / MCLBYTES + 1;
 	sc->wg_ctx = ctx;
 	sc->sc_ifp = iflib_get_ifp(ctx);
 
@@ -173,13 +184,7 @@ wg_transmit(struct ifnet *ifp, struct mbuf *m)
 		/* XXX log */
 		goto err;
 	}
-	mtx_lock(&peer->p_lock);
-	if (mbufq_enqueue(&peer->p_staged_packets, m) != 0) {
-		if_inc_counter(sc->sc_ifp, IFCOUNTER_OQDROPS, 1);
-		rc = ENOBUFS;
-		m_freem(m);
-	}
-	mtx_unlock(&peer->p_lock);
+	rc = wg_peer_stage(peer, m);
 	wg_peer_send_staged_packets(peer);
 	NET_EPOCH_EXIT(et);
 	return (rc); 
@@ -208,6 +213,17 @@ wg_attach_post(if_ctx_t ctx)
 
 	wg_hashtable_init(&sc->sc_hashtable);
 	wg_route_init(&sc->sc_routes);
+	wg_softc_handshake_init(sc);
+	wg_softc_encrypt_init(sc);
+	wg_decrypt_workers_init(sc);
+	wg_softc_timers_init(sc);
+	wg_softc_sysctl_init(sc, device_get_sysctl_ctx(iflib_get_dev(ctx)),
+	    SYSCTL_CHILDREN(device_get_sysctl_tree(iflib_get_dev(ctx))));
+
+	/* Without a crypto(9) session every packet is handled inline. */
+	if (wg_crypto_init(sc) != 0)
+		device_printf(iflib_get_dev(ctx),
+		    "no crypto(9) session, net.wg.crypto_async ignored\n");
 
 	return (0);
 }
@@ -220,7 +236,14 @@ wg_detach(if_ctx_t ctx)
 	sc = iflib_get_softc(ctx);
 	//sc->wg_accept_port = 0;
 	wg_socket_reinit(sc, NULL, NULL);
+	/* What is in crypto(9) still needs the peers, queues and tasks. */
+	wg_crypto_drain(sc);
 	wg_peer_remove_all(sc);
+	wg_softc_timers_uninit(sc);
+	wg_softc_handshake_uninit(sc);
+	wg_softc_encrypt_uninit(sc);
+	wg_decrypt_workers_uninit(sc);
+	wg_crypto_uninit(sc);
 	
 	atomic_add_int(&clone_count, -1);
 
@@ -394,6 +417,9 @@ int
 wg_ctx_init(void)
 {
 
+	wg_stats_init();
+	wg_zones_init();
+	noise_ephemeral_init();
 	return (0);
 }
 
@@ -401,6 +427,9 @@ void
 wg_ctx_uninit(void)
 {
 
+	noise_ephemeral_uninit();
+	wg_zones_uninit();
+	wg_stats_uninit();
 }
 
 static int
@@ -0,0 +1,387 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Throughput of every zinc implementation the host can run, written to
+ * stdout as JSON so that results can be compared between releases.
+ */
+
+#include <zinc/chacha20.h>
+#include <zinc/poly1305.h>
+#include <zinc/chacha20poly1305.h>
+#include <zinc/blake2s.h>
+#include <zinc/curve25519.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define bench_cycles() __rdtsc()
+#define BENCH_CLOCK "tsc"
+#else
+#define bench_cycles() ktime_get_ns()
+#define BENCH_CLOCK "ns"
+#endif
+
+enum bench_values {
+	BENCH_MAX_LEN = 9000,
+	BENCH_TRIALS = 5,
+	BENCH_WARMUP = 64,
+	BENCH_BYTES_PER_TRIAL = 1 << 22,
+	BENCH_X25519_OPS = 512
+};
+
+static const size_t bench_sizes[] = {
+	64, 128, 256, 512, 576, 1024, 1420, 1500, 4096, 9000
+};
+
+struct bench_impl {
+	const char *name;
+	unsigned long mask;
+};
+
+#define BENCH_IMPL_END { NULL, 0 }
+
+/* The masks follow the nobs order of each arch glue file. A wider
+ * implementation always keeps the narrower ones enabled, since the glue falls
+ * back to them for lengths that are too short for the widest one.
+ */
+static const struct bench_impl chacha20_impls[] = {
+	{ "generic", 0x0 },
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	{ "ssse3", 0x1 },
+	{ "avx2", 0x3 },
+	{ "avx512", 0x7 },
+	{ "avx512vl", 0xb },
+#endif
+	BENCH_IMPL_END
+};
+
+static const struct bench_impl poly1305_impls[] = {
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	{ "x86_64", 0x0 },
+	{ "avx", 0x1 },
+	{ "avx2", 0x3 },
+	{ "avx512", 0x7 },
+#else
+	{ "generic", 0x0 },
+#endif
+	BENCH_IMPL_END
+};
+
+static const struct bench_impl blake2s_impls[] = {
+	{ "generic", 0x0 },
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	{ "ssse3", 0x1 },
+	{ "avx512", 0x3 },
+#endif
+	BENCH_IMPL_END
+};
+
+static const struct bench_impl curve25519_impls[] = {
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	{ "hacl64", 0x0 },
+	{ "bmi2", 0x1 },
+	{ "adx", 0x3 },
+#else
+	{ "generic", 0x0 },
+#endif
+	BENCH_IMPL_END
+};
+
+/* ChaCha20-Poly1305 pairs up the two primitives at the same ISA level. */
+static const struct bench_aead_impl {
+	const char *name;
+	unsigned long chacha20_mask;
+	unsigned long poly1305_mask;
+} chacha20poly1305_impls[] = {
+	{ "generic", 0x0, 0x0 },
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	{ "ssse3-avx", 0x1, 0x1 },
+	{ "avx2", 0x3, 0x3 },
+	{ "avx512", 0x7, 0x7 },
+	{ "avx512vl", 0xb, 0x3 },
+#endif
+	{ NULL, 0, 0 }
+};
+
+static u8 bench_buf[BENCH_MAX_LEN + POLY1305_MAC_SIZE] __aligned(64);
+static const u8 bench_key[32] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static bool bench_first = true;
+static bool bench_quick;
+static const char *bench_only;
+
+static unsigned long zinc_available(const struct bench_zinc *zinc)
+{
+	unsigned long set = 0;
+	unsigned int i;
+
+	for (i = 0; i < zinc->nobs_len; ++i)
+		set |= ((unsigned long)*zinc->nobs[i]) << i;
+	return set;
+}
+
+static void zinc_force(const struct bench_zinc *zinc, unsigned long mask)
+{
+	unsigned int i;
+
+	for (i = 0; i < zinc->nobs_len; ++i)
+		*zinc->nobs[i] = BIT(i) & mask;
+}
+
+static bool bench_wanted(const char *primitive)
+{
+	return !bench_only || !strcmp(bench_only, primitive);
+}
+
+static void bench_result(const char *primitive, const char *impl, size_t len,
+			 double cycles)
+{
+	printf("%s\n    { \"primitive\": \"%s\", \"implementation\": \"%s\", "
+	       "\"bytes\": %zu, \"cycles_per_byte\": %.3f }",
+	       bench_first ? "" : ",", primitive, impl, len, cycles / len);
+	bench_first = false;
+}
+
+static void bench_op_result(const char *impl, const char *op, double cycles,
+			    double nsecs)
+{
+	printf("%s\n    { \"primitive\": \"x25519\", \"implementation\": \"%s\", "
+	       "\"operation\": \"%s\", \"cycles_per_op\": %.0f, "
+	       "\"ops_per_sec\": %.0f }",
+	       bench_first ? "" : ",", impl, op, cycles, 1e9 / nsecs);
+	bench_first = false;
+}
+
+/* Minimum over several trials of the cost of one call, in clock units. */
+static double bench_run(void (*fn)(size_t), size_t len)
+{
+	unsigned int i, trial, rounds;
+	double best = 0;
+	u64 start, end;
+
+	rounds = (bench_quick ? BENCH_BYTES_PER_TRIAL / 16 :
+				BENCH_BYTES_PER_TRIAL) / len + 1;
+	for (i = 0; i < BENCH_WARMUP; ++i)
+		fn(len);
+	for (trial = 0; trial < BENCH_TRIALS; ++trial) {
+		start = bench_cycles();
+		for (i = 0; i < rounds; ++i)
+			fn(len);
+		end = bench_cycles();
+		if (!trial || (double)(end - start) / rounds < best)
+			best = (double)(end - start) / rounds;
+	}
+	return best;
+}
+
+static void bench_sizes_run(const char *primitive, const char *impl,
+			    void (*fn)(size_t))
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(bench_sizes); ++i)
+		bench_result(primitive, impl, bench_sizes[i],
+			     bench_run(fn, bench_sizes[i]));
+}
+
+static void bench_chacha20_one(size_t len)
+{
+	struct chacha20_ctx ctx;
+	simd_context_t simd_context;
+
+	chacha20_init(&ctx, bench_key, 0);
+	simd_get(&simd_context);
+	chacha20(&ctx, bench_buf, bench_buf, len, &simd_context);
+	simd_put(&simd_context);
+}
+
+#define BENCH_POLY1305(prefix)						\
+static void bench_##prefix##_one(size_t len)				\
+{									\
+	struct poly1305_ctx ctx;					\
+	simd_context_t simd_context;					\
+	u8 mac[POLY1305_MAC_SIZE];					\
+									\
+	prefix##_init(&ctx, bench_key);					\
+	simd_get(&simd_context);					\
+	prefix##_update(&ctx, bench_buf, len, &simd_context);		\
+	prefix##_final(&ctx, mac, &simd_context);			\
+	simd_put(&simd_context);					\
+}
+
+BENCH_POLY1305(poly1305)
+BENCH_POLY1305(donna32_poly1305)
+BENCH_POLY1305(donna64_poly1305)
+
+static void bench_chacha20poly1305_one(size_t len)
+{
+	chacha20poly1305_encrypt(bench_buf, bench_buf, len, NULL, 0, 0,
+				 bench_key);
+}
+
+static void bench_blake2s_one(size_t len)
+{
+	u8 hash[BLAKE2S_HASH_SIZE];
+
+	blake2s(hash, bench_buf, NULL, sizeof(hash), len, 0);
+}
+
+static void bench_zinc_impls(const char *primitive,
+			     const struct bench_zinc *zinc,
+			     const struct bench_impl *impls,
+			     void (*fn)(size_t))
+{
+	const unsigned long available = zinc_available(zinc);
+
+	if (!bench_wanted(primitive))
+		return;
+	for (; impls->name; ++impls) {
+		if (impls->mask & ~available)
+			continue;
+		zinc_force(zinc, impls->mask);
+		bench_sizes_run(primitive, impls->name, fn);
+	}
+	zinc_force(zinc, available);
+}
+
+static void bench_chacha20poly1305(void)
+{
+	const unsigned long chacha20 = zinc_available(&bench_chacha20);
+	const unsigned long poly1305 = zinc_available(&bench_poly1305);
+	const struct bench_aead_impl *impl;
+
+	if (!bench_wanted("chacha20poly1305"))
+		return;
+	for (impl = chacha20poly1305_impls; impl->name; ++impl) {
+		if ((impl->chacha20_mask & ~chacha20) ||
+		    (impl->poly1305_mask & ~poly1305))
+			continue;
+		zinc_force(&bench_chacha20, impl->chacha20_mask);
+		zinc_force(&bench_poly1305, impl->poly1305_mask);
+		bench_sizes_run("chacha20poly1305", impl->name,
+				bench_chacha20poly1305_one);
+	}
+	zinc_force(&bench_chacha20, chacha20);
+	zinc_force(&bench_poly1305, poly1305);
+}
+
+static void bench_x25519(const char *impl,
+			 bool (*scalarmult)(u8 *, const u8 *, const u8 *),
+			 bool (*generate_public)(u8 *, const u8 *))
+{
+	u8 secret[CURVE25519_KEY_SIZE], point[CURVE25519_KEY_SIZE];
+	const unsigned int ops = bench_quick ? BENCH_X25519_OPS / 16 :
+					       BENCH_X25519_OPS;
+	u64 nsecs, cycles;
+	unsigned int i;
+
+	memcpy(secret, bench_key, sizeof(secret));
+	curve25519_clamp_secret(secret);
+	generate_public(point, secret);
+
+	nsecs = ktime_get_ns();
+	cycles = bench_cycles();
+	for (i = 0; i < ops; ++i)
+		scalarmult(point, secret, point);
+	cycles = bench_cycles() - cycles;
+	nsecs = ktime_get_ns() - nsecs;
+	bench_op_result(impl, "scalarmult", (double)cycles / ops,
+			(double)nsecs / ops);
+
+	nsecs = ktime_get_ns();
+	cycles = bench_cycles();
+	for (i = 0; i < ops; ++i)
+		generate_public(point, secret);
+	cycles = bench_cycles() - cycles;
+	nsecs = ktime_get_ns() - nsecs;
+	bench_op_result(impl, "generate_public", (double)cycles / ops,
+			(double)nsecs / ops);
+}
+
+static void bench_curve25519_impls(void)
+{
+	const unsigned long available = zinc_available(&bench_curve25519);
+	const struct bench_impl *impl;
+
+	if (!bench_wanted("x25519"))
+		return;
+#ifdef CONFIG_ZINC_ARCH_X86_64
+	bench_x25519("fiat32", fiat32_curve25519,
+		     fiat32_curve25519_generate_public);
+#endif
+	for (impl = curve25519_impls; impl->name; ++impl) {
+		if (impl->mask & ~available)
+			continue;
+		zinc_force(&bench_curve25519, impl->mask);
+		bench_x25519(impl->name, curve25519,
+			     curve25519_generate_public);
+	}
+	zinc_force(&bench_curve25519, available);
+}
+
+static const struct bench_zinc *const bench_zincs[] = {
+	&bench_chacha20, &bench_poly1305, &bench_blake2s, &bench_curve25519,
+	&bench_poly1305_donna32, &bench_poly1305_donna64,
+	&bench_curve25519_fiat32
+};
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-q] [-p primitive]\n"
+		"  -q  shorter runs, for smoke testing\n"
+		"  -p  one of chacha20, poly1305, chacha20poly1305, blake2s, "
+		"x25519\n", prog);
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int i;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "qp:")) != -1) {
+		switch (ch) {
+		case 'q':
+			bench_quick = true;
+			break;
+		case 'p':
+			bench_only = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	/* The module init path detects the CPU features and then runs the
+	 * self-tests, which turn off any implementation that fails them.
+	 */
+	for (i = 0; i < ARRAY_SIZE(bench_zincs); ++i) {
+		if (bench_zincs[i]->mod_init()) {
+			fprintf(stderr, "%s: self-tests failed\n",
+				bench_zincs[i]->name);
+			return 1;
+		}
+	}
+	if (chacha20poly1305_mod_init()) {
+		fprintf(stderr, "chacha20poly1305: self-tests failed\n");
+		return 1;
+	}
+
+	printf("{\n  \"clock\": \"" BENCH_CLOCK "\",\n  \"results\": [");
+	bench_zinc_impls("chacha20", &bench_chacha20, chacha20_impls,
+			 bench_chacha20_one);
+	if (bench_wanted("poly1305")) {
+		bench_sizes_run("poly1305", "donna32", bench_donna32_poly1305_one);
+		bench_sizes_run("poly1305", "donna64", bench_donna64_poly1305_one);
+	}
+	bench_zinc_impls("poly1305", &bench_poly1305, poly1305_impls,
+			 bench_poly1305_one);
+	bench_chacha20poly1305();
+	bench_zinc_impls("blake2s", &bench_blake2s, blake2s_impls,
+			 bench_blake2s_one);
+	bench_curve25519_impls();
+	printf("\n  ]\n}\n");
+	return 0;
+}
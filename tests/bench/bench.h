@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+/* Each zinc translation unit exports its nobs so that the benchmark can force
+ * one implementation at a time, exactly as selftest_run does.
+ */
+struct bench_zinc {
+	const char *name;
+	bool *const *nobs;
+	unsigned int nobs_len;
+	int (*mod_init)(void);
+};
+
+#define BENCH_ZINC(prim, init) {					\
+	.name = #prim,							\
+	.nobs = prim##_nobs,						\
+	.nobs_len = ARRAY_SIZE(prim##_nobs),				\
+	.mod_init = init						\
+}
+
+extern const struct bench_zinc bench_chacha20;
+extern const struct bench_zinc bench_poly1305;
+extern const struct bench_zinc bench_blake2s;
+extern const struct bench_zinc bench_curve25519;
+extern const struct bench_zinc bench_poly1305_donna32;
+extern const struct bench_zinc bench_poly1305_donna64;
+extern const struct bench_zinc bench_curve25519_fiat32;
+
+/* The portable fallbacks are built a second time without arch glue, under
+ * these names, so they can be measured next to the arch code on one host.
+ */
+void donna32_poly1305_init(struct poly1305_ctx *ctx,
+			   const u8 key[POLY1305_KEY_SIZE]);
+void donna32_poly1305_update(struct poly1305_ctx *ctx, const u8 *input,
+			     size_t len, simd_context_t *simd_context);
+void donna32_poly1305_final(struct poly1305_ctx *ctx,
+			    u8 mac[POLY1305_MAC_SIZE],
+			    simd_context_t *simd_context);
+void donna64_poly1305_init(struct poly1305_ctx *ctx,
+			   const u8 key[POLY1305_KEY_SIZE]);
+void donna64_poly1305_update(struct poly1305_ctx *ctx, const u8 *input,
+			     size_t len, simd_context_t *simd_context);
+void donna64_poly1305_final(struct poly1305_ctx *ctx,
+			    u8 mac[POLY1305_MAC_SIZE],
+			    simd_context_t *simd_context);
+bool fiat32_curve25519(u8 mypublic[CURVE25519_KEY_SIZE],
+		       const u8 secret[CURVE25519_KEY_SIZE],
+		       const u8 basepoint[CURVE25519_KEY_SIZE]);
+bool fiat32_curve25519_generate_public(u8 pub[CURVE25519_KEY_SIZE],
+				       const u8 secret[CURVE25519_KEY_SIZE]);
+
+int chacha20_mod_init(void);
+int poly1305_mod_init(void);
+int blake2s_mod_init(void);
+int curve25519_mod_init(void);
+int chacha20poly1305_mod_init(void);
+
+#endif
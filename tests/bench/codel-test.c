@@ -0,0 +1,210 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * CoDel as module/if_wg_codel.c has it, built unmodified, on a clock the
+ * test keeps. Packets that wait under WG_CODEL_TARGET, or leave the queue
+ * empty, are never dropped. Once they have waited longer for
+ * WG_CODEL_INTERVAL, one is dropped, and then one each time the control
+ * law comes round, WG_CODEL_INTERVAL over the square root of the number
+ * dropped, until one gets through in time. Dropping again soon after picks
+ * up where it left off, less the drops of the last episode; later, it
+ * starts over.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/time.h>
+
+#include <math.h>
+
+#include <sys/if_wg_codel.h>
+
+#define CODEL_TEST_LATE		(2 * WG_CODEL_TARGET)
+#define CODEL_TEST_STEP		(SBT_1MS / 8)
+
+static int codel_test_failed;
+
+#define codel_test_check(name, exp) do {				\
+	if (!(exp)) {							\
+		fprintf(stderr, "codel-test: %s: %s\n", (name), #exp);	\
+		codel_test_failed++;					\
+	}								\
+} while (0)
+
+/* The gap after the count-th drop. */
+static sbintime_t
+codel_test_gap(u_int count)
+{
+	return (WG_CODEL_INTERVAL / (u_int)floor(sqrt((double)count)));
+}
+
+/*
+ * Packets that all waited sojourn, taken off every CODEL_TEST_STEP from
+ * *now on until drops of them have been dropped. Returns when the last one
+ * was.
+ */
+static sbintime_t
+codel_test_run(struct wg_codel *c, sbintime_t *now, sbintime_t sojourn,
+    u_int drops)
+{
+	sbintime_t last = 0;
+
+	while (drops > 0) {
+		*now += CODEL_TEST_STEP;
+		if (wg_codel_drop(c, *now, sojourn, false)) {
+			last = *now;
+			drops--;
+		}
+	}
+	return (last);
+}
+
+/* Nothing is dropped while packets get through in time. */
+static void
+codel_test_under(const char *name)
+{
+	struct wg_codel c;
+	sbintime_t now = SBT_1S;
+	int i;
+
+	wg_codel_init(&c);
+	for (i = 0; i < 10000; i++) {
+		now += CODEL_TEST_STEP;
+		codel_test_check(name, !wg_codel_drop(&c, now,
+		    WG_CODEL_TARGET - 1, false));
+		codel_test_check(name, !wg_codel_drop(&c, now,
+		    CODEL_TEST_LATE, true));
+	}
+	codel_test_check(name, !c.c_dropping);
+	codel_test_check(name, c.c_first_above == 0);
+}
+
+/* The first drop, a full interval after packets first ran late. */
+static void
+codel_test_enter(const char *name)
+{
+	struct wg_codel c;
+	sbintime_t now = SBT_1S, start;
+
+	wg_codel_init(&c);
+	start = now;
+	codel_test_check(name, !wg_codel_drop(&c, now, WG_CODEL_TARGET,
+	    false));
+	codel_test_check(name, c.c_first_above == start + WG_CODEL_INTERVAL);
+	now = start + WG_CODEL_INTERVAL - 1;
+	codel_test_check(name, !wg_codel_drop(&c, now, CODEL_TEST_LATE,
+	    false));
+	codel_test_check(name, !c.c_dropping);
+	now++;
+	codel_test_check(name, wg_codel_drop(&c, now, CODEL_TEST_LATE,
+	    false));
+	codel_test_check(name, c.c_dropping);
+	codel_test_check(name, c.c_count == 1);
+	codel_test_check(name, c.c_drop_next == now + codel_test_gap(1));
+
+	/* One packet in time, or the queue running empty, starts it over. */
+	now += CODEL_TEST_STEP;
+	codel_test_check(name, !wg_codel_drop(&c, now, WG_CODEL_TARGET - 1,
+	    false));
+	codel_test_check(name, !c.c_dropping);
+	codel_test_check(name, c.c_first_above == 0);
+	start = now + CODEL_TEST_STEP;
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, now >= start + WG_CODEL_INTERVAL);
+	codel_test_check(name, now < start + WG_CODEL_INTERVAL +
+	    CODEL_TEST_STEP);
+	now += CODEL_TEST_STEP;
+	codel_test_check(name, !wg_codel_drop(&c, now, CODEL_TEST_LATE,
+	    true));
+	codel_test_check(name, !c.c_dropping);
+	codel_test_check(name, c.c_first_above == 0);
+}
+
+/* While dropping, drops come at the gaps the control law sets. */
+static void
+codel_test_control(const char *name)
+{
+	struct wg_codel c;
+	sbintime_t now = SBT_1S, last, next;
+	u_int count;
+
+	wg_codel_init(&c);
+	last = codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	next = last + codel_test_gap(1);
+	for (count = 2; count <= 400; count++) {
+		last = codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+		codel_test_check(name, last >= next);
+		codel_test_check(name, last < next + CODEL_TEST_STEP);
+		codel_test_check(name, c.c_count == count);
+		codel_test_check(name, c.c_drop_next ==
+		    next + codel_test_gap(count));
+		next = c.c_drop_next;
+	}
+	codel_test_check(name, codel_test_gap(400) == WG_CODEL_INTERVAL / 20);
+}
+
+/*
+ * Dropping again within 16 intervals picks up at the drops of the last
+ * episode less those of the one before; later, or with too few drops in
+ * between, it starts over at one.
+ */
+static void
+codel_test_reenter(const char *name)
+{
+	struct wg_codel c;
+	sbintime_t now = SBT_1S, last;
+
+	wg_codel_init(&c);
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 10);
+	codel_test_check(name, c.c_count == 10);
+	codel_test_check(name, c.c_lastcount == 1);
+
+	/* Back soon: the 9 dropped since the episode began. */
+	now += CODEL_TEST_STEP;
+	wg_codel_drop(&c, now, 0, false);
+	last = codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, c.c_count == 9);
+	codel_test_check(name, c.c_lastcount == 9);
+	codel_test_check(name, c.c_drop_next == last + codel_test_gap(9));
+
+	/* Back soon, with one drop in between: from one. */
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, c.c_count == 10);
+	now += CODEL_TEST_STEP;
+	wg_codel_drop(&c, now, 0, false);
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, c.c_count == 1);
+
+	/* Dropping again just inside 16 intervals still picks up... */
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 20);
+	codel_test_check(name, c.c_count == 21);
+	now = c.c_drop_next + 15 * WG_CODEL_INTERVAL - 2 * CODEL_TEST_STEP;
+	wg_codel_drop(&c, now, 0, false);
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, c.c_count == 20);
+
+	/* ...and just after starts over, whatever was dropped. */
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 20);
+	codel_test_check(name, c.c_count == 40);
+	now = c.c_drop_next + 15 * WG_CODEL_INTERVAL - CODEL_TEST_STEP;
+	wg_codel_drop(&c, now, 0, false);
+	codel_test_run(&c, &now, CODEL_TEST_LATE, 1);
+	codel_test_check(name, c.c_count == 1);
+	codel_test_check(name, c.c_lastcount == 1);
+}
+
+int
+main(void)
+{
+	codel_test_under("under");
+	codel_test_enter("enter");
+	codel_test_control("control");
+	codel_test_reenter("reenter");
+
+	if (codel_test_failed != 0)
+		return (1);
+	printf("codel-test: ok\n");
+	return (0);
+}
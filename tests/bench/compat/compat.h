@@ -0,0 +1,348 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Just enough of the kernel environment to build the zinc primitives as
+ * ordinary userspace objects. Every kernel header the zinc sources pull in
+ * is an empty placeholder next to this file; this header is force-included
+ * ahead of them.
+ */
+
+#ifndef _BENCH_COMPAT_H
+#define _BENCH_COMPAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/param.h>
+#include <cpuid.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef uint32_t __le32;
+typedef uint64_t __le64;
+
+#ifndef ENOTRECOVERABLE
+#define ENOTRECOVERABLE 131
+#endif
+
+#define U32_MAX		UINT32_MAX
+#ifndef PAGE_SIZE
+#define PAGE_SIZE	4096
+#endif
+#define BITS_PER_LONG	(sizeof(long) * CHAR_BIT)
+#define BIT(n)		(1UL << (n))
+#define ARRAY_SIZE(x)	(sizeof(x) / sizeof((x)[0]))
+#define IS_ENABLED(x)	__is_enabled(x)
+#define __is_enabled(x)	___is_enabled(__ARG_PLACEHOLDER_##x)
+#define __ARG_PLACEHOLDER_1 0,
+#define ___is_enabled(arg) ____is_enabled(arg 1, 0)
+#define ____is_enabled(ignored, val, ...) val
+
+#define __aligned(x)	__attribute__((__aligned__(x)))
+#define __packed	__attribute__((__packed__))
+#define __init
+#define __exit
+#define __initdata
+#define __initconst
+#define __ro_after_init
+#define asmlinkage
+#define likely(x)	__builtin_expect(!!(x), 1)
+#define unlikely(x)	__builtin_expect(!!(x), 0)
+#define __predict_true(x)	likely(x)
+#define __predict_false(x)	unlikely(x)
+#define READ_ONCE(x)	(*(const volatile __typeof__(x) *)&(x))
+
+#define BUILD_BUG_ON(x)	((void)sizeof(char[1 - 2 * !!(x)]))
+#define WARN_ON(x)	({ int __w = !!(x); if (__w) fprintf(stderr, "WARN_ON(%s)\n", #x); __w; })
+#define pr_info(...)	fprintf(stderr, __VA_ARGS__)
+#define pr_err(...)	fprintf(stderr, __VA_ARGS__)
+#define printk(...)	fprintf(stderr, __VA_ARGS__)
+#define KERN_CONT	""
+#define BUG()		abort()
+
+#define GFP_KERNEL	0
+#define kmalloc(n, f)	malloc(n)
+#define kfree(p)	free(p)
+#define vzalloc(n)	calloc(1, n)
+#define vfree(p)	free(p)
+
+#define DIV_ROUND_UP(n, d)	(((n) + (d) - 1) / (d))
+#define min(a, b)	((a) < (b) ? (a) : (b))
+#define max(a, b)	((a) > (b) ? (a) : (b))
+#define min_t(t, a, b)	((t)(a) < (t)(b) ? (t)(a) : (t)(b))
+
+#define EXPORT_SYMBOL(x)
+#define MODULE_PARM_DESC(x, y)
+#define module_param(n, t, p)
+#define module_param_array(n, t, c, p)
+
+#define cpu_to_le32(x)	((u32)(x))
+#define le32_to_cpu(x)	((u32)(x))
+#define cpu_to_le64(x)	((u64)(x))
+#define le64_to_cpu(x)	((u64)(x))
+#define cpu_to_le32_array(a, n)	((void)(a), (void)(n))
+#define le32_to_cpu_array(a, n)	((void)(a), (void)(n))
+
+static inline u32 get_unaligned_le32(const void *p)
+{
+	u32 v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline u64 get_unaligned_le64(const void *p)
+{
+	u64 v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline void put_unaligned_le32(u32 v, void *p)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+static inline void put_unaligned_le64(u64 v, void *p)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+static inline u32 rol32(u32 w, unsigned int s)
+{
+	return (w << (s & 31)) | (w >> ((-s) & 31));
+}
+
+static inline u32 ror32(u32 w, unsigned int s)
+{
+	return (w >> (s & 31)) | (w << ((-s) & 31));
+}
+
+static inline void memzero_explicit(void *s, size_t n)
+{
+	memset(s, 0, n);
+	__asm__ __volatile__("" : : "r"(s) : "memory");
+}
+
+static inline void crypto_xor(u8 *dst, const u8 *src, unsigned int n)
+{
+	while (n--)
+		*dst++ ^= *src++;
+}
+
+static inline void crypto_xor_cpy(u8 *dst, const u8 *a, const u8 *b,
+				  unsigned int n)
+{
+	while (n--)
+		*dst++ = *a++ ^ *b++;
+}
+
+static inline int crypto_memneq(const void *a, const void *b, size_t n)
+{
+	const u8 *x = a, *y = b;
+	u8 d = 0;
+
+	while (n--)
+		d |= *x++ ^ *y++;
+	return d != 0;
+}
+
+static inline void get_random_bytes(void *p, size_t n)
+{
+	u8 *b = p;
+
+	while (n--)
+		*b++ = (u8)random();
+}
+#define get_random_bytes_wait(p, n)	get_random_bytes(p, n)
+
+static inline u64 ktime_get_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Userspace is always allowed to touch the vector registers. */
+struct simd_context {
+	bool usable;
+};
+typedef struct simd_context simd_context_t;
+
+#define simd_get(ctx)	((ctx)->usable = true)
+#define simd_put(ctx)	((ctx)->usable = false)
+#define simd_relax(ctx)	((void)(ctx))
+#define simd_use(ctx)	((ctx)->usable)
+#define DONT_USE_SIMD	(&(simd_context_t){ .usable = false })
+
+/* zinc/blake2s.h leaves this commented out, as the kernel module links the
+ * FreeBSD blake2s.c whose blake2s_final also takes the output length.
+ */
+struct blake2s_state;
+void blake2s_final(struct blake2s_state *state, u8 *out);
+
+/* A flat scatterlist, enough for the sg self-tests of the AEAD. */
+struct scatterlist {
+	u8 *buf;
+	unsigned int length;
+	bool last;
+};
+
+struct sg_mapping_iter {
+	void *addr;
+	size_t length;
+	struct scatterlist *sg;
+	unsigned int nents;
+};
+
+#define SG_MITER_TO_SG	0
+#define SG_MITER_ATOMIC	0
+
+static inline void sg_init_table(struct scatterlist *sg, unsigned int n)
+{
+	memset(sg, 0, sizeof(*sg) * n);
+	sg[n - 1].last = true;
+}
+
+static inline void sg_set_buf(struct scatterlist *sg, const void *buf,
+			      unsigned int length)
+{
+	sg->buf = (u8 *)buf;
+	sg->length = length;
+}
+
+static inline void sg_init_one(struct scatterlist *sg, const void *buf,
+			       unsigned int length)
+{
+	sg_init_table(sg, 1);
+	sg_set_buf(sg, buf, length);
+}
+
+static inline int sg_nents(struct scatterlist *sg)
+{
+	int n = 1;
+
+	while (!sg++->last)
+		++n;
+	return n;
+}
+
+static inline void sg_miter_start(struct sg_mapping_iter *miter,
+				  struct scatterlist *sg, unsigned int nents,
+				  unsigned int flags)
+{
+	(void)flags;
+	miter->sg = sg;
+	miter->nents = nents;
+}
+
+static inline bool sg_miter_next(struct sg_mapping_iter *miter)
+{
+	while (miter->nents && !miter->sg->length) {
+		++miter->sg;
+		--miter->nents;
+	}
+	if (!miter->nents)
+		return false;
+	miter->addr = miter->sg->buf;
+	miter->length = miter->sg->length;
+	++miter->sg;
+	--miter->nents;
+	return true;
+}
+
+#define sg_miter_stop(miter)	((void)(miter))
+
+static inline void scatterwalk_map_and_copy(void *buf, struct scatterlist *sg,
+					    unsigned int start,
+					    unsigned int nbytes, int out)
+{
+	u8 *b = buf;
+
+	for (;; ++sg) {
+		if (start < sg->length) {
+			unsigned int n = min(sg->length - start, nbytes);
+
+			if (out)
+				memcpy(sg->buf + start, b, n);
+			else
+				memcpy(b, sg->buf + start, n);
+			b += n;
+			nbytes -= n;
+			start = 0;
+		} else {
+			start -= sg->length;
+		}
+		if (!nbytes || sg->last)
+			break;
+	}
+}
+
+enum {
+	X86_FEATURE_SSSE3,
+	X86_FEATURE_AVX,
+	X86_FEATURE_AVX2,
+	X86_FEATURE_AVX512F,
+	X86_FEATURE_AVX512VL,
+	X86_FEATURE_AVX512BW,
+	X86_FEATURE_BMI2,
+	X86_FEATURE_ADX
+};
+
+static inline bool boot_cpu_has(int feature)
+{
+	__builtin_cpu_init();
+	switch (feature) {
+	case X86_FEATURE_SSSE3: return __builtin_cpu_supports("ssse3");
+	case X86_FEATURE_AVX: return __builtin_cpu_supports("avx");
+	case X86_FEATURE_AVX2: return __builtin_cpu_supports("avx2");
+	case X86_FEATURE_AVX512F: return __builtin_cpu_supports("avx512f");
+	case X86_FEATURE_AVX512VL: return __builtin_cpu_supports("avx512vl");
+	case X86_FEATURE_AVX512BW: return __builtin_cpu_supports("avx512bw");
+	case X86_FEATURE_BMI2: return __builtin_cpu_supports("bmi2");
+	case X86_FEATURE_ADX: {
+		unsigned int a, b, c, d;
+
+		return __get_cpuid_count(7, 0, &a, &b, &c, &d) &&
+		       (b & bit_ADX);
+	}
+	}
+	return false;
+}
+
+#define XFEATURE_MASK_SSE	(1ULL << 1)
+#define XFEATURE_MASK_YMM	(1ULL << 2)
+#define XFEATURE_MASK_AVX512	(7ULL << 5)
+
+static inline bool cpu_has_xfeatures(u64 mask, const char **name)
+{
+	u32 lo, hi;
+
+	(void)name;
+	if (!__builtin_cpu_supports("avx"))
+		return false;
+	__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (((u64)hi << 32 | lo) & mask) == mask;
+}
+
+/* Only consulted to avoid zmm on Skylake-X, so never match. */
+#define INTEL_FAM6_SKYLAKE_X	(-1)
+static const struct {
+	int x86_model;
+} boot_cpu_data = { 0 };
+
+#endif
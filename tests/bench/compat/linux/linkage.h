@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+
+#ifndef _BENCH_LINUX_LINKAGE_H
+#define _BENCH_LINUX_LINKAGE_H
+
+#define SYM_FUNC_START(name)	\
+	.globl name;		\
+	.type name, @function;	\
+	.p2align 4;		\
+	name:
+#define SYM_FUNC_END(name)	\
+	.size name, . - name
+
+#endif
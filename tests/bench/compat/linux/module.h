@@ -0,0 +1 @@
+/* Provided by compat.h. */
@@ -0,0 +1,208 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * MAC1 through module/if_wg_cookie.c and module/if_wg_noise.c, built
+ * unmodified, with the softc plumbing of kern/session.c. The responder's
+ * private key is installed as wg_cloneattach installs it and taken up by
+ * wg_cookie_checker_attach, as at attach. An initiation from a peer set up
+ * as wg_peer_create sets one up must then pass wg_cookie_check_mac1, match
+ * a MAC1 computed here from the public key alone, and be consumed. Packets
+ * with a flipped bit must not pass, nor, once the key is replaced, packets
+ * MACed for the old one.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/malloc.h>
+#include <sys/refcount.h>
+#include <sys/mbuf.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_cookie.h>
+#include <sys/wg_module.h>
+
+#include <crypto/blake2s.h>
+#include <crypto/curve25519.h>
+
+struct cookie_test_end {
+	struct wg_softc		 e_sc;
+	struct wg_peer		 e_peer;
+};
+
+static struct wg_endpoint cookie_test_endpoint;
+static int cookie_test_failed;
+
+/* Provided by the zinc objects. */
+int chacha20_mod_init(void);
+int poly1305_mod_init(void);
+int chacha20poly1305_mod_init(void);
+
+/* Mirrored in kern/session.c. */
+void	wg_hashtable_peer_insert(struct wg_hashtable *, struct wg_peer *);
+
+#define cookie_test_check(name, exp) do {				\
+	if (!(exp)) {							\
+		fprintf(stderr, "cookie-test: %s: %s\n", (name), #exp);	\
+		cookie_test_failed++;					\
+	}								\
+} while (0)
+
+/* The if_wg_session.c functions only the cookie replies call. */
+struct wg_endpoint *
+wg_mbuf_endpoint_get(struct mbuf *m)
+{
+	return (&cookie_test_endpoint);
+}
+
+int
+wg_ratelimiter_allow(struct wg_ratelimiter *ratelimiter, struct mbuf *m)
+{
+	return (0);
+}
+
+/* As wg_cloneattach and then wg_attach_post. */
+static void
+cookie_test_attach(struct wg_softc *sc, const uint8_t key[WG_KEY_SIZE])
+{
+	wg_hashtable_init(&sc->sc_hashtable);
+	memcpy(sc->sc_local.l_private, key, WG_KEY_SIZE);
+	wg_cookie_checker_attach(sc);
+}
+
+/* As wg_peer_create, for the peer with the given public key. */
+static void
+cookie_test_peer(struct wg_peer *peer, struct wg_softc *sc,
+    const uint8_t public[WG_KEY_SIZE])
+{
+	uint8_t key[WG_KEY_SIZE];
+
+	memcpy(key, public, sizeof(key));
+	refcount_init(&peer->p_refcnt, 1);
+	peer->p_sc = sc;
+	noise_remote_init(&peer->p_remote, key);
+	noise_keypairs_init(&peer->p_keypairs);
+	wg_cookie_init(&peer->p_cookie);
+	wg_cookie_precompute_peer_keys(peer);
+	wg_hashtable_peer_insert(&sc->sc_hashtable, peer);
+}
+
+/* MAC1 from the responder's public key, per the protocol. */
+static void
+cookie_test_mac1(uint8_t mac1[WG_COOKIE_SIZE], const void *msg, size_t len,
+    const uint8_t public[WG_KEY_SIZE])
+{
+	struct blake2s_state state;
+	uint8_t key[WG_KEY_SIZE];
+
+	blake2s_init(&state, WG_KEY_SIZE);
+	blake2s_update(&state, (const uint8_t *)"mac1----", 8);
+	blake2s_update(&state, public, WG_KEY_SIZE);
+	blake2s_final(&state, key, WG_KEY_SIZE);
+	blake2s(mac1, msg, key, WG_COOKIE_SIZE,
+	    len - sizeof(struct wg_pkt_macs), WG_KEY_SIZE);
+}
+
+static bool
+cookie_test_check_mac1(struct wg_softc *sc, const void *msg, size_t len)
+{
+	struct mbuf *m;
+	bool valid;
+
+	m = m_gethdr(M_WAITOK, MT_DATA);
+	memcpy(mtod(m, void *), msg, len);
+	m->m_len = m->m_pkthdr.len = len;
+	valid = wg_cookie_check_mac1(&sc->sc_cookie_checker, m);
+	m_freem(m);
+	return (valid);
+}
+
+/* An initiation from i, MACed as wg_peer_send_handshake_initiation does. */
+static void
+cookie_test_initiation(struct wg_pkt_initiation *init,
+    struct cookie_test_end *i)
+{
+	bzero(init, sizeof(*init));
+	cookie_test_check("create",
+	    noise_handshake_create_initiation(init, &i->e_peer) == 0);
+	wg_cookie_add_mac_to_packet(&i->e_peer.p_cookie, init, sizeof(*init));
+}
+
+int
+main(void)
+{
+	static struct cookie_test_end i, r;
+	uint8_t ikey[WG_KEY_SIZE], rkey[WG_KEY_SIZE], public[WG_KEY_SIZE];
+	uint8_t mac1[WG_COOKIE_SIZE];
+	struct wg_pkt_initiation init, old;
+	struct noise_keypair *keypair;
+
+	if (chacha20_mod_init() || poly1305_mod_init() ||
+	    chacha20poly1305_mod_init()) {
+		fprintf(stderr, "cookie-test: chacha20poly1305 self-tests "
+		    "failed\n");
+		return (1);
+	}
+	wg_noise_param_init();
+	wg_keypair_zone = uma_zcreate("wg keypair",
+	    sizeof(struct noise_keypair), NULL, NULL, NULL, NULL,
+	    UMA_ALIGN_CACHE, 0);
+
+	/* Unclamped, as a key can come in through the nvlist. */
+	arc4random_buf(ikey, sizeof(ikey));
+	arc4random_buf(rkey, sizeof(rkey));
+	cookie_test_attach(&i.e_sc, ikey);
+	cookie_test_attach(&r.e_sc, rkey);
+	curve25519_generate_public(public, rkey);
+	cookie_test_check("attach", r.e_sc.sc_local.l_has_identity);
+	cookie_test_check("attach", memcmp(r.e_sc.sc_local.l_public, public,
+	    WG_KEY_SIZE) == 0);
+
+	cookie_test_peer(&i.e_peer, &i.e_sc, r.e_sc.sc_local.l_public);
+	cookie_test_peer(&r.e_peer, &r.e_sc, i.e_sc.sc_local.l_public);
+
+	cookie_test_initiation(&init, &i);
+	cookie_test_mac1(mac1, &init, sizeof(init), public);
+	cookie_test_check("initiation", memcmp(init.macs.mac1, mac1,
+	    WG_COOKIE_SIZE) == 0);
+	cookie_test_check("initiation", cookie_test_check_mac1(&r.e_sc, &init,
+	    sizeof(init)));
+	keypair = noise_handshake_consume_initiation(&init, &r.e_sc);
+	cookie_test_check("initiation", keypair != NULL);
+	if (keypair != NULL)
+		noise_keypair_put(keypair);
+
+	old = init;
+	old.unencrypted_ephemeral[0] ^= 1;
+	cookie_test_check("flipped", !cookie_test_check_mac1(&r.e_sc, &old,
+	    sizeof(old)));
+	old = init;
+	old.macs.mac1[WG_COOKIE_SIZE - 1] ^= 0x80;
+	cookie_test_check("flipped", !cookie_test_check_mac1(&r.e_sc, &old,
+	    sizeof(old)));
+
+	/* A new key, as WG_DEVICE_HAS_PRIVKEY installs one. */
+	old = init;
+	arc4random_buf(rkey, sizeof(rkey));
+	wg_cookie_checker_set_private(&r.e_sc, rkey);
+	curve25519_generate_public(public, rkey);
+	cookie_test_check("rekeyed", memcmp(r.e_sc.sc_local.l_public, public,
+	    WG_KEY_SIZE) == 0);
+	cookie_test_check("rekeyed", !cookie_test_check_mac1(&r.e_sc, &old,
+	    sizeof(old)));
+	memcpy(i.e_peer.p_remote.r_public, public, WG_KEY_SIZE);
+	wg_cookie_precompute_peer_keys(&i.e_peer);
+	cookie_test_initiation(&init, &i);
+	cookie_test_check("rekeyed", cookie_test_check_mac1(&r.e_sc, &init,
+	    sizeof(init)));
+
+	if (cookie_test_failed != 0)
+		return (1);
+	printf("cookie-test: ok\n");
+	return (0);
+}
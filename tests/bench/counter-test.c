@@ -0,0 +1,270 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * The replay window of module/if_wg_counter.c, built unmodified. Streams of
+ * nonces, reordered, repeated and skipping ahead, go through
+ * wg_counter_stale and wg_counter_validate and are checked against a plain
+ * model of the window: a nonce is accepted once, if it is under
+ * REJECT_AFTER_MESSAGES and no more than COUNTER_WINDOW_SIZE behind c_recv,
+ * which moves up to a nonce that starts a new word of c_backtrack. Whatever
+ * wg_counter_stale calls stale must be refused, and with nothing running
+ * alongside, it must call stale exactly what is refused. The edges of the
+ * window, of the words of c_backtrack and of its wrap are checked one by
+ * one, and the streams run both from 0 and up against
+ * REJECT_AFTER_MESSAGES.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/wg_module.h>
+
+#define COUNTER_TEST_RANGE	(1 << 24)
+#define COUNTER_TEST_STREAM	200000
+
+/* The window as the model keeps it, from start on. */
+struct counter_test_model {
+	uint64_t		 m_start;
+	uint64_t		 m_recv;
+	uint8_t			*m_seen;
+};
+
+static uint64_t counter_test_rng = 0x9e3779b97f4a7c15ull;
+static int counter_test_failed;
+
+#define counter_test_check(name, exp) do {				\
+	if (!(exp)) {							\
+		fprintf(stderr, "counter-test: %s: %s\n", (name), #exp);\
+		counter_test_failed++;					\
+	}								\
+} while (0)
+
+static uint64_t
+counter_test_random(void)
+{
+	counter_test_rng ^= counter_test_rng << 13;
+	counter_test_rng ^= counter_test_rng >> 7;
+	counter_test_rng ^= counter_test_rng << 17;
+	return (counter_test_rng);
+}
+
+static void
+counter_test_model_init(struct counter_test_model *m, uint64_t start)
+{
+	m->m_start = start;
+	m->m_recv = 0;
+	m->m_seen = calloc(COUNTER_TEST_RANGE, 1);
+}
+
+static bool
+counter_test_model_validate(struct counter_test_model *m, uint64_t n)
+{
+	if (n >= REJECT_AFTER_MESSAGES || n + COUNTER_WINDOW_SIZE < m->m_recv)
+		return (false);
+	if (m->m_seen[n - m->m_start])
+		return (false);
+	m->m_seen[n - m->m_start] = 1;
+	if (n / COUNTER_TYPE_BITS > m->m_recv / COUNTER_TYPE_BITS)
+		m->m_recv = n;
+	return (true);
+}
+
+/* One nonce through both, checked against the model. */
+static bool
+counter_test_one(const char *name, struct wg_counter *ctr,
+    struct counter_test_model *m, uint64_t n)
+{
+	bool stale, valid, expect;
+
+	stale = wg_counter_stale(ctr, n);
+	valid = wg_counter_validate(ctr, n) == 0;
+	expect = counter_test_model_validate(m, n);
+	counter_test_check(name, !(stale && valid));
+	counter_test_check(name, stale == !valid);
+	counter_test_check(name, valid == expect);
+	counter_test_check(name, ctr->c_recv == m->m_recv);
+	return (valid);
+}
+
+/*
+ * A sender's nonces as the receiver sees them: mostly in order, some held
+ * back by up to a little more than the window, some sent twice, and now
+ * and then a run of them lost.
+ */
+static u_int
+counter_test_stream(const char *name, uint64_t start)
+{
+	struct counter_test_model m;
+	struct wg_counter ctr;
+	uint64_t next, n, r;
+	u_int accepted = 0;
+	int i;
+
+	wg_counter_init(&ctr);
+	counter_test_model_init(&m, start);
+	next = start + COUNTER_WINDOW_SIZE + 64;
+	for (i = 0; i < COUNTER_TEST_STREAM; i++) {
+		r = counter_test_random();
+		switch (r % 256) {
+		case 0 ... 15:
+			n = next - (r >> 8) % (COUNTER_WINDOW_SIZE + 64);
+			break;
+		case 16 ... 31:
+			n = next - (r >> 8) % 64;
+			break;
+		case 32:
+			next += (r >> 8) % (3 * COUNTER_WINDOW_SIZE);
+			/* FALLTHROUGH */
+		default:
+			n = next++;
+			break;
+		}
+		if (next - start >= COUNTER_TEST_RANGE)
+			break;
+		if (counter_test_one(name, &ctr, &m, n))
+			accepted++;
+	}
+	(free)(m.m_seen);
+	mtx_destroy(&ctr.c_mtx);
+	return (accepted);
+}
+
+/* The edges, from a window whose c_recv starts a word at base. */
+static void
+counter_test_edges(const char *name, uint64_t base)
+{
+	struct counter_test_model m;
+	struct wg_counter ctr;
+	uint64_t n;
+	int i;
+
+	wg_counter_init(&ctr);
+	counter_test_model_init(&m, base - COUNTER_WINDOW_SIZE - 64);
+	counter_test_one(name, &ctr, &m, base);
+	counter_test_check(name, ctr.c_recv == base);
+
+	/* The far end of the window is in; one further back is not. */
+	counter_test_check(name,
+	    counter_test_one(name, &ctr, &m, base - COUNTER_WINDOW_SIZE));
+	counter_test_check(name,
+	    !counter_test_one(name, &ctr, &m, base - COUNTER_WINDOW_SIZE - 1));
+	counter_test_check(name,
+	    !counter_test_one(name, &ctr, &m, base - COUNTER_WINDOW_SIZE));
+
+	/* Either end of a word, and the words either side of it. */
+	for (i = -1; i <= 1; i++) {
+		n = base + i * COUNTER_TYPE_BITS;
+		counter_test_one(name, &ctr, &m, n - 1);
+		counter_test_one(name, &ctr, &m, n + COUNTER_TYPE_BITS - 1);
+		counter_test_check(name,
+		    !counter_test_one(name, &ctr, &m, n - 1));
+		counter_test_check(name, !counter_test_one(name, &ctr, &m,
+		    n + COUNTER_TYPE_BITS - 1));
+	}
+
+	/*
+	 * Nonces later in the word of c_recv leave it where it is, so the
+	 * window is still measured from there.
+	 */
+	n = (ctr.c_recv / COUNTER_TYPE_BITS + 1) * COUNTER_TYPE_BITS;
+	counter_test_one(name, &ctr, &m, n);
+	counter_test_one(name, &ctr, &m, n + COUNTER_TYPE_BITS - 1);
+	counter_test_check(name, ctr.c_recv == n);
+	counter_test_check(name,
+	    counter_test_one(name, &ctr, &m, n - COUNTER_WINDOW_SIZE));
+
+	/*
+	 * A word at a time, round the whole of c_backtrack and on, each word
+	 * clearing the slot it takes over: what it held falls behind the
+	 * window, and the new word's nonces are all accepted once.
+	 */
+	for (i = 0; i < 2 * COUNTER_TYPE_NUM; i++) {
+		n = (ctr.c_recv / COUNTER_TYPE_BITS + 1) * COUNTER_TYPE_BITS;
+		counter_test_check(name, counter_test_one(name, &ctr, &m,
+		    n + COUNTER_TYPE_BITS - 1));
+		counter_test_check(name, counter_test_one(name, &ctr, &m, n));
+		counter_test_check(name,
+		    !counter_test_one(name, &ctr, &m, n));
+		counter_test_check(name, !counter_test_one(name, &ctr, &m,
+		    n - COUNTER_TYPE_NUM * COUNTER_TYPE_BITS));
+	}
+
+	/* Exactly as far ahead as c_backtrack reaches, then further. */
+	n = ctr.c_recv;
+	counter_test_one(name, &ctr, &m,
+	    n + COUNTER_TYPE_NUM * COUNTER_TYPE_BITS);
+	counter_test_one(name, &ctr, &m,
+	    n + COUNTER_TYPE_NUM * COUNTER_TYPE_BITS - 1);
+	counter_test_one(name, &ctr, &m,
+	    n + 3 * COUNTER_TYPE_NUM * COUNTER_TYPE_BITS + 5);
+	counter_test_one(name, &ctr, &m,
+	    n + 2 * COUNTER_TYPE_NUM * COUNTER_TYPE_BITS + 5);
+
+	(free)(m.m_seen);
+	mtx_destroy(&ctr.c_mtx);
+}
+
+/* The last nonces there are, and none after them. */
+static void
+counter_test_reject(const char *name)
+{
+	struct counter_test_model m;
+	struct wg_counter ctr;
+	uint64_t last = REJECT_AFTER_MESSAGES - 1;
+
+	wg_counter_init(&ctr);
+	counter_test_model_init(&m, last - COUNTER_WINDOW_SIZE - 64);
+	counter_test_check(name, counter_test_one(name, &ctr, &m, last - 1));
+	counter_test_check(name, counter_test_one(name, &ctr, &m, last));
+	counter_test_check(name,
+	    !counter_test_one(name, &ctr, &m, last + 1));
+	counter_test_check(name,
+	    !counter_test_one(name, &ctr, &m, UINT64_MAX));
+	counter_test_check(name,
+	    counter_test_one(name, &ctr, &m, last - COUNTER_WINDOW_SIZE + 1));
+	(free)(m.m_seen);
+	mtx_destroy(&ctr.c_mtx);
+}
+
+/* Nonces are handed out in order, from 0, one or several at a time. */
+static void
+counter_test_next(const char *name)
+{
+	struct wg_counter ctr;
+	uint64_t i;
+
+	wg_counter_init(&ctr);
+	for (i = 0; i < 1000; i++)
+		counter_test_check(name, wg_counter_next(&ctr, 1) == i);
+	for (i = 1; i < 100; i++)
+		counter_test_check(name,
+		    wg_counter_next(&ctr, i) == 1000 + i * (i - 1) / 2);
+	mtx_destroy(&ctr.c_mtx);
+}
+
+int
+main(void)
+{
+	counter_test_next("next");
+	counter_test_edges("edges", 10 * COUNTER_WINDOW_SIZE);
+	counter_test_edges("edges far", REJECT_AFTER_MESSAGES -
+	    (REJECT_AFTER_MESSAGES % COUNTER_TYPE_BITS) -
+	    8 * COUNTER_TYPE_NUM * COUNTER_TYPE_BITS);
+	counter_test_reject("reject");
+	counter_test_check("stream",
+	    counter_test_stream("stream", 0) > COUNTER_TEST_STREAM / 2);
+	/* Runs out of nonces half way. */
+	counter_test_stream("stream far", REJECT_AFTER_MESSAGES -
+	    COUNTER_TEST_RANGE / 2);
+
+	if (counter_test_failed != 0)
+		return (1);
+	printf("counter-test: ok\n");
+	return (0);
+}
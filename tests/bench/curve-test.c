@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Public key generation in module/curve25519.c: the fixed-base comb of
+ * module/curve25519-comb.c against the RFC 7748 test vectors, and against
+ * the Montgomery ladder on the base point for random secrets and the
+ * smallest and largest a clamped one can be. Batched scalar multiplication
+ * against the ladder one at a time, for every size of batch, with points of
+ * low order among random ones: those have to come out as zero and leave the
+ * rest of their batch alone.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+
+#include <crypto/curve25519.h>
+
+#define CURVE_TEST_CHECKS	4096
+#define CURVE_TEST_BATCHES	64
+
+static const u8 curve_test_basepoint[CURVE25519_KEY_SIZE] = { 9 };
+
+/* Points that every clamped scalar, a multiple of 8, takes to zero. */
+static const u8 curve_test_low_order[][CURVE25519_KEY_SIZE] = {
+	{ 0 },
+	/* Of order 8. */
+	{ 0xe0, 0xeb, 0x7a, 0x7c, 0x3b, 0x41, 0xb8, 0xae,
+	  0x16, 0x56, 0xe3, 0xfa, 0xf1, 0x9f, 0xc4, 0x6a,
+	  0xda, 0x09, 0x8d, 0xeb, 0x9c, 0x32, 0xb1, 0xfd,
+	  0x86, 0x62, 0x05, 0x16, 0x5f, 0x49, 0xb8, 0x00 },
+};
+
+/* RFC 7748, section 6.1. */
+static const struct {
+	u8	secret[CURVE25519_KEY_SIZE];
+	u8	public[CURVE25519_KEY_SIZE];
+} curve_test_vectors[] = {
+	{
+		{ 0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d,
+		  0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+		  0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a,
+		  0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a },
+		{ 0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54,
+		  0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+		  0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4,
+		  0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a },
+	},
+	{
+		{ 0x5d, 0xab, 0x08, 0x7e, 0x62, 0x4a, 0x8a, 0x4b,
+		  0x79, 0xe1, 0x7f, 0x8b, 0x83, 0x80, 0x0e, 0xe6,
+		  0x6f, 0x3b, 0xb1, 0x29, 0x26, 0x18, 0xb6, 0xfd,
+		  0x1c, 0x2f, 0x8b, 0x27, 0xff, 0x88, 0xe0, 0xeb },
+		{ 0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4,
+		  0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+		  0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d,
+		  0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f },
+	},
+};
+
+static int
+curve_test_batch(void)
+{
+	u8 scalars[CURVE25519_BATCH_MAX][CURVE25519_KEY_SIZE];
+	u8 points[CURVE25519_BATCH_MAX][CURVE25519_KEY_SIZE];
+	u8 outs[CURVE25519_BATCH_MAX][CURVE25519_KEY_SIZE];
+	u8 single[CURVE25519_KEY_SIZE];
+	const u8 *scalar[CURVE25519_BATCH_MAX], *point[CURVE25519_BATCH_MAX];
+	u8 *out[CURVE25519_BATCH_MAX];
+	static const u8 zero[CURVE25519_KEY_SIZE];
+	int failed = 0, i, low, n, round;
+
+	for (i = 0; i < CURVE25519_BATCH_MAX; ++i) {
+		scalar[i] = scalars[i];
+		point[i] = points[i];
+		out[i] = outs[i];
+	}
+
+	for (n = 1; n <= CURVE25519_BATCH_MAX; ++n) {
+		for (round = 0; round < CURVE_TEST_BATCHES; ++round) {
+			arc4random_buf(scalars, sizeof(scalars));
+			arc4random_buf(points, sizeof(points));
+			for (i = 0; i < n; ++i)
+				curve25519_clamp_secret(scalars[i]);
+			/* Every other round has a point of low order in it. */
+			low = round % 2 == 0 ? -1 : (int)arc4random_uniform(n);
+			if (low >= 0)
+				memcpy(points[low], curve_test_low_order[round /
+				    2 % nitems(curve_test_low_order)],
+				    CURVE25519_KEY_SIZE);
+
+			curve25519_generic_batch(out, scalar, point, n);
+			for (i = 0; i < n; ++i) {
+				curve25519_generic(single, scalars[i],
+				    points[i]);
+				if (memcmp(outs[i], single, sizeof(single)) != 0 ||
+				    (i == low &&
+				    memcmp(outs[i], zero, sizeof(zero)) != 0)) {
+					fprintf(stderr, "curve-test: batch of "
+					    "%d disagrees with the ladder on "
+					    "%d in round %d\n", n, i, round);
+					failed++;
+				}
+			}
+		}
+	}
+	return (failed);
+}
+
+int
+main(void)
+{
+	u8 secret[CURVE25519_KEY_SIZE];
+	u8 ladder[CURVE25519_KEY_SIZE], comb[CURVE25519_KEY_SIZE];
+	unsigned int i;
+	int failed = 0;
+
+	for (i = 0; i < nitems(curve_test_vectors); ++i) {
+		curve25519_generic_base(comb, curve_test_vectors[i].secret);
+		if (memcmp(comb, curve_test_vectors[i].public,
+		    sizeof(comb)) != 0) {
+			fprintf(stderr, "curve-test: vector %u\n", i);
+			failed++;
+		}
+	}
+
+	for (i = 0; i < CURVE_TEST_CHECKS; ++i) {
+		if (i == 0)
+			memset(secret, 0, sizeof(secret));
+		else if (i == 1)
+			memset(secret, 0xff, sizeof(secret));
+		else
+			arc4random_buf(secret, sizeof(secret));
+		curve25519_clamp_secret(secret);
+		curve25519_generic(ladder, secret, curve_test_basepoint);
+		curve25519_generic_base(comb, secret);
+		if (memcmp(ladder, comb, sizeof(ladder)) != 0) {
+			fprintf(stderr, "curve-test: comb and ladder disagree "
+			    "on secret %u\n", i);
+			failed++;
+		}
+	}
+
+	failed += curve_test_batch();
+
+	if (failed != 0)
+		return (1);
+	printf("curve-test: ok\n");
+	return (0);
+}
@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * The queue limits of module/if_wg_dql.c, built unmodified, on a clock the
+ * test moves by hand. A queue served at a steady rate without running empty
+ * must have its rate averaged in a quarter at a time, interval by interval,
+ * and its limit follow as that many milliseconds of work, within the
+ * bounds. An interval in which the queue ran empty, or that went without a
+ * report for over twice its length, may raise the rate but never lower it.
+ * The longest the queue got is kept for each interval, and all of this
+ * holds across the wrap of ticks.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+
+#include <sys/if_wg_dql.h>
+
+#define DQL_TEST_HZ		1000
+#define DQL_TEST_INTERVAL	(DQL_TEST_HZ * WG_DQL_INTERVAL_MS / 1000)
+#define DQL_TEST_MIN		128
+#define DQL_TEST_MAX		16384
+#define DQL_TEST_DELAY		5
+
+volatile int ticks;
+int hz = DQL_TEST_HZ;
+
+static int dql_test_failed;
+
+#define dql_test_check(name, exp) do {					\
+	if (!(exp)) {							\
+		fprintf(stderr, "dql-test: %s: %s\n", (name), #exp);	\
+		dql_test_failed++;					\
+	}								\
+} while (0)
+
+/* Moves the clock on, wrapping as the kernel's does. */
+static void
+dql_test_tick(u_int n)
+{
+	ticks = (int)((u_int)ticks + n);
+}
+
+/* The limit a rate stands for. */
+static u_int
+dql_test_limit(uint64_t rate)
+{
+	uint64_t limit = rate * DQL_TEST_DELAY / 1000;
+
+	return (MAX(DQL_TEST_MIN, MIN(limit, DQL_TEST_MAX)));
+}
+
+/*
+ * One interval of the consumer taking n packets a tick, leaving len behind
+ * each time, and then empty on the last tick if drain is set. Returns the
+ * rate the interval showed, in packets a second.
+ */
+static uint64_t
+dql_test_interval(struct wg_dql *d, u_int n, u_int len, bool drain)
+{
+	int i;
+
+	for (i = 1; i <= DQL_TEST_INTERVAL; i++) {
+		dql_test_tick(1);
+		wg_dql_served(d, n, drain && i == DQL_TEST_INTERVAL ? 0 : len);
+	}
+	return ((uint64_t)n * DQL_TEST_HZ);
+}
+
+/* Busy intervals at n a tick, checked one by one against the average. */
+static void
+dql_test_busy(const char *name, struct wg_dql *d, u_int n, int intervals)
+{
+	uint64_t rate, expect;
+
+	while (intervals-- > 0) {
+		expect = d->d_rate;
+		rate = dql_test_interval(d, n, 64, false);
+		expect -= expect >> WG_DQL_RATE_WEIGHT;
+		expect += rate >> WG_DQL_RATE_WEIGHT;
+		dql_test_check(name, d->d_rate == expect);
+		dql_test_check(name, wg_dql_limit(d) ==
+		    dql_test_limit(d->d_rate));
+	}
+}
+
+static void
+dql_test_run(const char *name, int start)
+{
+	struct wg_dql d;
+	u_int limit, rate;
+
+	ticks = start;
+	wg_dql_init(&d, 1024, DQL_TEST_MIN, DQL_TEST_MAX, DQL_TEST_DELAY);
+	dql_test_check(name, wg_dql_limit(&d) == 1024);
+	dql_test_check(name, d.d_rate == 1024 * 1000 / DQL_TEST_DELAY);
+
+	/* Nothing is folded in before the interval is over. */
+	dql_test_tick(DQL_TEST_INTERVAL - 1);
+	wg_dql_served(&d, 1, 1);
+	dql_test_check(name, d.d_served == 1);
+	dql_test_check(name, d.d_rate == 1024 * 1000 / DQL_TEST_DELAY);
+	dql_test_tick(1);
+	wg_dql_served(&d, 1, 1);
+	dql_test_check(name, d.d_served == 0);
+	dql_test_check(name, d.d_start == (u_int)ticks);
+
+	/* A slower consumer brings the limit down to its rate. */
+	dql_test_busy(name, &d, 50, 80);
+	dql_test_check(name, wg_dql_limit(&d) == dql_test_limit(50000));
+
+	/* A faster one brings it up. */
+	dql_test_busy(name, &d, 400, 80);
+	dql_test_check(name, wg_dql_limit(&d) == dql_test_limit(400000));
+
+	/* Intervals that ran empty do not lower it... */
+	limit = wg_dql_limit(&d);
+	rate = d.d_rate;
+	dql_test_interval(&d, 10, 1, true);
+	dql_test_check(name, d.d_rate == rate);
+	dql_test_check(name, wg_dql_limit(&d) == limit);
+	dql_test_interval(&d, 10, 0, false);
+	dql_test_check(name, d.d_rate == rate);
+
+	/* ...but raise it to their rate at once. */
+	dql_test_interval(&d, 1000, 1, true);
+	dql_test_check(name, d.d_rate == 1000 * DQL_TEST_HZ);
+	dql_test_check(name, wg_dql_limit(&d) == dql_test_limit(1000000));
+
+	/* An interval gone quiet for a while counts as run empty. */
+	rate = d.d_rate;
+	dql_test_tick(3 * DQL_TEST_INTERVAL);
+	wg_dql_served(&d, 1, 1);
+	dql_test_check(name, d.d_rate == rate);
+
+	/* The bounds hold. */
+	dql_test_busy(name, &d, 10000, 40);
+	dql_test_check(name, wg_dql_limit(&d) == DQL_TEST_MAX);
+	dql_test_busy(name, &d, 1, 60);
+	dql_test_check(name, wg_dql_limit(&d) == DQL_TEST_MIN);
+
+	/* The high-water mark is kept per interval. */
+	wg_dql_queued(&d, 700);
+	wg_dql_queued(&d, 300);
+	dql_test_interval(&d, 1, 1, false);
+	dql_test_check(name, d.d_watermark == 700);
+	dql_test_check(name, d.d_high == 0);
+	dql_test_interval(&d, 1, 1, false);
+	dql_test_check(name, d.d_watermark == 0);
+}
+
+int
+main(void)
+{
+	dql_test_run("dql", 0);
+	dql_test_run("dql wrap", INT_MAX - 5000);
+
+	if (dql_test_failed != 0)
+		return (1);
+	printf("dql-test: ok\n");
+	return (0);
+}
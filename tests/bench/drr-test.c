@@ -0,0 +1,594 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Staging and the encrypt queue's deficit round-robin, module/if_wg_drr.c,
+ * built unmodified with CoDel, the queue limits, the nonce counter, the
+ * packet tags and the keypairs of the module. wg_pktq_enqueue stands in for
+ * the encrypt workers and records what it is handed; the test completes the
+ * encryptions itself, through wg_softc_encrypt_done, and runs the encrypt
+ * task's wg_softc_drr_run when it is kicked.
+ *
+ * Peers in line share the encrypt path by bytes, each turn worth
+ * WG_DRR_QUANTUM: the order of a handful of packets is worked out by hand,
+ * and over long runs neither of two busy peers gets more than a quantum
+ * and a packet ahead of the other. A packet CoDel drops leaves its bytes in
+ * the deficit. Once the encryptions in flight reach the limit the encrypt
+ * path stops, refuses a peer with packets waiting with ENOBUFS, and starts
+ * again when the encryptions are down to half the limit.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/malloc.h>
+#include <sys/refcount.h>
+#include <sys/mbuf.h>
+
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_mbuf.h>
+#include <sys/wg_module.h>
+
+#define DRR_TEST_LIMIT		64
+#define DRR_TEST_SENT		4096
+#define DRR_TEST_SEGSZ		1000
+#define DRR_TEST_HLEN		(sizeof(struct ip) + sizeof(struct tcphdr))
+
+/* A packet handed to the encrypt workers. */
+struct drr_test_sent {
+	struct wg_peer		*s_peer;
+	struct mbuf		*s_m;
+	struct noise_keypair	*s_keypair;
+	uint64_t		 s_nonce;
+	int			 s_len;
+};
+
+volatile int ticks;
+int hz = 1000;
+
+static uint64_t drr_test_codel_drops;
+static uint64_t drr_test_stops;
+static uint64_t drr_test_refused;
+counter_u64_t wg_send_codel_drops = &drr_test_codel_drops;
+counter_u64_t wg_send_stops = &drr_test_stops;
+counter_u64_t wg_send_refused = &drr_test_refused;
+
+static struct drr_test_sent drr_test_sent[DRR_TEST_SENT];
+static u_int drr_test_nsent;	/* Handed to the workers. */
+static u_int drr_test_ndone;	/* Of those, encrypted. */
+static int drr_test_failed;
+
+#define drr_test_check(name, exp) do {					\
+	if (!(exp)) {							\
+		fprintf(stderr, "drr-test: %s: %s\n", (name), #exp);	\
+		drr_test_failed++;					\
+	}								\
+} while (0)
+
+/* The encrypt workers: packets are taken as they are handed over. */
+void
+wg_pktq_enqueue(struct wg_pktq *parallel, struct wg_pktq *serial,
+    struct wg_queue_pkt *pkt)
+{
+	struct drr_test_sent *s;
+
+	MPASS(drr_test_nsent < DRR_TEST_SENT);
+	s = &drr_test_sent[drr_test_nsent++];
+	s->s_peer = __containerof(serial, struct wg_peer, p_send_queue);
+	s->s_m = pkt->p_pkt;
+	s->s_keypair = pkt->p_keypair;
+	s->s_nonce = pkt->p_nonce;
+	s->s_len = pkt->p_pkt->m_pkthdr.len;
+	MPASS(pkt->p_state == WG_PKT_STATE_CLEAR);
+	MPASS(pkt->p_keypair->k_peer == s->s_peer);
+}
+
+/* Encryptions complete in the order they were handed over. */
+static void
+drr_test_complete(struct wg_softc *sc, u_int n)
+{
+	struct drr_test_sent *s;
+
+	while (n-- > 0) {
+		MPASS(drr_test_ndone < drr_test_nsent);
+		s = &drr_test_sent[drr_test_ndone++];
+		noise_keypair_put(s->s_keypair);
+		m_freem(s->s_m);
+		wg_softc_encrypt_done(sc);
+	}
+}
+
+/* As wg_softc_encrypt_init, with a limit that stays put. */
+static void
+drr_test_attach(struct wg_softc *sc)
+{
+	bzero(sc, sizeof(*sc));
+	wg_hashtable_init(&sc->sc_hashtable);
+	wg_dql_init(&sc->sc_encrypt_dql, DRR_TEST_LIMIT, DRR_TEST_LIMIT,
+	    DRR_TEST_LIMIT, WG_PKTQ_DELAY);
+	mtx_init(&sc->sc_drr.d_mtx, "wg drr", NULL, MTX_DEF);
+	TAILQ_INIT(&sc->sc_drr.d_active);
+}
+
+/* Makes the peer's next keypair current, as the handshake does. */
+static struct noise_keypair *
+drr_test_keypair(struct wg_peer *peer)
+{
+	struct noise_keypair *keypair;
+
+	keypair = noise_keypair_create();
+	MPASS(keypair != NULL);
+	noise_keypair_attach_to_peer(keypair, peer);
+	noise_keypairs_received_with_keypair(&peer->p_keypairs, keypair);
+	return (keypair);
+}
+
+/* As wg_peer_create, with a keypair to send with. */
+static void
+drr_test_peer(struct wg_peer *peer, struct wg_softc *sc)
+{
+	bzero(peer, sizeof(*peer));
+	refcount_init(&peer->p_refcnt, 1);
+	peer->p_sc = sc;
+	arc4random_buf(peer->p_remote.r_public, WG_KEY_SIZE);
+	noise_keypairs_init(&peer->p_keypairs);
+	mtx_init(&peer->p_lock, "peer lock", NULL, MTX_DEF);
+	mbufq_init(&peer->p_staged_packets, WG_PKTQ_MAX);
+	wg_codel_init(&peer->p_codel);
+	drr_test_keypair(peer);
+}
+
+static int
+drr_test_stage(struct wg_peer *peer, int len)
+{
+	struct mbuf *m;
+
+	m = m_get2(len, M_WAITOK, MT_DATA, M_PKTHDR);
+	m->m_len = m->m_pkthdr.len = len;
+	memset(mtod(m, void *), 0, len);
+	return (wg_peer_stage(peer, m));
+}
+
+/* Stages n packets of len, all of which are to be taken. */
+static void
+drr_test_stage_n(struct wg_peer *peer, u_int n, int len)
+{
+	while (n-- > 0)
+		drr_test_check("stage", drr_test_stage(peer, len) == 0);
+}
+
+/* Stages n packets of len and puts the peer in line. */
+static void
+drr_test_send(struct wg_peer *peer, u_int n, int len)
+{
+	drr_test_stage_n(peer, n, len);
+	wg_peer_send_staged_packets(peer);
+}
+
+/*
+ * Stages a TCP segment left to TSO, cut into n packets of DRR_TEST_SEGSZ
+ * payload bytes, the first from seq.
+ */
+static void
+drr_test_stage_tso(struct wg_peer *peer, u_int n, uint32_t seq)
+{
+	struct mbuf *m;
+	struct ip *ip;
+	struct tcphdr *th;
+	int len = DRR_TEST_HLEN + n * DRR_TEST_SEGSZ;
+
+	m = m_get2(len, M_WAITOK, MT_DATA, M_PKTHDR);
+	m->m_len = m->m_pkthdr.len = len;
+	memset(mtod(m, void *), 0, len);
+	ip = mtod(m, struct ip *);
+	ip->ip_v = IPVERSION;
+	ip->ip_hl = sizeof(*ip) >> 2;
+	ip->ip_len = htons(len);
+	ip->ip_ttl = 64;
+	ip->ip_p = IPPROTO_TCP;
+	th = (struct tcphdr *)(ip + 1);
+	th->th_seq = htonl(seq);
+	th->th_off = sizeof(*th) >> 2;
+	th->th_flags = TH_ACK;
+	m->m_pkthdr.csum_flags = CSUM_IP_TSO;
+	m->m_pkthdr.tso_segsz = DRR_TEST_SEGSZ;
+	drr_test_check("stage", wg_peer_stage(peer, m) == 0);
+}
+
+/*
+ * Fills the encrypt path from peer c, so that the next peer put in line
+ * stops it. Peers that stage more than one packet do so first, as staging
+ * behind a stopped encrypt path is refused.
+ */
+static void
+drr_test_fill(struct wg_softc *sc, struct wg_peer *c)
+{
+	drr_test_send(c, DRR_TEST_LIMIT, 100);
+	drr_test_check("fill", sc->sc_encrypt_pending == DRR_TEST_LIMIT);
+}
+
+/*
+ * The encrypt task's run of the line: it serves the line again for as long
+ * as that queues anything, the encrypt workers meanwhile taking packets.
+ */
+static void
+drr_test_task(struct wg_softc *sc)
+{
+	while (wg_softc_drr_run(sc, true))
+		;
+}
+
+/* Runs the encrypt task and completes encryptions until both are done. */
+static void
+drr_test_drain(struct wg_softc *sc)
+{
+	for (;;) {
+		drr_test_task(sc);
+		if (drr_test_ndone == drr_test_nsent)
+			break;
+		drr_test_complete(sc, drr_test_nsent - drr_test_ndone);
+	}
+}
+
+/* Every packet handed over from i on, in order, is peer's and of len. */
+static u_int
+drr_test_expect(const char *name, u_int i, struct wg_peer *peer, int n,
+    int len)
+{
+	for (; n > 0; n--, i++) {
+		drr_test_check(name, i < drr_test_nsent);
+		drr_test_check(name, drr_test_sent[i].s_peer == peer);
+		drr_test_check(name, drr_test_sent[i].s_len == len);
+	}
+	return (i);
+}
+
+/* The order a few packets go in, and what is left of each deficit. */
+static void
+drr_test_order(struct wg_softc *sc, struct wg_peer *a, struct wg_peer *b,
+    struct wg_peer *c)
+{
+	u_int i;
+
+	drr_test_fill(sc, c);
+	drr_test_stage_n(a, 3, 1000);
+	drr_test_stage_n(b, 3, 400);
+	drr_test_stage_n(c, 1, 1600);
+	wg_peer_send_staged_packets(a);
+	wg_peer_send_staged_packets(b);
+	wg_peer_send_staged_packets(c);
+	i = drr_test_nsent;
+	drr_test_drain(sc);
+
+	/*
+	 * a: 1000 of 1500, leaving 500 for the next; b: all three, 300 left
+	 * over; c: 1600 is over a quantum, so it waits for its second turn.
+	 * a's second turn is worth 2000, and c's 3000.
+	 */
+	i = drr_test_expect("order", i, a, 1, 1000);
+	i = drr_test_expect("order", i, b, 3, 400);
+	i = drr_test_expect("order", i, a, 2, 1000);
+	i = drr_test_expect("order", i, c, 1, 1600);
+	drr_test_check("order", i == drr_test_nsent);
+	drr_test_check("order", a->p_drr_deficit == 0);
+	drr_test_check("order", b->p_drr_deficit == 300);
+	drr_test_check("order", c->p_drr_deficit == 1400);
+	drr_test_check("order", !a->p_drr_active && !b->p_drr_active &&
+	    !c->p_drr_active);
+	drr_test_check("order", TAILQ_EMPTY(&sc->sc_drr.d_active));
+	/* Out of line, each is down to its own reference and its keypair's. */
+	drr_test_check("order", a->p_refcnt == 2 && b->p_refcnt == 2 &&
+	    c->p_refcnt == 2);
+}
+
+/* Tops the peer's staged packets up to the limit. */
+static void
+drr_test_top(struct wg_peer *peer, int len)
+{
+	drr_test_stage_n(peer,
+	    DRR_TEST_LIMIT - mbufq_len(&peer->p_staged_packets), len);
+}
+
+/*
+ * Two peers kept busy, one with full-sized packets and one with small
+ * ones, share the encrypt path by bytes: at no point has either been
+ * served more than a quantum and a packet beyond the other.
+ */
+static void
+drr_test_fair(struct wg_softc *sc, struct wg_peer *a, struct wg_peer *b,
+    struct wg_peer *c)
+{
+	int64_t bytes_a = 0, bytes_b = 0, lead = 0;
+	u_int i, round;
+
+	drr_test_fill(sc, c);
+	drr_test_top(a, 1400);
+	drr_test_top(b, 200);
+	wg_peer_send_staged_packets(a);
+	wg_peer_send_staged_packets(b);
+	i = drr_test_nsent;
+	for (round = 0; round < 40; round++) {
+		/* Room again, and the encrypt path no longer refuses. */
+		drr_test_complete(sc, drr_test_nsent - drr_test_ndone);
+		drr_test_top(a, 1400);
+		drr_test_top(b, 200);
+		drr_test_task(sc);
+		for (; i < drr_test_nsent; i++) {
+			drr_test_check("fair", drr_test_sent[i].s_peer != c);
+			if (drr_test_sent[i].s_peer == a)
+				bytes_a += drr_test_sent[i].s_len;
+			else
+				bytes_b += drr_test_sent[i].s_len;
+			lead = MAX(lead, MAX(bytes_a - bytes_b,
+			    bytes_b - bytes_a));
+		}
+		drr_test_check("fair", a->p_drr_active && b->p_drr_active);
+	}
+	drr_test_check("fair", bytes_a > 100 * WG_DRR_QUANTUM);
+	drr_test_check("fair", bytes_b > 100 * WG_DRR_QUANTUM);
+	drr_test_check("fair", lead <= WG_DRR_QUANTUM + 1400);
+	drr_test_drain(sc);
+	drr_test_check("fair", mbufq_len(&a->p_staged_packets) == 0);
+	drr_test_check("fair", mbufq_len(&b->p_staged_packets) == 0);
+}
+
+/*
+ * CoDel drops the first packet of a turn, the queue having run late for an
+ * interval; its bytes stay in the deficit.
+ */
+static void
+drr_test_codel(struct wg_softc *sc, struct wg_peer *a)
+{
+	struct mbuf *m;
+	u_int i;
+
+	drr_test_stage_n(a, 3, 400);
+	STAILQ_FOREACH(m, &a->p_staged_packets.mq_head, m_stailqpkt)
+		wg_mbuf_pkt_get(m)->p_staged -= 2 * WG_CODEL_TARGET;
+	a->p_codel.c_first_above = 1;
+	i = drr_test_nsent;
+	wg_peer_send_staged_packets(a);
+	drr_test_check("codel", drr_test_codel_drops == 1);
+	drr_test_check("codel", drr_test_nsent - i == 2);
+	drr_test_check("codel", a->p_drr_deficit == WG_DRR_QUANTUM - 2 * 400);
+	drr_test_check("codel", !a->p_codel.c_dropping);
+	drr_test_drain(sc);
+}
+
+/*
+ * The encrypt path stops at the limit, refuses a peer that has packets
+ * waiting but not one that has none, and starts again when the encryptions
+ * in flight are down to half the limit.
+ */
+static void
+drr_test_stop(struct wg_softc *sc, struct wg_peer *a, struct wg_peer *b,
+    struct wg_peer *c)
+{
+	uint64_t stops = drr_test_stops, refused = drr_test_refused;
+	u_int i, kicks;
+
+	drr_test_fill(sc, c);
+	drr_test_check("stop", sc->sc_encrypt_stopped == 0);
+	drr_test_send(a, 2, 100);
+	drr_test_check("stop", sc->sc_encrypt_stopped == 1);
+	drr_test_check("stop", drr_test_stops == stops + 1);
+	drr_test_check("stop", a->p_drr_active);
+
+	drr_test_check("stop", drr_test_stage(a, 100) == ENOBUFS);
+	drr_test_check("stop", drr_test_refused == refused + 1);
+	drr_test_check("stop", mbufq_len(&a->p_staged_packets) == 2);
+	drr_test_check("stop", drr_test_stage(b, 100) == 0);
+	wg_peer_send_staged_packets(b);
+	drr_test_check("stop", drr_test_stops == stops + 1);
+
+	kicks = sc->sc_encrypt.gt_enqueued;
+	for (i = DRR_TEST_LIMIT; i > DRR_TEST_LIMIT / 2 + 1; i--) {
+		drr_test_complete(sc, 1);
+		drr_test_check("stop", sc->sc_encrypt_stopped == 1);
+	}
+	drr_test_check("stop", sc->sc_encrypt.gt_enqueued == kicks);
+	drr_test_complete(sc, 1);
+	drr_test_check("stop", sc->sc_encrypt_pending == DRR_TEST_LIMIT / 2);
+	drr_test_check("stop", sc->sc_encrypt_stopped == 0);
+	drr_test_check("stop", sc->sc_encrypt.gt_enqueued == kicks + 1);
+
+	i = drr_test_nsent;
+	drr_test_task(sc);
+	i = drr_test_expect("stop", i, a, 2, 100);
+	i = drr_test_expect("stop", i, b, 1, 100);
+	drr_test_check("stop", i == drr_test_nsent);
+	drr_test_check("stop", !sc->sc_encrypt_stopped);
+	drr_test_send(a, 1, 100);
+	drr_test_drain(sc);
+}
+
+/* Each peer's nonces were handed out in order, without a gap. */
+static void
+drr_test_nonces(struct wg_peer *peer)
+{
+	uint64_t next = 0;
+	u_int i;
+
+	for (i = 0; i < drr_test_nsent; i++) {
+		if (drr_test_sent[i].s_peer != peer)
+			continue;
+		drr_test_check("nonces", drr_test_sent[i].s_nonce == next);
+		next++;
+	}
+}
+
+/*
+ * The n packets of a train handed over from i on: one after the other,
+ * under keypair, with consecutive nonces from nonce and in the order they
+ * were cut, from seq.
+ */
+static u_int
+drr_test_train(const char *name, u_int i, struct wg_peer *peer,
+    struct noise_keypair *keypair, u_int n, uint64_t nonce, uint32_t seq)
+{
+	struct drr_test_sent *s;
+	struct tcphdr *th;
+
+	for (; n > 0; n--, i++, nonce++, seq += DRR_TEST_SEGSZ) {
+		drr_test_check(name, i < drr_test_nsent);
+		s = &drr_test_sent[i];
+		drr_test_check(name, s->s_peer == peer);
+		drr_test_check(name, s->s_keypair == keypair);
+		drr_test_check(name, s->s_nonce == nonce);
+		drr_test_check(name,
+		    s->s_len == DRR_TEST_HLEN + DRR_TEST_SEGSZ);
+		th = (struct tcphdr *)(mtod(s->s_m, struct ip *) + 1);
+		drr_test_check(name, ntohl(th->th_seq) == seq);
+	}
+	return (i);
+}
+
+/*
+ * A train bigger than a quantum waits for the turns it needs and then goes
+ * whole, in one turn; packets of others go in between turns, but never into
+ * the train.
+ */
+static void
+drr_test_trains(struct wg_softc *sc, struct wg_peer *a, struct wg_peer *b,
+    struct wg_peer *c)
+{
+	struct noise_keypair *keypair;
+	uint64_t nonce;
+	u_int i;
+
+	keypair = noise_keypairs_current(&a->p_keypairs);
+	nonce = keypair->k_counter.c_send;
+	drr_test_fill(sc, c);
+	drr_test_stage_tso(a, 3, 5000);
+	drr_test_stage_n(b, 20, 100);
+	wg_peer_send_staged_packets(a);
+	wg_peer_send_staged_packets(b);
+	i = drr_test_nsent;
+	drr_test_drain(sc);
+	i = drr_test_expect("train", i, b, 15, 100);
+	i = drr_test_expect("train", i, b, 5, 100);
+	i = drr_test_train("train", i, a, keypair, 3, nonce, 5000);
+	drr_test_check("train", i == drr_test_nsent);
+	drr_test_check("train", a->p_drr_deficit ==
+	    3 * WG_DRR_QUANTUM - 3 * (int)(DRR_TEST_HLEN + DRR_TEST_SEGSZ));
+
+	/* A train waiting while the keypair changes goes under the new one. */
+	drr_test_fill(sc, c);
+	drr_test_stage_tso(a, 3, 8000);
+	wg_peer_send_staged_packets(a);
+	keypair = drr_test_keypair(a);
+	i = drr_test_nsent;
+	drr_test_drain(sc);
+	i = drr_test_train("rotate", i, a, keypair, 3, 0, 8000);
+	drr_test_check("rotate", i == drr_test_nsent);
+}
+
+/*
+ * A train that would run past the last nonce of the keypair takes none of
+ * it: the packets ahead of it go, and it waits whole for the next keypair.
+ */
+static void
+drr_test_exhaust(struct wg_softc *sc, struct wg_peer *a)
+{
+	struct noise_keypair *keypair;
+	struct wg_queue_pkt *pkt;
+	u_int i;
+
+	keypair = drr_test_keypair(a);
+	keypair->k_counter.c_send = REJECT_AFTER_MESSAGES - 3;
+	drr_test_stage_n(a, 2, 100);
+	drr_test_stage_tso(a, 3, 11000);
+	i = drr_test_nsent;
+	wg_peer_send_staged_packets(a);
+	i = drr_test_expect("exhaust", i, a, 2, 100);
+	drr_test_check("exhaust", i == drr_test_nsent);
+	drr_test_check("exhaust", drr_test_sent[i - 1].s_nonce ==
+	    REJECT_AFTER_MESSAGES - 2);
+	drr_test_check("exhaust", mbufq_len(&a->p_staged_packets) == 3);
+	pkt = wg_mbuf_pkt_get(mbufq_first(&a->p_staged_packets));
+	drr_test_check("exhaust", pkt->p_train == 3);
+	drr_test_check("exhaust",
+	    pkt->p_train_len == 3 * (DRR_TEST_HLEN + DRR_TEST_SEGSZ));
+	drr_test_check("exhaust", pkt->p_state == WG_PKT_STATE_NEW);
+	drr_test_check("exhaust", !a->p_drr_active);
+
+	/* The handshake completes, and the train goes under the new keypair. */
+	keypair = drr_test_keypair(a);
+	i = drr_test_nsent;
+	wg_peer_send_staged_packets(a);
+	i = drr_test_train("exhaust", i, a, keypair, 3, 0, 11000);
+	drr_test_check("exhaust", i == drr_test_nsent);
+	drr_test_drain(sc);
+}
+
+/* What CoDel leaves of a train still goes as one, its first packet gone. */
+static void
+drr_test_train_codel(struct wg_softc *sc, struct wg_peer *a)
+{
+	struct noise_keypair *keypair;
+	struct mbuf *m;
+	uint64_t drops = drr_test_codel_drops, nonce;
+	u_int i;
+
+	keypair = noise_keypairs_current(&a->p_keypairs);
+	nonce = keypair->k_counter.c_send;
+	drr_test_stage_tso(a, 4, 20000);
+	STAILQ_FOREACH(m, &a->p_staged_packets.mq_head, m_stailqpkt)
+		wg_mbuf_pkt_get(m)->p_staged -= 2 * WG_CODEL_TARGET;
+	wg_codel_init(&a->p_codel);
+	a->p_codel.c_first_above = 1;
+	i = drr_test_nsent;
+	wg_peer_send_staged_packets(a);
+	drr_test_check("train codel", drr_test_codel_drops == drops + 1);
+	i = drr_test_train("train codel", i, a, keypair, 3, nonce,
+	    20000 + DRR_TEST_SEGSZ);
+	drr_test_check("train codel", i == drr_test_nsent);
+	drr_test_drain(sc);
+}
+
+int
+main(void)
+{
+	static struct wg_softc sc;
+	static struct wg_peer a, b, c;
+
+	wg_keypair_zone = uma_zcreate("wg keypair",
+	    sizeof(struct noise_keypair), NULL, NULL, NULL, NULL,
+	    UMA_ALIGN_CACHE, 0);
+	wg_pkt_zone = uma_zcreate("wg packet", sizeof(struct wg_pkt_tag),
+	    NULL, NULL, NULL, NULL, UMA_ALIGN_PTR, 0);
+
+	drr_test_attach(&sc);
+	drr_test_peer(&a, &sc);
+	drr_test_peer(&b, &sc);
+	drr_test_peer(&c, &sc);
+
+	drr_test_order(&sc, &a, &b, &c);
+	drr_test_fair(&sc, &a, &b, &c);
+	drr_test_codel(&sc, &a);
+	drr_test_stop(&sc, &a, &b, &c);
+	/* Before the keypairs change. */
+	drr_test_nonces(&a);
+	drr_test_nonces(&b);
+	drr_test_nonces(&c);
+	drr_test_trains(&sc, &a, &b, &c);
+	drr_test_exhaust(&sc, &a);
+	drr_test_train_codel(&sc, &a);
+
+	drr_test_check("done", drr_test_ndone == drr_test_nsent);
+	drr_test_check("done", sc.sc_encrypt_pending == 0);
+
+	if (drr_test_failed != 0)
+		return (1);
+	printf("drr-test: ok\n");
+	return (0);
+}
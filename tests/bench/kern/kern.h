@@ -0,0 +1,801 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Just enough of the FreeBSD kernel environment to build the Noise handshake
+ * (module/if_wg_noise.c) and the kmod's own BLAKE2s and Curve25519 as
+ * ordinary userspace objects. Like compat/compat.h for zinc, every kernel
+ * header those sources pull in is an empty placeholder next to this file and
+ * this header is force-included ahead of them. Locks map onto pthreads so
+ * that the handshake bench sees the same contention the kernel would.
+ */
+
+#ifndef _BENCH_KERN_H
+#define _BENCH_KERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <assert.h>
+#include <endian.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/param.h>
+#include <sys/time.h>
+#include <sys/queue.h>
+#include <sys/ioctl.h>
+
+#ifndef __packed
+#define __packed		__attribute__((__packed__))
+#endif
+#ifndef __aligned
+#define __aligned(x)		__attribute__((__aligned__(x)))
+#endif
+#define __read_mostly
+#define __predict_true(exp)	__builtin_expect((exp), 1)
+#define __predict_false(exp)	__builtin_expect((exp), 0)
+#define __LONG_BIT		(sizeof(long) * CHAR_BIT)
+#define __UQUAD_MAX		UINT64_MAX
+#define CTASSERT(x)		_Static_assert(x, #x)
+#ifndef roundup2
+#define roundup2(x, y)		(((x) + ((y) - 1)) & ~((y) - 1))
+#endif
+#ifndef nitems
+#define nitems(x)		(sizeof((x)) / sizeof((x)[0]))
+#endif
+
+/* sys/queue.h: glibc's lacks the _SAFE iterators. */
+#ifndef TAILQ_FOREACH_SAFE
+#define TAILQ_FOREACH_SAFE(var, head, field, tvar)			\
+	for ((var) = TAILQ_FIRST((head));				\
+	    (var) && ((tvar) = TAILQ_NEXT((var), field), 1);		\
+	    (var) = (tvar))
+#endif
+
+/* machine/param.h */
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE		64
+#endif
+
+#ifndef ENOTRECOVERABLE
+#define ENOTRECOVERABLE		131
+#endif
+
+#define panic(fmt, ...) do {						\
+	fprintf(stderr, "panic: " fmt, ##__VA_ARGS__);			\
+	abort();							\
+} while (0)
+#define MPASS(exp)		assert(exp)
+#define KASSERT(exp, msg)	assert(exp)
+
+/* sys/malloc.h: the malloc type is ignored, the flags are honoured. */
+struct malloc_type {
+	const char *ks_shortdesc;
+};
+#define MALLOC_DECLARE(type)	extern struct malloc_type type[1]
+#define MALLOC_DEFINE(type, shortdesc, longdesc)			\
+	struct malloc_type type[1] = { { shortdesc } }
+#define M_NOWAIT		0x0001
+#define M_WAITOK		0x0002
+#define M_ZERO			0x0100
+
+/* Like malloc(9)'s power-of-two buckets, never split a cache line. */
+static inline void *
+kern_malloc(size_t size, int flags)
+{
+	void *addr;
+
+	if (posix_memalign(&addr, CACHE_LINE_SIZE, size) != 0)
+		return (NULL);
+	if (flags & M_ZERO)
+		memset(addr, 0, size);
+	return (addr);
+}
+#define malloc(size, type, flags)	kern_malloc((size), (flags))
+#define free(addr, type)		free(addr)
+
+/*
+ * vm/uma.h: items come back through a small per-CPU cache in front of a
+ * locked zone-wide list, like UMA's buckets, and are only returned to
+ * malloc when the zone is destroyed. A lock stands in for critical_enter()
+ * on each CPU's cache.
+ */
+#define UMA_ALIGN_PTR		(sizeof(void *) - 1)
+#define UMA_ALIGN_CACHE		(CACHE_LINE_SIZE - 1)
+
+enum kern_uma_values {
+	KERN_UMA_CPUS = 64,
+	KERN_UMA_BUCKET = 32
+};
+
+struct kern_uma_cache {
+	pthread_mutex_t		 uc_lock;
+	void			*uc_items;
+	unsigned int		 uc_count;
+} __aligned(CACHE_LINE_SIZE);
+
+struct uma_zone {
+	const char		*uz_name;
+	size_t			 uz_size;
+	pthread_mutex_t		 uz_lock;
+	void			*uz_items;
+	unsigned int		 uz_count;
+	volatile uint64_t	 uz_allocs;
+	volatile uint64_t	 uz_frees;
+	volatile uint64_t	 uz_imports;	/* Items taken from malloc. */
+	struct kern_uma_cache	 uz_cpu[KERN_UMA_CPUS];
+};
+typedef struct uma_zone *uma_zone_t;
+
+static inline uma_zone_t
+uma_zcreate(const char *name, size_t size, void *ctor, void *dtor,
+    void *init, void *fini, int align, uint32_t flags)
+{
+	uma_zone_t zone;
+	unsigned int i;
+
+	if (posix_memalign((void **)&zone, CACHE_LINE_SIZE, sizeof(*zone)))
+		abort();
+	memset(zone, 0, sizeof(*zone));
+	zone->uz_name = name;
+	zone->uz_size = roundup2(MAX(size, sizeof(void *)), align + 1);
+	pthread_mutex_init(&zone->uz_lock, NULL);
+	for (i = 0; i < KERN_UMA_CPUS; ++i)
+		pthread_mutex_init(&zone->uz_cpu[i].uc_lock, NULL);
+	return (zone);
+}
+
+/* Moves up to n items from one free list to another. */
+static inline unsigned int
+kern_uma_move(void **from, void **to, unsigned int n)
+{
+	unsigned int i;
+	void *item;
+
+	for (i = 0; i < n && *from != NULL; ++i) {
+		item = *from;
+		*from = *(void **)item;
+		*(void **)item = *to;
+		*to = item;
+	}
+	return (i);
+}
+
+static inline void *
+uma_zalloc(uma_zone_t zone, int flags)
+{
+	struct kern_uma_cache *c;
+	unsigned int n;
+	void *item;
+
+	c = &zone->uz_cpu[sched_getcpu() % KERN_UMA_CPUS];
+	pthread_mutex_lock(&c->uc_lock);
+	if (c->uc_count == 0) {
+		pthread_mutex_lock(&zone->uz_lock);
+		n = kern_uma_move(&zone->uz_items, &c->uc_items,
+		    KERN_UMA_BUCKET);
+		zone->uz_count -= n;
+		c->uc_count += n;
+		pthread_mutex_unlock(&zone->uz_lock);
+	}
+	if ((item = c->uc_items) != NULL) {
+		c->uc_items = *(void **)item;
+		c->uc_count--;
+	}
+	pthread_mutex_unlock(&c->uc_lock);
+
+	if (item == NULL) {
+		if (posix_memalign(&item, CACHE_LINE_SIZE, zone->uz_size))
+			return (NULL);
+		__atomic_fetch_add(&zone->uz_imports, 1, __ATOMIC_RELAXED);
+	}
+	__atomic_fetch_add(&zone->uz_allocs, 1, __ATOMIC_RELAXED);
+	if (flags & M_ZERO)
+		memset(item, 0, zone->uz_size);
+	return (item);
+}
+
+static inline void
+uma_zfree(uma_zone_t zone, void *item)
+{
+	struct kern_uma_cache *c;
+	unsigned int n;
+
+	if (item == NULL)
+		return;
+	__atomic_fetch_add(&zone->uz_frees, 1, __ATOMIC_RELAXED);
+	c = &zone->uz_cpu[sched_getcpu() % KERN_UMA_CPUS];
+	pthread_mutex_lock(&c->uc_lock);
+	*(void **)item = c->uc_items;
+	c->uc_items = item;
+	if (++c->uc_count > 2 * KERN_UMA_BUCKET) {
+		pthread_mutex_lock(&zone->uz_lock);
+		n = kern_uma_move(&c->uc_items, &zone->uz_items,
+		    KERN_UMA_BUCKET);
+		zone->uz_count += n;
+		c->uc_count -= n;
+		pthread_mutex_unlock(&zone->uz_lock);
+	}
+	pthread_mutex_unlock(&c->uc_lock);
+}
+
+static inline void
+uma_zdestroy(uma_zone_t zone)
+{
+	unsigned int i;
+	void *item;
+
+	for (i = 0; i < KERN_UMA_CPUS; ++i)
+		kern_uma_move(&zone->uz_cpu[i].uc_items, &zone->uz_items,
+		    UINT_MAX);
+	while ((item = zone->uz_items) != NULL) {
+		zone->uz_items = *(void **)item;
+		(free)(item);
+	}
+	(free)(zone);
+}
+
+/*
+ * sys/mutex.h and sys/rwlock.h. Both locks are a struct lock_object and a
+ * word long, as on amd64, so that the layouts WG_CACHELINE_GROUP checks are
+ * the kernel's; the pthread lock behind each is allocated when it is
+ * initialised.
+ */
+#define MTX_DEF			0x0000
+
+struct mtx {
+	pthread_mutex_t		*m;
+	uintptr_t		 m_spare[3];
+};
+
+struct rwlock {
+	pthread_rwlock_t	*rw_lock;
+	uintptr_t		 rw_spare[3];
+};
+
+CTASSERT(sizeof(struct mtx) == 32);
+CTASSERT(sizeof(struct rwlock) == 32);
+
+static inline void
+kern_mtx_init(struct mtx *mtx)
+{
+	if ((mtx->m = (malloc)(sizeof(*mtx->m))) == NULL)
+		abort();
+	pthread_mutex_init(mtx->m, NULL);
+}
+
+static inline void
+kern_mtx_destroy(struct mtx *mtx)
+{
+	pthread_mutex_destroy(mtx->m);
+	(free)(mtx->m);
+	mtx->m = NULL;
+}
+
+static inline void
+kern_rw_init(struct rwlock *rw)
+{
+	if ((rw->rw_lock = (malloc)(sizeof(*rw->rw_lock))) == NULL)
+		abort();
+	pthread_rwlock_init(rw->rw_lock, NULL);
+}
+
+static inline void
+kern_rw_destroy(struct rwlock *rw)
+{
+	pthread_rwlock_destroy(rw->rw_lock);
+	(free)(rw->rw_lock);
+	rw->rw_lock = NULL;
+}
+
+#define mtx_init(mtx, name, type, opts)	kern_mtx_init(mtx)
+#define mtx_destroy(mtx)		kern_mtx_destroy(mtx)
+#define mtx_lock(mtx)			pthread_mutex_lock((mtx)->m)
+#define mtx_trylock(mtx)		(pthread_mutex_trylock((mtx)->m) == 0)
+#define mtx_unlock(mtx)			pthread_mutex_unlock((mtx)->m)
+#define mtx_assert(mtx, what)
+#define MA_OWNED			0
+#define rw_init(rw, name)		kern_rw_init(rw)
+#define rw_destroy(rw)			kern_rw_destroy(rw)
+#define rw_rlock(rw)			pthread_rwlock_rdlock((rw)->rw_lock)
+#define rw_runlock(rw)			pthread_rwlock_unlock((rw)->rw_lock)
+#define rw_wlock(rw)			pthread_rwlock_wrlock((rw)->rw_lock)
+#define rw_wunlock(rw)			pthread_rwlock_unlock((rw)->rw_lock)
+
+/* sys/refcount.h */
+static inline void
+refcount_init(volatile uint32_t *count, uint32_t value)
+{
+	__atomic_store_n(count, value, __ATOMIC_RELAXED);
+}
+
+static inline void
+refcount_acquire(volatile uint32_t *count)
+{
+	__atomic_fetch_add(count, 1, __ATOMIC_RELAXED);
+}
+
+static inline void
+refcount_acquiren(volatile uint32_t *count, uint32_t n)
+{
+	__atomic_fetch_add(count, n, __ATOMIC_RELAXED);
+}
+
+static inline bool
+refcount_release(volatile uint32_t *count)
+{
+	uint32_t old;
+
+	old = __atomic_fetch_sub(count, 1, __ATOMIC_ACQ_REL);
+	MPASS(old > 0);
+	return (old == 1);
+}
+
+static inline bool
+refcount_acquire_if_not_zero(volatile uint32_t *count)
+{
+	uint32_t old;
+
+	old = __atomic_load_n(count, __ATOMIC_RELAXED);
+	do {
+		if (old == 0)
+			return (false);
+	} while (!__atomic_compare_exchange_n(count, &old, old + 1, true,
+	    __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	return (true);
+}
+
+/* machine/atomic.h */
+#define atomic_load_acq_ptr(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define atomic_store_rel_ptr(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define atomic_fetchadd_64(p, v)	__atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define atomic_load_acq_64(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define atomic_store_rel_64(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define atomic_add_int(p, v)		__atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define atomic_fetchadd_int(p, v)	__atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define atomic_load_int(p)		__atomic_load_n((p), __ATOMIC_RELAXED)
+#define atomic_store_int(p, v)		__atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define atomic_readandclear_int(p)	__atomic_exchange_n((p), 0, __ATOMIC_RELAXED)
+#define atomic_cmpset_int(p, c, v) __extension__ ({			\
+	__typeof(*(p) + 0) __c = (c);					\
+	__atomic_compare_exchange_n((p), &__c, (v), false,		\
+	    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);			\
+})
+#define atomic_thread_fence_seq_cst()	__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* sys/sysctl.h: the bench has no knobs to turn. */
+#define SYSCTL_DECL(name)	extern int sysctl_##name
+struct sysctl_ctx_list;
+struct sysctl_oid_list;
+
+/*
+ * sys/callout.h and sys/kernel.h: time stands still unless a bench that
+ * uses it defines ticks and hz and advances ticks, and nothing fires on its
+ * own; the bench runs callouts that are due itself.
+ */
+extern volatile int ticks;
+extern int hz;
+
+struct callout {
+	int			 c_time;
+	bool			 c_pending;
+	void			(*c_func)(void *);
+	void			*c_arg;
+};
+
+#define callout_init(c, mpsafe)		memset((c), 0, sizeof(*(c)))
+#define callout_pending(c)		((c)->c_pending)
+
+static inline int
+callout_stop(struct callout *c)
+{
+	int pending = c->c_pending;
+
+	c->c_pending = false;
+	return (pending);
+}
+
+#define callout_drain(c)		callout_stop(c)
+
+static inline int
+callout_reset(struct callout *c, int to_ticks, void (*func)(void *),
+	      void *arg)
+{
+	int pending = c->c_pending;
+
+	c->c_time = ticks + to_ticks;
+	c->c_func = func;
+	c->c_arg = arg;
+	c->c_pending = true;
+	return (pending);
+}
+
+/* sys/pcpu.h and sys/smp.h */
+#define mp_maxid			((u_int)sysconf(_SC_NPROCESSORS_CONF) - 1)
+#define mp_ncpus			((int)sysconf(_SC_NPROCESSORS_ONLN))
+#define curcpu				((u_int)sched_getcpu() % (mp_maxid + 1))
+#define CPU_FOREACH(i)			for ((i) = 0; (i) <= mp_maxid; (i)++)
+
+/*
+ * sys/taskqueue.h: taskqueue_thread runs each enqueued task on a thread of
+ * its own, so that the work really happens off the caller's CPU. A task is
+ * enqueued at most once until it has run, as in the kernel.
+ */
+struct task {
+	volatile int	 ta_pending;
+	void		(*ta_func)(void *, int);
+	void		*ta_context;
+};
+struct taskqueue;
+#define taskqueue_thread		((struct taskqueue *)NULL)
+#define TASK_INIT(task, pri, func, ctx) do {				\
+	(task)->ta_pending = 0;						\
+	(task)->ta_func = (func);					\
+	(task)->ta_context = (ctx);					\
+} while (0)
+
+static inline void *
+kern_task_run(void *arg)
+{
+	struct task *task = arg;
+
+	task->ta_func(task->ta_context, 1);
+	__atomic_store_n(&task->ta_pending, 0, __ATOMIC_RELEASE);
+	return (NULL);
+}
+
+static inline int
+taskqueue_enqueue(struct taskqueue *tq, struct task *task)
+{
+	pthread_attr_t attr;
+	pthread_t thread;
+
+	if (__atomic_exchange_n(&task->ta_pending, 1, __ATOMIC_ACQ_REL))
+		return (0);
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	pthread_create(&thread, &attr, kern_task_run, task);
+	pthread_attr_destroy(&attr);
+	return (0);
+}
+
+static inline void
+taskqueue_drain(struct taskqueue *tq, struct task *task)
+{
+	while (__atomic_load_n(&task->ta_pending, __ATOMIC_ACQUIRE))
+		sched_yield();
+}
+
+/* sys/epoch.h: nothing is freed behind the bench's back. */
+struct epoch_context {
+	void *data[2];
+};
+typedef struct epoch_context *epoch_context_t;
+struct epoch_tracker {
+	int et_unused;
+};
+#define NET_EPOCH_ENTER(et)	((void)(et))
+#define NET_EPOCH_EXIT(et)	((void)(et))
+#define NET_EPOCH_ASSERT()
+#define NET_EPOCH_CALL(fn, ctx)	(fn)(ctx)
+#define __containerof(x, s, m)	((s *)((char *)(x) - offsetof(s, m)))
+
+/* sys/time.h */
+static inline void
+getnanotime(struct timespec *ts)
+{
+	clock_gettime(CLOCK_REALTIME, ts);
+}
+
+#define timespecsub(tsp, usp, vsp) do {					\
+	(vsp)->tv_sec = (tsp)->tv_sec - (usp)->tv_sec;			\
+	(vsp)->tv_nsec = (tsp)->tv_nsec - (usp)->tv_nsec;		\
+	if ((vsp)->tv_nsec < 0) {					\
+		(vsp)->tv_sec--;					\
+		(vsp)->tv_nsec += 1000000000L;				\
+	}								\
+} while (0)
+#define timespeccmp(tvp, uvp, cmp)					\
+	(((tvp)->tv_sec == (uvp)->tv_sec) ?				\
+	 ((tvp)->tv_nsec cmp (uvp)->tv_nsec) :				\
+	 ((tvp)->tv_sec cmp (uvp)->tv_sec))
+
+typedef int64_t sbintime_t;
+#define SBT_1S	((sbintime_t)1 << 32)
+#define SBT_1MS	(SBT_1S / 1000)
+#define SBT_1US	(SBT_1S / 1000000)
+
+static inline sbintime_t
+sbinuptime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * SBT_1S + ts.tv_nsec * SBT_1S / 1000000000);
+}
+
+/* sys/libkern.h and sys/endian.h */
+static inline int
+timingsafe_bcmp(const void *b1, const void *b2, size_t n)
+{
+	const unsigned char *p1 = b1, *p2 = b2;
+	int ret = 0;
+
+	for (; n > 0; n--)
+		ret |= *p1++ ^ *p2++;
+	return (ret != 0);
+}
+
+static inline uint32_t
+le32dec(const void *pp)
+{
+	const uint8_t *p = pp;
+
+	return (((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) |
+		((uint32_t)p[1] << 8) | p[0]);
+}
+
+static inline void
+le32enc(void *pp, uint32_t u)
+{
+	uint8_t *p = pp;
+
+	p[0] = u & 0xff;
+	p[1] = (u >> 8) & 0xff;
+	p[2] = (u >> 16) & 0xff;
+	p[3] = (u >> 24) & 0xff;
+}
+
+/*
+ * sys/mbuf.h: plain mbufs and clusters of any size, with the cluster
+ * reference count that decides whether an mbuf is writable. The functions
+ * are in kern/mbuf.c, built into the tests that move packets.
+ */
+#define MSIZE			256
+#define MCLBYTES		2048
+#define MJUMPAGESIZE		4096
+#define MJUM9BYTES		(9 * 1024)
+#define MJUM16BYTES		(16 * 1024)
+
+#define M_EXT			0x00000001
+#define M_PKTHDR		0x00000002
+#define M_RDONLY		0x00000008
+#define M_BCAST			0x00000010
+#define M_MCAST			0x00000020
+#define M_COPYFLAGS		(M_PKTHDR | M_RDONLY | M_BCAST | M_MCAST)
+#define MT_DATA			1
+
+#define CSUM_IP			0x00000001
+#define CSUM_IP_UDP		0x00000002
+#define CSUM_IP_TCP		0x00000004
+#define CSUM_IP_TSO		0x00000010
+#define CSUM_IP6_UDP		0x00000200
+#define CSUM_IP6_TCP		0x00000400
+#define CSUM_IP6_TSO		0x00001000
+#define CSUM_UDP		CSUM_IP_UDP
+#define CSUM_TCP		CSUM_IP_TCP
+#define CSUM_UDP_IPV6		CSUM_IP6_UDP
+#define CSUM_TCP_IPV6		CSUM_IP6_TCP
+#define CSUM_TSO		(CSUM_IP_TSO | CSUM_IP6_TSO)
+#define CSUM_DELAY_DATA		(CSUM_TCP | CSUM_UDP)
+#define CSUM_DELAY_DATA_IPV6	(CSUM_TCP_IPV6 | CSUM_UDP_IPV6)
+
+struct m_tag {
+	SLIST_ENTRY(m_tag)	 m_tag_link;
+	uint16_t		 m_tag_id;
+	uint16_t		 m_tag_len;
+	uint32_t		 m_tag_cookie;
+	void			(*m_tag_free)(struct m_tag *);
+};
+
+struct pkthdr {
+	SLIST_HEAD(, m_tag)	 tags;
+	struct ifnet		*rcvif;
+	int			 len;
+	uint32_t		 csum_flags;
+	uint16_t		 csum_data;
+	uint16_t		 tso_segsz;
+};
+
+struct m_ext {
+	char			*ext_buf;
+	u_int			 ext_size;
+	volatile u_int		*ext_cnt;
+};
+
+struct mbuf {
+	union {
+		struct mbuf		*m_nextpkt;
+		STAILQ_ENTRY(mbuf)	 m_stailqpkt;
+	};
+	struct mbuf		*m_next;
+	caddr_t			 m_data;
+	int			 m_len;
+	int			 m_type;
+	int			 m_flags;
+	struct pkthdr		 m_pkthdr;
+	struct m_ext		 m_ext;
+	char			 m_dat[MSIZE] __aligned(8);
+};
+
+#define MLEN			MSIZE
+#define MHLEN			MSIZE
+#define m_pktdat		m_dat
+#define mtod(m, t)		((t)((m)->m_data))
+#define M_SIZE(m)		((m)->m_flags & M_EXT ? \
+				 (int)(m)->m_ext.ext_size : MSIZE)
+#define M_START(m)		((m)->m_flags & M_EXT ? \
+				 (m)->m_ext.ext_buf : (m)->m_dat)
+#define M_WRITABLE(m)		(((m)->m_flags & M_RDONLY) == 0 && \
+				 (((m)->m_flags & M_EXT) == 0 || \
+				  *(m)->m_ext.ext_cnt == 1))
+#define M_LEADINGSPACE(m)	(M_WRITABLE(m) ? \
+				 (int)((m)->m_data - M_START(m)) : 0)
+#define M_TRAILINGSPACE(m)	(M_WRITABLE(m) ? (int)(M_START(m) + \
+				 M_SIZE(m) - ((m)->m_data + (m)->m_len)) : 0)
+
+struct mbuf	*m_get(int, short);
+struct mbuf	*m_gethdr(int, short);
+struct mbuf	*m_getcl(int, short, int);
+struct mbuf	*m_getjcl(int, short, int, int);
+struct mbuf	*m_get2(int, int, short, int);
+struct mbuf	*m_free(struct mbuf *);
+void		 m_freem(struct mbuf *);
+void		 m_copydata(const struct mbuf *, int, int, caddr_t);
+struct mbuf	*m_copym(struct mbuf *, int, int, int);
+struct mbuf	*m_pullup(struct mbuf *, int);
+int		 m_append(struct mbuf *, int, const void *);
+void		 m_move_pkthdr(struct mbuf *, struct mbuf *);
+int		 m_dup_pkthdr(struct mbuf *, const struct mbuf *, int);
+void		 m_tag_prepend(struct mbuf *, struct m_tag *);
+void		 m_tag_delete(struct mbuf *, struct m_tag *);
+struct m_tag	*m_tag_locate(struct mbuf *, uint32_t, uint16_t,
+		    struct m_tag *);
+
+static inline void
+m_tag_setup(struct m_tag *t, uint32_t cookie, uint16_t type, int len)
+{
+	t->m_tag_id = type;
+	t->m_tag_len = len;
+	t->m_tag_cookie = cookie;
+}
+
+struct mbufq {
+	STAILQ_HEAD(, mbuf)	 mq_head;
+	int			 mq_len;
+	int			 mq_maxlen;
+};
+
+static inline void
+mbufq_init(struct mbufq *mq, int maxlen)
+{
+	STAILQ_INIT(&mq->mq_head);
+	mq->mq_len = 0;
+	mq->mq_maxlen = maxlen;
+}
+
+static inline int
+mbufq_len(const struct mbufq *mq)
+{
+	return (mq->mq_len);
+}
+
+static inline struct mbuf *
+mbufq_first(const struct mbufq *mq)
+{
+	return (STAILQ_FIRST(&mq->mq_head));
+}
+
+static inline int
+mbufq_enqueue(struct mbufq *mq, struct mbuf *m)
+{
+	if (mq->mq_len >= mq->mq_maxlen)
+		return (ENOBUFS);
+	STAILQ_INSERT_TAIL(&mq->mq_head, m, m_stailqpkt);
+	mq->mq_len++;
+	return (0);
+}
+
+static inline struct mbuf *
+mbufq_dequeue(struct mbufq *mq)
+{
+	struct mbuf *m;
+
+	if ((m = STAILQ_FIRST(&mq->mq_head)) != NULL) {
+		STAILQ_REMOVE_HEAD(&mq->mq_head, m_stailqpkt);
+		m->m_nextpkt = NULL;
+		mq->mq_len--;
+	}
+	return (m);
+}
+
+static inline void
+mbufq_concat(struct mbufq *mq_dst, struct mbufq *mq_src)
+{
+	STAILQ_CONCAT(&mq_dst->mq_head, &mq_src->mq_head);
+	mq_dst->mq_len += mq_src->mq_len;
+	mq_src->mq_len = 0;
+}
+
+static inline void
+mbufq_drain(struct mbufq *mq)
+{
+	struct mbuf *m;
+
+	while ((m = mbufq_dequeue(mq)) != NULL)
+		m_freem(m);
+}
+
+/*
+ * netinet: glibc's headers, and what only FreeBSD's have. The checksum
+ * routines of machine/in_cksum.h are in kern/mbuf.c.
+ */
+#define IPV6_VERSION		0x60
+#define TH_CWR			0x80
+
+struct ip6_hdr;
+
+u_short		 in_cksum_skip(struct mbuf *, int, int);
+u_short		 in_pseudo(u_int, u_int, u_int);
+int		 in6_cksum_pseudo(struct ip6_hdr *, uint32_t, uint8_t,
+		    uint16_t);
+void		 in_delayed_cksum(struct mbuf *);
+void		 in6_delayed_cksum(struct mbuf *, uint32_t, u_short);
+int		 ip6_lasthdr(const struct mbuf *, int, int, int *);
+#define in_cksum(m, len)	in_cksum_skip((m), (len), 0)
+
+/*
+ * sys/gtaskqueue.h: a grouptask only counts the times it was enqueued, and
+ * the tests run its work themselves.
+ */
+struct grouptask {
+	volatile u_int gt_enqueued;
+};
+#define GROUPTASK_ENQUEUE(gt)						\
+	__atomic_fetch_add(&(gt)->gt_enqueued, 1, __ATOMIC_RELAXED)
+
+/* sys/counter.h: one counter for every CPU. */
+typedef uint64_t *counter_u64_t;
+#define counter_u64_add(c, n)	__atomic_fetch_add((c), (n), __ATOMIC_RELAXED)
+
+/* net/if_var.h: the interface counters are not kept. */
+#define IFCOUNTER_OERRORS	1
+#define IFCOUNTER_OQDROPS	2
+#define if_inc_counter(ifp, cnt, n)	((void)(ifp), (void)(n))
+
+/* Everything below is only ever used by pointer or embedded, never touched
+ * by the handshake itself.
+ */
+struct socket;
+struct ifnet;
+struct taskq;
+struct radix_node_head;
+struct radix_node {
+	int rn_unused;
+};
+struct route {
+	void *ro_rt;
+};
+struct route_in6 {
+	void *ro_rt;
+};
+typedef uint32_t rt_gen_t;
+typedef struct crypto_session *crypto_session_t;
+typedef void *if_softc_ctx_t;
+typedef void *if_ctx_t;
+
+#define CK_LIST_HEAD		LIST_HEAD
+#define CK_LIST_ENTRY		LIST_ENTRY
+
+#include <sys/support.h>
+
+#endif
@@ -0,0 +1,387 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * The mbuf routines of kern.h. Clusters are malloc'd at the size asked for
+ * and carry a reference count, so that m_copym shares them the way the
+ * kernel's does and M_WRITABLE tells a shared cluster from a private one.
+ * The Internet checksum routines, which walk mbufs, are here as well.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/udp.h>
+
+static void
+m_init(struct mbuf *m, short type, int flags)
+{
+	bzero(m, offsetof(struct mbuf, m_dat));
+	m->m_type = type;
+	m->m_flags = flags;
+	m->m_data = m->m_dat;
+	if (flags & M_PKTHDR)
+		SLIST_INIT(&m->m_pkthdr.tags);
+}
+
+struct mbuf *
+m_get(int how, short type)
+{
+	struct mbuf *m;
+
+	if ((m = malloc(sizeof(*m), M_TEMP, how)) != NULL)
+		m_init(m, type, 0);
+	return (m);
+}
+
+struct mbuf *
+m_gethdr(int how, short type)
+{
+	struct mbuf *m;
+
+	if ((m = malloc(sizeof(*m), M_TEMP, how)) != NULL)
+		m_init(m, type, M_PKTHDR);
+	return (m);
+}
+
+static int
+m_cljset(struct mbuf *m, int size, int how)
+{
+	u_int *cnt;
+	char *buf;
+
+	if ((buf = malloc(size, M_TEMP, how)) == NULL)
+		return (ENOMEM);
+	if ((cnt = malloc(sizeof(*cnt), M_TEMP, how)) == NULL) {
+		free(buf, M_TEMP);
+		return (ENOMEM);
+	}
+	*cnt = 1;
+	m->m_ext.ext_buf = buf;
+	m->m_ext.ext_size = size;
+	m->m_ext.ext_cnt = cnt;
+	m->m_flags |= M_EXT;
+	m->m_data = buf;
+	return (0);
+}
+
+struct mbuf *
+m_getjcl(int how, short type, int flags, int size)
+{
+	struct mbuf *m;
+
+	if ((m = malloc(sizeof(*m), M_TEMP, how)) == NULL)
+		return (NULL);
+	m_init(m, type, flags);
+	if (m_cljset(m, size, how) != 0) {
+		free(m, M_TEMP);
+		return (NULL);
+	}
+	return (m);
+}
+
+struct mbuf *
+m_getcl(int how, short type, int flags)
+{
+	return (m_getjcl(how, type, flags, MCLBYTES));
+}
+
+struct mbuf *
+m_get2(int size, int how, short type, int flags)
+{
+	if (size <= MSIZE)
+		return (flags & M_PKTHDR ? m_gethdr(how, type) :
+		    m_get(how, type));
+	if (size <= MCLBYTES)
+		return (m_getjcl(how, type, flags, MCLBYTES));
+	if (size <= MJUMPAGESIZE)
+		return (m_getjcl(how, type, flags, MJUMPAGESIZE));
+	return (NULL);
+}
+
+static void
+m_tag_delete_chain(struct mbuf *m)
+{
+	struct m_tag *t;
+
+	while ((t = SLIST_FIRST(&m->m_pkthdr.tags)) != NULL) {
+		SLIST_REMOVE_HEAD(&m->m_pkthdr.tags, m_tag_link);
+		t->m_tag_free(t);
+	}
+}
+
+struct mbuf *
+m_free(struct mbuf *m)
+{
+	struct mbuf *n = m->m_next;
+
+	if (m->m_flags & M_PKTHDR)
+		m_tag_delete_chain(m);
+	if ((m->m_flags & M_EXT) &&
+	    __atomic_sub_fetch(m->m_ext.ext_cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+		free(m->m_ext.ext_buf, M_TEMP);
+		free((void *)m->m_ext.ext_cnt, M_TEMP);
+	}
+	free(m, M_TEMP);
+	return (n);
+}
+
+void
+m_freem(struct mbuf *m)
+{
+	while (m != NULL)
+		m = m_free(m);
+}
+
+void
+m_copydata(const struct mbuf *m, int off, int len, caddr_t cp)
+{
+	int count;
+
+	for (; off >= m->m_len; m = m->m_next)
+		off -= m->m_len;
+	for (; len > 0; m = m->m_next, off = 0) {
+		count = MIN(m->m_len - off, len);
+		memcpy(cp, mtod(m, caddr_t) + off, count);
+		len -= count;
+		cp += count;
+	}
+}
+
+/* Clusters are shared with the copy, small mbufs are copied. */
+struct mbuf *
+m_copym(struct mbuf *m, int off, int len, int how)
+{
+	struct mbuf *top = NULL, **np = &top, *n;
+	bool first = off == 0 && (m->m_flags & M_PKTHDR);
+
+	for (; off >= m->m_len; m = m->m_next)
+		off -= m->m_len;
+	for (; len > 0; m = m->m_next, off = 0) {
+		n = first ? m_gethdr(how, m->m_type) : m_get(how, m->m_type);
+		if (n == NULL) {
+			m_freem(top);
+			return (NULL);
+		}
+		if (first) {
+			m_dup_pkthdr(n, m, how);
+			first = false;
+		}
+		n->m_len = MIN(m->m_len - off, len);
+		if (m->m_flags & M_EXT) {
+			n->m_ext = m->m_ext;
+			n->m_flags |= M_EXT;
+			n->m_data = mtod(m, caddr_t) + off;
+			__atomic_add_fetch(m->m_ext.ext_cnt, 1,
+			    __ATOMIC_RELAXED);
+		} else {
+			memcpy(n->m_data, mtod(m, caddr_t) + off, n->m_len);
+		}
+		len -= n->m_len;
+		*np = n;
+		np = &n->m_next;
+	}
+	return (top);
+}
+
+/* Into the first mbuf, which has to be a plain one with room. */
+struct mbuf *
+m_pullup(struct mbuf *m, int len)
+{
+	struct mbuf *n;
+	int count;
+
+	if (m->m_len >= len)
+		return (m);
+	if (len > MSIZE || (m->m_flags & M_EXT) ||
+	    m->m_data + len > m->m_dat + MSIZE) {
+		m_freem(m);
+		return (NULL);
+	}
+	while (m->m_len < len && (n = m->m_next) != NULL) {
+		count = MIN(len - m->m_len, n->m_len);
+		memcpy(m->m_data + m->m_len, mtod(n, caddr_t), count);
+		m->m_len += count;
+		n->m_len -= count;
+		n->m_data += count;
+		if (n->m_len == 0)
+			m->m_next = m_free(n);
+	}
+	if (m->m_len < len) {
+		m_freem(m);
+		return (NULL);
+	}
+	return (m);
+}
+
+int
+m_append(struct mbuf *m, int len, const void *cp)
+{
+	struct mbuf *n;
+	int count;
+
+	while (m->m_next != NULL)
+		m = m->m_next;
+	count = MIN(M_TRAILINGSPACE(m), len);
+	for (;;) {
+		memcpy(m->m_data + m->m_len, cp, count);
+		m->m_len += count;
+		cp = (const char *)cp + count;
+		len -= count;
+		if (len == 0)
+			return (1);
+		if ((n = m_get(M_NOWAIT, m->m_type)) == NULL)
+			return (0);
+		m->m_next = n;
+		m = n;
+		count = MIN(MSIZE, len);
+	}
+}
+
+void
+m_move_pkthdr(struct mbuf *to, struct mbuf *from)
+{
+	to->m_flags = (from->m_flags & M_COPYFLAGS) | (to->m_flags & M_EXT);
+	if ((to->m_flags & M_EXT) == 0)
+		to->m_data = to->m_pktdat;
+	to->m_pkthdr = from->m_pkthdr;
+	SLIST_INIT(&from->m_pkthdr.tags);
+	from->m_flags &= ~M_PKTHDR;
+}
+
+/* Tags are not copied: the tests never tag a packet they duplicate. */
+int
+m_dup_pkthdr(struct mbuf *to, const struct mbuf *from, int how)
+{
+	MPASS(SLIST_EMPTY(&from->m_pkthdr.tags));
+	to->m_flags = (from->m_flags & M_COPYFLAGS) | (to->m_flags & M_EXT);
+	if ((to->m_flags & M_EXT) == 0)
+		to->m_data = to->m_pktdat;
+	to->m_pkthdr = from->m_pkthdr;
+	SLIST_INIT(&to->m_pkthdr.tags);
+	return (1);
+}
+
+void
+m_tag_prepend(struct mbuf *m, struct m_tag *t)
+{
+	SLIST_INSERT_HEAD(&m->m_pkthdr.tags, t, m_tag_link);
+}
+
+void
+m_tag_delete(struct mbuf *m, struct m_tag *t)
+{
+	SLIST_REMOVE(&m->m_pkthdr.tags, t, m_tag, m_tag_link);
+	t->m_tag_free(t);
+}
+
+struct m_tag *
+m_tag_locate(struct mbuf *m, uint32_t cookie, uint16_t type,
+    struct m_tag *t)
+{
+	t = t == NULL ? SLIST_FIRST(&m->m_pkthdr.tags) :
+	    SLIST_NEXT(t, m_tag_link);
+	for (; t != NULL; t = SLIST_NEXT(t, m_tag_link))
+		if (t->m_tag_cookie == cookie && t->m_tag_id == type)
+			return (t);
+	return (NULL);
+}
+
+static u_short
+in_cksum_fold(uint64_t sum)
+{
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+	return (sum);
+}
+
+/* The ones' complement of the sum of bytes skip to len, in network order. */
+u_short
+in_cksum_skip(struct mbuf *m, int len, int skip)
+{
+	uint64_t sum = 0;
+	uint8_t *p;
+	int i, pos = 0;
+
+	for (; m != NULL && pos < len; m = m->m_next) {
+		p = mtod(m, uint8_t *);
+		for (i = 0; i < m->m_len && pos < len; i++, pos++) {
+			if (pos < skip)
+				continue;
+			sum += (pos - skip) & 1 ? p[i] : p[i] << 8;
+		}
+	}
+	return (~htons(in_cksum_fold(sum)) & 0xffff);
+}
+
+u_short
+in_pseudo(u_int a, u_int b, u_int c)
+{
+	return (in_cksum_fold((uint64_t)a + b + c));
+}
+
+int
+in6_cksum_pseudo(struct ip6_hdr *ip6, uint32_t len, uint8_t nxt,
+    uint16_t csum)
+{
+	const uint16_t *w = (const uint16_t *)&ip6->ip6_src;
+	uint64_t sum = csum;
+	int i;
+
+	/* Source and destination, then the length and next header. */
+	for (i = 0; i < 16; i++)
+		sum += w[i];
+	sum += htonl(len) >> 16;
+	sum += htonl(len) & 0xffff;
+	sum += htons(nxt);
+	return (in_cksum_fold(sum));
+}
+
+/*
+ * Stores the checksum at csum_data past off, over the bytes from off to
+ * len; the stack left the pseudo-header sum in its place. UDP sends a zero
+ * sum as all ones.
+ */
+static void
+in_delayed_cksum_store(struct mbuf *m, int len, int off)
+{
+	u_short csum;
+
+	csum = in_cksum_skip(m, len, off);
+	if (csum == 0 && (m->m_pkthdr.csum_flags &
+	    (CSUM_UDP | CSUM_UDP_IPV6)) != 0)
+		csum = 0xffff;
+	MPASS(off + m->m_pkthdr.csum_data + sizeof(csum) <= m->m_len);
+	memcpy(mtod(m, char *) + off + m->m_pkthdr.csum_data, &csum,
+	    sizeof(csum));
+}
+
+void
+in_delayed_cksum(struct mbuf *m)
+{
+	struct ip *ip = mtod(m, struct ip *);
+
+	in_delayed_cksum_store(m, ntohs(ip->ip_len), ip->ip_hl << 2);
+}
+
+void
+in6_delayed_cksum(struct mbuf *m, uint32_t plen, u_short off)
+{
+	in_delayed_cksum_store(m, off + plen, off);
+}
+
+/* The tests send no extension headers. */
+int
+ip6_lasthdr(const struct mbuf *m, int off, int proto, int *nxtp)
+{
+	const struct ip6_hdr *ip6 = mtod(m, const struct ip6_hdr *);
+
+	MPASS(off == 0 && proto == IPPROTO_IPV6);
+	*nxtp = ip6->ip6_nxt;
+	return (sizeof(*ip6));
+}
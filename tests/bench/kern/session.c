@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Mirrors of the if_wg_session.c functions that if_wg_noise.c and
+ * if_wg_cookie.c depend on, for the programs that build those unmodified.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/malloc.h>
+#include <sys/refcount.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/wg_module.h>
+
+MALLOC_DEFINE(M_WG, "WG", "wireguard");
+uma_zone_t wg_keypair_zone;
+
+int
+wg_timers_expired(struct timespec *birthdate, time_t sec, long nsec)
+{
+	struct timespec time;
+	struct timespec diff = { .tv_sec = sec, .tv_nsec = nsec };
+
+	getnanotime(&time);
+	timespecsub(&time, &diff, &time);
+	return timespeccmp(birthdate, &time, <) ? ETIMEDOUT : 0;
+}
+
+void
+wg_peer_queue_handshake_initiation(struct wg_peer *peer, int is_retry)
+{
+}
+
+struct wg_peer *
+wg_peer_ref(struct wg_peer *peer)
+{
+	if (peer != NULL)
+		refcount_acquire(&peer->p_refcnt);
+	return (peer);
+}
+
+/* Peers live until the program exits, so the last reference is never freed. */
+void
+wg_peer_put(struct wg_peer *peer)
+{
+	if (peer != NULL)
+		refcount_release(&peer->p_refcnt);
+}
+
+void
+wg_hashtable_init(struct wg_hashtable *ht)
+{
+	mtx_init(&ht->h_mtx, "hash lock", NULL, MTX_DEF);
+	arc4random_buf(&ht->h_secret, sizeof(ht->h_secret));
+	ht->h_num_peers = 0;
+	ht->h_num_keys = 0;
+	ht->h_peers_mask = HASHTABLE_PEER_SIZE - 1;
+	ht->h_keys_mask = HASHTABLE_INDEX_SIZE - 1;
+	ht->h_peers = calloc(HASHTABLE_PEER_SIZE, sizeof(*ht->h_peers));
+	ht->h_keys = calloc(HASHTABLE_INDEX_SIZE, sizeof(*ht->h_keys));
+}
+
+/* Public keys are uniformly random here, so they need no keyed hash. */
+void
+wg_hashtable_peer_insert(struct wg_hashtable *ht, struct wg_peer *peer)
+{
+	uint32_t key;
+
+	key = le32dec(peer->p_remote.r_public) ^ ht->h_secret.k0;
+
+	mtx_lock(&ht->h_mtx);
+	ht->h_num_peers++;
+	peer = wg_peer_ref(peer);
+	LIST_INSERT_HEAD(&ht->h_peers[key & ht->h_peers_mask], peer, p_entry);
+	mtx_unlock(&ht->h_mtx);
+}
+
+struct wg_peer *
+wg_hashtable_peer_lookup(struct wg_hashtable *ht,
+			 const uint8_t pubkey[WG_KEY_SIZE])
+{
+	uint32_t key;
+	struct wg_peer *i, *peer = NULL;
+
+	key = le32dec(pubkey) ^ ht->h_secret.k0;
+
+	mtx_lock(&ht->h_mtx);
+	LIST_FOREACH(i, &ht->h_peers[key & ht->h_peers_mask], p_entry) {
+		if (timingsafe_bcmp(i->p_remote.r_public, pubkey,
+					WG_KEY_SIZE) == 0) {
+			peer = wg_peer_ref(i);
+			break;
+		}
+	}
+	mtx_unlock(&ht->h_mtx);
+
+	return peer;
+}
+
+uint32_t
+wg_hashtable_keypair_insert(struct wg_hashtable *ht,
+			    struct noise_keypair *keypair)
+{
+	uint32_t index;
+	struct noise_keypair *i;
+
+	mtx_lock(&ht->h_mtx);
+	ht->h_num_keys++;
+assign_id:
+	index = arc4random();
+	LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry)
+		if (i->k_local_index == index)
+			goto assign_id;
+
+	keypair->k_local_index = index;
+	keypair = noise_keypair_ref(keypair);
+	LIST_INSERT_HEAD(&ht->h_keys[index & ht->h_keys_mask], keypair, k_entry);
+
+	mtx_unlock(&ht->h_mtx);
+	return index;
+}
+
+struct noise_keypair *
+wg_hashtable_keypair_lookup(struct wg_hashtable *ht, const uint32_t index)
+{
+	struct noise_keypair *i, *keypair = NULL;
+
+	mtx_lock(&ht->h_mtx);
+	LIST_FOREACH(i, &ht->h_keys[index & ht->h_keys_mask], k_entry) {
+		if (i->k_local_index == index) {
+			keypair = noise_keypair_ref(i);
+			break;
+		}
+	}
+	mtx_unlock(&ht->h_mtx);
+
+	return keypair;
+}
+
+void
+wg_hashtable_keypair_remove(struct wg_hashtable *ht,
+			    struct noise_keypair *keypair)
+{
+	mtx_lock(&ht->h_mtx);
+	ht->h_num_keys--;
+	LIST_REMOVE(keypair, k_entry);
+	noise_keypair_put(keypair);
+	mtx_unlock(&ht->h_mtx);
+}
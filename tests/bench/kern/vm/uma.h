@@ -0,0 +1 @@
+/* Provided by kern.h. */
@@ -0,0 +1,383 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Data messages through module/if_wg_mbuf.c, built unmodified against the
+ * mbufs of kern/mbuf.c. Packets are shaped the way the stack hands them to
+ * wg_transmit: chains of a header mbuf and clusters, and clusters still
+ * shared with the socket buffer TCP would retransmit from. Each is framed
+ * and sealed as the inline encrypt path does, then checked to be one
+ * writable mbuf, with room left for the outer header, that opens to the
+ * original plaintext, with its tags moved along and the socket buffer left
+ * as it was. TCP segments left to TSO, IPv4 and IPv6, are cut by
+ * wg_mbuf_tso and each packet checked to be such an mbuf already, with its
+ * headers and checksums right, and sealed where it lies.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/tcp.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_mbuf.h>
+
+#include <zinc/chacha20poly1305.h>
+
+#define MBUF_TEST_COOKIE	0x77677465
+
+struct mbuf_test_tag {
+	struct m_tag		 t_tag;
+	bool			*t_freed;
+};
+
+static uint8_t mbuf_test_key[CHACHA20POLY1305_KEY_SIZE];
+static int mbuf_test_failed;
+
+#define mbuf_test_check(name, exp) do {					\
+	if (!(exp)) {							\
+		fprintf(stderr, "mbuf-test: %s: %s\n", (name), #exp);	\
+		mbuf_test_failed++;					\
+	}								\
+} while (0)
+
+static void
+mbuf_test_tag_free(struct m_tag *t)
+{
+	*((struct mbuf_test_tag *)t)->t_freed = true;
+	free(t, M_TEMP);
+}
+
+static void
+mbuf_test_tag(struct mbuf *m, bool *freed)
+{
+	struct mbuf_test_tag *t;
+
+	t = malloc(sizeof(*t), M_TEMP, M_WAITOK | M_ZERO);
+	t->t_tag.m_tag_cookie = MBUF_TEST_COOKIE;
+	t->t_tag.m_tag_free = mbuf_test_tag_free;
+	t->t_freed = freed;
+	*freed = false;
+	m_tag_prepend(m, &t->t_tag);
+}
+
+/*
+ * A socket buffer of len bytes of pattern in clusters, and the packet
+ * tcp_output would build from it: headers in an mbuf of their own, then the
+ * payload as an m_copym of the socket buffer, sharing its clusters.
+ */
+static struct mbuf *
+mbuf_test_sb(const uint8_t *pattern, int len, int clsize)
+{
+	struct mbuf *top = NULL, **np = &top, *m;
+	int off;
+
+	for (off = 0; off < len; off += m->m_len) {
+		m = m_getjcl(M_WAITOK, MT_DATA, 0, clsize);
+		m->m_len = MIN(clsize, len - off);
+		memcpy(mtod(m, void *), pattern + off, m->m_len);
+		*np = m;
+		np = &m->m_next;
+	}
+	return (top);
+}
+
+static struct mbuf *
+mbuf_test_packet(const uint8_t *plain, int hlen, struct mbuf *sb, int len)
+{
+	struct mbuf *m;
+
+	m = m_gethdr(M_WAITOK, MT_DATA);
+	m->m_data += 64;
+	m->m_len = hlen;
+	memcpy(mtod(m, void *), plain, hlen);
+	if (len > hlen)
+		m->m_next = m_copym(sb, 0, len - hlen, M_WAITOK);
+	m->m_pkthdr.len = len;
+	return (m);
+}
+
+/* Frames and seals m as packet nonce, and checks what comes out. */
+static void
+mbuf_test_seal(const char *name, struct mbuf *m, const uint8_t *plain,
+    int len, bool copied)
+{
+	struct mbuf *orig = m;
+	struct wg_pkt_data *data;
+	uint8_t *out;
+	bool freed;
+	int padded;
+
+	mbuf_test_tag(m, &freed);
+	m = wg_mbuf_data_frame(m, 0x12345678, 42);
+	mbuf_test_check(name, m != NULL);
+	if (m == NULL)
+		return;
+	mbuf_test_check(name, (m != orig) == copied);
+	wg_mbuf_data_seal(m, mbuf_test_key);
+
+	padded = len + WG_PADDING_SIZE(len);
+	mbuf_test_check(name, m->m_next == NULL);
+	mbuf_test_check(name, M_WRITABLE(m));
+	mbuf_test_check(name, M_LEADINGSPACE(m) >= WG_IPUDP_HDR_MAX);
+	mbuf_test_check(name, m->m_len == m->m_pkthdr.len);
+	mbuf_test_check(name, m->m_pkthdr.len ==
+	    (int)sizeof(struct wg_pkt_data) + padded + WG_MAC_SIZE);
+	mbuf_test_check(name, m_tag_locate(m, MBUF_TEST_COOKIE, 0, NULL) !=
+	    NULL);
+
+	data = mtod(m, struct wg_pkt_data *);
+	mbuf_test_check(name, data->header.type == WG_PKT_DATA);
+	mbuf_test_check(name, data->receiver_index == 0x12345678);
+	mbuf_test_check(name, le64toh(data->nonce) == 42);
+
+	out = malloc(padded, M_TEMP, M_WAITOK);
+	mbuf_test_check(name, chacha20poly1305_decrypt(out, data->buf,
+	    padded + WG_MAC_SIZE, NULL, 0, 42, mbuf_test_key));
+	mbuf_test_check(name, memcmp(out, plain, len) == 0);
+	while (len < padded)
+		mbuf_test_check(name, out[len++] == 0);
+	free(out, M_TEMP);
+
+	m_freem(m);
+	mbuf_test_check(name, freed);
+}
+
+/* The ones' complement sum of len bytes, added to sum. */
+static uint16_t
+mbuf_test_cksum(const uint8_t *p, int len, uint32_t sum)
+{
+	int i;
+
+	for (i = 0; i < len; i++)
+		sum += i & 1 ? p[i] : p[i] << 8;
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+	return (sum);
+}
+
+/*
+ * IP and TCP headers, checksums left out, of a packet of len bytes from seq
+ * with the IPv4 id and the TCP flags.
+ */
+static int
+mbuf_test_tcp_hdr(uint8_t *p, bool v4, int len, uint32_t seq, uint16_t id,
+    uint8_t flags)
+{
+	struct ip *ip = (struct ip *)p;
+	struct ip6_hdr *ip6 = (struct ip6_hdr *)p;
+	struct tcphdr *th;
+	int iphlen, hlen;
+
+	iphlen = v4 ? sizeof(struct ip) : sizeof(struct ip6_hdr);
+	hlen = iphlen + sizeof(struct tcphdr) + 12;
+	bzero(p, hlen);
+	if (v4) {
+		ip->ip_v = IPVERSION;
+		ip->ip_hl = sizeof(struct ip) >> 2;
+		ip->ip_len = htons(len);
+		ip->ip_id = htons(id);
+		ip->ip_ttl = 64;
+		ip->ip_p = IPPROTO_TCP;
+		ip->ip_src.s_addr = htonl(0x0a000001);
+		ip->ip_dst.s_addr = htonl(0x0a000002);
+	} else {
+		ip6->ip6_flow = htonl(IPV6_VERSION << 24);
+		ip6->ip6_plen = htons(len - iphlen);
+		ip6->ip6_nxt = IPPROTO_TCP;
+		ip6->ip6_hlim = 64;
+		ip6->ip6_src.s6_addr[0] = 0xfd;
+		ip6->ip6_src.s6_addr[15] = 1;
+		ip6->ip6_dst.s6_addr[0] = 0xfd;
+		ip6->ip6_dst.s6_addr[15] = 2;
+	}
+	th = (struct tcphdr *)(p + iphlen);
+	th->th_sport = htons(22);
+	th->th_dport = htons(50000);
+	th->th_seq = htonl(seq);
+	th->th_off = (hlen - iphlen) >> 2;
+	th->th_flags = flags;
+	th->th_win = htons(65535);
+	/* A timestamp option, as TCP sends with every segment. */
+	memcpy(p + iphlen + sizeof(struct tcphdr),
+	    "\x01\x01\x08\x0a\x00\x00\x00\x01\x00\x00\x00\x02", 12);
+	return (hlen);
+}
+
+/* Whether the IP and TCP checksums of the packet p of len bytes hold. */
+static bool
+mbuf_test_tcp_cksum(const uint8_t *p, bool v4, int len)
+{
+	const struct ip6_hdr *ip6 = (const struct ip6_hdr *)p;
+	const struct ip *ip = (const struct ip *)p;
+	uint8_t pseudo[40];
+	int iphlen, tlen;
+
+	if (v4) {
+		iphlen = ip->ip_hl << 2;
+		if (mbuf_test_cksum(p, iphlen, 0) != 0xffff)
+			return (false);
+		tlen = len - iphlen;
+		memcpy(pseudo, &ip->ip_src, 8);
+		pseudo[8] = 0;
+		pseudo[9] = IPPROTO_TCP;
+		pseudo[10] = tlen >> 8;
+		pseudo[11] = tlen;
+		return (mbuf_test_cksum(p + iphlen, tlen,
+		    mbuf_test_cksum(pseudo, 12, 0)) == 0xffff);
+	}
+	iphlen = sizeof(struct ip6_hdr);
+	tlen = len - iphlen;
+	bzero(pseudo, sizeof(pseudo));
+	memcpy(pseudo, &ip6->ip6_src, 32);
+	pseudo[34] = tlen >> 8;
+	pseudo[35] = tlen;
+	pseudo[39] = IPPROTO_TCP;
+	return (mbuf_test_cksum(p + iphlen, tlen,
+	    mbuf_test_cksum(pseudo, 40, 0)) == 0xffff);
+}
+
+/*
+ * A TSO segment of total bytes, the payload shared with the socket buffer,
+ * cut into packets of segsz payload bytes that must each come out as the
+ * stack would have sent it on its own, framed and sealed in place.
+ */
+static void
+mbuf_test_tso(const char *name, bool v4, const uint8_t *payload, int total,
+    int segsz)
+{
+	uint8_t hdr[128], pkt[128 + 9000];
+	struct mbuf *sb, *m, *n;
+	struct mbufq mq;
+	struct tcphdr *th;
+	int hlen, iphlen, off, len, count;
+	uint8_t flags;
+
+	iphlen = v4 ? sizeof(struct ip) : sizeof(struct ip6_hdr);
+	hlen = mbuf_test_tcp_hdr(hdr, v4, total, 1000, 7,
+	    TH_ACK | TH_PUSH | TH_FIN | TH_CWR);
+	sb = mbuf_test_sb(payload, total - hlen, MCLBYTES);
+	m = mbuf_test_packet(hdr, hlen, sb, total);
+	m->m_pkthdr.csum_flags = v4 ? CSUM_IP_TSO : CSUM_IP6_TSO;
+	m->m_pkthdr.tso_segsz = segsz;
+
+	mbufq_init(&mq, INT_MAX);
+	mbuf_test_check(name, wg_mbuf_tso(m, &mq) == 0);
+	count = (total - hlen + segsz - 1) / segsz;
+	mbuf_test_check(name, mbufq_len(&mq) == count);
+
+	for (off = 0; (n = mbufq_dequeue(&mq)) != NULL; off += len) {
+		len = MIN(segsz, total - hlen - off);
+		mbuf_test_check(name, n->m_next == NULL);
+		mbuf_test_check(name, M_WRITABLE(n));
+		mbuf_test_check(name, M_LEADINGSPACE(n) >= WG_IPUDP_HDR_MAX +
+		    (int)sizeof(struct wg_pkt_data));
+		mbuf_test_check(name, M_TRAILINGSPACE(n) >=
+		    WG_PADDING_SIZE(hlen + len) + WG_MAC_SIZE);
+		mbuf_test_check(name, n->m_pkthdr.len == hlen + len);
+		mbuf_test_check(name, n->m_len == n->m_pkthdr.len);
+		mbuf_test_check(name, n->m_pkthdr.csum_flags == 0);
+		mbuf_test_check(name, n->m_pkthdr.tso_segsz == 0);
+
+		/*
+		 * As TCP would have sent it on its own: FIN and PUSH on the
+		 * last packet only, CWR on the first.
+		 */
+		flags = TH_ACK;
+		if (off + len == total - hlen)
+			flags |= TH_PUSH | TH_FIN;
+		if (off == 0)
+			flags |= TH_CWR;
+		mbuf_test_tcp_hdr(pkt, v4, hlen + len, 1000 + off,
+		    7 + off / segsz, flags);
+		memcpy(hdr, mtod(n, uint8_t *), hlen);
+		if (v4)
+			((struct ip *)hdr)->ip_sum = 0;
+		th = (struct tcphdr *)(hdr + iphlen);
+		th->th_sum = 0;
+		mbuf_test_check(name, memcmp(hdr, pkt, hlen) == 0);
+		mbuf_test_check(name, memcmp(mtod(n, uint8_t *) + hlen,
+		    payload + off, len) == 0);
+		mbuf_test_check(name, mbuf_test_tcp_cksum(mtod(n, uint8_t *),
+		    v4, hlen + len));
+
+		memcpy(pkt, mtod(n, uint8_t *), hlen + len);
+		mbuf_test_seal(name, n, pkt, hlen + len, false);
+	}
+	mbuf_test_check(name, off == total - hlen);
+
+	/* The socket buffer is as it was. */
+	for (off = 0, m = sb; m != NULL; off += m->m_len, m = m->m_next) {
+		mbuf_test_check(name, M_WRITABLE(m));
+		mbuf_test_check(name,
+		    memcmp(mtod(m, void *), payload + off, m->m_len) == 0);
+	}
+	m_freem(sb);
+}
+
+int
+main(void)
+{
+	uint8_t plain[9000], saved[9000];
+	struct mbuf *sb, *m;
+	int len;
+
+	arc4random_buf(mbuf_test_key, sizeof(mbuf_test_key));
+	arc4random_buf(plain, sizeof(plain));
+
+	/* A full-sized TCP segment, the payload shared with the socket. */
+	len = 1420;
+	sb = mbuf_test_sb(plain + 52, len - 52, MCLBYTES);
+	memcpy(saved, plain, sizeof(saved));
+	m = mbuf_test_packet(plain, 52, sb, len);
+	mbuf_test_seal("shared chain", m, plain, len, true);
+	m = sb;
+	for (len = 52; m != NULL; m = m->m_next) {
+		mbuf_test_check("socket buffer", M_WRITABLE(m));
+		mbuf_test_check("socket buffer",
+		    memcmp(mtod(m, void *), saved + len, m->m_len) == 0);
+		len += m->m_len;
+	}
+
+	/* The same after the socket buffer let go of its clusters. */
+	len = 1420;
+	m = mbuf_test_packet(plain, 52, sb, len);
+	m_freem(sb);
+	mbuf_test_seal("private chain", m, plain, len, true);
+
+	/* A jumbo frame over several clusters. */
+	len = 9000;
+	sb = mbuf_test_sb(plain + 52, len - 52, MCLBYTES);
+	m = mbuf_test_packet(plain, 52, sb, len);
+	mbuf_test_seal("jumbo chain", m, plain, len, true);
+	m_freem(sb);
+
+	/* One cluster of its own with room around it is not copied. */
+	len = 1337;
+	m = m_getcl(M_WAITOK, MT_DATA, M_PKTHDR);
+	m->m_data += WG_IPUDP_HDR_MAX + sizeof(struct wg_pkt_data);
+	memcpy(mtod(m, void *), plain, len);
+	m->m_len = m->m_pkthdr.len = len;
+	mbuf_test_seal("private cluster", m, plain, len, false);
+
+	/* Nor is a keepalive. */
+	m = m_gethdr(M_WAITOK, MT_DATA);
+	m->m_data += WG_IPUDP_HDR_MAX + sizeof(struct wg_pkt_data);
+	mbuf_test_seal("keepalive", m, plain, 0, false);
+
+	/* TSO segments, the last packet short, and one packet alone. */
+	mbuf_test_tso("tso ipv4", true, plain, 9000, 1368);
+	mbuf_test_tso("tso ipv6", false, plain, 9000, 1348);
+	mbuf_test_tso("tso single", true, plain, 1000, 1368);
+
+	if (mbuf_test_failed != 0)
+		return (1);
+	printf("mbuf-test: ok\n");
+	return (0);
+}
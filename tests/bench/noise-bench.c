@@ -0,0 +1,372 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * Handshake rate of module/if_wg_noise.c: N initiating peers, each with its
+ * own softc, complete full Noise_IK handshakes against one responding softc
+ * from M threads. The handshake code, the kmod's BLAKE2s and Curve25519, and
+ * zinc's ChaCha20Poly1305 are built unmodified; the softc plumbing that
+ * lives in if_wg_session.c is mirrored in kern/session.c. Ephemeral keys come from the
+ * per-CPU pools unless -E is given; -i leaves the pools time to refill
+ * between handshakes, as they would have between real ones. With -b the
+ * responder takes initiations in batches, as wg_softc_handshake_receive
+ * does with net.wg.handshake_batch set. The responder's own share of the work, consuming initiations and
+ * creating responses, is timed apart from the rest and reported per core.
+ * Results are written to stdout as JSON.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/malloc.h>
+#include <sys/refcount.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/wg_module.h>
+
+#include <inttypes.h>
+#include <unistd.h>
+
+enum noise_bench_values {
+	NOISE_BENCH_PEERS = 64,
+	NOISE_BENCH_ROUNDS = 16,
+	NOISE_BENCH_MAX_THREADS = 256,
+	NOISE_BENCH_BATCH = 1
+};
+
+struct noise_bench_peer {
+	struct wg_softc		 b_sc;
+	struct wg_peer		 b_peer;
+	struct wg_peer		*b_remote;
+};
+
+struct noise_bench_thread {
+	pthread_t		 t_thread;
+	unsigned int		 t_id;
+	size_t			 t_done;
+	uint64_t		*t_nsecs;
+	uint64_t		 t_responder_ns;
+	int			 t_error;
+};
+
+static struct wg_softc noise_bench_responder;
+static struct noise_bench_peer *noise_bench_peers;
+static unsigned int noise_bench_npeers = NOISE_BENCH_PEERS;
+static unsigned int noise_bench_nthreads;
+static unsigned int noise_bench_rounds = NOISE_BENCH_ROUNDS;
+static unsigned int noise_bench_idle_us;
+static unsigned int noise_bench_batch = NOISE_BENCH_BATCH;
+static bool noise_bench_pool = true;
+
+/* Provided by the zinc objects. */
+int chacha20_mod_init(void);
+int poly1305_mod_init(void);
+int chacha20poly1305_mod_init(void);
+
+static uint64_t
+noise_bench_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/* Mirrored in kern/session.c. */
+void	wg_hashtable_peer_insert(struct wg_hashtable *, struct wg_peer *);
+
+static void
+noise_bench_softc_init(struct wg_softc *sc)
+{
+	uint8_t private[WG_KEY_SIZE];
+
+	wg_hashtable_init(&sc->sc_hashtable);
+	noise_local_init(&sc->sc_local);
+	curve25519_generate_secret(private);
+	noise_local_set_private(&sc->sc_local, private);
+	explicit_bzero(private, sizeof(private));
+}
+
+static struct wg_peer *
+noise_bench_peer_init(struct wg_peer *peer, struct wg_softc *sc,
+		      struct wg_softc *remote, const uint8_t psk[WG_KEY_SIZE])
+{
+	refcount_init(&peer->p_refcnt, 1);
+	peer->p_sc = sc;
+	noise_remote_init(&peer->p_remote, remote->sc_local.l_public);
+	noise_remote_set_psk(&peer->p_remote, (uint8_t *)psk);
+	noise_keypairs_init(&peer->p_keypairs);
+	wg_hashtable_peer_insert(&sc->sc_hashtable, peer);
+	return (peer);
+}
+
+/*
+ * Timestamps only have second granularity and the responder accepts a few
+ * initiations per second from any one peer, so both protections are rewound
+ * before every handshake. Nothing else in the handshake is skipped.
+ */
+static void
+noise_bench_rewind(struct wg_peer *peer)
+{
+	mtx_lock(&peer->p_remote.r_mtx);
+	bzero(peer->p_remote.r_ts, sizeof(peer->p_remote.r_ts));
+	bzero(&peer->p_remote.r_last_init, sizeof(peer->p_remote.r_last_init));
+	mtx_unlock(&peer->p_remote.r_mtx);
+}
+
+/*
+ * Full initiations, responses and key derivations for n peers, sequenced as
+ * wg_softc_handshake_receive and wg_peer_send_handshake_* do it. The time
+ * the responder spends is added to *responder_ns.
+ */
+static int
+noise_bench_handshakes(struct noise_bench_peer **bp, unsigned int n,
+		       uint64_t *responder_ns)
+{
+	struct wg_pkt_initiation init[WG_HANDSHAKE_BATCH];
+	struct wg_pkt_initiation *src[WG_HANDSHAKE_BATCH];
+	struct wg_pkt_response resp[WG_HANDSHAKE_BATCH];
+	struct noise_keypair *ikp, *rkp[WG_HANDSHAKE_BATCH];
+	uint64_t start;
+	unsigned int i;
+	int ret = 0;
+
+	for (i = 0; i < n; ++i) {
+		noise_bench_rewind(bp[i]->b_remote);
+		if (noise_handshake_create_initiation(&init[i],
+		    &bp[i]->b_peer) != 0)
+			return (EINVAL);
+		src[i] = &init[i];
+	}
+
+	start = noise_bench_ns();
+	if (n == 1 && noise_bench_batch == 1)
+		rkp[0] = noise_handshake_consume_initiation(src[0],
+		    &noise_bench_responder);
+	else
+		noise_handshake_consume_initiations(src, rkp, n,
+		    &noise_bench_responder);
+	for (i = 0; i < n; ++i) {
+		if (rkp[i] == NULL ||
+		    noise_handshake_create_response(&resp[i],
+		    rkp[i]->k_peer) != 0 ||
+		    noise_keypairs_begin_session(
+		    &rkp[i]->k_peer->p_keypairs) != 0)
+			ret = EINVAL;
+	}
+	*responder_ns += noise_bench_ns() - start;
+
+	for (i = 0; i < n; ++i) {
+		if (ret != 0)
+			break;
+		ikp = noise_handshake_consume_response(&resp[i],
+		    &bp[i]->b_sc);
+		if (ikp == NULL) {
+			ret = EINVAL;
+			break;
+		}
+		if (noise_keypairs_begin_session(&bp[i]->b_peer.p_keypairs)
+		    != 0 ||
+		    timingsafe_bcmp(ikp->k_send, rkp[i]->k_recv,
+		    WG_KEY_SIZE) != 0 ||
+		    timingsafe_bcmp(ikp->k_recv, rkp[i]->k_send,
+		    WG_KEY_SIZE) != 0)
+			ret = EINVAL;
+		noise_keypair_put(ikp);
+	}
+	for (i = 0; i < n; ++i)
+		if (rkp[i] != NULL)
+			noise_keypair_put(rkp[i]);
+	return (ret);
+}
+
+static void *
+noise_bench_thread(void *arg)
+{
+	struct noise_bench_thread *t = arg;
+	struct noise_bench_peer *bp[WG_HANDSHAKE_BATCH];
+	unsigned int round, i, j, n;
+	uint64_t start, elapsed;
+
+	for (round = 0; round < noise_bench_rounds; ++round) {
+		for (i = t->t_id; i < noise_bench_npeers;) {
+			for (n = 0; n < noise_bench_batch &&
+			     i < noise_bench_npeers; i += noise_bench_nthreads)
+				bp[n++] = &noise_bench_peers[i];
+			start = noise_bench_ns();
+			if (noise_bench_handshakes(bp, n,
+			    &t->t_responder_ns) != 0) {
+				t->t_error = EINVAL;
+				return (NULL);
+			}
+			elapsed = noise_bench_ns() - start;
+			for (j = 0; j < n; ++j)
+				t->t_nsecs[t->t_done++] = elapsed / n;
+			if (noise_bench_idle_us != 0)
+				usleep(noise_bench_idle_us);
+		}
+	}
+	return (NULL);
+}
+
+static int
+noise_bench_cmp(const void *a, const void *b)
+{
+	const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint64_t
+noise_bench_percentile(const uint64_t *nsecs, size_t n, unsigned int pct)
+{
+	return nsecs[MIN(n - 1, (n * pct) / 100)];
+}
+
+static void
+usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-E] [-n peers] [-t threads] [-r rounds] "
+		"[-i usecs] [-b batch]\n"
+		"  -E  generate ephemeral keys inline, without the pools\n"
+		"  -n  initiating peers (default %u)\n"
+		"  -t  threads (default: online CPUs)\n"
+		"  -r  handshakes per peer (default %u)\n"
+		"  -i  idle time after each batch of handshakes (default 0)\n"
+		"  -b  initiations consumed together, up to %u (default %u)\n",
+		prog, NOISE_BENCH_PEERS, NOISE_BENCH_ROUNDS,
+		WG_HANDSHAKE_BATCH, NOISE_BENCH_BATCH);
+	exit(1);
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct noise_bench_thread *threads;
+	uint8_t psk[WG_KEY_SIZE];
+	uint64_t *nsecs, start, elapsed, responder_ns;
+	size_t total, n;
+	unsigned int i;
+	int ch;
+
+	noise_bench_nthreads = MAX(1, sysconf(_SC_NPROCESSORS_ONLN));
+	while ((ch = getopt(argc, argv, "En:t:r:i:b:")) != -1) {
+		switch (ch) {
+		case 'E':
+			noise_bench_pool = false;
+			break;
+		case 'n':
+			noise_bench_npeers = strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			noise_bench_nthreads = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			noise_bench_rounds = strtoul(optarg, NULL, 0);
+			break;
+		case 'i':
+			noise_bench_idle_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			noise_bench_batch = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (noise_bench_npeers == 0 || noise_bench_rounds == 0 ||
+	    noise_bench_nthreads == 0 ||
+	    noise_bench_nthreads > NOISE_BENCH_MAX_THREADS ||
+	    noise_bench_batch == 0 || noise_bench_batch > WG_HANDSHAKE_BATCH)
+		usage(argv[0]);
+	noise_bench_nthreads = MIN(noise_bench_nthreads, noise_bench_npeers);
+
+	if (chacha20_mod_init() || poly1305_mod_init() ||
+	    chacha20poly1305_mod_init()) {
+		fprintf(stderr, "chacha20poly1305: self-tests failed\n");
+		return 1;
+	}
+	wg_noise_param_init();
+	if (noise_bench_pool)
+		noise_ephemeral_init();
+	wg_keypair_zone = uma_zcreate("wg keypair",
+	    sizeof(struct noise_keypair), NULL, NULL, NULL, NULL,
+	    UMA_ALIGN_CACHE, 0);
+
+	noise_bench_softc_init(&noise_bench_responder);
+	noise_bench_peers = malloc(noise_bench_npeers *
+	    sizeof(*noise_bench_peers), M_WG, M_WAITOK | M_ZERO);
+	for (i = 0; i < noise_bench_npeers; ++i) {
+		struct noise_bench_peer *bp = &noise_bench_peers[i];
+
+		arc4random_buf(psk, sizeof(psk));
+		noise_bench_softc_init(&bp->b_sc);
+		noise_bench_peer_init(&bp->b_peer, &bp->b_sc,
+				      &noise_bench_responder, psk);
+		bp->b_remote = noise_bench_peer_init(
+		    malloc(sizeof(struct wg_peer), M_WG, M_WAITOK | M_ZERO),
+		    &noise_bench_responder, &bp->b_sc, psk);
+
+		/* Warm up, and check both ends derive the same keys. */
+		if (noise_bench_handshakes(&bp, 1, &responder_ns) != 0) {
+			fprintf(stderr, "peer %u: handshake failed\n", i);
+			return 1;
+		}
+	}
+
+	threads = calloc(noise_bench_nthreads, sizeof(*threads));
+	for (i = 0; i < noise_bench_nthreads; ++i) {
+		threads[i].t_id = i;
+		threads[i].t_nsecs = calloc(noise_bench_rounds *
+		    howmany(noise_bench_npeers, noise_bench_nthreads),
+		    sizeof(uint64_t));
+	}
+
+	start = noise_bench_ns();
+	for (i = 0; i < noise_bench_nthreads; ++i)
+		pthread_create(&threads[i].t_thread, NULL, noise_bench_thread,
+			       &threads[i]);
+	for (i = 0; i < noise_bench_nthreads; ++i)
+		pthread_join(threads[i].t_thread, NULL);
+	elapsed = noise_bench_ns() - start;
+
+	total = 0;
+	responder_ns = 0;
+	for (i = 0; i < noise_bench_nthreads; ++i) {
+		if (threads[i].t_error) {
+			fprintf(stderr, "thread %u: handshake failed\n", i);
+			return 1;
+		}
+		total += threads[i].t_done;
+		responder_ns += threads[i].t_responder_ns;
+	}
+	nsecs = calloc(total, sizeof(*nsecs));
+	for (i = 0, n = 0; i < noise_bench_nthreads; ++i) {
+		memcpy(nsecs + n, threads[i].t_nsecs,
+		       threads[i].t_done * sizeof(*nsecs));
+		n += threads[i].t_done;
+	}
+	qsort(nsecs, total, sizeof(*nsecs), noise_bench_cmp);
+
+	printf("{\n  \"peers\": %u,\n  \"threads\": %u,\n"
+	       "  \"ephemeral_pool\": %s,\n  \"idle_us\": %u,\n"
+	       "  \"batch\": %u,\n"
+	       "  \"handshakes\": %zu,\n  \"seconds\": %.3f,\n"
+	       "  \"handshakes_per_sec\": %.1f,\n"
+	       "  \"responder_per_sec_per_core\": %.1f,\n"
+	       "  \"latency_ns\": { \"min\": %" PRIu64 ", \"p50\": %" PRIu64
+	       ", \"p90\": %" PRIu64 ", \"p99\": %" PRIu64
+	       ", \"max\": %" PRIu64 " }\n}\n",
+	       noise_bench_npeers, noise_bench_nthreads,
+	       noise_bench_pool ? "true" : "false", noise_bench_idle_us,
+	       noise_bench_batch, total, elapsed / 1e9, total * 1e9 / elapsed,
+	       total * 1e9 / responder_ns, nsecs[0],
+	       noise_bench_percentile(nsecs, total, 50),
+	       noise_bench_percentile(nsecs, total, 90),
+	       noise_bench_percentile(nsecs, total, 99), nsecs[total - 1]);
+	return 0;
+}
@@ -0,0 +1,538 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * The peer timers, module/if_wg_timers.c, built unmodified on the timer
+ * wheel of module/if_wg_wheel.c, on a clock the test keeps. What the timers
+ * set off is recorded, not done, but for a handshake initiation, which is
+ * taken to go out at once and so re-arms the retransmit timer.
+ *
+ * Setting a timer only records its deadline; the peer's wheel entry is
+ * rescheduled, keeping its one reference, only for a deadline ahead of the
+ * one it is armed for. Each timer fires once, on time, and the entry is
+ * armed again for the next deadline, or dropped with its reference once
+ * there is none. A timer cancelled or pushed back leaves the entry alone
+ * and does not fire. A handshake is given up once MAX_TIMER_HANDSHAKES
+ * retries have gone unanswered. The peers due in a tick are run in
+ * batches, with one kick of the encrypt task for each, and a stopped peer
+ * fires no more. It all runs again across the wrap of ticks.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/rwlock.h>
+#include <sys/refcount.h>
+
+#include <sys/if_wg_session.h>
+#include <sys/if_wg_session_vars.h>
+#include <sys/if_wg_wheel.h>
+#include <sys/wg_module.h>
+
+#define TIMERS_TEST_HZ		1000
+#define TIMERS_TEST_TICK	(TIMERS_TEST_HZ / WG_WHEEL_HZ)
+#define TIMERS_TEST_PEERS	600
+
+/* A peer, and what its timers set off. */
+struct timers_test_peer {
+	struct wg_peer	 p_peer;
+	int		 p_initiations;
+	int		 p_retries;
+	int		 p_clear_src;
+	int		 p_keepalives;
+	int		 p_flushes;
+	int		 p_zeroed;
+	int		 p_at;		/* When the last of them was. */
+	u_int		 p_kicks;	/* Encrypt task kicks before it. */
+};
+
+volatile int ticks;
+int hz = TIMERS_TEST_HZ;
+
+static struct wg_softc timers_test_sc;
+static struct timers_test_peer timers_test_peers[TIMERS_TEST_PEERS];
+static int timers_test_failed;
+
+#define timers_test_check(name, exp) do {				\
+	if (!(exp)) {							\
+		fprintf(stderr, "timers-test: %s: %s\n", (name), #exp);	\
+		timers_test_failed++;					\
+	}								\
+} while (0)
+
+static struct timers_test_peer *
+timers_test_peer(struct wg_peer *peer)
+{
+	return (__containerof(peer, struct timers_test_peer, p_peer));
+}
+
+static void
+timers_test_record(struct timers_test_peer *tp)
+{
+	tp->p_at = ticks;
+	tp->p_kicks = timers_test_sc.sc_encrypt.gt_enqueued;
+}
+
+/* Sent at once, so the retransmit timer is armed again. */
+void
+wg_peer_queue_handshake_initiation(struct wg_peer *peer, int is_retry)
+{
+	struct timers_test_peer *tp = timers_test_peer(peer);
+
+	tp->p_initiations++;
+	tp->p_retries += is_retry;
+	timers_test_record(tp);
+	wg_peer_timers_handshake_initiated(peer);
+}
+
+void
+wg_peer_clear_src(struct wg_peer *peer)
+{
+	timers_test_peer(peer)->p_clear_src++;
+}
+
+bool
+wg_peer_stage_keepalive(struct wg_peer *peer)
+{
+	struct timers_test_peer *tp = timers_test_peer(peer);
+
+	tp->p_keepalives++;
+	timers_test_record(tp);
+	return (true);
+}
+
+void
+wg_peer_flush_staged_packets(struct wg_peer *peer)
+{
+	timers_test_peer(peer)->p_flushes++;
+}
+
+void
+noise_keypairs_clear(struct noise_keypairs *keypairs)
+{
+	struct timers_test_peer *tp;
+
+	tp = __containerof(keypairs, struct timers_test_peer,
+	    p_peer.p_keypairs);
+	tp->p_zeroed++;
+	timers_test_record(tp);
+}
+
+struct wg_peer *
+wg_peer_ref(struct wg_peer *peer)
+{
+	refcount_acquire(&peer->p_refcnt);
+	return (peer);
+}
+
+void
+wg_peer_put(struct wg_peer *peer)
+{
+	refcount_release(&peer->p_refcnt);
+}
+
+/* The clock moves on, and the wheel's callout runs when it is due. */
+static void
+timers_test_run(int n)
+{
+	struct callout *c = &timers_test_sc.sc_wheel.w_callout;
+
+	while (n-- > 0) {
+		ticks++;
+		if (c->c_pending && ticks - c->c_time >= 0) {
+			c->c_pending = false;
+			c->c_func(c->c_arg);
+		}
+	}
+}
+
+/* Runs the clock to when, which may be behind it already. */
+static void
+timers_test_run_to(int when)
+{
+	if (when - ticks > 0)
+		timers_test_run(when - ticks);
+}
+
+static void
+timers_test_start(int start)
+{
+	struct timers_test_peer *tp;
+
+	ticks = start;
+	bzero(&timers_test_sc, sizeof(timers_test_sc));
+	wg_softc_timers_init(&timers_test_sc);
+	for (tp = timers_test_peers;
+	    tp < &timers_test_peers[TIMERS_TEST_PEERS]; tp++) {
+		bzero(tp, sizeof(*tp));
+		tp->p_peer.p_sc = &timers_test_sc;
+		refcount_init(&tp->p_peer.p_refcnt, 1);
+		wg_peer_timers_init(&tp->p_peer);
+	}
+}
+
+/* The peer's wheel entry is armed for when, and holds a reference. */
+static void
+timers_test_armed(const char *name, struct timers_test_peer *tp, int when)
+{
+	struct wg_timers *t = &tp->p_peer.p_timers;
+
+	timers_test_check(name, t->t_armed == when);
+	timers_test_check(name, wg_wheel_pending(&t->t_entry));
+	timers_test_check(name, tp->p_peer.p_refcnt == 2);
+}
+
+/* The peer's wheel entry is off the wheel, and its reference dropped. */
+static void
+timers_test_idle(const char *name, struct timers_test_peer *tp)
+{
+	struct wg_timers *t = &tp->p_peer.p_timers;
+
+	timers_test_check(name, t->t_armed == 0);
+	timers_test_check(name, !wg_wheel_pending(&t->t_entry));
+	timers_test_check(name, tp->p_peer.p_refcnt == 1);
+}
+
+/* How late the wheel may run a deadline set at set. */
+static int
+timers_test_slack(int set, int deadline)
+{
+	return ((deadline - set) / 8 + 2 * TIMERS_TEST_TICK);
+}
+
+/* Runs the clock past when a deadline set at set may go off. */
+static void
+timers_test_run_past(int set, int deadline)
+{
+	timers_test_run_to(deadline + timers_test_slack(set, deadline) + 1);
+}
+
+/* Something went off at p_at for a deadline set at set, never early. */
+static void
+timers_test_on_time(const char *name, struct timers_test_peer *tp, int set,
+    int deadline)
+{
+	timers_test_check(name, tp->p_at - deadline >= 0);
+	timers_test_check(name, tp->p_at - deadline <=
+	    timers_test_slack(set, deadline));
+}
+
+static void
+timers_test_finish(const char *name)
+{
+	struct timers_test_peer *tp;
+
+	for (tp = timers_test_peers;
+	    tp < &timers_test_peers[TIMERS_TEST_PEERS]; tp++) {
+		wg_peer_timers_stop(&tp->p_peer);
+		timers_test_check(name, tp->p_peer.p_refcnt == 1);
+	}
+	timers_test_check(name, timers_test_sc.sc_wheel.w_count == 0);
+	wg_softc_timers_uninit(&timers_test_sc);
+}
+
+/*
+ * A session's timers, one after another: the persistent keepalive, a
+ * handshake retransmit, a new handshake cancelled by the reply, and the
+ * keys zeroed once nothing was heard for long enough.
+ */
+static void
+timers_test_session(const char *name, int start)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+	struct wg_wheel_entry *e = &t->t_entry;
+	int set, retransmit, zero, new, persistent;
+	uint64_t expire;
+
+	timers_test_start(start);
+	set = ticks;
+	wg_peer_timers_handshake_initiated(&tp->p_peer);
+	retransmit = t->t_retransmit_handshake;
+	timers_test_check(name, retransmit - set >= REKEY_TIMEOUT * hz);
+	timers_test_check(name, retransmit - set <
+	    REKEY_TIMEOUT * hz + REKEY_TIMEOUT_JITTER);
+	timers_test_armed(name, tp, retransmit);
+	expire = e->we_expire;
+
+	/* Later deadlines leave the wheel alone. */
+	wg_peer_timers_session_derived(&tp->p_peer);
+	zero = t->t_zero_key_material;
+	timers_test_check(name, zero == set + REJECT_AFTER_TIME * 3 * hz);
+	wg_peer_timers_data_sent(&tp->p_peer);
+	new = t->t_new_handshake;
+	timers_test_check(name, new - set >= NEW_HANDSHAKE_TIMEOUT * hz);
+	timers_test_run(1);
+	wg_peer_timers_data_sent(&tp->p_peer);
+	timers_test_check(name, t->t_new_handshake == new);
+	timers_test_armed(name, tp, retransmit);
+	timers_test_check(name, e->we_expire == expire);
+
+	/* An earlier one reschedules it, under the same reference. */
+	t->t_persistent_keepalive_interval = 1;
+	wg_peer_timers_any_authenticated_packet_traversal(&tp->p_peer);
+	persistent = ticks + hz;
+	timers_test_armed(name, tp, persistent);
+	timers_test_check(name, e->we_expire < expire);
+
+	timers_test_run_to(persistent - 1);
+	timers_test_check(name, tp->p_keepalives == 0);
+	timers_test_run_past(persistent - hz, persistent);
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_check(name, tp->p_kicks + 1 ==
+	    timers_test_sc.sc_encrypt.gt_enqueued);
+	timers_test_on_time(name, tp, persistent - hz, persistent);
+	timers_test_check(name, t->t_last_traversal == 0);
+	timers_test_armed(name, tp, retransmit);
+
+	/* The retransmit goes off once, and the retry is armed again. */
+	set = ticks;
+	timers_test_run_past(set, retransmit);
+	timers_test_check(name, tp->p_initiations == 1);
+	timers_test_check(name, tp->p_retries == 1);
+	timers_test_check(name, tp->p_clear_src == 1);
+	timers_test_check(name, t->t_handshake_attempts == 1);
+	timers_test_on_time(name, tp, set, retransmit);
+	retransmit = t->t_retransmit_handshake;
+	timers_test_check(name, retransmit - tp->p_at >= REKEY_TIMEOUT * hz);
+	timers_test_armed(name, tp, retransmit);
+
+	/* The handshake completes; the new handshake is cancelled by a reply. */
+	wg_peer_timers_handshake_complete(&tp->p_peer);
+	timers_test_check(name, t->t_retransmit_handshake == 0);
+	timers_test_check(name, t->t_handshake_attempts == 0);
+	wg_peer_timers_any_authenticated_packet_received(&tp->p_peer);
+	timers_test_check(name, t->t_new_handshake == 0);
+	timers_test_run_past(set, new);
+	timers_test_check(name, tp->p_initiations == 1);
+	timers_test_armed(name, tp, zero);
+
+	/* Nothing heard for long enough: the keys go, and the entry with it. */
+	timers_test_run_to(zero - 1);
+	timers_test_check(name, tp->p_zeroed == 0);
+	timers_test_run_past(zero - REJECT_AFTER_TIME * 3 * hz, zero);
+	timers_test_check(name, tp->p_zeroed == 1);
+	timers_test_on_time(name, tp, zero - REJECT_AFTER_TIME * 3 * hz, zero);
+	timers_test_check(name, t->t_zero_key_material == 0);
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_idle(name, tp);
+	timers_test_finish(name);
+}
+
+/*
+ * Data received arms the keepalive; more before it goes off asks for
+ * another after it. Sending anything cancels it.
+ */
+static void
+timers_test_keepalive(const char *name, int start)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+	int set, keepalive;
+
+	timers_test_start(start);
+	set = ticks;
+	wg_peer_timers_data_received(&tp->p_peer);
+	keepalive = t->t_send_keepalive;
+	timers_test_check(name, keepalive == set + KEEPALIVE_TIMEOUT * hz);
+	timers_test_armed(name, tp, keepalive);
+	timers_test_run(hz);
+	wg_peer_timers_data_received(&tp->p_peer);
+	timers_test_check(name, t->t_send_keepalive == keepalive);
+	timers_test_check(name, t->t_need_another_keepalive);
+
+	timers_test_run_past(set, keepalive);
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_on_time(name, tp, set, keepalive);
+	timers_test_check(name, !t->t_need_another_keepalive);
+	set = tp->p_at;
+	keepalive = t->t_send_keepalive;
+	timers_test_check(name, keepalive == set + KEEPALIVE_TIMEOUT * hz);
+	timers_test_armed(name, tp, keepalive);
+	timers_test_run_past(set, keepalive);
+	timers_test_check(name, tp->p_keepalives == 2);
+	timers_test_on_time(name, tp, set, keepalive);
+	timers_test_idle(name, tp);
+
+	/* Cancelled: the entry still goes off, finds nothing, and is done. */
+	wg_peer_timers_data_received(&tp->p_peer);
+	keepalive = t->t_send_keepalive;
+	timers_test_armed(name, tp, keepalive);
+	wg_peer_timers_any_authenticated_packet_sent(&tp->p_peer);
+	timers_test_check(name, t->t_send_keepalive == 0);
+	timers_test_armed(name, tp, keepalive);
+	timers_test_run_past(ticks, keepalive);
+	timers_test_check(name, tp->p_keepalives == 2);
+	timers_test_idle(name, tp);
+	timers_test_finish(name);
+}
+
+/*
+ * Data sent and nothing heard back: the keepalive goes first, and the entry
+ * is armed again for the new handshake, which starts one afresh.
+ */
+static void
+timers_test_new_handshake(const char *name, int start)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+	int set, keepalive, new;
+
+	timers_test_start(start);
+	set = ticks;
+	wg_peer_timers_data_received(&tp->p_peer);
+	wg_peer_timers_data_sent(&tp->p_peer);
+	keepalive = t->t_send_keepalive;
+	new = t->t_new_handshake;
+	timers_test_armed(name, tp, keepalive);
+	timers_test_run_past(set, keepalive);
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_armed(name, tp, new);
+
+	timers_test_run_past(set, new);
+	timers_test_check(name, tp->p_initiations == 1);
+	timers_test_check(name, tp->p_retries == 0);
+	timers_test_check(name, tp->p_clear_src == 1);
+	timers_test_check(name, t->t_new_handshake == 0);
+	timers_test_on_time(name, tp, set, new);
+	timers_test_armed(name, tp, t->t_retransmit_handshake);
+	wg_peer_timers_handshake_complete(&tp->p_peer);
+	timers_test_run_past(tp->p_at, tp->p_at + REKEY_TIMEOUT * hz +
+	    REKEY_TIMEOUT_JITTER);
+	timers_test_check(name, tp->p_initiations == 1);
+	timers_test_idle(name, tp);
+	timers_test_finish(name);
+}
+
+/*
+ * A handshake nobody answers is retried until MAX_TIMER_HANDSHAKES retries
+ * have gone unanswered, then given up: what was staged is flushed, and the keys are zeroed later.
+ */
+static void
+timers_test_give_up(const char *name, int start)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+	int zero;
+
+	timers_test_start(start);
+	wg_peer_timers_data_received(&tp->p_peer);
+	wg_peer_timers_handshake_initiated(&tp->p_peer);
+	timers_test_run((MAX_TIMER_HANDSHAKES + 2) *
+	    (REKEY_TIMEOUT * hz + REKEY_TIMEOUT_JITTER + hz));
+	timers_test_check(name, tp->p_initiations == MAX_TIMER_HANDSHAKES + 1);
+	timers_test_check(name, tp->p_retries == MAX_TIMER_HANDSHAKES + 1);
+	timers_test_check(name, tp->p_flushes == 1);
+	timers_test_check(name, t->t_retransmit_handshake == 0);
+	/* The keepalive went once; the one pending at the end was dropped. */
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_check(name, t->t_send_keepalive == 0);
+	zero = t->t_zero_key_material;
+	timers_test_check(name, zero != 0);
+	timers_test_armed(name, tp, zero);
+	timers_test_run_past(zero - REJECT_AFTER_TIME * 3 * hz, zero);
+	timers_test_check(name, tp->p_zeroed == 1);
+	timers_test_idle(name, tp);
+	timers_test_finish(name);
+}
+
+/*
+ * Peers due in the same tick are run WG_WHEEL_BATCH at a time, in the
+ * order they were armed, and the encrypt task is kicked once for each
+ * batch that queued a keepalive.
+ */
+static void
+timers_test_batch(const char *name, int start)
+{
+	struct timers_test_peer *tp;
+	u_int kicks;
+	int i, set, keepalive;
+
+	timers_test_start(start);
+	set = ticks;
+	for (i = 0; i < TIMERS_TEST_PEERS; i++)
+		wg_peer_timers_data_received(&timers_test_peers[i].p_peer);
+	keepalive = timers_test_peers[0].p_peer.p_timers.t_send_keepalive;
+	kicks = timers_test_sc.sc_encrypt.gt_enqueued;
+	timers_test_run_past(set, keepalive);
+	timers_test_check(name, timers_test_sc.sc_encrypt.gt_enqueued - kicks ==
+	    howmany(TIMERS_TEST_PEERS, WG_WHEEL_BATCH));
+	for (i = 0; i < TIMERS_TEST_PEERS; i++) {
+		tp = &timers_test_peers[i];
+		timers_test_check(name, tp->p_keepalives == 1);
+		timers_test_check(name, tp->p_at == timers_test_peers[0].p_at);
+		timers_test_check(name, tp->p_kicks - kicks ==
+		    i / WG_WHEEL_BATCH);
+		timers_test_idle(name, tp);
+	}
+	timers_test_on_time(name, &timers_test_peers[0], set, keepalive);
+	timers_test_finish(name);
+}
+
+/* A stopped peer gives up its entry, and is not armed again. */
+static void
+timers_test_stop(const char *name, int start)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+
+	timers_test_start(start);
+	wg_peer_timers_data_received(&tp->p_peer);
+	wg_peer_timers_handshake_initiated(&tp->p_peer);
+	timers_test_armed(name, tp, t->t_retransmit_handshake);
+	wg_peer_timers_stop(&tp->p_peer);
+	timers_test_idle(name, tp);
+	wg_peer_timers_session_derived(&tp->p_peer);
+	timers_test_idle(name, tp);
+	timers_test_run(2 * KEEPALIVE_TIMEOUT * hz);
+	timers_test_check(name, tp->p_keepalives == 0);
+	timers_test_check(name, tp->p_initiations == 0);
+	timers_test_finish(name);
+}
+
+/* A deadline that falls on tick 0 is taken as tick 1, and still goes off. */
+static void
+timers_test_zero(const char *name)
+{
+	struct timers_test_peer *tp = &timers_test_peers[0];
+	struct wg_timers *t = &tp->p_peer.p_timers;
+
+	timers_test_start(-KEEPALIVE_TIMEOUT * hz);
+	wg_peer_timers_data_received(&tp->p_peer);
+	timers_test_check(name, t->t_send_keepalive == 1);
+	timers_test_armed(name, tp, 1);
+	timers_test_run(KEEPALIVE_TIMEOUT * hz + hz);
+	timers_test_check(name, tp->p_keepalives == 1);
+	timers_test_check(name, tp->p_at >= 1);
+	timers_test_idle(name, tp);
+	timers_test_finish(name);
+}
+
+int
+main(void)
+{
+	/* Runs up to the wrap of ticks and past it. */
+	int wrap = INT_MAX - 60 * TIMERS_TEST_HZ;
+
+	timers_test_session("session", 0);
+	timers_test_session("session wrap", wrap);
+	timers_test_keepalive("keepalive", 0);
+	timers_test_keepalive("keepalive wrap", INT_MAX - 5 * TIMERS_TEST_HZ);
+	timers_test_new_handshake("new handshake", 0);
+	timers_test_new_handshake("new handshake wrap",
+	    INT_MAX - 5 * TIMERS_TEST_HZ);
+	timers_test_give_up("give up", 0);
+	timers_test_give_up("give up wrap", wrap);
+	timers_test_batch("batch", 0);
+	timers_test_batch("batch wrap", INT_MAX - 5 * TIMERS_TEST_HZ);
+	timers_test_stop("stop", 0);
+	timers_test_zero("zero");
+
+	if (timers_test_failed != 0)
+		return (1);
+	printf("timers-test: ok\n");
+	return (0);
+}
@@ -0,0 +1,367 @@
+/* SPDX-License-Identifier: GPL-2.0 OR MIT */
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ *
+ * The timer wheel of module/if_wg_wheel.c, built unmodified, on a clock the
+ * test moves a tick at a time, running the wheel's callout when it is due.
+ * Every entry scheduled fires once, never before its deadline and no later
+ * than an eighth of its timeout and a couple of wheel ticks after it, in
+ * batches however many expire together; one moved fires at its new
+ * deadline only, and one removed never. An entry further out than the top
+ * level reaches fires early, as its owner is told to expect, and fires on
+ * time once re-armed from the callback. All of it holds across the wrap of
+ * ticks.
+ */
+
+#include <sys/types.h>
+#include <sys/systm.h>
+#include <sys/param.h>
+#include <sys/kernel.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/callout.h>
+
+#include <sys/if_wg_wheel.h>
+
+#define WHEEL_TEST_HZ		1000
+#define WHEEL_TEST_TICK		(WHEEL_TEST_HZ / WG_WHEEL_HZ)
+#define WHEEL_TEST_TIMERS	2000
+/* As far as the top level reaches, in ticks. */
+#define WHEEL_TEST_REACH	((WG_WHEEL_SLOTS << (WG_WHEEL_GRAN_BITS * \
+				    (WG_WHEEL_LEVELS - 1))) * WHEEL_TEST_TICK)
+
+struct wheel_test_timer {
+	struct wg_wheel_entry	 t_entry;
+	int			 t_timeout;
+	int			 t_deadline;
+	int			 t_lag;		/* Behind the wheel's clock. */
+	int			 t_fired;	/* On time or late. */
+	int			 t_fired_at;
+	int			 t_early;	/* Re-armed, as its owner would. */
+	bool			 t_removed;
+	/* Scheduled from the callback for the tick it runs, if set. */
+	struct wheel_test_timer	*t_chain;
+};
+
+volatile int ticks;
+int hz = WHEEL_TEST_HZ;
+
+static struct wg_wheel wheel_test_wheel;
+static struct wheel_test_timer wheel_test_timers[WHEEL_TEST_TIMERS];
+static uint64_t wheel_test_rng = 0x2545f4914f6cdd1dull;
+static int wheel_test_batches, wheel_test_batch_max;
+static int wheel_test_failed;
+
+#define wheel_test_check(name, exp) do {				\
+	if (!(exp)) {							\
+		fprintf(stderr, "wheel-test: %s: %s\n", (name), #exp);	\
+		wheel_test_failed++;					\
+	}								\
+} while (0)
+
+static uint64_t
+wheel_test_random(void)
+{
+	wheel_test_rng ^= wheel_test_rng << 13;
+	wheel_test_rng ^= wheel_test_rng >> 7;
+	wheel_test_rng ^= wheel_test_rng << 17;
+	return (wheel_test_rng);
+}
+
+/*
+ * The owner's side, as wg_peer_timers_run has it: a timer that went off
+ * before its deadline is armed again for it.
+ */
+static void
+wheel_test_fn(void *arg, struct wg_wheel_entry **batch, int n)
+{
+	struct wheel_test_timer *t;
+	int i;
+
+	wheel_test_check("batch", arg == &wheel_test_wheel);
+	wheel_test_check("batch", n > 0 && n <= WG_WHEEL_BATCH);
+	wheel_test_batches++;
+	wheel_test_batch_max = MAX(wheel_test_batch_max, n);
+	for (i = 0; i < n; i++) {
+		t = __containerof(batch[i], struct wheel_test_timer, t_entry);
+		wheel_test_check("batch", !wg_wheel_pending(&t->t_entry));
+		wheel_test_check("batch", !t->t_removed);
+		/* Never more often than the top level's reach allows. */
+		if (ticks - t->t_deadline < 0 &&
+		    t->t_early <= t->t_timeout / WHEEL_TEST_REACH) {
+			t->t_early++;
+			wg_wheel_schedule(&wheel_test_wheel, &t->t_entry,
+			    t->t_deadline);
+			continue;
+		}
+		t->t_fired++;
+		t->t_fired_at = ticks;
+		if (t->t_chain != NULL)
+			wg_wheel_schedule(&wheel_test_wheel,
+			    &t->t_chain->t_entry, t->t_chain->t_deadline);
+	}
+}
+
+/*
+ * Moves the clock on n ticks, running the callout whenever it is due, or
+ * not at all if stalled, as a callout can be held up.
+ */
+static void
+wheel_test_advance(int n, bool stalled)
+{
+	struct callout *c = &wheel_test_wheel.w_callout;
+
+	while (n-- > 0) {
+		ticks++;
+		if (!stalled && c->c_pending && ticks - c->c_time >= 0) {
+			c->c_pending = false;
+			c->c_func(c->c_arg);
+		}
+	}
+}
+
+static void
+wheel_test_run(int n)
+{
+	wheel_test_advance(n, false);
+}
+
+static void
+wheel_test_schedule(struct wheel_test_timer *t, int timeout)
+{
+	t->t_timeout = timeout;
+	t->t_deadline = ticks + timeout;
+	wg_wheel_schedule(&wheel_test_wheel, &t->t_entry, t->t_deadline);
+	t->t_lag = ticks - wheel_test_wheel.w_ticks;
+}
+
+static void
+wheel_test_start(int start)
+{
+	struct wheel_test_timer *t;
+
+	ticks = start;
+	wg_wheel_init(&wheel_test_wheel, wheel_test_fn, &wheel_test_wheel);
+	for (t = wheel_test_timers; t < &wheel_test_timers[WHEEL_TEST_TIMERS];
+	    t++) {
+		bzero(t, sizeof(*t));
+		wg_wheel_entry_init(&t->t_entry);
+	}
+	wheel_test_batches = wheel_test_batch_max = 0;
+}
+
+/*
+ * Every timer fired once, on time, unless it was removed; nothing is left
+ * on the wheel, nor its callout armed. A timer is placed from where the
+ * wheel's clock stood, which lags while its callout is held up, and one due
+ * before the callout runs again at resume is that much later.
+ */
+static void
+wheel_test_finish(const char *name, const int *resume)
+{
+	struct wheel_test_timer *t;
+	int late, held;
+
+	for (t = wheel_test_timers; t < &wheel_test_timers[WHEEL_TEST_TIMERS];
+	    t++) {
+		wheel_test_check(name, !wg_wheel_pending(&t->t_entry));
+		if (t->t_timeout == 0 || t->t_removed) {
+			wheel_test_check(name, t->t_fired == 0);
+			continue;
+		}
+		wheel_test_check(name, t->t_fired == 1);
+		late = t->t_fired_at - t->t_deadline;
+		held = resume != NULL ? MAX(*resume - t->t_deadline, 0) : 0;
+		wheel_test_check(name, late >= 0);
+		wheel_test_check(name,
+		    late <= held + (t->t_timeout + t->t_lag) / 8 +
+		    2 * WHEEL_TEST_TICK);
+		if (t->t_timeout < WHEEL_TEST_REACH - WHEEL_TEST_TICK)
+			wheel_test_check(name, t->t_early == 0);
+	}
+	wheel_test_check(name, wheel_test_wheel.w_count == 0);
+	wheel_test_check(name, !callout_pending(&wheel_test_wheel.w_callout));
+	wg_wheel_uninit(&wheel_test_wheel);
+}
+
+/* Timeouts spread over every level, scheduled while the clock runs. */
+static void
+wheel_test_insert(const char *name, int start)
+{
+	int i, longest = 0, timeout;
+
+	wheel_test_start(start);
+	for (i = 0; i < WHEEL_TEST_TIMERS; i++) {
+		/* A tick up to twenty minutes, evenly over the levels. */
+		timeout = 1 + wheel_test_random() %
+		    (WHEEL_TEST_TICK << (i % 18));
+		wheel_test_schedule(&wheel_test_timers[i], timeout);
+		longest = MAX(longest, timeout);
+		wheel_test_run(wheel_test_random() % 50);
+	}
+	wheel_test_run(longest + longest / 8 + 2 * WHEEL_TEST_TICK);
+	wheel_test_finish(name, NULL);
+}
+
+/*
+ * Timers moved earlier and later, some more than once, fire at their last
+ * deadline; removed ones never do, even if they were due that very tick.
+ */
+static void
+wheel_test_move(const char *name, int start)
+{
+	struct wheel_test_timer *t;
+	int i;
+
+	wheel_test_start(start);
+	/* The last two are kept for the end. */
+	for (i = 0; i < WHEEL_TEST_TIMERS - 2; i++)
+		wheel_test_schedule(&wheel_test_timers[i],
+		    1 + wheel_test_random() % (60 * WHEEL_TEST_HZ));
+	wheel_test_run(5 * WHEEL_TEST_HZ);
+	for (i = 0; i < WHEEL_TEST_TIMERS - 2; i++) {
+		t = &wheel_test_timers[i];
+		switch (i % 4) {
+		case 0:
+			break;
+		case 1:
+			/* Still pending, unless it has fired. */
+			wheel_test_check(name, wg_wheel_pending(&t->t_entry) ==
+			    (t->t_fired == 0));
+			if (t->t_fired != 0)
+				break;
+			wheel_test_check(name, wg_wheel_remove(
+			    &wheel_test_wheel, &t->t_entry));
+			wheel_test_check(name, !wg_wheel_remove(
+			    &wheel_test_wheel, &t->t_entry));
+			t->t_removed = true;
+			break;
+		default:
+			if (t->t_fired != 0)
+				break;
+			wheel_test_check(name, wg_wheel_pending(&t->t_entry));
+			wheel_test_schedule(t, i % 4 == 2 ?
+			    1 + wheel_test_random() % (120 * WHEEL_TEST_HZ) :
+			    1 + wheel_test_random() % WHEEL_TEST_HZ);
+			if (i % 8 == 3)
+				wheel_test_schedule(t, t->t_timeout + 1);
+			break;
+		}
+	}
+
+	/* Due in the same slot as one that goes off, then removed. */
+	t = &wheel_test_timers[WHEEL_TEST_TIMERS - 1];
+	wheel_test_schedule(t, WHEEL_TEST_TICK);
+	wheel_test_schedule(t - 1, WHEEL_TEST_TICK);
+	wheel_test_run(WHEEL_TEST_TICK - 1);
+	wheel_test_check(name, wg_wheel_remove(&wheel_test_wheel, &t->t_entry));
+	t->t_removed = true;
+	wheel_test_run(WHEEL_TEST_TICK);
+	wheel_test_check(name, (t - 1)->t_fired == 1);
+
+	wheel_test_run(140 * WHEEL_TEST_HZ);
+	wheel_test_finish(name, NULL);
+}
+
+/*
+ * Many timers expiring together come in full batches, and one scheduled
+ * from the callback for the tick being run goes off in that same run.
+ */
+static void
+wheel_test_batch(const char *name, int start)
+{
+	int i, timeout = 3 * WHEEL_TEST_HZ;
+
+	wheel_test_start(start);
+	for (i = 0; i < WHEEL_TEST_TIMERS - 1; i++)
+		wheel_test_schedule(&wheel_test_timers[i], timeout);
+	wheel_test_timers[0].t_chain = &wheel_test_timers[i];
+	wheel_test_timers[i].t_timeout = timeout;
+	wheel_test_timers[i].t_deadline = ticks + timeout;
+	wheel_test_run(timeout + timeout / 8 + 2 * WHEEL_TEST_TICK);
+	wheel_test_check(name, wheel_test_batch_max == WG_WHEEL_BATCH);
+	wheel_test_check(name, wheel_test_batches ==
+	    howmany(WHEEL_TEST_TIMERS - 1, WG_WHEEL_BATCH) + 1);
+	wheel_test_check(name, wheel_test_timers[i].t_fired_at ==
+	    wheel_test_timers[0].t_fired_at);
+	wheel_test_finish(name, NULL);
+}
+
+/*
+ * Timers further out than the top level reaches go off early, at the end
+ * of its reach, and on time once their owner has armed them again.
+ */
+static void
+wheel_test_far(const char *name, int start)
+{
+	struct wheel_test_timer *t;
+	int i;
+
+	wheel_test_start(start);
+	for (i = 0; i < 8; i++) {
+		t = &wheel_test_timers[i];
+		wheel_test_schedule(t, WHEEL_TEST_REACH + (i + 1) *
+		    WHEEL_TEST_REACH / 4 + wheel_test_random() % WHEEL_TEST_HZ);
+		wheel_test_run(wheel_test_random() % (60 * WHEEL_TEST_HZ));
+	}
+	wheel_test_run(WHEEL_TEST_REACH + 100);
+	for (i = 0; i < 8; i++) {
+		t = &wheel_test_timers[i];
+		wheel_test_check(name, t->t_early >= 1);
+		wheel_test_check(name, t->t_fired == 0);
+	}
+	wheel_test_run(2 * WHEEL_TEST_REACH + WHEEL_TEST_REACH / 8);
+	for (i = 0; i < 8; i++)
+		wheel_test_check(name, wheel_test_timers[i].t_early <=
+		    wheel_test_timers[i].t_timeout / WHEEL_TEST_REACH + 1);
+	wheel_test_finish(name, NULL);
+}
+
+/*
+ * With the callout held up, timers scheduled meanwhile do not put the wheel
+ * past the slots still to run, and all that came due goes off at once when
+ * it runs.
+ */
+static void
+wheel_test_stall(const char *name, int start)
+{
+	int i, resume, stall = 3 * WHEEL_TEST_HZ;
+
+	wheel_test_start(start);
+	for (i = 0; i < WHEEL_TEST_TIMERS / 2; i++)
+		wheel_test_schedule(&wheel_test_timers[i],
+		    1 + wheel_test_random() % (5 * WHEEL_TEST_HZ));
+	wheel_test_run(WHEEL_TEST_HZ);
+	for (; i < WHEEL_TEST_TIMERS; i++) {
+		wheel_test_advance(wheel_test_random() % 6, true);
+		wheel_test_schedule(&wheel_test_timers[i],
+		    1 + wheel_test_random() % (5 * WHEEL_TEST_HZ));
+	}
+	wheel_test_advance(stall, true);
+	resume = ticks + 1;
+	wheel_test_run(10 * WHEEL_TEST_HZ);
+	wheel_test_finish(name, &resume);
+}
+
+int
+main(void)
+{
+	/* Runs up to the wrap of ticks and past it. */
+	int wrap = INT_MAX - 90 * WHEEL_TEST_HZ;
+
+	wheel_test_insert("insert", 0);
+	wheel_test_insert("insert wrap", wrap);
+	wheel_test_move("move", 0);
+	wheel_test_move("move wrap", wrap);
+	wheel_test_batch("batch", 0);
+	wheel_test_batch("batch wrap", INT_MAX - WHEEL_TEST_HZ);
+	wheel_test_stall("stall", 0);
+	wheel_test_stall("stall wrap", wrap);
+	wheel_test_far("far", 0);
+	wheel_test_far("far wrap", wrap);
+
+	if (wheel_test_failed != 0)
+		return (1);
+	printf("wheel-test: ok\n");
+	return (0);
+}
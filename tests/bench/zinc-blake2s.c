@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#include "../../module/crypto/zinc/blake2s/blake2s.c"
+#include <zinc/poly1305.h>
+#include <zinc/curve25519.h>
+#include "bench.h"
+
+const struct bench_zinc bench_blake2s = BENCH_ZINC(blake2s, blake2s_mod_init);
@@ -0,0 +1,6 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#include "../../module/crypto/zinc/chacha20poly1305.c"
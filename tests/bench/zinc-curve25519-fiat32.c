@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#undef CONFIG_ZINC_ARCH_X86_64
+#undef CONFIG_ARCH_SUPPORTS_INT128
+#define curve25519 fiat32_curve25519
+#define curve25519_generate_public fiat32_curve25519_generate_public
+#define curve25519_generate_secret fiat32_curve25519_generate_secret
+#define curve25519_mod_init fiat32_curve25519_mod_init
+
+#include "../../module/crypto/zinc/curve25519/curve25519.c"
+#include <zinc/poly1305.h>
+#include "bench.h"
+
+const struct bench_zinc bench_curve25519_fiat32 =
+	BENCH_ZINC(curve25519, fiat32_curve25519_mod_init);
@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#include "../../module/crypto/zinc/curve25519/curve25519.c"
+#include <zinc/poly1305.h>
+#include "bench.h"
+
+const struct bench_zinc bench_curve25519 =
+	BENCH_ZINC(curve25519, curve25519_mod_init);
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#undef CONFIG_ZINC_ARCH_X86_64
+#ifndef CONFIG_ARCH_SUPPORTS_INT128
+#define CONFIG_ARCH_SUPPORTS_INT128
+#endif
+#define poly1305_init donna64_poly1305_init
+#define poly1305_update donna64_poly1305_update
+#define poly1305_final donna64_poly1305_final
+#define poly1305_mod_init donna64_poly1305_mod_init
+
+#include "../../module/crypto/zinc/poly1305/poly1305.c"
+#include <zinc/curve25519.h>
+#include "bench.h"
+
+const struct bench_zinc bench_poly1305_donna64 =
+	BENCH_ZINC(poly1305, donna64_poly1305_mod_init);
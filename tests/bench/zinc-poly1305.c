@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: GPL-2.0 OR MIT
+/*
+ * Copyright (C) 2019-2020 Netgate, Inc.
+ */
+
+#include "../../module/crypto/zinc/poly1305/poly1305.c"
+#include <zinc/curve25519.h>
+#include "bench.h"
+
+const struct bench_zinc bench_poly1305 = BENCH_ZINC(poly1305, poly1305_mod_init);
@@ -75,17 +75,13 @@ static noinline void memzero_explicit(void *s, size_t count)
 	asm volatile("": :"r"(s) : "memory");
 }
 
-#ifdef __SIZEOF_INT128__
-#include "../crypto/zinc/curve25519/curve25519-hacl64.c"
-#else
-#include "../crypto/zinc/curve25519/curve25519-fiat32.c"
-#endif
+/* The comb works on fiat32 field elements, so the ladder uses them too. */
+#include "../module/crypto/zinc/curve25519/curve25519-fiat32.c"
+#include "../module/curve25519-comb.c"
 
 void curve25519_generate_public(uint8_t pub[static CURVE25519_KEY_SIZE], const uint8_t secret[static CURVE25519_KEY_SIZE])
 {
-	static const uint8_t basepoint[CURVE25519_KEY_SIZE] __aligned(sizeof(uintptr_t)) = { 9 };
-
-	curve25519(pub, secret, basepoint);
+	curve25519_comb_base(pub, secret);
 }
 
 void curve25519(uint8_t mypublic[static CURVE25519_KEY_SIZE], const uint8_t secret[static CURVE25519_KEY_SIZE], const uint8_t basepoint[static CURVE25519_KEY_SIZE])